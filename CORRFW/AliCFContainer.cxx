@@ -123,6 +123,16 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
   fGrid[istep]->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFContainer::SetDenseFillThreshold(Double_t thr, Long64_t maxCells)
+{
+  //
+  // sets the occupancy threshold above which the grids of all steps
+  // switch to the dense storage (thr<0 disables it)
+  //
+  for (Int_t iStep=0; iStep<fNStep; iStep++) fGrid[iStep]->SetDenseFillThreshold(thr,maxCells);
+}
+
 //____________________________________________________________________
 TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3) const
 {
@@ -175,7 +185,7 @@ AliCFContainer* AliCFContainer::MakeSlice(Int_t nSteps, const Int_t* steps,
   for (Int_t iStep=0; iStep<nSteps; iStep++) grids[iStep] = fGrid[steps[iStep]]->MakeSlice(nVars,vars,varMin,varMax,useBins);
 
   TAxis ** axis = new TAxis*[nVars];
-  for (Int_t iVar=0; iVar<nVars; iVar++) axis[iVar] = ((AliCFGridSparse*)grids[0])->GetGrid()->GetAxis(iVar); //same axis for every grid
+  for (Int_t iVar=0; iVar<nVars; iVar++) axis[iVar] = grids[0]->GetAxis(iVar); //same axis for every grid
 
   //define new binning for new container
   Int_t* bins=new Int_t[nVars];
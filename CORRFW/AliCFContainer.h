@@ -45,8 +45,8 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t    * GetNBins()                                      const {return fGrid[0]->GetNBins();}
   virtual Float_t    GetBinCenter(Int_t ivar,Int_t ibin)             const {return fGrid[0]->GetBinCenter(ivar,ibin);}
   virtual Float_t    GetBinSize  (Int_t ivar,Int_t ibin)             const {return fGrid[0]->GetBinSize  (ivar,ibin);}
-  virtual Float_t    GetBinContent(const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetGrid()->GetBinContent(coordinates);}
-  virtual Float_t    GetBinError  (const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetGrid()->GetBinError  (coordinates);}
+  virtual Float_t    GetBinContent(const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetStorage()->GetBinContent(coordinates);}
+  virtual Float_t    GetBinError  (const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetStorage()->GetBinError  (coordinates);}
   virtual const Char_t* GetBinLabel (Int_t ivar,Int_t ibin)          const {return GetAxis(ivar,0)->GetBinLabel(ibin);}
 
   virtual void       Print(const Option_t*) const ;
@@ -85,6 +85,7 @@ class AliCFContainer : public AliCFFrame
 
   virtual void  SetGrid(Int_t step, AliCFGridSparse* grid) {if (fGrid[step]) delete fGrid[step]; fGrid[step]=grid;}
   virtual AliCFGridSparse * GetGrid(Int_t istep) const {return fGrid[istep];};
+  virtual void  SetDenseFillThreshold(Double_t thr, Long64_t maxCells=AliCFGridSparse::kDenseMaxCells) ; // see AliCFGridSparse
 
   virtual void  Scale(Double_t factor) const;
 
@@ -147,13 +148,13 @@ inline void  AliCFContainer::Scale(Double_t factor) const {
 inline void AliCFContainer::SetBinContent(Int_t* bin, Int_t step, Double_t value) {
   // sets the content 'value' to the current container, at step 'step'
   // 'bin' is the array of the bin coordinates
-  GetGrid(step)->GetGrid()->SetBinContent(bin,value);
+  GetGrid(step)->GetStorage()->SetBinContent(bin,value);
 }
 
 inline void AliCFContainer::SetBinError(Int_t* bin, Int_t step, Double_t value) {
   // sets the error 'value' to the current container, at step 'step'
   // 'bin' is the array of the bin coordinates
-  GetGrid(step)->GetGrid()->SetBinError(bin,value);
+  GetGrid(step)->GetStorage()->SetBinError(bin,value);
 }
 
 #endif
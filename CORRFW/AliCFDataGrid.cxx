@@ -67,7 +67,7 @@ AliCFDataGrid::AliCFDataGrid(const Char_t* name, const Char_t* title, const AliC
   //
 
   //simply clones the container's data at specified step
-  fData = (THnSparse*) fContainer->GetGrid(fSelData)->GetGrid()->Clone();
+  SetStorage((THnBase*) fContainer->GetGrid(fSelData)->GetStorage()->Clone());
   SumW2();
   AliInfo(Form("retrieving measured data from Container %s at selection step %i.",fContainer->GetName(),fSelData));
 }
@@ -146,8 +146,8 @@ Double_t AliCFEffGrid::GetAverage() const
   Double_t valnum=0;
   Double_t valden=0;
 
-  THnSparse* num = ((AliCFGridSparse*)GetNum())->GetGrid() ;
-  THnSparse* den = ((AliCFGridSparse*)GetDen())->GetGrid() ;
+  THnBase* num = ((AliCFGridSparse*)GetNum())->GetStorage() ;
+  THnBase* den = ((AliCFGridSparse*)GetDen())->GetStorage() ;
 
   for (Long_t iBin=0; iBin<num->GetNbins(); iBin++) valnum+=num->GetBinContent(iBin);
   for (Long_t iBin=0; iBin<den->GetNbins(); iBin++) valden+=den->GetBinContent(iBin);
@@ -169,29 +169,29 @@ TH1* AliCFEffGrid::Project(Int_t ivar1, Int_t ivar2, Int_t ivar3) const
   const Int_t nDim = 3 ;
   Int_t dim[nDim] = {ivar1,ivar2,ivar3} ;
   
-  THnSparse *hNum, *hDen, *ratio;
+  THnBase *hNum, *hDen, *ratio;
   TH1* h ;
 
   if (ivar3<0) {
     if (ivar2<0) {
-      hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nDim-2,dim);
-      hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nDim-2,dim);
-      ratio = (THnSparse*)hNum->Clone();
+      hNum = ((AliCFGridSparse*)GetNum())->GetStorage()->Projection(nDim-2,dim);
+      hDen = ((AliCFGridSparse*)GetDen())->GetStorage()->Projection(nDim-2,dim);
+      ratio = (THnBase*)hNum->Clone();
       ratio->Divide(hNum,hDen,1.,1.,"B");
       h = ratio->Projection(0);
     }
     else{
-      hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nDim-1,dim);
-      hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nDim-1,dim);
-      ratio = (THnSparse*)hNum->Clone();
+      hNum = ((AliCFGridSparse*)GetNum())->GetStorage()->Projection(nDim-1,dim);
+      hDen = ((AliCFGridSparse*)GetDen())->GetStorage()->Projection(nDim-1,dim);
+      ratio = (THnBase*)hNum->Clone();
       ratio->Divide(hNum,hDen,1.,1.,"B");
       h = ratio->Projection(1,0);
     }
   }
   else {
-    hNum = ((AliCFGridSparse*)GetNum())->GetGrid()->Projection(nDim,dim);
-    hDen = ((AliCFGridSparse*)GetDen())->GetGrid()->Projection(nDim,dim);
-    ratio = (THnSparse*)hNum->Clone();
+    hNum = ((AliCFGridSparse*)GetNum())->GetStorage()->Projection(nDim,dim);
+    hDen = ((AliCFGridSparse*)GetDen())->GetStorage()->Projection(nDim,dim);
+    ratio = (THnBase*)hNum->Clone();
     ratio->Divide(hNum,hDen,1.,1.,"B");
     h = ratio->Projection(0,1,2);
   }
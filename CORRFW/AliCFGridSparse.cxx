@@ -17,7 +17,7 @@
 // AliCFGridSparse Class                                              //
 // Class to accumulate data on an N-dimensional grid, to be used      //
 // as input to get corrections for Reconstruction & Trigger efficiency// 
-// Based on root THnSparse                                            //
+// Based on root THnSparse, or THnF/THnD for well occupied grids      //
 // -- Author : S.Arcelli                                              //
 // Still to be done:                                                  //
 // --Interpolate among bins in a range                                // 
@@ -26,6 +26,7 @@
 //
 #include "AliCFGridSparse.h"
 #include "THnSparse.h"
+#include "THn.h"
 #include "AliLog.h"
 #include "TMath.h"
 #include "TROOT.h"
@@ -38,11 +39,18 @@
 //____________________________________________________________________
 ClassImp(AliCFGridSparse)
 
+const Double_t AliCFGridSparse::fgkDenseDefaultThreshold = 0.3;
+
 //____________________________________________________________________
 AliCFGridSparse::AliCFGridSparse() : 
   AliCFFrame(),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fDenseData(0x0),
+  fDenseThreshold(fgkDenseDefaultThreshold),
+  fDenseMaxCells(kDenseMaxCells),
+  fNFillsToCheck(kDenseCheckPeriod),
+  fGridExported(kFALSE)
 {
   // default constructor
 }
@@ -50,7 +58,12 @@ AliCFGridSparse::AliCFGridSparse() :
 AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title) : 
   AliCFFrame(name,title),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fDenseData(0x0),
+  fDenseThreshold(fgkDenseDefaultThreshold),
+  fDenseMaxCells(kDenseMaxCells),
+  fNFillsToCheck(kDenseCheckPeriod),
+  fGridExported(kFALSE)
 {
   // default constructor
 }
@@ -58,7 +71,12 @@ AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title) :
 AliCFGridSparse::AliCFGridSparse(const Char_t* name, const Char_t* title, Int_t nVarIn, const Int_t * nBinIn) :  
   AliCFFrame(name,title),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fDenseData(0x0),
+  fDenseThreshold(fgkDenseDefaultThreshold),
+  fDenseMaxCells(kDenseMaxCells),
+  fNFillsToCheck(kDenseCheckPeriod),
+  fGridExported(kFALSE)
 {
   //
   // main constructor
@@ -74,13 +92,19 @@ AliCFGridSparse::~AliCFGridSparse()
   // destructor
   //
   if (fData) delete fData;
+  if (fDenseData) delete fDenseData;
 }
 
 //____________________________________________________________________
 AliCFGridSparse::AliCFGridSparse(const AliCFGridSparse& c) :
   AliCFFrame(c),
   fSumW2(kFALSE),
-  fData(0x0)
+  fData(0x0),
+  fDenseData(0x0),
+  fDenseThreshold(fgkDenseDefaultThreshold),
+  fDenseMaxCells(kDenseMaxCells),
+  fNFillsToCheck(kDenseCheckPeriod),
+  fGridExported(kFALSE)
 {
   //
   // copy constructor
@@ -107,7 +131,7 @@ void AliCFGridSparse::SetBinLimits(Int_t ivar, Double_t min, Double_t max)
   Int_t nBins = GetNBins(ivar);
   Double_t * array = new Double_t[nBins+1];
   for (Int_t iEdge=0; iEdge<=nBins; iEdge++) array[iEdge] = min + iEdge * (max-min)/nBins ;
-  fData->SetBinEdges(ivar, array);
+  GetStorage()->SetBinEdges(ivar, array);
   delete [] array ;
 } 
 
@@ -117,7 +141,7 @@ void AliCFGridSparse::SetBinLimits(Int_t ivar, const Double_t *array)
   //
   // setting the arrays containing the bin limits 
   //
-  fData->SetBinEdges(ivar, array);
+  GetStorage()->SetBinEdges(ivar, array);
 } 
 
 //____________________________________________________________________
@@ -128,7 +152,190 @@ void AliCFGridSparse::Fill(const Double_t *var, Double_t weight)
   // given a set of values of the input variable, 
   // with weight (by default w=1)
   //
+  if (fDenseData) {
+    fDenseData->Fill(var,weight);
+    return;
+  }
   fData->Fill(var,weight);
+  // check the occupancy from time to time, switch to the dense storage when it is high enough
+  if (fDenseThreshold >= 0 && --fNFillsToCheck <= 0) CheckOccupancy();
+}
+
+//____________________________________________________________________
+THnSparse* AliCFGridSparse::GetGrid() const
+{
+  //
+  // returns the THnSparse storage. A dense grid is switched back to it
+  // first, and the THnSparse is then kept: the returned pointer stays
+  // valid and sees the later fills
+  //
+  if (fDenseData) const_cast<AliCFGridSparse*>(this)->SwitchToSparse();
+  fGridExported = kTRUE;
+  return fData;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SetDenseFillThreshold(Double_t thr, Long64_t maxCells)
+{
+  //
+  // sets the fraction of filled cells above which the grid switches to
+  // the dense storage, and the maximum number of cells of the dense storage
+  //
+  fDenseThreshold = thr;
+  fDenseMaxCells  = maxCells;
+  if (fDenseData) {
+    Double_t nCells = 1.;
+    for (Int_t iVar=0; iVar<GetNVar(); iVar++) nCells *= GetNBins(iVar)+2;
+    if (thr < 0 || nCells > maxCells) SwitchToSparse();
+  }
+  else CheckOccupancy();
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::CheckOccupancy()
+{
+  //
+  // switches to the dense storage if the fraction of filled cells
+  // (including over/underflows) exceeds fDenseThreshold
+  //
+  fNFillsToCheck = kDenseCheckPeriod;
+  if (!fData || fDenseData || fDenseThreshold < 0 || fGridExported) return;
+  Double_t nCells = 1.;
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) nCells *= GetNBins(iVar)+2;
+  if (fData->GetNbins() >= fDenseThreshold * nCells) SwitchToDense();
+}
+
+//____________________________________________________________________
+Bool_t AliCFGridSparse::SwitchToDense()
+{
+  //
+  // moves the content of the THnSparse to a THnF (THnD for a THnSparseD)
+  // and deletes the THnSparse. Not done if the grid has more than
+  // fDenseMaxCells cells, if an axis can be extended by a fill or if the
+  // THnSparse was handed out by GetGrid()
+  //
+  if (fDenseData) return kTRUE;
+  if (!fData || fGridExported) return kFALSE;
+  Double_t nCells = 1.;
+  for (Int_t iVar=0; iVar<GetNVar(); iVar++) {
+    TAxis* axis = fData->GetAxis(iVar);
+    if (axis->CanExtend()) return kFALSE;
+    nCells *= axis->GetNbins()+2;
+  }
+  if (nCells > fDenseMaxCells) return kFALSE;
+
+  THnBase* dense = NewStorage(kTRUE);
+  AddStorage(dense,fData,1.);
+  delete fData;
+  fData = 0x0;
+  fDenseData = dense;
+  AliDebug(1,Form("%s: switched to dense storage with %.0f cells",GetName(),nCells));
+  return kTRUE;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SwitchToSparse()
+{
+  //
+  // moves the content of the dense storage back to a THnSparse
+  //
+  if (!fDenseData) return;
+  THnBase* sparse = NewStorage(kFALSE);
+  AddStorage(sparse,fDenseData,1.);
+  delete fDenseData;
+  fDenseData = 0x0;
+  fData = (THnSparse*)sparse;
+  fNFillsToCheck = kDenseCheckPeriod;
+  AliDebug(1,Form("%s: switched to sparse storage",GetName()));
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::MatchStorage(const AliCFGridSparse* aGrid)
+{
+  //
+  // switches to the dense storage before a dense grid is added to this one,
+  // so that its empty cells are not visited in a THnSparse
+  //
+  if (aGrid->IsDense() && fDenseThreshold >= 0) SwitchToDense();
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::SetStorage(THnBase* h)
+{
+  //
+  // replaces the storage by h, a THnSparse or a dense THn (adopted)
+  //
+  if (h && h == GetStorage()) return;
+  if (fData) delete fData;
+  if (fDenseData) delete fDenseData;
+  fData = 0x0;
+  fDenseData = 0x0;
+  if (!h || h->InheritsFrom(THnSparse::Class())) fData = (THnSparse*)h;
+  else fDenseData = h;
+  fNFillsToCheck = kDenseCheckPeriod;
+}
+
+//____________________________________________________________________
+THnBase* AliCFGridSparse::NewStorage(Bool_t dense) const
+{
+  //
+  // creates an empty storage with the axes of the current one:
+  // a THnF/THnD if dense, a THnSparseF/THnSparseD otherwise
+  //
+  const THnBase* h = GetStorage();
+  const Int_t nVar = GetNVar();
+  Int_t*    nBins = new Int_t[nVar];
+  Double_t* xMin  = new Double_t[nVar];
+  Double_t* xMax  = new Double_t[nVar];
+  for (Int_t iVar=0; iVar<nVar; iVar++) {
+    nBins[iVar] = h->GetAxis(iVar)->GetNbins();
+    xMin[iVar]  = h->GetAxis(iVar)->GetXmin();
+    xMax[iVar]  = h->GetAxis(iVar)->GetXmax();
+  }
+  const Bool_t isFloat = h->InheritsFrom(THnSparseF::Class()) || h->InheritsFrom(THnF::Class());
+  THnBase* out = 0x0;
+  if (dense) {
+    if (isFloat) out = new THnF(h->GetName(),h->GetTitle(),nVar,nBins,xMin,xMax);
+    else         out = new THnD(h->GetName(),h->GetTitle(),nVar,nBins,xMin,xMax);
+  }
+  else {
+    if (isFloat) out = new THnSparseF(h->GetName(),h->GetTitle(),nVar,nBins,xMin,xMax);
+    else         out = new THnSparseD(h->GetName(),h->GetTitle(),nVar,nBins,xMin,xMax);
+  }
+  for (Int_t iVar=0; iVar<nVar; iVar++) h->GetAxis(iVar)->Copy(*out->GetAxis(iVar)); // variable bins, titles, labels, ranges
+  if (h->GetCalculateErrors()) out->Sumw2();
+  delete [] nBins;
+  delete [] xMin;
+  delete [] xMax;
+  return out;
+}
+
+//____________________________________________________________________
+void AliCFGridSparse::AddStorage(THnBase* target, const THnBase* h, Double_t c)
+{
+  //
+  // adds c*h to target for any combination of sparse and dense storages:
+  // THnBase::Add between two THnSparse, otherwise cell by cell, skipping
+  // the empty cells of h. The number of entries is added as in THnBase::Add
+  //
+  if (target->InheritsFrom(THnSparse::Class()) && h->InheritsFrom(THnSparse::Class())) {
+    target->Add(h,c);
+    return;
+  }
+  const Double_t entries = target->GetEntries() + c * h->GetEntries();
+  if (!target->GetCalculateErrors() && h->GetCalculateErrors()) target->Sumw2();
+  const Bool_t errors = target->GetCalculateErrors();
+  Int_t* coord = new Int_t[h->GetNdimensions()];
+  for (Long64_t i=0; i<h->GetNbins(); i++) {
+    const Double_t v = h->GetBinContent(i,coord);
+    const Double_t e2 = errors ? h->GetBinError2(i) : 0.;
+    if (v == 0 && e2 == 0) continue;
+    const Long64_t bin = target->GetBin(coord,kTRUE);
+    if (errors) target->AddBinError2(bin,c*c*e2);
+    target->AddBinContent(bin,c*v);
+  }
+  delete [] coord;
+  target->SetEntries(entries);
 }
 
 //___________________________________________________________________
@@ -139,7 +346,6 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   // axis ranges can be defined in arrays varMin, varMax
   // If useBins=true, varMin and varMax are taken as bin numbers
   //
-
   // binning for new grid
   Int_t* bins = new Int_t[nVars];
   for (Int_t iVar=0; iVar<nVars; iVar++) {
@@ -150,7 +356,7 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   AliCFGridSparse* out = new AliCFGridSparse(fName,fTitle,nVars,bins);
 
   //set the range in the THnSparse to project
-  THnSparse* clone = ((THnSparse*)fData->Clone());
+  THnBase* clone = ((THnBase*)GetStorage()->Clone());
   if (varMin && varMax) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) {
       SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
@@ -158,7 +364,8 @@ AliCFGridSparse* AliCFGridSparse::MakeSlice(Int_t nVars, const Int_t* vars, cons
   }
   else AliInfo("Keeping same axis ranges");
 
-  out->SetGrid(clone->Projection(nVars,vars));
+  out->SetStorage(clone->Projection(nVars,vars));
+  out->CheckOccupancy();
   delete [] bins;
   delete clone;
   return out;
@@ -172,7 +379,7 @@ Float_t AliCFGridSparse::GetBinCenter(Int_t ivar, Int_t ibin) const
   // Returns the center of specified bin for variable axis ivar
   // 
   
-  return (Float_t) fData->GetAxis(ivar)->GetBinCenter(ibin);
+  return (Float_t) GetStorage()->GetAxis(ivar)->GetBinCenter(ibin);
 }
 
 //____________________________________________________________________
@@ -182,7 +389,7 @@ Float_t AliCFGridSparse::GetBinSize(Int_t ivar, Int_t ibin) const
   // Returns the size of specified bin for variable axis ivar
   // 
   
-  return (Float_t) fData->GetAxis(ivar)->GetBinUpEdge(ibin) - fData->GetAxis(ivar)->GetBinLowEdge(ibin);
+  return (Float_t) GetStorage()->GetAxis(ivar)->GetBinUpEdge(ibin) - GetStorage()->GetAxis(ivar)->GetBinLowEdge(ibin);
 }
 
 //____________________________________________________________________
@@ -191,8 +398,21 @@ Float_t AliCFGridSparse::GetEntries() const
   //
   // total entries (including overflows and underflows)
   //
+  return GetStorage()->GetEntries();
+}
 
-  return fData->GetEntries();
+//____________________________________________________________________
+Long_t AliCFGridSparse::GetNFilledBins() const
+{
+  //
+  // number of filled bins (including overflows and underflows)
+  //
+  if (!fDenseData) return fData->GetNbins();
+  Long_t nFilled=0;
+  for (Long64_t i=0; i<fDenseData->GetNbins(); i++) {
+    if (fDenseData->GetBinContent(i)!=0) nFilled++;
+  }
+  return nFilled;
 }
 
 //____________________________________________________________________
@@ -202,7 +422,7 @@ Float_t AliCFGridSparse::GetElement(Long_t index) const
   // Returns content of grid element index 
   //
   
-  return fData->GetBinContent(index);
+  return GetStorage()->GetBinContent(index);
 }
 //____________________________________________________________________
 Float_t AliCFGridSparse::GetElement(const Int_t *bin) const
@@ -210,7 +430,7 @@ Float_t AliCFGridSparse::GetElement(const Int_t *bin) const
   //
   // Get the content in a bin corresponding to a set of bin indexes
   //
-  return fData->GetBinContent(bin);
+  return GetStorage()->GetBinContent(bin);
 
 }  
 //____________________________________________________________________
@@ -219,10 +439,9 @@ Float_t AliCFGridSparse::GetElement(const Double_t *var) const
   //
   // Get the content in a bin corresponding to a set of input variables
   //
-
-  Long_t index = fData->GetBin(var,kFALSE);
+  Long_t index = GetStorage()->GetBin(var,kFALSE);
   if (index<0) return 0.;
-  return fData->GetBinContent(index);
+  return GetStorage()->GetBinContent(index);
 } 
 
 //____________________________________________________________________
@@ -231,8 +450,7 @@ Float_t AliCFGridSparse::GetElementError(Long_t index) const
   //
   // Returns the error on the content 
   //
-
-  return fData->GetBinError(index);
+  return GetStorage()->GetBinError(index);
 }
 //____________________________________________________________________
 Float_t AliCFGridSparse::GetElementError(const Int_t *bin) const
@@ -240,7 +458,7 @@ Float_t AliCFGridSparse::GetElementError(const Int_t *bin) const
  //
   // Get the error in a bin corresponding to a set of bin indexes
   //
-  return fData->GetBinError(bin);
+  return GetStorage()->GetBinError(bin);
 
 }  
 //____________________________________________________________________
@@ -249,10 +467,9 @@ Float_t AliCFGridSparse::GetElementError(const Double_t *var) const
   //
   // Get the error in a bin corresponding to a set of input variables
   //
-
-  Long_t index=fData->GetBin(var,kFALSE); //this is the THnSparse index (do not allocate new cells if content is empy)
+  Long_t index=GetStorage()->GetBin(var,kFALSE); //this is the THnSparse index (do not allocate new cells if content is empy)
   if (index<0) return 0.;
-  return fData->GetBinError(index);
+  return GetStorage()->GetBinError(index);
 } 
 
 //____________________________________________________________________
@@ -262,7 +479,7 @@ void AliCFGridSparse::SetElement(Long_t index, Float_t val)
   // Sets grid element value
   //
   Int_t* bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin); //affects the bin coordinates
+  GetStorage()->GetBinContent(index,bin); //affects the bin coordinates
   SetElement(bin,val);
   delete [] bin ;
 }
@@ -273,7 +490,7 @@ void AliCFGridSparse::SetElement(const Int_t *bin, Float_t val)
   //
   // Sets grid element of bin indeces bin to val
   //
-  fData->SetBinContent(bin,val);
+  GetStorage()->SetBinContent(bin,val);
 }
 //____________________________________________________________________
 void AliCFGridSparse::SetElement(const Double_t *var, Float_t val) 
@@ -281,9 +498,9 @@ void AliCFGridSparse::SetElement(const Double_t *var, Float_t val)
   //
   // Set the content in a bin to value val corresponding to a set of input variables
   //
-  Long_t index=fData->GetBin(var,kTRUE); //THnSparse index: allocate the cell
+  Long_t index=GetStorage()->GetBin(var,kTRUE); //THnSparse index: allocate the cell
   Int_t *bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin); //trick to access the array of bins
+  GetStorage()->GetBinContent(index,bin); //trick to access the array of bins
   SetElement(bin,val);
   delete [] bin;
 }
@@ -295,7 +512,7 @@ void AliCFGridSparse::SetElementError(Long_t index, Float_t val)
   // Sets grid element iel error to val (linear indexing) in AliCFFrame
   //
   Int_t *bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin);
+  GetStorage()->GetBinContent(index,bin);
   SetElementError(bin,val);
   delete [] bin;
 }
@@ -306,7 +523,7 @@ void AliCFGridSparse::SetElementError(const Int_t *bin, Float_t val)
   //
   // Sets grid element error of bin indeces bin to val
   //
-  fData->SetBinError(bin,val);
+  GetStorage()->SetBinError(bin,val);
 }
 //____________________________________________________________________
 void AliCFGridSparse::SetElementError(const Double_t *var, Float_t val) 
@@ -314,9 +531,9 @@ void AliCFGridSparse::SetElementError(const Double_t *var, Float_t val)
   //
   // Set the error in a bin to value val corresponding to a set of input variables
   //
-  Long_t index=fData->GetBin(var); //THnSparse index
+  Long_t index=GetStorage()->GetBin(var); //THnSparse index
   Int_t *bin = new Int_t[GetNVar()];
-  fData->GetBinContent(index,bin); //trick to access the array of bins
+  GetStorage()->GetBinContent(index,bin); //trick to access the array of bins
   SetElementError(bin,val);
   delete [] bin;
 }
@@ -328,7 +545,7 @@ void AliCFGridSparse::SumW2()
   //set calculation of the squared sum of the weighted entries
   //
   if(!fSumW2){
-    fData->CalculateErrors(kTRUE); 
+    GetStorage()->CalculateErrors(kTRUE); 
   }
   fSumW2=kTRUE;
 }
@@ -339,14 +556,15 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid, Double_t c)
   //
   //add aGrid to the current one
   //
-
   if (aGrid->GetNVar() != GetNVar()){
     AliError("Different number of variables, cannot add the grids");
     return;
   } 
   
   if (!fSumW2  && aGrid->GetSumW2()) SumW2();
-  fData->Add(aGrid->GetGrid(),c);
+  MatchStorage(aGrid);
+  AddStorage(GetStorage(),aGrid->GetStorage(),c);
+  CheckOccupancy();
 }
 
 //____________________________________________________________________
@@ -355,7 +573,6 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid1, const AliCFGridSparse*
   //
   //Add aGrid1 and aGrid2 and deposit the result into the current one
   //
-
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliInfo("Different number of variables, cannot add the grids");
     return;
@@ -363,9 +580,12 @@ void AliCFGridSparse::Add(const AliCFGridSparse* aGrid1, const AliCFGridSparse*
   
   if (!fSumW2  && (aGrid1->GetSumW2() || aGrid2->GetSumW2())) SumW2();
 
-  fData->Reset();
-  fData->Add(aGrid1->GetGrid(),c1);
-  fData->Add(aGrid2->GetGrid(),c2);
+  GetStorage()->Reset();
+  MatchStorage(aGrid1);
+  MatchStorage(aGrid2);
+  AddStorage(GetStorage(),aGrid1->GetStorage(),c1);
+  AddStorage(GetStorage(),aGrid2->GetStorage(),c2);
+  CheckOccupancy();
 }
 
 //____________________________________________________________________
@@ -374,16 +594,15 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid, Double_t c)
   //
   // Multiply aGrid to the current one
   //
-
   if (aGrid->GetNVar() != GetNVar()) {
     AliError("Different number of variables, cannot multiply the grids");
     return;
   } 
   
   if(!fSumW2  && aGrid->GetSumW2()) SumW2();
-  THnSparse *h = aGrid->GetGrid();
-  fData->Multiply(h);
-  fData->Scale(c);
+  THnBase *h = aGrid->GetStorage();
+  GetStorage()->Multiply(h);
+  GetStorage()->Scale(c);
 }
 
 //____________________________________________________________________
@@ -392,7 +611,6 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid1, const AliCFGridSpa
   //
   //Multiply aGrid1 and aGrid2 and deposit the result into the current one
   //
-
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliError("Different number of variables, cannot multiply the grids");
     return;
@@ -400,12 +618,14 @@ void AliCFGridSparse::Multiply(const AliCFGridSparse* aGrid1, const AliCFGridSpa
   
   if(!fSumW2  && (aGrid1->GetSumW2() || aGrid2->GetSumW2())) SumW2();
 
-  fData->Reset();
-  THnSparse *h1 = aGrid1->GetGrid();
-  THnSparse *h2 = aGrid2->GetGrid();
+  GetStorage()->Reset();
+  THnBase *h1 = aGrid1->GetStorage();
+  THnBase *h2 = aGrid2->GetStorage();
   h2->Multiply(h1);
   h2->Scale(c1*c2);
-  fData->Add(h2);
+  MatchStorage(aGrid2);
+  AddStorage(GetStorage(),h2,1.);
+  CheckOccupancy();
 }
 
 //____________________________________________________________________
@@ -414,7 +634,6 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid, Double_t c)
   //
   // Divide aGrid to the current one
   //
-
   if (aGrid->GetNVar() != GetNVar()) {
     AliError("Different number of variables, cannot divide the grids");
     return;
@@ -422,10 +641,10 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid, Double_t c)
   
   if (!fSumW2  && aGrid->GetSumW2()) SumW2();
 
-  THnSparse *h1 = aGrid->GetGrid();
-  THnSparse *h2 = (THnSparse*)fData->Clone();
-  fData->Divide(h2,h1);
-  fData->Scale(c);
+  THnBase *h1 = aGrid->GetStorage();
+  THnBase *h2 = (THnBase*)GetStorage()->Clone();
+  GetStorage()->Divide(h2,h1);
+  GetStorage()->Scale(c);
 }
 
 //____________________________________________________________________
@@ -435,7 +654,6 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid1, const AliCFGridSpars
   //Divide aGrid1 and aGrid2 and deposit the result into the current one
   //binomial errors are supported
   //
-
   if (GetNVar() != aGrid1->GetNVar() || GetNVar() != aGrid2->GetNVar()) {
     AliError("Different number of variables, cannot divide the grids");
     return;
@@ -443,9 +661,10 @@ void AliCFGridSparse::Divide(const AliCFGridSparse* aGrid1, const AliCFGridSpars
   
   if (!fSumW2  && (aGrid1->GetSumW2() || aGrid2->GetSumW2())) SumW2();
 
-  THnSparse *h1= aGrid1->GetGrid();
-  THnSparse *h2= aGrid2->GetGrid();
-  fData->Divide(h1,h2,c1,c2,option);
+  MatchStorage(aGrid1); // THnBase::Divide visits all the cells of aGrid1
+  THnBase *h1= aGrid1->GetStorage();
+  THnBase *h2= aGrid2->GetStorage();
+  GetStorage()->Divide(h1,h2,c1,c2,option);
 }
 
 
@@ -462,9 +681,16 @@ void AliCFGridSparse::Rebin(const Int_t* group)
     if (group[i]!=1) AliInfo(Form(" merging bins along dimension %i in groups of %i bins", i,group[i]));
   }
 
-  THnSparse *rebinned =fData->Rebin(group);
-  fData->Reset();
-  fData = rebinned;
+  THnBase *rebinned = GetStorage()->Rebin(group);
+  if (fDenseData) {
+    delete fDenseData;
+    fDenseData = rebinned;
+  }
+  else {
+    fData->Reset();
+    fData = (THnSparse*)rebinned;
+  }
+  CheckOccupancy(); // the rebinned grid is more occupied
 }
 //____________________________________________________________________
 void AliCFGridSparse::Scale(Long_t index, const Double_t *fact)
@@ -521,7 +747,7 @@ void AliCFGridSparse::Scale(const Double_t* fact)
   //scale contents of the whole grid by fact
   //
 
-  for (Long_t iel=0; iel<GetNFilledBins(); iel++) {
+  for (Long_t iel=0; iel<GetStorage()->GetNbins(); iel++) {
     Scale(iel,fact);
   }
 }
@@ -553,7 +779,7 @@ Double_t AliCFGridSparse::GetIntegral() const
   //
   // Get full Integral
   //
-  return fData->ComputeIntegral();  
+  return GetStorage()->ComputeIntegral();  
 } 
 
 //____________________________________________________________________
@@ -606,9 +832,15 @@ void AliCFGridSparse::Copy(TObject& c) const
   AliCFFrame::Copy(c);
   AliCFGridSparse& target = (AliCFGridSparse &) c;
   target.fSumW2 = fSumW2 ;
+  target.fDenseThreshold = fDenseThreshold ;
+  target.fDenseMaxCells  = fDenseMaxCells ;
+  target.fGridExported = kFALSE;
   if (fData) {
     target.fData = (THnSparse*)fData->Clone();
   }
+  if (fDenseData) {
+    target.fDenseData = (THnBase*)fDenseData->Clone();
+  }
 }
 
 //____________________________________________________________________
@@ -620,8 +852,7 @@ TH1* AliCFGridSparse::Slice(Int_t iVar1, Int_t iVar2, Int_t iVar3, const Double_
   // therefore varMin and varMax must have their dimensions equal to GetNVar()
   // If useBins=true, varMin and varMax are taken as bin numbers
   // if varmin or varmax point to null, all the range is taken, including over- and underflows
-
-  THnSparse* clone = (THnSparse*)fData->Clone();
+  THnBase* clone = (THnBase*)GetStorage()->Clone();
   if (varMin != 0x0 && varMax != 0x0) {
     for (Int_t iAxis=0; iAxis<GetNVar(); iAxis++) SetAxisRange(clone->GetAxis(iAxis),varMin[iAxis],varMax[iAxis],useBins);
   }
@@ -712,9 +943,9 @@ void AliCFGridSparse::SetRangeUser(Int_t iVar, Double_t varMin, Double_t varMax,
   //
   // set range of axis iVar. 
   //
-  SetAxisRange(fData->GetAxis(iVar),varMin,varMax,useBins);
+  SetAxisRange(GetStorage()->GetAxis(iVar),varMin,varMax,useBins);
 	//AliInfo(Form("AliCFGridSparse axis %d range has been modified",iVar));
-	TAxis* currAxis = fData->GetAxis(iVar);
+	TAxis* currAxis = GetStorage()->GetAxis(iVar);
   TString outString = Form("%s new range: %.5f < %s < %.5f", GetName(), currAxis->GetBinLowEdge(currAxis->GetFirst()), currAxis->GetTitle(), currAxis->GetBinUpEdge(currAxis->GetLast()));
   TString binLabel = currAxis->GetBinLabel(currAxis->GetFirst());
   if ( ! binLabel.IsNull() ) {
@@ -749,8 +980,8 @@ Float_t AliCFGridSparse::GetOverFlows(Int_t ivar, Bool_t exclusive) const
   Int_t* bin = new Int_t[GetNVar()];
   memset(bin, 0, sizeof(Int_t) * GetNVar());
   Float_t ovfl=0.;
-  for (Long64_t i = 0; i < fData->GetNbins(); i++) {
-    Double_t v = fData->GetBinContent(i, bin);
+  for (Long64_t i = 0; i < GetStorage()->GetNbins(); i++) {
+    Double_t v = GetStorage()->GetBinContent(i, bin);
     Bool_t add=kTRUE;
     if (exclusive) {
       for(Int_t j=0;j<GetNVar();j++){
@@ -775,8 +1006,8 @@ Float_t AliCFGridSparse::GetUnderFlows(Int_t ivar, Bool_t exclusive) const
   Int_t* bin = new Int_t[GetNVar()];
   memset(bin, 0, sizeof(Int_t) * GetNVar());
   Float_t unfl=0.;
-  for (Long64_t i = 0; i < fData->GetNbins(); i++) {
-    Double_t v = fData->GetBinContent(i, bin);
+  for (Long64_t i = 0; i < GetStorage()->GetNbins(); i++) {
+    Double_t v = GetStorage()->GetBinContent(i, bin);
     Bool_t add=kTRUE;
     if (exclusive) {
       for(Int_t j=0;j<GetNVar();j++){
@@ -797,9 +1028,10 @@ void AliCFGridSparse::Smooth() {
   //
   // smoothing function: TO USE WITH CARE
   //
-
   AliInfo("Your GridSparse is going to be smoothed");
   AliInfo(Form("N TOTAL  BINS : %li",GetNBinsTotal()));
   AliInfo(Form("N FILLED BINS : %li",GetNFilledBins()));
+  SwitchToSparse();
   AliCFUnfolding::SmoothUsingNeighbours(fData);
+  CheckOccupancy();
 }
@@ -4,12 +4,14 @@
 //                                                                    //
 // AliCFGridSparse.cxx Class                                          //
 // Class to handle N-dim maps for the correction Framework            // 
-// uses a THnSparse to store the grid                                 //
+// uses a THnSparse to store the grid, or a dense THnF/THnD once      //
+// the grid is well occupied (see SetDenseFillThreshold)              //
 // Author:S.Arcelli, silvia.arcelli@cern.ch
 //--------------------------------------------------------------------//
 
 #include "AliCFFrame.h"
 #include "THnSparse.h"
+#include "THn.h"
 #include "AliLog.h"
 #include "TAxis.h"
 
@@ -29,7 +31,7 @@ class AliCFGridSparse : public AliCFFrame
   virtual void Copy(TObject& c) const;
 
   // AliCFFrame functions
-  virtual Int_t      GetNVar() const {return fData->GetNdimensions();}
+  virtual Int_t      GetNVar() const {return GetStorage()->GetNdimensions();}
   virtual void       PrintBinLimits() const ;
   virtual void       PrintNBins() const ; 
   virtual void       SetBinLimits(Int_t ivar, Double_t min, Double_t max); // for uniform bin width only
@@ -37,16 +39,16 @@ class AliCFGridSparse : public AliCFFrame
   virtual void       GetBinLimits(Int_t ivar, Double_t * array) const ;
   virtual Double_t * GetBinLimits(Int_t ivar) const ;
   virtual Long_t     GetNBinsTotal() const ;
-  virtual Long_t     GetNFilledBins() const {return fData->GetNbins();}
-  virtual Int_t      GetNBins(Int_t ivar) const {return fData->GetAxis(ivar)->GetNbins();}
+  virtual Long_t     GetNFilledBins() const ;
+  virtual Int_t      GetNBins(Int_t ivar) const {return GetStorage()->GetAxis(ivar)->GetNbins();}
   virtual Int_t *    GetNBins() const ;
   virtual Float_t    GetBinCenter(Int_t ivar,Int_t ibin) const ;
   virtual Float_t    GetBinSize  (Int_t ivar,Int_t ibin) const ;
   //virtual void       GetBinCenters(const Int_t *ibin, Float_t *binCenter) const ;
   //virtual void       GetBinSizes  (const Int_t *ibin, Float_t *binSizes)  const ;
-  virtual TAxis    * GetAxis(Int_t ivar) const {return fData->GetAxis(ivar);}
+  virtual TAxis    * GetAxis(Int_t ivar) const {return GetStorage()->GetAxis(ivar);}
 
-  virtual void          SetVarTitle(Int_t ivar, const Char_t* lab) {fData->GetAxis(ivar)->SetTitle(lab);}
+  virtual void          SetVarTitle(Int_t ivar, const Char_t* lab) {GetStorage()->GetAxis(ivar)->SetTitle(lab);}
   virtual const Char_t* GetVarTitle(Int_t ivar) const {return GetAxis(ivar)->GetTitle();}
   virtual Int_t         GetVar(const Char_t* title) const ; // returns the variable corresponding to the given title
 
@@ -99,8 +101,21 @@ class AliCFGridSparse : public AliCFFrame
   //virtual Double_t GetIntegral(const Double_t *varMin, const Double_t *varMax) const;
   virtual Long64_t Merge(TCollection* list);
 
-  virtual void     SetGrid(THnSparse* grid) {if (fData) delete fData ; fData=grid;}
-  THnSparse   *    GetGrid() const {return fData;}
+  virtual void     SetGrid(THnSparse* grid) {SetStorage(grid); fGridExported=kFALSE;}
+  THnSparse   *    GetGrid() const ; // switches a dense grid back to the THnSparse storage
+  THnBase     *    GetStorage() const {return fDenseData ? fDenseData : (THnBase*)fData;}
+  Bool_t           IsDense() const {return fDenseData!=0x0;}
+
+  enum {kDenseMaxCells = 1<<23, kDenseCheckPeriod = 1024};
+
+  // dense storage: once the fraction of filled cells exceeds the threshold (and the grid has
+  // at most maxCells cells including over/underflows), the content is moved to a THnF (THnD)
+  // and the THnSparse is deleted. A negative threshold disables it, a null one switches at once.
+  // GetGrid() moves the content back to a THnSparse, which is then kept.
+  virtual void     SetDenseFillThreshold(Double_t thr, Long64_t maxCells=kDenseMaxCells) ;
+  Double_t         GetDenseFillThreshold() const {return fDenseThreshold;}
+  Bool_t           SwitchToDense();
+  void             SwitchToSparse();
 
   virtual Float_t GetOverFlows (Int_t var, Bool_t excl=kFALSE) const;
   virtual Float_t GetUnderFlows(Int_t var, Bool_t excl=kFALSE) const;
@@ -118,12 +133,25 @@ class AliCFGridSparse : public AliCFFrame
   void     SetAxisRange(TAxis* axis, Double_t min, Double_t max, Bool_t useBins) const;
   void     GetProjectionName (TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
   void     GetProjectionTitle(TString& s,Int_t var0, Int_t var1=-1, Int_t var2=-1) const;
+  void     SetStorage(THnBase* h);
+  void     CheckOccupancy();
+  void     MatchStorage(const AliCFGridSparse* aGrid);
+  THnBase* NewStorage(Bool_t dense) const;
+  static void AddStorage(THnBase* target, const THnBase* h, Double_t c);
+
+  static const Double_t fgkDenseDefaultThreshold; // default for fDenseThreshold
 
   // data members:
   Bool_t      fSumW2    ; // Flag to check if calculation of squared weights enabled
   THnSparse  *fData     ; // The data Container: a THnSparse  
+  THnBase    *fDenseData; // Dense data container (THnF or THnD), replaces fData when the grid is well occupied
+  Double_t    fDenseThreshold ; // fraction of filled cells above which the grid switches to fDenseData (<0: never)
+  Long64_t    fDenseMaxCells  ; // maximum number of cells (incl. over/underflows) of fDenseData
+
+  Int_t          fNFillsToCheck ; //! fills before the next occupancy check
+  mutable Bool_t fGridExported  ; //! the THnSparse was handed out by GetGrid(): keep it
 
-  ClassDef(AliCFGridSparse,3);
+  ClassDef(AliCFGridSparse,5);
 };
 
 
@@ -132,7 +160,7 @@ class AliCFGridSparse : public AliCFFrame
 inline Long_t AliCFGridSparse::GetNBinsTotal() const {
   Long_t n=1;
   for (Int_t iVar=0; iVar<GetNVar(); iVar++) {
-    n *= fData->GetAxis(iVar)->GetNbins();
+    n *= GetStorage()->GetAxis(iVar)->GetNbins();
   }
   return n ;
 }
@@ -143,7 +171,7 @@ inline void AliCFGridSparse::PrintNBins() const
   // printing the array containing the # of bins  
   //
   for (Int_t i=0;i<GetNVar();i++) {
-    AliInfo(Form("bins in axis %i are: %i",i,fData->GetAxis(i)->GetNbins()));
+    AliInfo(Form("bins in axis %i are: %i",i,GetStorage()->GetAxis(i)->GetNbins()));
   }
 } 
 
@@ -165,7 +193,7 @@ inline void AliCFGridSparse::PrintBinLimits() const
 }
 
 inline void AliCFGridSparse::GetBinLimits(Int_t ivar, Double_t * array) const {
-  TAxis * axis = fData->GetAxis(ivar) ;
+  TAxis * axis = GetStorage()->GetAxis(ivar) ;
   Int_t nBins = axis->GetNbins();
   for (Int_t iBin=0; iBin<nBins; iBin++) array[iBin] = axis->GetBinLowEdge(iBin+1);
   array[nBins] = axis->GetBinUpEdge(nBins);
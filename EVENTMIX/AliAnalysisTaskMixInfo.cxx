@@ -212,7 +212,7 @@ void AliAnalysisTaskMixInfo::InitMixInfo()
          if (fMixInfo) fMixInfo->CreateHistogram(AliMixInfo::kMixedEvents, 1, 1, 2);
       } else {
          if (evPool->NeedInit()) evPool->Init();
-         Int_t num = evPool->GetListOfEntryLists()->GetEntriesFast();
+         Int_t num = evPool->GetNumberOfBins();
          if (fMixInfo) fMixInfo->CreateHistogram(AliMixInfo::kMainEvents, num, 1, num + 1);
          if (fMixInfo) fMixInfo->CreateHistogram(AliMixInfo::kMixedEvents, num, 1, num + 1);
       }
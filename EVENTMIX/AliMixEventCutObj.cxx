@@ -27,7 +27,8 @@ AliMixEventCutObj::AliMixEventCutObj(AliMixEventCutObj::EEPAxis_t type, Float_t
    fCutMax(max),
    fCutStep(step),
    fCutSmallVal(0),
-   fCurrentVal(min)
+   fCurrentVal(min),
+   fBinLowEdges()
 {
    //
    // Default constructor
@@ -45,7 +46,8 @@ AliMixEventCutObj::AliMixEventCutObj(const AliMixEventCutObj &obj) : TObject(obj
    fCutMax(obj.fCutMax),
    fCutStep(obj.fCutStep),
    fCutSmallVal(obj.fCutSmallVal),
-   fCurrentVal(obj.fCurrentVal)
+   fCurrentVal(obj.fCurrentVal),
+   fBinLowEdges()
 {
    //
    // Copy constructor
@@ -69,6 +71,7 @@ AliMixEventCutObj &AliMixEventCutObj::operator=(const AliMixEventCutObj &obj)
       fCutStep = obj.fCutStep;
       fCutSmallVal = obj.fCutSmallVal;
       fCurrentVal = obj.fCurrentVal;
+      fBinLowEdges.clear();
 //       fNoMore = obj.fNoMore;
    }
    return *this;
@@ -137,13 +140,20 @@ Int_t AliMixEventCutObj::GetBinNumber(Float_t num) const
    // Returns bin (index) number in current cut.
    // Returns -1 in case of out of range
    //
-   Int_t binNum = 0;
-   for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) {
-      binNum++;
-      if ((num >= iCurrent) && (num < iCurrent + fCutStep - fCutSmallVal)) {
-         return binNum;
-      }
+   if (fCutStep < 1e-5) return -1;
+   if (fBinLowEdges.empty()) {
+      // same (float) stepping as in the cut intervals, so edges are identical
+      for (Float_t iCurrent = fCutMin; iCurrent < fCutMax; iCurrent += fCutStep) fBinLowEdges.push_back(iCurrent);
+   }
+   if (fBinLowEdges.empty() || num < fBinLowEdges.front()) return -1;
+   // binary search for last low edge <= num
+   Int_t lo = 0, hi = (Int_t) fBinLowEdges.size() - 1;
+   while (lo < hi) {
+      Int_t mid = (lo + hi + 1) / 2;
+      if (fBinLowEdges[mid] <= num) lo = mid;
+      else hi = mid - 1;
    }
+   if (num < fBinLowEdges[lo] + fCutStep - fCutSmallVal) return lo + 1;
    return -1;
 }
 
@@ -13,6 +13,7 @@
 
 #include <TObject.h>
 #include <TString.h>
+#include <vector>
 
 class AliVEvent;
 class AliAODEvent;
@@ -64,7 +65,9 @@ private:
 
    Float_t     fCurrentVal;    // current value
 
-   ClassDef(AliMixEventCutObj, 3)
+   mutable std::vector<Float_t> fBinLowEdges; //! low edges of bins (filled on first use)
+
+   ClassDef(AliMixEventCutObj, 4)
 };
 
 #endif
@@ -9,6 +9,7 @@
 //
 
 #include <TEntryList.h>
+#include <TH1I.h>
 
 #include "AliLog.h"
 #include "AliMixEventCutObj.h"
@@ -21,9 +22,13 @@ ClassImp(AliMixEventPool)
 AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(name, title),
    fListOfEntryList(),
    fListOfEventCuts(),
+   fListBinIndex(),
    fBinNumber(0),
    fBufferSize(0),
-   fMixNumber(0)
+   fMixNumber(0),
+   fNRejected(0),
+   fBinStride(),
+   fBinMap()
 {
    //
    // Default constructor.
@@ -35,9 +40,13 @@ AliMixEventPool::AliMixEventPool(const char *name, const char *title) : TNamed(n
 AliMixEventPool::AliMixEventPool(const AliMixEventPool &obj) : TNamed(obj),
    fListOfEntryList(obj.fListOfEntryList),
    fListOfEventCuts(obj.fListOfEventCuts),
+   fListBinIndex(obj.fListBinIndex),
    fBinNumber(obj.fBinNumber),
    fBufferSize(obj.fBufferSize),
-   fMixNumber(obj.fMixNumber)
+   fMixNumber(obj.fMixNumber),
+   fNRejected(obj.fNRejected),
+   fBinStride(),
+   fBinMap()
 {
    //
    // Copy constructor
@@ -56,9 +65,13 @@ AliMixEventPool &AliMixEventPool::operator=(const AliMixEventPool &obj)
       TNamed::operator=(obj);
       fListOfEntryList = obj.fListOfEntryList;
       fListOfEventCuts = obj.fListOfEventCuts;
+      fListBinIndex = obj.fListBinIndex;
       fBinNumber = obj.fBinNumber;
       fBufferSize = obj.fBufferSize;
       fMixNumber = obj.fMixNumber;
+      fNRejected = obj.fNRejected;
+      fBinStride.Set(0);
+      fBinMap.clear();
    }
    return *this;
 }
@@ -79,7 +92,10 @@ void AliMixEventPool::AddCut(AliMixEventCutObj *cut)
    //
    // Adds cut
    //
-   if (cut && cut->IsValid()) fListOfEventCuts.Add(new AliMixEventCutObj(*cut));
+   if (cut && cut->IsValid()) {
+      fListOfEventCuts.Add(new AliMixEventCutObj(*cut));
+      fBinStride.Set(0);
+   }
 }
 //_________________________________________________________________________________________________
 void AliMixEventPool::Print(const Option_t *option) const
@@ -93,72 +109,77 @@ void AliMixEventPool::Print(const Option_t *option) const
    while ((cut = (AliMixEventCutObj *) next())) {
       cut->Print(option);
    }
-   AliDebug(AliLog::kDebug, Form("NumOfEntryList %d", fListOfEntryList.GetEntries()));
+   AliDebug(AliLog::kDebug, Form("NumOfBins %d NumOfEntryList %d Rejected %lld", fBinNumber, fListOfEntryList.GetEntries(), fNRejected));
    TEntryList *el;
    for (Int_t i = 0; i < fListOfEntryList.GetEntries(); i++) {
       el = (TEntryList *) fListOfEntryList.At(i);
-      AliDebug(AliLog::kDebug, Form("EntryList[%d] %lld", i, el->GetN()));
+      AliDebug(AliLog::kDebug, Form("EntryList[%d] %lld", fListBinIndex.At(i), el->GetN()));
    }
 }
 //_________________________________________________________________________________________________
 Int_t AliMixEventPool::Init()
 {
    //
-   // Init event pool
+   // Init event pool: computes number of bins and strides of linear bin index.
+   // Entry lists are created only when first event falls in the bin
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   CreateEntryListsRecursivly(fListOfEventCuts.GetEntries() - 1);
-   fBinNumber++;
+   Int_t numCuts = fListOfEventCuts.GetEntriesFast();
+   fBinStride.Set(numCuts);
+   fBinNumber = 1;
+   AliMixEventCutObj *cut;
+   for (Int_t i = 0; i < numCuts; i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      fBinStride.AddAt(fBinNumber, i);
+      fBinNumber *= cut->GetNumberOfBins();
+   }
+   // rebuild bin map (needed when pool was read from file)
+   fBinMap.clear();
+   for (Int_t i = 0; i < fListOfEntryList.GetEntriesFast(); i++) fBinMap[fListBinIndex.At(i)] = i;
    AliDebug(AliLog::kDebug, Form("fBinnumber = %d", fBinNumber));
-   AddEntryList();
    AliDebug(AliLog::kDebug + 5, "->");
    return 0;
 }
 
 //_________________________________________________________________________________________________
-void AliMixEventPool::CreateEntryListsRecursivly(Int_t index)
+TEntryList *AliMixEventPool::AddEntryList(Int_t binIndex)
 {
    //
-   // Helper function which create entrylist recursivly
+   // Adds entry list for bin binIndex
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   AliMixEventCutObj *cut;
-   if (index >= 0) {
-      AliDebug(AliLog::kDebug + 1, Form("index = %d", index));
-      cut = dynamic_cast<AliMixEventCutObj *>(fListOfEventCuts.At(index));
-      if (!cut) return;
-      cut->Reset();
-      while (cut->HasMore()) {
-         cut->AddStep();
-         CreateEntryListsRecursivly(index - 1);
-         if (cut->HasMore()) {
-            fBinNumber++;
-            AliDebug(AliLog::kDebug + 1, Form("fBinnumber = %d", fBinNumber));
-            AddEntryList();
-            //                 PrintCurrentCutIntervals();
-         }
-      }
-   }
+   TEntryList *el = new TEntryList;
+   fListOfEntryList.Add(el);
+   Int_t pos = fListOfEntryList.GetEntriesFast() - 1;
+   fListBinIndex.Set(pos + 1);
+   fListBinIndex.AddAt(binIndex, pos);
+   fBinMap[binIndex] = pos;
+   AliDebug(AliLog::kDebug + 1, Form("Entry list for bin %d created (%d lists)", binIndex, pos + 1));
    AliDebug(AliLog::kDebug + 5, "->");
+   return el;
 }
 
 //_________________________________________________________________________________________________
-TEntryList *AliMixEventPool::AddEntryList()
+Int_t AliMixEventPool::GetBinIndex(AliVEvent *ev)
 {
    //
-   // Adds endtry list
+   // Returns linear bin index of event (-1 when out of range).
+   // Index of the first cut runs fastest (same as in SetCutValuesFromBinIndex)
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
-   TObjArrayIter next(&fListOfEventCuts);
+   if (NeedInit()) Init();
+   Int_t index = 0, binCut;
    AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      if (cut) cut->PrintCurrentInterval();
+   for (Int_t i = 0; i < fListOfEventCuts.GetEntriesFast(); i++) {
+      cut = (AliMixEventCutObj *) fListOfEventCuts.At(i);
+      binCut = cut->GetIndex(ev);
+      if (binCut < 1 || binCut > cut->GetNumberOfBins()) {
+         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
+         return -1;
+      }
+      index += (binCut - 1) * fBinStride.At(i);
+      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, binCut));
    }
-   TEntryList *el = new TEntryList;
-   fListOfEntryList.Add(el);
-   AliDebug(AliLog::kDebug + 1, Form("Number in Entry list -> %lld", el->GetN()));
-   AliDebug(AliLog::kDebug + 5, "->");
-   return el;
+   return index;
 }
 
 //_________________________________________________________________________________________________
@@ -180,6 +201,7 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
       AliDebug(AliLog::kDebug, Form("Entry %lld was added with idEntryList %d !!!", entry, idEntryList));
       return kTRUE;
    }
+   fNRejected++;
    AliDebug(AliLog::kDebug, Form("Entry %lld was NOT added !!!", entry));
    AliDebug(AliLog::kDebug + 5, "->");
    return kFALSE;
@@ -189,52 +211,38 @@ Bool_t AliMixEventPool::AddEntry(Long64_t entry, AliVEvent *ev)
 TEntryList *AliMixEventPool::FindEntryList(AliVEvent *ev, Int_t &idEntryList)
 {
    //
-   // Find entrlist in list of entrlist
+   // Find entrlist in list of entrlist (it is created if needed).
+   // idEntryList is bin index + 1
    //
    AliDebug(AliLog::kDebug + 5, "<-");
-   Int_t num = fListOfEventCuts.GetEntriesFast();
-   if (num < 1) return 0;
-   Int_t *indexes = new Int_t[num] ;
-   Int_t *lenght = new Int_t[num];
-   Int_t i = 0;
-   TObjArrayIter next(&fListOfEventCuts);
-   AliMixEventCutObj *cut;
-   while ((cut = (AliMixEventCutObj *) next())) {
-      indexes[i] = cut->GetIndex(ev);
-      if (indexes[i] < 0) {
-         AliDebug(AliLog::kDebug, Form("idEntryList %d", -1));
-         delete [] indexes;
-         delete [] lenght;
-         return 0;
-      }
-      lenght[i] = cut->GetNumberOfBins();
-      AliDebug(AliLog::kDebug + 1, Form("indexes[%d] %d", i, indexes[i]));
-      i++;
-   }
-   idEntryList = 0;
-   SearchIndexRecursive(fListOfEventCuts.GetEntries() - 1, &indexes[0], &lenght[0], idEntryList);
-   AliDebug(AliLog::kDebug, Form("idEntryList %d", idEntryList - 1));
-   // index which start with 0 (idEntryList-1)
-   delete [] indexes;
-   delete [] lenght;
+   if (fListOfEventCuts.GetEntriesFast() < 1) return 0;
+   Int_t index = GetBinIndex(ev);
+   if (index < 0) return 0;
+   idEntryList = index + 1;
+   AliDebug(AliLog::kDebug, Form("idEntryList %d", index));
+   std::unordered_map<Int_t, Int_t>::const_iterator it = fBinMap.find(index);
+   if (it != fBinMap.end()) return (TEntryList *) fListOfEntryList.At(it->second);
    AliDebug(AliLog::kDebug + 5, "->");
-   return (TEntryList *) fListOfEntryList.At(idEntryList - 1);
+   return AddEntryList(index);
 }
 
 //_________________________________________________________________________________________________
-void AliMixEventPool::SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index)
+TH1I *AliMixEventPool::CreateOccupancyHistogram(const char *name) const
 {
    //
-   // Search for index of entrylist
+   // Returns histogram with number of entries in every bin
+   // (x = bin index + 1, as for AliMixInfo). Out of range events are in underflow.
+   // Histogram is owned by caller
    //
-   AliDebug(AliLog::kDebug + 5, "<-");
-   if (num > 0) {
-      index += (i[num] - 1) * d[num - 1];
-      SearchIndexRecursive(num - 1, i, d, index);
-   } else {
-      index += i[num];
+   TH1I *h = new TH1I(name, Form("%s occupancy;bin index;entries", GetName()), fBinNumber, 1, fBinNumber + 1);
+   h->SetDirectory(0);
+   for (Int_t i = 0; i < fListOfEntryList.GetEntriesFast(); i++) {
+      TEntryList *el = (TEntryList *) fListOfEntryList.At(i);
+      h->SetBinContent(fListBinIndex.At(i) + 1, el->GetN());
    }
-   AliDebug(AliLog::kDebug + 5, "->");
+   h->SetBinContent(0, fNRejected);
+   h->SetEntries(h->Integral(0, fBinNumber + 1));
+   return h;
 }
 
 //_________________________________________________________________________________________________
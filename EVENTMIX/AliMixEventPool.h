@@ -11,9 +11,13 @@
 #ifndef ALIMIXEVENTPOOL_H
 #define ALIMIXEVENTPOOL_H
 
+#include <unordered_map>
+
 #include <TObjArray.h>
 #include <TNamed.h>
+#include <TArrayI.h>
 
+class TH1I;
 class TEntryList;
 class AliMixEventCutObj;
 class AliVEvent;
@@ -30,16 +34,15 @@ public:
    // inits correctly object
    Int_t       Init();
 
-   void        CreateEntryListsRecursivly(Int_t index);
-   void        SearchIndexRecursive(Int_t num, Int_t *i, Int_t *d, Int_t &index);
-   TEntryList *AddEntryList();
+   TEntryList *AddEntryList(Int_t binIndex);
+   Int_t       GetBinIndex(AliVEvent *ev);
 
    Bool_t      AddEntry(Long64_t entry, AliVEvent *ev);
    TEntryList *FindEntryList(AliVEvent *ev, Int_t &idEntryList);
 
    void        AddCut(AliMixEventCutObj *cut);
 
-   Bool_t      NeedInit() { return (fListOfEntryList.GetEntries() == 0); }
+   Bool_t      NeedInit() { return (fBinStride.GetSize() != fListOfEventCuts.GetEntriesFast()); }
    TObjArray  *GetListOfEntryLists() { return &fListOfEntryList; }
    TObjArray  *GetListOfEventCuts() { return &fListOfEventCuts; }
 
@@ -48,17 +51,26 @@ public:
    void        SetMixNumber(Int_t numMix) { fMixNumber = numMix; }
    Int_t       GetBufferSize() const { return fBufferSize; }
    Int_t       GetMixNumber() const { return fMixNumber; }
+   Int_t       GetNumberOfBins() const { return fBinNumber; }
+   Long64_t    GetNumberOfRejected() const { return fNRejected; }
+
+   TH1I       *CreateOccupancyHistogram(const char *name = "hMixPoolOccupancy") const;
 
 private:
 
-   TObjArray   fListOfEntryList;       // list of entry lists
+   TObjArray   fListOfEntryList;       // list of entry lists (only for bins with events)
    TObjArray   fListOfEventCuts;       // list of entry lists
+   TArrayI     fListBinIndex;          // bin index of each entry list
 
-   Int_t       fBinNumber;             // bin number
+   Int_t       fBinNumber;             // number of bins
    Int_t       fBufferSize;            // buffer size
    Int_t       fMixNumber;             // mixing number
+   Long64_t    fNRejected;             // number of events out of binning range
+
+   TArrayI     fBinStride;             //! linear index stride of every cut
+   std::unordered_map<Int_t, Int_t> fBinMap; //! bin index -> position in fListOfEntryList
 
-   ClassDef(AliMixEventPool, 1)
+   ClassDef(AliMixEventPool, 2)
 };
 
 #endif
@@ -0,0 +1,369 @@
+//
+// Class AliMixEventRingPool
+//
+// AliMixEventRingPool keeps, for every event-mixing bin, a ring buffer
+// of the last events in memory
+//
+
+#include <TMath.h>
+
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "AliAODTrack.h"
+
+#include "AliMixEventRingPool.h"
+
+ClassImp(AliMixEventRingPool)
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool::AliMixEventRingPool(const char *name, const char *title) : TNamed(name, title),
+   fTrackFields(),
+   fEventFields(),
+   fDepth(10),
+   fMemoryBudget(500000000),
+   fTrackFilterBit(0),
+   fTrackPtMin(0.),
+   fTrackEtaMax(0.),
+   fRings(),
+   fRingHead(),
+   fRingSize(),
+   fLRUPrev(),
+   fLRUNext(),
+   fLRUFirst(-1),
+   fLRULast(-1),
+   fMemoryUsed(0),
+   fNEvicted(0)
+{
+   //
+   // Default constructor.
+   //
+   fEventFields.SetOwner(kTRUE);
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool::AliMixEventRingPool(const AliMixEventRingPool &obj) : TNamed(obj),
+   fTrackFields(obj.fTrackFields),
+   fEventFields(),
+   fDepth(obj.fDepth),
+   fMemoryBudget(obj.fMemoryBudget),
+   fTrackFilterBit(obj.fTrackFilterBit),
+   fTrackPtMin(obj.fTrackPtMin),
+   fTrackEtaMax(obj.fTrackEtaMax),
+   fRings(),
+   fRingHead(),
+   fRingSize(),
+   fLRUPrev(),
+   fLRUNext(),
+   fLRUFirst(-1),
+   fLRULast(-1),
+   fMemoryUsed(0),
+   fNEvicted(0)
+{
+   //
+   // Copy constructor (configuration only, buffers are not copied)
+   //
+   fEventFields.SetOwner(kTRUE);
+   for (Int_t i = 0; i < obj.fEventFields.GetEntriesFast(); i++)
+      fEventFields.Add(new AliMixEventCutObj(*(AliMixEventCutObj *) obj.fEventFields.At(i)));
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool &AliMixEventRingPool::operator=(const AliMixEventRingPool &obj)
+{
+   //
+   // Assigned operator (configuration only, buffers are reset)
+   //
+   if (&obj != this) {
+      TNamed::operator=(obj);
+      Reset();
+      fTrackFields = obj.fTrackFields;
+      fEventFields.Delete();
+      for (Int_t i = 0; i < obj.fEventFields.GetEntriesFast(); i++)
+         fEventFields.Add(new AliMixEventCutObj(*(AliMixEventCutObj *) obj.fEventFields.At(i)));
+      fDepth = obj.fDepth;
+      fMemoryBudget = obj.fMemoryBudget;
+      fTrackFilterBit = obj.fTrackFilterBit;
+      fTrackPtMin = obj.fTrackPtMin;
+      fTrackEtaMax = obj.fTrackEtaMax;
+   }
+   return *this;
+}
+
+//_________________________________________________________________________________________________
+AliMixEventRingPool::~AliMixEventRingPool()
+{
+   //
+   // Destructor
+   //
+   fEventFields.Delete();
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::AddTrackField(ETrackField_t field)
+{
+   //
+   // Registers track field to be stored for every track
+   //
+   if (field < 0 || field >= kAllTrackFields) {
+      AliError(Form("Track field %d is not supported !!!", field));
+      return;
+   }
+   if (GetTrackFieldIndex(field) >= 0) return;
+   if (!fRings.empty()) {
+      AliError("Track fields cannot be added after events were stored !!!");
+      return;
+   }
+   fTrackFields.Set(fTrackFields.GetSize() + 1);
+   fTrackFields.AddAt(field, fTrackFields.GetSize() - 1);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::AddEventField(AliMixEventCutObj::EEPAxis_t type, const char *opt)
+{
+   //
+   // Registers event variable to be stored with every event
+   //
+   if (!fRings.empty()) {
+      AliError("Event fields cannot be added after events were stored !!!");
+      return;
+   }
+   fEventFields.Add(new AliMixEventCutObj(type, 0.0, 1.0, 1.0, opt));
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::GetTrackFieldIndex(ETrackField_t field) const
+{
+   //
+   // Returns position of track field in AliMixSlimEvent track (-1 if not registered)
+   //
+   for (Int_t i = 0; i < fTrackFields.GetSize(); i++) {
+      if (fTrackFields.At(i) == field) return i;
+   }
+   return -1;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::GetEventFieldIndex(AliMixEventCutObj::EEPAxis_t type) const
+{
+   //
+   // Returns position of event variable in AliMixSlimEvent (-1 if not registered)
+   //
+   for (Int_t i = 0; i < fEventFields.GetEntriesFast(); i++) {
+      if (((AliMixEventCutObj *) fEventFields.At(i))->GetType() == type) return i;
+   }
+   return -1;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::Print(const Option_t *option) const
+{
+   //
+   // Prints usefull information
+   //
+   TNamed::Print(option);
+   AliInfo(Form("depth=%d memory budget=%lld B track fields=%d event fields=%d", fDepth, fMemoryBudget, GetNTrackFields(), GetNEventFields()));
+   Int_t nEvents = 0;
+   for (Int_t iBin = 0; iBin < (Int_t) fRingSize.size(); iBin++) nEvents += fRingSize[iBin];
+   AliInfo(Form("bins=%d events=%d memory used=%lld B evicted=%lld", (Int_t) fRingSize.size(), nEvents, fMemoryUsed, fNEvicted));
+}
+
+//_________________________________________________________________________________________________
+Float_t AliMixEventRingPool::GetTrackValue(AliVParticle *track, Int_t field) const
+{
+   //
+   // Returns value of track field
+   //
+   switch (field) {
+      case kPt:
+         return track->Pt();
+      case kEta:
+         return track->Eta();
+      case kPhi:
+         return track->Phi();
+      case kCharge:
+         return track->Charge();
+      case kPx:
+         return track->Px();
+      case kPy:
+         return track->Py();
+      case kPz:
+         return track->Pz();
+      case kMass:
+         return track->M();
+      case kLabel:
+         return track->GetLabel();
+      case kID:
+      {
+         AliVTrack *vtrack = dynamic_cast<AliVTrack *>(track);
+         return vtrack ? vtrack->GetID() : -1;
+      }
+      default:
+         break;
+   }
+   return 0.;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::ResizeBins(Int_t nBins)
+{
+   //
+   // Makes room for bins up to nBins
+   //
+   if (nBins <= (Int_t) fRings.size()) return;
+   fRings.resize(nBins);
+   fRingHead.resize(nBins, -1);
+   fRingSize.resize(nBins, 0);
+   fLRUPrev.resize(nBins, -1);
+   fLRUNext.resize(nBins, -1);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::UnlinkLRU(Int_t bin)
+{
+   //
+   // Removes bin from LRU list
+   //
+   Int_t prev = fLRUPrev[bin], next = fLRUNext[bin];
+   if (prev >= 0) fLRUNext[prev] = next;
+   else if (fLRUFirst == bin) fLRUFirst = next;
+   if (next >= 0) fLRUPrev[next] = prev;
+   else if (fLRULast == bin) fLRULast = prev;
+   fLRUPrev[bin] = fLRUNext[bin] = -1;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::LinkLRU(Int_t bin)
+{
+   //
+   // Puts bin on the front of LRU list
+   //
+   fLRUNext[bin] = fLRUFirst;
+   fLRUPrev[bin] = -1;
+   if (fLRUFirst >= 0) fLRUPrev[fLRUFirst] = bin;
+   fLRUFirst = bin;
+   if (fLRULast < 0) fLRULast = bin;
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::Touch(Int_t bin)
+{
+   //
+   // Marks bin as most recently used
+   //
+   if (bin < 0 || bin >= (Int_t) fRingSize.size() || !fRingSize[bin] || fLRUFirst == bin) return;
+   UnlinkLRU(bin);
+   LinkLRU(bin);
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::EvictLRU(Int_t keepBin)
+{
+   //
+   // Removes oldest events of least recently used bins until memory budget is respected.
+   // The newest event of bin keepBin is never removed
+   //
+   while (fMemoryBudget > 0 && fMemoryUsed > fMemoryBudget) {
+      Int_t bin = fLRULast;
+      if (bin == keepBin) bin = fLRUPrev[bin];
+      if (bin < 0) {
+         if (keepBin < 0 || fRingSize[keepBin] <= 1) break;
+         bin = keepBin;
+      }
+      Int_t oldest = (fRingHead[bin] - fRingSize[bin] + 1 + fDepth) % fDepth;
+      AliMixSlimEvent &slot = fRings[bin][oldest];
+      fMemoryUsed -= slot.GetMemorySize();
+      slot.Release();
+      fRingSize[bin]--;
+      fNEvicted++;
+      if (!fRingSize[bin]) {
+         UnlinkLRU(bin);
+         std::vector<AliMixSlimEvent>().swap(fRings[bin]);
+         fRingHead[bin] = -1;
+      }
+   }
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixEventRingPool::AddEvent(Int_t bin, Long64_t entry, AliVEvent *ev)
+{
+   //
+   // Stores slim copy of event in ring buffer of bin (oldest event is overwritten)
+   //
+   if (!ev || bin < 0 || fDepth < 1) return kFALSE;
+   ResizeBins(bin + 1);
+   std::vector<AliMixSlimEvent> &ring = fRings[bin];
+   if (ring.empty()) ring.resize(fDepth);
+
+   Int_t head = (fRingHead[bin] + 1) % fDepth;
+   AliMixSlimEvent &slot = ring[head];
+   if (fRingSize[bin] == fDepth) fMemoryUsed -= slot.GetMemorySize();
+
+   const Int_t nTrackFields = fTrackFields.GetSize();
+   slot.Reset(entry, fEventFields.GetEntriesFast(), nTrackFields);
+   for (Int_t i = 0; i < fEventFields.GetEntriesFast(); i++)
+      slot.SetEventValue(i, ((AliMixEventCutObj *) fEventFields.At(i))->GetValue(ev));
+
+   if (nTrackFields > 0) {
+      AliVParticle *track = 0;
+      for (Int_t iTrack = 0; iTrack < ev->GetNumberOfTracks(); iTrack++) {
+         track = ev->GetTrack(iTrack);
+         if (!track) continue;
+         if (fTrackFilterBit) {
+            AliAODTrack *aodTrack = dynamic_cast<AliAODTrack *>(track);
+            if (aodTrack && !aodTrack->TestFilterBit(fTrackFilterBit)) continue;
+         }
+         if (track->Pt() < fTrackPtMin) continue;
+         if (fTrackEtaMax > 0 && TMath::Abs(track->Eta()) > fTrackEtaMax) continue;
+         Float_t *values = slot.AddTrack();
+         for (Int_t i = 0; i < nTrackFields; i++) values[i] = GetTrackValue(track, fTrackFields.At(i));
+      }
+   }
+   fMemoryUsed += slot.GetMemorySize();
+
+   fRingHead[bin] = head;
+   if (fRingSize[bin] < fDepth) {
+      if (!fRingSize[bin]) LinkLRU(bin);
+      fRingSize[bin]++;
+   }
+   Touch(bin);
+   EvictLRU(bin);
+   AliDebug(AliLog::kDebug + 1, Form("Entry %lld added to bin %d (%d events, %lld B used)", entry, bin, fRingSize[bin], fMemoryUsed));
+   return kTRUE;
+}
+
+//_________________________________________________________________________________________________
+Int_t AliMixEventRingPool::GetNEvents(Int_t bin) const
+{
+   //
+   // Returns number of buffered events in bin
+   //
+   if (bin < 0 || bin >= (Int_t) fRingSize.size()) return 0;
+   return fRingSize[bin];
+}
+
+//_________________________________________________________________________________________________
+const AliMixSlimEvent *AliMixEventRingPool::GetEvent(Int_t bin, Int_t i) const
+{
+   //
+   // Returns i-th buffered event in bin (0 is the newest one)
+   //
+   if (i < 0 || i >= GetNEvents(bin)) return 0;
+   return &fRings[bin][(fRingHead[bin] - i + fDepth) % fDepth];
+}
+
+//_________________________________________________________________________________________________
+void AliMixEventRingPool::Reset()
+{
+   //
+   // Removes all buffered events
+   //
+   fRings.clear();
+   fRingHead.clear();
+   fRingSize.clear();
+   fLRUPrev.clear();
+   fLRUNext.clear();
+   fLRUFirst = -1;
+   fLRULast = -1;
+   fMemoryUsed = 0;
+}
@@ -0,0 +1,97 @@
+//
+// Class AliMixEventRingPool
+//
+// AliMixEventRingPool keeps, for every event-mixing bin, a ring buffer
+// of the last events in memory (as AliMixSlimEvent, only with the track
+// and event fields registered by the user). When the memory budget is
+// exceeded, events are evicted from the least recently used bins.
+// It is used by AliMixInputEventHandler (SetRingPool) to mix without
+// reading the mixed events again from disk.
+//
+
+#ifndef ALIMIXEVENTRINGPOOL_H
+#define ALIMIXEVENTRINGPOOL_H
+
+#include <vector>
+
+#include <TNamed.h>
+#include <TObjArray.h>
+#include <TArrayI.h>
+
+#include "AliMixEventCutObj.h"
+#include "AliMixSlimEvent.h"
+
+class AliVEvent;
+class AliVParticle;
+class AliMixEventRingPool : public TNamed {
+public:
+   enum ETrackField_t {kPt = 0, kEta = 1, kPhi = 2, kCharge = 3, kPx = 4, kPy = 5, kPz = 6, kMass = 7,
+                       kLabel = 8, kID = 9, kAllTrackFields = 10
+                      };
+
+   AliMixEventRingPool(const char *name = "mixEventRingPool", const char *title = "Mix event ring pool");
+   AliMixEventRingPool(const AliMixEventRingPool &obj);
+   AliMixEventRingPool &operator= (const AliMixEventRingPool &obj);
+   virtual ~AliMixEventRingPool();
+
+   virtual void            Print(const Option_t *option = "") const;
+
+   // configuration
+   void                    AddTrackField(ETrackField_t field);
+   void                    AddEventField(AliMixEventCutObj::EEPAxis_t type, const char *opt = "");
+   void                    SetDepth(Int_t depth) { if (depth != fDepth) Reset(); fDepth = depth; }
+   void                    SetMemoryBudget(Long64_t bytes) { fMemoryBudget = bytes; }
+   void                    SetTrackFilterBit(UInt_t bit) { fTrackFilterBit = bit; }
+   void                    SetTrackPtMin(Float_t ptMin) { fTrackPtMin = ptMin; }
+   void                    SetTrackEtaMax(Float_t etaMax) { fTrackEtaMax = etaMax; }
+
+   Int_t                   GetDepth() const { return fDepth; }
+   Long64_t                GetMemoryBudget() const { return fMemoryBudget; }
+   Int_t                   GetNTrackFields() const { return fTrackFields.GetSize(); }
+   Int_t                   GetTrackFieldIndex(ETrackField_t field) const;
+   Int_t                   GetNEventFields() const { return fEventFields.GetEntriesFast(); }
+   Int_t                   GetEventFieldIndex(AliMixEventCutObj::EEPAxis_t type) const;
+   UInt_t                  GetTrackFilterBit() const { return fTrackFilterBit; }
+
+   // buffer access
+   Bool_t                  AddEvent(Int_t bin, Long64_t entry, AliVEvent *ev);
+   Int_t                   GetNEvents(Int_t bin) const;
+   const AliMixSlimEvent  *GetEvent(Int_t bin, Int_t i) const;
+   void                    Touch(Int_t bin);
+   void                    Reset();
+
+   Long64_t                GetMemoryUsed() const { return fMemoryUsed; }
+   Long64_t                GetNEvicted() const { return fNEvicted; }
+
+private:
+
+   void                    ResizeBins(Int_t nBins);
+   void                    EvictLRU(Int_t keepBin);
+   void                    UnlinkLRU(Int_t bin);
+   void                    LinkLRU(Int_t bin);
+   Float_t                 GetTrackValue(AliVParticle *track, Int_t field) const;
+
+   // configuration
+   TArrayI                 fTrackFields;       // registered track fields (ETrackField_t)
+   TObjArray               fEventFields;       // registered event fields (AliMixEventCutObj)
+   Int_t                   fDepth;             // number of events kept per bin
+   Long64_t                fMemoryBudget;      // memory budget in bytes (<=0 no limit)
+   UInt_t                  fTrackFilterBit;    // AOD filter bit of stored tracks (0 all)
+   Float_t                 fTrackPtMin;        // min pt of stored tracks
+   Float_t                 fTrackEtaMax;       // max |eta| of stored tracks (<=0 no cut)
+
+   // ring buffers (one per bin)
+   std::vector<std::vector<AliMixSlimEvent> > fRings; //! event slots per bin
+   std::vector<Int_t>      fRingHead;          //! slot of the newest event per bin
+   std::vector<Int_t>      fRingSize;          //! number of events per bin
+   std::vector<Int_t>      fLRUPrev;           //! LRU list of non-empty bins (previous = more recent)
+   std::vector<Int_t>      fLRUNext;           //! LRU list of non-empty bins (next = less recent)
+   Int_t                   fLRUFirst;          //! most recently used bin
+   Int_t                   fLRULast;           //! least recently used bin
+   Long64_t                fMemoryUsed;        //! memory used by the buffered events
+   Long64_t                fNEvicted;          //! number of events evicted because of the budget
+
+   ClassDef(AliMixEventRingPool, 1)
+};
+
+#endif
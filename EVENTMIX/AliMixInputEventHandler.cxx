@@ -11,14 +11,17 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
 #include "AliMixEventPool.h"
+#include "AliMixEventRingPool.h"
 #include "AliMixInputEventHandler.h"
 #include "AliMixInputHandlerInfo.h"
+#include "AliMixSlimEventHandler.h"
 
 #include "AliAnalysisTaskSE.h"
 
@@ -31,6 +34,7 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fMixIntupHandlerInfoTmp(0),
    fEntryCounter(0),
    fEventPool(0),
+   fRingPool(0),
    fNumberMixed(0),
    fMixNumber(mixNum),
    fUseDefautProcess(kFALSE),
@@ -43,7 +47,9 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fCurrentSlimEvent(0),
+   fSlimEventHandler(0)
 {
    //
    // Default constructor.
@@ -59,6 +65,10 @@ AliMixInputEventHandler::~AliMixInputEventHandler() {
    // Destructor
    //
    fMixTrees.Clear();
+   if (fSlimEventHandler) {
+      fInputHandlers.Remove(fSlimEventHandler);
+      delete fSlimEventHandler;
+   }
 }
 
 //_____________________________________________________________________________
@@ -106,6 +116,13 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
       fMixIntupHandlerInfoTmp = new AliMixInputHandlerInfo(tree->GetName());
    }
 
+   // with the ring pool the mixed event is given by the handler of the slim events
+   if (fRingPool && !fSlimEventHandler) {
+      fSlimEventHandler = new AliMixSlimEventHandler();
+      fInputHandlers.Clear();
+      fInputHandlers.Add(fSlimEventHandler);
+   }
+
    AliInputEventHandler *ih = 0;
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       ih = (AliInputEventHandler *) fInputHandlers.At(i);
@@ -139,6 +156,14 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    //
    AliDebug(AliLog::kDebug + 5, Form("<- %s", path));
 
+   if (fRingPool) {
+      // mixed events are taken from memory, no need to prepare trees
+      if (fEventPool && fEventPool->NeedInit())
+         fEventPool->Init();
+      AliDebug(AliLog::kDebug + 5, Form("-> (ring pool)"));
+      return kTRUE;
+   }
+
    Bool_t doPrepareEntry=kTRUE;
    TString anType = fAnalysisType;
 
@@ -192,7 +217,10 @@ Bool_t AliMixInputEventHandler::GetEntry()
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
 
-   if (!fEventPool) {
+   if (fRingPool) {
+      MixRingPool();
+   }
+   else if (!fEventPool) {
       MixStd();
    }
    // if buffer size is higher then 1
@@ -495,6 +523,73 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithBuffer()
    return kFALSE;
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::MixRingPool()
+{
+   //
+   // Mix with events kept in memory by fRingPool.
+   // Event is mixed with (up to) fMixNumber newest events from its bin,
+   // then it is added to the pool. Mixed event is available in UserExecMix
+   // via GetMixedSlimEvent() or, as an AliAODEvent, via InputEventHandler(0)
+   //
+   AliDebug(AliLog::kDebug + 5, "<-");
+   AliDebug(AliLog::kDebug + 1, "Mix method");
+   // get correct handler
+   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+   AliMultiInputEventHandler *mh = dynamic_cast<AliMultiInputEventHandler *>(mgr->GetInputEventHandler());
+   AliInputEventHandler *inEvHMain = 0;
+   if (mh) inEvHMain = dynamic_cast<AliInputEventHandler *>(mh->GetFirstInputEventHandler());
+   else inEvHMain = dynamic_cast<AliInputEventHandler *>(mgr->GetInputEventHandler());
+   if (!inEvHMain) return kFALSE;
+
+   // check for PhysSelection
+   if (!IsEventCurrentSelected()) return kFALSE;
+
+   fCurrentMixEntry.Reset();
+   fCurrentSlimEvent = 0;
+   fNumberMixed = 0;
+
+   // bin of the event (all events in one bin without event pool)
+   Int_t idEntryList = 1;
+   if (fEventPool) {
+      TEntryList *el = fEventPool->FindEntryList(inEvHMain->GetEvent(), idEntryList);
+      if (!el) idEntryList = -1;
+   }
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   if (idEntryList < 0) {
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (el null) +++++++++++++++++++", fEntryCounter));
+      UserExecMixAllTasks(fEntryCounter, -1, fEntryCounter, -1, 0);
+      return kTRUE;
+   }
+   Int_t bin = idEntryList - 1;
+
+   Int_t nInBin = fRingPool->GetNEvents(bin);
+   if (!nInBin || (!fDoMixIfNotEnoughEvents && nInBin < fMixNumber)) {
+      UserExecMixAllTasks(fEntryCounter, fDoMixIfNotEnoughEvents ? idEntryList : -1, fEntryCounter, -1, 0);
+      AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld SKIPPED (%d) NOT ENOUGH EVENTS TO MIX => NEED=%d +++++++++++++++++++", fEntryCounter, nInBin, fMixNumber));
+   } else {
+      Int_t mixNum = TMath::Min(fMixNumber, nInBin);
+      for (Int_t counter = 0; counter < mixNum; counter++) {
+         fCurrentSlimEvent = fRingPool->GetEvent(bin, counter);
+         fCurrentMixEntry.Reset();
+         fCurrentMixEntry.Enter(fCurrentSlimEvent->GetEntry());
+         if (fDoMixEventGetEntryAuto) GetEntryMixedEvent(0);
+         fNumberMixed++;
+         UserExecMixAllTasks(fEntryCounter, idEntryList, fEntryCounter, fCurrentSlimEvent->GetEntry(), fNumberMixed);
+      }
+      fRingPool->Touch(bin);
+      fCurrentSlimEvent = 0;
+   }
+
+   // current event becomes available for next events
+   fRingPool->AddEvent(bin, fEntryCounter, inEvHMain->GetEvent());
+
+   AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
+   AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ END SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
+   AliDebug(AliLog::kDebug + 5, "->");
+   return kTRUE;
+}
+
 //_____________________________________________________________________________
 Bool_t AliMixInputEventHandler::FinishEvent()
 {
@@ -605,6 +700,14 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
    // (Should be used in UserExecMix() only)
    //
 
+   if (fRingPool) {
+      // mixed event is in memory, it is copied to the event of InputEventHandler(0)
+      if (id != 0 || !fCurrentSlimEvent || !fSlimEventHandler) {
+         AliError(Form("GetEntryMixedEvent(%d) => no mixed event in memory", id));
+         return kFALSE;
+      }
+      return fSlimEventHandler->SetSlimEvent(fCurrentSlimEvent, fRingPool);
+   }
    AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(id);
 
    Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN()-id-1);
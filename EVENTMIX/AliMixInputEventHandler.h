@@ -21,6 +21,9 @@
 class TChain;
 class TChainElement;
 class AliMixEventPool;
+class AliMixEventRingPool;
+class AliMixSlimEvent;
+class AliMixSlimEventHandler;
 class AliMixInputHandlerInfo;
 class AliInputEventHandler;
 class AliMixInputEventHandler : public AliMultiInputEventHandler {
@@ -42,8 +45,14 @@ public:
 
    void                    SetInputHandlerForMixing(const AliInputEventHandler *const inHandler);
    void                    SetEventPool(AliMixEventPool *const evPool) { fEventPool = evPool; }
+   // mixes with events kept in memory (no input handler for mixing is needed,
+   // InputEventHandler(0) is an AliMixSlimEventHandler with the mixed event)
+   void                    SetRingPool(AliMixEventRingPool *const ringPool) { fRingPool = ringPool; }
 
    AliMixEventPool        *GetEventPool() const { return fEventPool; }
+   AliMixEventRingPool    *GetRingPool() const { return fRingPool; }
+   const AliMixSlimEvent  *GetMixedSlimEvent() const { return fCurrentSlimEvent; }
+   AliMixSlimEventHandler *GetSlimEventHandler() const { return fSlimEventHandler; }
    Int_t                   BufferSize() const { return fBufferSize; }
    Int_t                   NumberMixedTimes() const { return fNumberMixed; }
    Int_t                   MixNumber() const { return fMixNumber; }
@@ -80,6 +89,7 @@ protected:
    AliMixInputHandlerInfo *fMixIntupHandlerInfoTmp;//! mix input handler info full chain
    Long64_t                fEntryCounter;          // entry counter
    AliMixEventPool        *fEventPool;             // event pool
+   AliMixEventRingPool    *fRingPool;              // in-memory event pool (ring buffer mode)
    Int_t                   fNumberMixed;           // number of mixed events with current event
    Int_t                   fMixNumber;             // user's mix number request
 
@@ -99,18 +109,21 @@ private:
 
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
+   const AliMixSlimEvent *fCurrentSlimEvent; //! current mixed event (ring buffer mode)
+   AliMixSlimEventHandler *fSlimEventHandler; //! input handler of the mixed event (ring buffer mode)
 
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
+   virtual Bool_t          MixRingPool();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -0,0 +1,64 @@
+//
+// Class AliMixSlimEvent
+//
+// AliMixSlimEvent is a reduced copy of an event kept in memory by
+// AliMixEventRingPool
+//
+
+#include "AliMixSlimEvent.h"
+
+ClassImp(AliMixSlimEvent)
+
+//_________________________________________________________________________________________________
+AliMixSlimEvent::AliMixSlimEvent() : TObject(),
+   fEntry(-1),
+   fNTrackFields(0),
+   fEventValues(),
+   fTracks()
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+void AliMixSlimEvent::Reset(Long64_t entry, Int_t nEventFields, Int_t nTrackFields)
+{
+   //
+   // Prepares the object for a new event (keeps allocated memory)
+   //
+   fEntry = entry;
+   fNTrackFields = nTrackFields;
+   fEventValues.assign(nEventFields, 0.);
+   fTracks.clear();
+}
+
+//_________________________________________________________________________________________________
+void AliMixSlimEvent::Release()
+{
+   //
+   // Frees all memory
+   //
+   fEntry = -1;
+   std::vector<Float_t>().swap(fEventValues);
+   std::vector<Float_t>().swap(fTracks);
+}
+
+//_________________________________________________________________________________________________
+Float_t *AliMixSlimEvent::AddTrack()
+{
+   //
+   // Appends a track and returns pointer to its fields
+   //
+   fTracks.resize(fTracks.size() + fNTrackFields);
+   return &fTracks[fTracks.size() - fNTrackFields];
+}
+
+//_________________________________________________________________________________________________
+Long64_t AliMixSlimEvent::GetMemorySize() const
+{
+   //
+   // Returns memory used by this object (in bytes)
+   //
+   return sizeof(AliMixSlimEvent) + (fEventValues.capacity() + fTracks.capacity()) * sizeof(Float_t);
+}
@@ -0,0 +1,44 @@
+//
+// Class AliMixSlimEvent
+//
+// AliMixSlimEvent is a reduced copy of an event kept in memory by
+// AliMixEventRingPool: a few event variables and, for every accepted
+// track, the track fields registered in the pool (stored row by row)
+//
+
+#ifndef ALIMIXSLIMEVENT_H
+#define ALIMIXSLIMEVENT_H
+
+#include <vector>
+
+#include <TObject.h>
+
+class AliMixSlimEvent : public TObject {
+public:
+   AliMixSlimEvent();
+   virtual ~AliMixSlimEvent() {}
+
+   void           Reset(Long64_t entry, Int_t nEventFields, Int_t nTrackFields);
+   void           Release();
+   Float_t       *AddTrack();
+   void           SetEventValue(Int_t i, Float_t val) { fEventValues[i] = val; }
+
+   Long64_t       GetEntry() const { return fEntry; }
+   Int_t          GetNTracks() const { return fNTrackFields > 0 ? (Int_t)(fTracks.size() / fNTrackFields) : 0; }
+   Int_t          GetNTrackFields() const { return fNTrackFields; }
+   Int_t          GetNEventValues() const { return (Int_t) fEventValues.size(); }
+   Float_t        GetEventValue(Int_t i) const { return fEventValues[i]; }
+   const Float_t *GetTrack(Int_t iTrack) const { return &fTracks[iTrack * fNTrackFields]; }
+   Float_t        GetTrackValue(Int_t iTrack, Int_t iField) const { return fTracks[iTrack * fNTrackFields + iField]; }
+   Long64_t       GetMemorySize() const;
+
+private:
+   Long64_t              fEntry;        // entry counter of the event
+   Int_t                 fNTrackFields; // number of stored fields per track
+   std::vector<Float_t>  fEventValues;  // event variables
+   std::vector<Float_t>  fTracks;       // track fields, fNTrackFields values per track
+
+   ClassDef(AliMixSlimEvent, 1)
+};
+
+#endif
@@ -0,0 +1,107 @@
+//
+// Class AliMixSlimEventHandler
+//
+// AliMixSlimEventHandler gives the mixed events of AliMixEventRingPool
+// to UserExecMix as an AliAODEvent
+//
+
+#include <TClonesArray.h>
+#include <TMath.h>
+
+#include "AliLog.h"
+#include "AliAODEvent.h"
+#include "AliAODTrack.h"
+#include "AliAODVertex.h"
+
+#include "AliMixSlimEvent.h"
+#include "AliMixEventRingPool.h"
+#include "AliMixSlimEventHandler.h"
+
+ClassImp(AliMixSlimEventHandler)
+
+//_________________________________________________________________________________________________
+AliMixSlimEventHandler::AliMixSlimEventHandler(const char *name, const char *title) : AliInputEventHandler(name, title),
+   fAODEvent(0),
+   fSlimEvent(0)
+{
+   //
+   // Default constructor.
+   //
+}
+
+//_________________________________________________________________________________________________
+AliMixSlimEventHandler::~AliMixSlimEventHandler()
+{
+   //
+   // Destructor
+   //
+   delete fAODEvent;
+}
+
+//_________________________________________________________________________________________________
+AliVEvent *AliMixSlimEventHandler::GetEvent() const
+{
+   //
+   // Returns event filled from the current slim event (null before the first one)
+   //
+   return fSlimEvent ? fAODEvent : 0;
+}
+
+//_________________________________________________________________________________________________
+Bool_t AliMixSlimEventHandler::SetSlimEvent(const AliMixSlimEvent *slimEvent, const AliMixEventRingPool *pool)
+{
+   //
+   // Fills AOD event with tracks and primary vertex of slimEvent
+   //
+   fSlimEvent = slimEvent;
+   if (!slimEvent || !pool) return kFALSE;
+   if (!fAODEvent) {
+      fAODEvent = new AliAODEvent();
+      fAODEvent->CreateStdContent();
+   }
+
+   TClonesArray *vertices = fAODEvent->GetVertices();
+   vertices->Delete();
+   Int_t iZ = pool->GetEventFieldIndex(AliMixEventCutObj::kZVertex);
+   if (iZ >= 0) {
+      Double_t pos[3] = {0., 0., slimEvent->GetEventValue(iZ)};
+      new ((*vertices)[0]) AliAODVertex(pos, 0, -999., 0, -1, AliAODVertex::kPrimary);
+   }
+
+   Int_t iPt = pool->GetTrackFieldIndex(AliMixEventRingPool::kPt);
+   Int_t iEta = pool->GetTrackFieldIndex(AliMixEventRingPool::kEta);
+   Int_t iPhi = pool->GetTrackFieldIndex(AliMixEventRingPool::kPhi);
+   Int_t iPx = pool->GetTrackFieldIndex(AliMixEventRingPool::kPx);
+   Int_t iPy = pool->GetTrackFieldIndex(AliMixEventRingPool::kPy);
+   Int_t iPz = pool->GetTrackFieldIndex(AliMixEventRingPool::kPz);
+   Int_t iCharge = pool->GetTrackFieldIndex(AliMixEventRingPool::kCharge);
+   Int_t iLabel = pool->GetTrackFieldIndex(AliMixEventRingPool::kLabel);
+   Int_t iID = pool->GetTrackFieldIndex(AliMixEventRingPool::kID);
+   Bool_t cartesian = (iPx >= 0 && iPy >= 0 && iPz >= 0);
+
+   TClonesArray *tracks = fAODEvent->GetTracks();
+   tracks->Delete();
+   Double_t p[3];
+   for (Int_t iTrack = 0; iTrack < slimEvent->GetNTracks(); iTrack++) {
+      const Float_t *values = slimEvent->GetTrack(iTrack);
+      AliAODTrack *track = new ((*tracks)[iTrack]) AliAODTrack();
+      if (cartesian) {
+         p[0] = values[iPx];
+         p[1] = values[iPy];
+         p[2] = values[iPz];
+      } else {
+         // AliAODTrack polar momentum is (pt, phi, theta)
+         p[0] = iPt >= 0 ? values[iPt] : 0.;
+         p[1] = iPhi >= 0 ? values[iPhi] : 0.;
+         p[2] = iEta >= 0 ? 2. * TMath::ATan(TMath::Exp(-values[iEta])) : TMath::PiOver2();
+      }
+      track->SetP(p, cartesian);
+      if (iCharge >= 0) track->SetCharge((Short_t) values[iCharge]);
+      if (iLabel >= 0) track->SetLabel((Int_t) values[iLabel]);
+      if (iID >= 0) track->SetID((Short_t) values[iID]);
+      track->SetFilterMap(pool->GetTrackFilterBit());
+      track->SetAODEvent(fAODEvent);
+   }
+   AliDebug(AliLog::kDebug + 1, Form("Entry %lld with %d tracks", slimEvent->GetEntry(), slimEvent->GetNTracks()));
+   return kTRUE;
+}
@@ -0,0 +1,41 @@
+//
+// Class AliMixSlimEventHandler
+//
+// AliMixSlimEventHandler is the input handler seen by UserExecMix when
+// AliMixInputEventHandler mixes with AliMixEventRingPool. Its event is an
+// AliAODEvent filled from the current AliMixSlimEvent: the stored tracks
+// (kinematics, charge, label, ID and the filter bit of the pool) and the
+// primary vertex z, when these fields are registered in the pool.
+// The other event variables are read from GetSlimEvent()
+//
+
+#ifndef ALIMIXSLIMEVENTHANDLER_H
+#define ALIMIXSLIMEVENTHANDLER_H
+
+#include "AliInputEventHandler.h"
+
+class AliAODEvent;
+class AliMixSlimEvent;
+class AliMixEventRingPool;
+class AliMixSlimEventHandler : public AliInputEventHandler {
+public:
+   AliMixSlimEventHandler(const char *name = "mixSlimEventHandler", const char *title = "Mixed slim event");
+   virtual ~AliMixSlimEventHandler();
+
+   virtual AliVEvent      *GetEvent() const;
+
+   Bool_t                  SetSlimEvent(const AliMixSlimEvent *slimEvent, const AliMixEventRingPool *pool);
+   const AliMixSlimEvent  *GetSlimEvent() const { return fSlimEvent; }
+
+private:
+
+   AliAODEvent            *fAODEvent;   //! event filled from the slim event
+   const AliMixSlimEvent  *fSlimEvent;  //! current slim event
+
+   AliMixSlimEventHandler(const AliMixSlimEventHandler &handler);
+   AliMixSlimEventHandler &operator=(const AliMixSlimEventHandler &handler);
+
+   ClassDef(AliMixSlimEventHandler, 1)
+};
+
+#endif
@@ -2,6 +2,9 @@
 
 #pragma link C++ class AliMixEventCutObj+;
 #pragma link C++ class AliMixEventPool+;
+#pragma link C++ class AliMixSlimEvent+;
+#pragma link C++ class AliMixEventRingPool+;
+#pragma link C++ class AliMixSlimEventHandler+;
 
 #pragma link C++ class AliMixInfo+;
 #pragma link C++ class AliMixInputHandlerInfo+;
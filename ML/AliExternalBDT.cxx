@@ -13,11 +13,29 @@
 #include "AliExternalBDT.h"
 
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <dlfcn.h>
+#include <fcntl.h>
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#if defined(__has_include)
+#if __has_include("treelite/version.h")
+#include "treelite/version.h"
+#endif
+#endif
 
 namespace {
+  const std::string kCompilerFlags = "-O1 -fPIC";
+  const int kLockTimeout = 1800;    // seconds to wait for another job populating the cache
+
   inline bool checkFile (const std::string name) {
     FILE *file = fopen(name.c_str(), "r");
     if (file != NULL) {
@@ -27,6 +45,46 @@ namespace {
       return false;
     }
   }
+
+  /// FNV-1a hash, enough to tell apart model files and build settings
+  const uint64_t kHashSeed = 14695981039346656037ull;
+  inline void hashBytes(uint64_t &hash, const char *data, size_t size) {
+    for (size_t iByte = 0; iByte < size; ++iByte) {
+      hash ^= static_cast<unsigned char>(data[iByte]);
+      hash *= 1099511628211ull;
+    }
+  }
+
+  inline bool hashFile(uint64_t &hash, const std::string &name) {
+    FILE *file = fopen(name.data(), "rb");
+    if (file == NULL) return false;
+    char buffer[65536];
+    size_t nRead = 0;
+    while ((nRead = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+      hashBytes(hash, buffer, nRead);
+    }
+    fclose(file);
+    return true;
+  }
+
+  /// version of treelite, which generates the model code. Taken from the headers if they define it,
+  /// otherwise from the hash of the loaded treelite library
+  std::string treeliteVersion() {
+#ifdef TREELITE_VER_MAJOR
+    return std::to_string(TREELITE_VER_MAJOR) + "." + std::to_string(TREELITE_VER_MINOR) + "." +
+      std::to_string(TREELITE_VER_PATCH);
+#else
+    Dl_info info;
+    if (dladdr(reinterpret_cast<void *>(&TreeliteCompilerCreate), &info) == 0 || info.dli_fname == NULL) {
+      return "unknown";
+    }
+    uint64_t hash = kHashSeed;
+    if (!hashFile(hash, info.dli_fname)) return "unknown";
+    char version[17];
+    snprintf(version, sizeof(version), "%016llx", static_cast<unsigned long long>(hash));
+    return version;
+#endif
+  }
 }
 
 AliExternalBDT::AliExternalBDT(std::string name) :
@@ -35,8 +93,17 @@ AliExternalBDT::AliExternalBDT(std::string name) :
   fModelPath{""},
   fModelName{""},
   fCompiler{},
-  fPredictor{}
+  fPredictor{},
+  fNThreads{1},
+  fCacheDirectory{""},
+  fPrecompiledLibrary{""},
+  fCacheKey{""},
+  fLoadedFromCache{false},
+  fStartupTime{0.},
+  fBatchOutput{}
 {
+  const char *cacheDir = getenv("ALIML_MODEL_CACHE");
+  if (cacheDir) fCacheDirectory = cacheDir;
 }
 
 
@@ -44,16 +111,78 @@ bool AliExternalBDT::CompileAndLoadModelLibrary() {
   std::string path = GetUniquePath();
   if (checkFile(path + "/main.so")) {
     std::cout << "Library found: " << path.data() << "/main.so . Loading it!" << std::endl;
-  } else {
-    std::cout << "Starting the model compilation, depending on the model size it can take a while..." << std::endl;
-    system((std::string("gcc -c -O1 -fPIC ") + path + "/main.c -o " + path + "/main.o && gcc -shared " + path + \
-          "/main.o -o " + path + "/main.so").data());
+  } else if (!CompileLibrary(path)) {
+    return false;
   }
   return LoadModelLibrary(path + "/main.so");
 }
 
-bool AliExternalBDT::CreateModelCode() {
-  std::string path = GetUniquePath();
+bool AliExternalBDT::CompileLibrary(const std::string &path) {
+  std::cout << "Starting the model compilation, depending on the model size it can take a while..." << std::endl;
+  const int status = system((std::string("gcc -c ") + kCompilerFlags + " " + path + "/main.c -o " + path +
+        "/main.o && gcc -shared " + path + "/main.o -o " + path + "/main.so").data());
+  if (status != 0) {
+    std::cerr << "Model compilation failed." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool AliExternalBDT::CompileToCache() {
+  mkdir(fCacheDirectory.data(), 0755);
+  const std::string library = fCacheDirectory + "/" + fCacheKey + ".so";
+  const std::string lock = library + ".lock";
+
+  /// only one job populates a given cache entry, the others wait for it. The flock is released
+  /// by the system when the owning job ends, also if it crashes, so the lock file is never stale
+  const int lockFile = open(lock.data(), O_CREAT | O_RDWR, 0644);
+  bool locked = lockFile >= 0 && flock(lockFile, LOCK_EX | LOCK_NB) == 0;
+  if (lockFile >= 0 && !locked) {
+    std::cout << "Model library " << library << " is being compiled by another process, waiting for it..." << std::endl;
+    for (int iWait = 0; iWait < kLockTimeout && !locked; ++iWait) {
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      locked = flock(lockFile, LOCK_EX | LOCK_NB) == 0;
+    }
+  }
+  if (!locked) {
+    if (lockFile >= 0) close(lockFile);
+    std::cout << "Could not lock the model cache, compiling the model privately." << std::endl;
+    return CreateModelCode(GetUniquePath()) && CompileAndLoadModelLibrary();
+  }
+
+  /// the library is there if another job compiled it while this one was waiting
+  bool status = true;
+  if (checkFile(library)) {
+    fLoadedFromCache = true;
+  } else {
+    /// build in a private directory and move the library in place atomically
+    const std::string path = fCacheDirectory + "/" + fCacheKey + "_" + std::to_string(getpid());
+    status = CreateModelCode(path) && CompileLibrary(path);
+    if (status && rename((path + "/main.so").data(), library.data()) != 0) {
+      std::cerr << "Could not move the compiled model to the cache." << std::endl;
+      status = false;
+    }
+    system((std::string("rm -rf ") + path).data());
+  }
+  /// the lock file is left in place, removing it would let two jobs hold a lock at the same time
+  flock(lockFile, LOCK_UN);
+  close(lockFile);
+  if (!status) return false;
+  return LoadModelLibrary(library);
+}
+
+std::string AliExternalBDT::ComputeCacheKey() const {
+  static const std::string kTreeliteVersion = treeliteVersion();
+  uint64_t hash = kHashSeed;
+  if (!hashFile(hash, fModelPath)) return "";
+  const std::string settings = kTreeliteVersion + "|" + kCompilerFlags;
+  hashBytes(hash, settings.data(), settings.size());
+  char key[17];
+  snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+  return key;
+}
+
+bool AliExternalBDT::CreateModelCode(const std::string &path) {
   if (checkFile(path + "/main.c")) {
     std::cout << "Code found: " << path.data() << "/main.c . \
       Remove it or unset/change the AliExternalBDT name to force its regeneration." << std::endl;
@@ -72,6 +201,21 @@ bool AliExternalBDT::CreateModelCode() {
   return true;
 }
 
+std::string AliExternalBDT::FindCachedLibrary() const {
+  if (fCacheKey.empty()) return "";
+  if (!fPrecompiledLibrary.empty()) {
+    const std::string name = fPrecompiledLibrary.substr(fPrecompiledLibrary.find_last_of("\\/") + 1);
+    if (name == fCacheKey + ".so" && checkFile(fPrecompiledLibrary)) return fPrecompiledLibrary;
+    std::cout << "Precompiled library " << fPrecompiledLibrary << " does not match the model (expected "
+      << fCacheKey << ".so), ignoring it." << std::endl;
+  }
+  if (!fCacheDirectory.empty()) {
+    const std::string library = fCacheDirectory + "/" + fCacheKey + ".so";
+    if (checkFile(library)) return library;
+  }
+  return "";
+}
+
 std::string AliExternalBDT::GetUniquePath() {
   if (fBDTname.empty()) {
     return fModelName + std::to_string((unsigned long)this);
@@ -87,25 +231,42 @@ bool AliExternalBDT::LoadModel(const std::string &path, int type) {
   }
   fModelPath = path;
   fModelName = fModelPath.substr(fModelPath.find_last_of("\\/")+1,fModelPath.size());
-  int status = 0;
-  switch (type) {
-    case 0:
-      status = TreeliteLoadXGBoostModel(fModelPath.data(), &fModel);
-      break;
-    case 1:
-      status = TreeliteLoadLightGBMModel(fModelPath.data(), &fModel);
-      break;
-    default:
-      std::cerr << "Invalid model type" << std::endl;
+  const auto start = std::chrono::steady_clock::now();
+  fCacheKey = ComputeCacheKey();
+  fLoadedFromCache = false;
+  const std::string cached = FindCachedLibrary();
+  bool loaded = false;
+  if (!cached.empty()) {
+    std::cout << "Compiled model found in cache: " << cached << " . Loading it!" << std::endl;
+    fLoadedFromCache = true;
+    loaded = LoadModelLibrary(cached);
+  } else {
+    int status = 0;
+    switch (type) {
+      case 0:
+        status = TreeliteLoadXGBoostModel(fModelPath.data(), &fModel);
+        break;
+      case 1:
+        status = TreeliteLoadLightGBMModel(fModelPath.data(), &fModel);
+        break;
+      default:
+        std::cerr << "Invalid model type" << std::endl;
+        return false;
+    }
+    if (status != 0) {
+      std::cerr << "Model loading failed" << std::endl;
       return false;
+    }
+    if (!fCacheDirectory.empty() && !fCacheKey.empty()) {
+      loaded = CompileToCache();
+    } else {
+      loaded = CreateModelCode(GetUniquePath()) && CompileAndLoadModelLibrary();
+    }
   }
-  if (status != 0) {
-    std::cerr << "Model loading failed" << std::endl;
-    return false;
-  }
-  if (!CreateModelCode()) return false;
-  if (!CompileAndLoadModelLibrary()) return false;
-  return true;
+  fStartupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << "Model " << fModelName << " ready in " << fStartupTime << " s"
+    << (fLoadedFromCache ? " (from cache)" : "") << std::endl;
+  return loaded;
 }
 
 bool AliExternalBDT::LoadXGBoostModel(std::string path) {
@@ -119,7 +280,7 @@ bool AliExternalBDT::LoadLightGBMModel(std::string path) {
 }
 
 bool AliExternalBDT::LoadModelLibrary(std::string path) {
-  const int status = TreelitePredictorLoad(path.data(), 1, &fPredictor);
+  const int status = TreelitePredictorLoad(path.data(), fNThreads, &fPredictor);
   if (status != 0) {
     std::cerr << "Library loading failed" << std::endl;
     return false;
@@ -141,3 +302,31 @@ double AliExternalBDT::Predict(double *features, int size, bool useRawScore) {
       &out_size);
   return output;
 }
+
+bool AliExternalBDT::PredictBatch(const float *features, size_t nRows, int nColumns, double *output, bool useRawScore) {
+  if (nRows == 0) return true;
+  DenseBatchHandle batch;
+  if (TreeliteAssembleDenseBatch(features, NAN, nRows, static_cast<size_t>(nColumns), &batch) != 0) {
+    std::cerr << "Dense batch creation failed" << std::endl;
+    return false;
+  }
+  size_t out_size{0u};
+  if (TreelitePredictorQueryResultSize(fPredictor, batch, 0, &out_size) != 0 || out_size != nRows) {
+    std::cerr << "Batch prediction supports only models with one output per row (" << out_size << " outputs for "
+      << nRows << " rows)" << std::endl;
+    TreeliteDeleteDenseBatch(batch);
+    return false;
+  }
+  fBatchOutput.resize(out_size);
+  const int status = TreelitePredictorPredictBatch(fPredictor, batch, 0, 0, static_cast<int>(useRawScore),
+      fBatchOutput.data(), &out_size);
+  TreeliteDeleteDenseBatch(batch);
+  if (status != 0 || out_size != nRows) {
+    std::cerr << "Batch prediction failed" << std::endl;
+    return false;
+  }
+  for (size_t iRow = 0; iRow < nRows; ++iRow) {
+    output[iRow] = fBatchOutput[iRow];
+  }
+  return true;
+}
@@ -30,10 +30,34 @@ public:
   bool LoadXGBoostModel(std::string path);
 
   double Predict(double *features, int size, bool useRaw = false);
+  /// score nRows candidates stored row-major in features (nRows x nColumns)
+  /// with a single treelite batch query, results are written in output
+  bool PredictBatch(const float *features, size_t nRows, int nColumns, double *output, bool useRaw = false);
+
+  /// number of treelite worker threads used by the batch prediction,
+  /// it has to be set before loading the model
+  void SetNThreads(int nThreads) { fNThreads = nThreads > 0 ? nThreads : 1; }
+  int GetNThreads() const { return fNThreads; }
+
+  /// directory where the compiled model libraries are cached, keyed by the
+  /// hash of the model file, the treelite version and the compiler flags
+  void SetCacheDirectory(std::string dir) { fCacheDirectory = dir; }
+  /// library compiled beforehand and shipped with the configuration, it is
+  /// used only if its name is <cache key>.so
+  void SetPrecompiledLibrary(std::string path) { fPrecompiledLibrary = path; }
+
+  std::string const &GetCacheKey() const { return fCacheKey; }
+  bool IsLoadedFromCache() const { return fLoadedFromCache; }
+  /// wall time spent to load (and compile if needed) the model, in seconds
+  double GetStartupTime() const { return fStartupTime; }
 
 private:
   bool CompileAndLoadModelLibrary();
-  bool CreateModelCode();
+  bool CompileLibrary(const std::string &path);
+  bool CompileToCache();
+  std::string ComputeCacheKey() const;
+  bool CreateModelCode(const std::string &path);
+  std::string FindCachedLibrary() const;
   std::string GetUniquePath();
   bool LoadModel(const std::string &path, int type);
 
@@ -43,6 +67,14 @@ private:
   std::string fModelName;
   CompilerHandle fCompiler;
   PredictorHandle fPredictor;
+  int fNThreads;              /// Number of treelite worker threads
+  std::string fCacheDirectory;       /// Directory of the compiled model cache
+  std::string fPrecompiledLibrary;   /// Library shipped with the configuration
+  std::string fCacheKey;             /// Cache key of the loaded model
+  bool fLoadedFromCache;             /// True if the compilation was skipped
+  double fStartupTime;               /// Time spent in loading the model (s)
+
+  std::vector<float> fBatchOutput;   /// buffer for the batch prediction output
 };
 
 #endif
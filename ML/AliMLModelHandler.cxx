@@ -26,7 +26,8 @@ ClassImp(AliMLModelHandler);
 /// \endcond
 
 //_______________________________________________________________________________
-AliMLModelHandler::AliMLModelHandler() : TNamed(), fModel{nullptr}, fPath{}, fLibrary{}, fScoreCut{} {
+AliMLModelHandler::AliMLModelHandler()
+    : TNamed(), fModel{nullptr}, fPath{}, fLibrary{}, fCompiledLibrary{}, fScoreCut{} {
   //
   // Default constructor
   //
@@ -35,10 +36,13 @@ AliMLModelHandler::AliMLModelHandler() : TNamed(), fModel{nullptr}, fPath{}, fLi
 //_______________________________________________________________________________
 AliMLModelHandler::AliMLModelHandler(const YAML::Node &node)
     : TNamed(), fModel{nullptr}, fPath{node["path"].as<std::string>()},
-      fLibrary{node["library"].as<std::string>()}, fScoreCut{node["cut"].as<double>()} {
+      fLibrary{node["library"].as<std::string>()}, fCompiledLibrary{}, fScoreCut{node["cut"].as<double>()} {
   //
   // Standard constructor
   //
+  if (node["compiled"]) {
+    fCompiledLibrary = node["compiled"].as<std::string>();
+  }
   fModel = new AliExternalBDT();
 }
 
@@ -53,7 +57,7 @@ AliMLModelHandler::~AliMLModelHandler() {
 //_______________________________________________________________________________
 AliMLModelHandler::AliMLModelHandler(const AliMLModelHandler &source)
     : TNamed(source.GetName(), source.GetTitle()), fModel{nullptr}, fPath{source.fPath},
-      fLibrary{source.fLibrary}, fScoreCut{source.fScoreCut} {
+      fLibrary{source.fLibrary}, fCompiledLibrary{source.fCompiledLibrary}, fScoreCut{source.fScoreCut} {
   //
   // Copy constructor
   //
@@ -74,13 +78,14 @@ AliMLModelHandler &AliMLModelHandler::operator=(const AliMLModelHandler &source)
 
   fPath      = source.fPath;
   fLibrary   = source.fLibrary;
+  fCompiledLibrary = source.fCompiledLibrary;
   fScoreCut  = source.fScoreCut;
 
   return *this;
 }
 
 //_______________________________________________________________________________
-bool AliMLModelHandler::CompileModel() {
+bool AliMLModelHandler::CompileModel(std::string cacheDir) {
 
   std::map<std::string, int> libraryMap = {{"kXGBoost", AliMLModelHandler::kXGBoost}, 
                                            {"kLightGBM", AliMLModelHandler::kLightGBM},
@@ -88,6 +93,13 @@ bool AliMLModelHandler::CompileModel() {
 
   std::string localpath = ImportFile(fPath);
 
+  if (!cacheDir.empty()) {
+    fModel->SetCacheDirectory(cacheDir);
+  }
+  if (!fCompiledLibrary.empty()) {
+    fModel->SetPrecompiledLibrary(ImportFile(fCompiledLibrary));
+  }
+
   switch (libraryMap[GetLibrary()]) {
     case kXGBoost: {
       return fModel->LoadXGBoostModel(localpath.data());
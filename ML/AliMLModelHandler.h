@@ -38,8 +38,9 @@ public:
   std::string const &GetPath() const { return fPath; }
   std::string const &GetLibrary() const { return fLibrary; }
   double const &GetScoreCut() const { return fScoreCut; }
+  std::string const &GetCompiledLibrary() const { return fCompiledLibrary; }
 
-  bool CompileModel();
+  bool CompileModel(std::string cacheDir = "");
   static std::string ImportFile(std::string path);
 
 private:
@@ -47,11 +48,12 @@ private:
 
   std::string fPath;       ///
   std::string fLibrary;    ///
+  std::string fCompiledLibrary;    /// optional precompiled model library shipped with the config
 
   double fScoreCut;        ///
 
 /// \cond CLASSIMP
-ClassDef(AliMLModelHandler, 1);    ///
+ClassDef(AliMLModelHandler, 2);    ///
 /// \endcond
 };
 
@@ -12,8 +12,12 @@
 
 #include "AliMLResponse.h"
 
+#include <algorithm>
+
 #include "yaml-cpp/yaml.h"
 
+#include "TH2F.h"
+
 #include "AliExternalBDT.h"
 #include "AliLog.h"
 
@@ -29,7 +33,8 @@ ClassImp(AliMLResponse);
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse()
     : TNamed(), fConfigFilePath{}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{}, fNVariables{},
-      fBinsBegin{}, fRaw{} {
+      fBinsBegin{}, fRaw{}, fNThreads{1}, fModelCacheDir{}, fBatchBins{}, fBatchOffsets{}, fBatchRows{}, fBatchFeatures{},
+      fBatchScores{} {
   //
   // Default constructor
   //
@@ -38,7 +43,8 @@ AliMLResponse::AliMLResponse()
 //_______________________________________________________________________________
 AliMLResponse::AliMLResponse(const Char_t *name, const Char_t *title)
     : TNamed(name, title), fConfigFilePath{""}, fModels{}, fCentClasses{}, fBins{}, fVariableNames{}, fNBins{},
-      fNVariables{}, fBinsBegin{}, fRaw{} {
+      fNVariables{}, fBinsBegin{}, fRaw{}, fNThreads{1}, fModelCacheDir{}, fBatchBins{}, fBatchOffsets{}, fBatchRows{},
+      fBatchFeatures{}, fBatchScores{} {
   //
   // Standard constructor
   //
@@ -55,7 +61,8 @@ AliMLResponse::~AliMLResponse() {
 AliMLResponse::AliMLResponse(const AliMLResponse &source)
     : TNamed(source.GetName(), source.GetTitle()), fConfigFilePath{source.fConfigFilePath}, fModels{source.fModels},
       fCentClasses{source.fCentClasses}, fBins{source.fBins}, fVariableNames{source.fVariableNames},
-      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw} {
+      fNBins{source.fNBins}, fNVariables{source.fNVariables}, fBinsBegin{source.fBinsBegin}, fRaw{source.fRaw},
+      fNThreads{source.fNThreads}, fModelCacheDir{source.fModelCacheDir}, fBatchBins{}, fBatchOffsets{}, fBatchRows{}, fBatchFeatures{}, fBatchScores{} {
   //
   // Copy constructor
   //
@@ -78,6 +85,8 @@ AliMLResponse &AliMLResponse::operator=(const AliMLResponse &source) {
   fNVariables     = source.fNVariables;
   fBinsBegin      = source.fBinsBegin;
   fRaw            = source.fRaw;
+  fNThreads       = source.fNThreads;
+  fModelCacheDir  = source.fModelCacheDir;
 
   return *this;
 }
@@ -120,16 +129,46 @@ void AliMLResponse::CompileModels(std::string configLocalPath) {
 
   fBinsBegin = fBins.begin();
 
+  if (fModelCacheDir.empty() && nodeList["CACHE_DIR"]) {
+    fModelCacheDir = nodeList["CACHE_DIR"].as<string>();
+  }
+
   for (const auto &model : nodeList["MODELS"]) {
     fModels.push_back(AliMLModelHandler{model});
   }
 
   for (auto &model : fModels) {
-    bool comp = model.CompileModel();
+    model.GetModel()->SetNThreads(fNThreads);
+    bool comp = model.CompileModel(fModelCacheDir);
     if (!comp) {
       AliFatal("Error in model compilation! Exit");
     }
   }
+
+  double startupTime{0.};
+  int nCached{0};
+  for (auto &model : fModels) {
+    startupTime += model.GetModel()->GetStartupTime();
+    nCached += model.GetModel()->IsLoadedFromCache();
+  }
+  AliInfo(Form("%d models ready in %.1f s, %d of them loaded from the cache", (int)fModels.size(), startupTime,
+               nCached));
+}
+
+//_______________________________________________________________________________
+TH2F *AliMLResponse::GetStartupTimeHisto() {
+  TH2F *hStartup = new TH2F(Form("hMLStartupTime_%s", GetName()), ";model;", fModels.size(), 0.5,
+                            fModels.size() + 0.5, 2, 0.5, 2.5);
+  hStartup->GetYaxis()->SetBinLabel(1, "startup time (s)");
+  hStartup->GetYaxis()->SetBinLabel(2, "loaded from cache");
+  for (size_t iModel = 0; iModel < fModels.size(); ++iModel) {
+    AliExternalBDT *model = fModels[iModel].GetModel();
+    hStartup->GetXaxis()->SetBinLabel(iModel + 1, Form("model %zu", iModel));
+    hStartup->SetBinContent(iModel + 1, 1, model->GetStartupTime());
+    hStartup->SetBinContent(iModel + 1, 2, model->IsLoadedFromCache() ? 1. : 0.);
+  }
+  hStartup->SetEntries(fModels.size());
+  return hStartup;
 }
 
 //_______________________________________________________________________________
@@ -185,6 +224,79 @@ double AliMLResponse::Predict(double binvar, vector<double> variables) {
   return fModels.at(bin - 1).GetModel()->Predict(&variables[0], fNVariables, fRaw);
 }
 
+//_______________________________________________________________________________
+vector<int> AliMLResponse::GetFeatureIndices(const vector<string> &columnNames) {
+  vector<int> indices;
+  for (const auto &varname : fVariableNames) {
+    auto col = std::find(columnNames.begin(), columnNames.end(), varname);
+    if (col == columnNames.end()) {
+      AliFatal(Form("Variable |%s| not found in the column list provided! Exit", varname.data()));
+    }
+    indices.push_back(col - columnNames.begin());
+  }
+  return indices;
+}
+
+//_______________________________________________________________________________
+void AliMLResponse::PredictBatch(int nRows, int nColumns, const double *features, const double *binvars,
+                                 double *scores, const vector<int> &featureIndices, bool columnMajor) {
+  vector<int> identity;
+  const vector<int> *indices = &featureIndices;
+  if (featureIndices.empty()) {
+    if (nColumns != fNVariables) {
+      AliFatal(Form("Number of columns passed (%d) different from the one used in the model (%d)! Exit", nColumns,
+                    fNVariables));
+    }
+    for (int iVar = 0; iVar < fNVariables; ++iVar) identity.push_back(iVar);
+    indices = &identity;
+  } else if ((int)featureIndices.size() != fNVariables) {
+    AliFatal(Form("Number of feature indices passed (%d) different from the one used in the model (%d)! Exit",
+                  (int)featureIndices.size(), fNVariables));
+  }
+
+  /// counting sort of the candidates by bin, bins 0 and fNBins are the out of range ones
+  fBatchBins.resize(nRows);
+  fBatchOffsets.assign(fNBins + 2, 0);
+  int nOutside{0};
+  for (int iRow = 0; iRow < nRows; ++iRow) {
+    int bin = std::lower_bound(fBins.begin(), fBins.end(), binvars[iRow]) - fBins.begin();
+    if (bin == 0 || bin == fNBins) {
+      scores[iRow] = -999.;
+      ++nOutside;
+    }
+    fBatchBins[iRow] = bin;
+    ++fBatchOffsets[bin + 1];
+  }
+  if (nOutside > 0) {
+    AliWarning(Form("%d candidates with binned variable outside range, no model available!", nOutside));
+  }
+  for (int iBin = 0; iBin <= fNBins; ++iBin) fBatchOffsets[iBin + 1] += fBatchOffsets[iBin];
+  fBatchRows.resize(nRows);
+  vector<int> fill(fBatchOffsets.begin(), fBatchOffsets.end() - 1);
+  for (int iRow = 0; iRow < nRows; ++iRow) fBatchRows[fill[fBatchBins[iRow]]++] = iRow;
+
+  for (int iBin = 1; iBin < fNBins; ++iBin) {
+    const int first = fBatchOffsets[iBin];
+    const int nCand = fBatchOffsets[iBin + 1] - first;
+    if (nCand == 0) continue;
+    fBatchFeatures.resize(nCand * fNVariables);
+    for (int iCand = 0; iCand < nCand; ++iCand) {
+      const int row = fBatchRows[first + iCand];
+      float *dest   = &fBatchFeatures[iCand * fNVariables];
+      for (int iVar = 0; iVar < fNVariables; ++iVar) {
+        const int col = (*indices)[iVar];
+        dest[iVar]    = static_cast<float>(columnMajor ? features[col * nRows + row] : features[row * nColumns + col]);
+      }
+    }
+    fBatchScores.resize(nCand);
+    if (!fModels.at(iBin - 1).GetModel()->PredictBatch(fBatchFeatures.data(), nCand, fNVariables,
+                                                         fBatchScores.data(), fRaw)) {
+      AliFatal("Error in the batch prediction! Exit");
+    }
+    for (int iCand = 0; iCand < nCand; ++iCand) scores[fBatchRows[first + iCand]] = fBatchScores[iCand];
+  }
+}
+
 //_______________________________________________________________________________
 bool AliMLResponse::IsSelected(double binvar, std::map<std::string, double> varmap) {
   double score{0.};
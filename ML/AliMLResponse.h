@@ -23,6 +23,8 @@
 
 #include "AliMLModelHandler.h"
 
+class TH2F;
+
 namespace YAML {
 class Node;
 }
@@ -45,6 +47,13 @@ public:
   /// methods to configure the AliMLResponse object from the config file and compile the models usign treelite
   void CompileModels(std::string configLocalPath);     /// (it has to be done run time)
   void MLResponseInit();    /// (it has to be done run time)
+  /// number of treelite threads used for the batch prediction (to be set before the model compilation)
+  void SetNThreads(int nthreads) { fNThreads = nthreads; }
+  /// directory for the cache of the compiled models (overrides the CACHE_DIR entry of the config)
+  void SetModelCacheDirectory(std::string dir) { fModelCacheDir = dir; }
+  /// histogram with the startup time (s) of each model and whether it was loaded from the cache,
+  /// to be added to the task output (the caller owns it)
+  TH2F *GetStartupTimeHisto();
 
   /// return the bin index
   int FindBin(double binvar);
@@ -52,6 +61,14 @@ public:
   double Predict(double binvar, std::map<std::string, double> varmap);
   /// overload to pass directly a vector of variables
   double Predict(double binvar, std::vector<double> variables);
+  /// return the column index of each model feature in a candidate table with the given column names,
+  /// to be computed once and passed to PredictBatch so that no string lookup is done per candidate
+  std::vector<int> GetFeatureIndices(const std::vector<std::string> &columnNames);
+  /// score nRows candidates at once: the features table (nRows x nColumns, row-major unless columnMajor is set)
+  /// is grouped by bin and each group is predicted with a single call to the model. Candidates outside the
+  /// bin range get a -999 score. If featureIndices is empty the columns must follow the config variable order
+  void PredictBatch(int nRows, int nColumns, const double *features, const double *binvars, double *scores,
+                    const std::vector<int> &featureIndices = {}, bool columnMajor = false);
   /// return true if predicted score for map is above the threshold given in the config
   bool IsSelected(double binvar, std::map<std::string, double> varmap);
   /// overload for getting the model score too
@@ -75,9 +92,17 @@ protected:
   std::vector<float>::iterator fBinsBegin;    //!<!  evaluate just once is better
 
   bool fRaw;    /// set to true to use raw score instead of probability
+  int fNThreads;    /// number of treelite threads for the batch prediction
+  std::string fModelCacheDir;    /// directory of the compiled model cache
+
+  std::vector<int> fBatchBins;            //!<! bin of each candidate in the batch
+  std::vector<int> fBatchOffsets;         //!<! first position of each bin in the sorted candidate list
+  std::vector<int> fBatchRows;            //!<! candidate indices sorted by bin
+  std::vector<float> fBatchFeatures;      //!<! features of the candidates of one bin (row-major)
+  std::vector<double> fBatchScores;       //!<! scores of the candidates of one bin
 
   /// \cond CLASSIMP
-  ClassDef(AliMLResponse, 2);    ///
+  ClassDef(AliMLResponse, 4);    ///
   /// \endcond
 };
 
@@ -0,0 +1,94 @@
+#include <TFile.h>
+#include <TStopwatch.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AliExternalBDT.h"
+
+#define DELTA 1.0e-6
+
+/// Compare the throughput of the single-row and of the batched prediction
+/// on the candidates of the test tree, replicated nRepeat times
+int benchmark_AliExternalBDT(string path = "", int nRepeat = 100, int nThreads = 1) {
+
+  string tree_path, model_path;
+
+  if (path == "") {
+    tree_path  = "test_tree_pt8_12.root";
+    model_path = "test_xgboost_pt8_12.model";
+  } else {
+    tree_path  = path + "/" + "test_tree_pt8_12.root";
+    model_path = path + "/" + "test_xgboost_pt8_12.model";
+  }
+
+  const int nFeatures = 12;
+  const char *names[nFeatures] = {"delta_mass_KK", "d_len",       "norm_dl_xy",  "sig_vert",
+                                  "cos_PiKPhi_3",  "norm_IP",     "sigComb_K_0", "sigComb_K_1",
+                                  "sigComb_K_2",   "sigComb_Pi_0", "sigComb_Pi_1", "sigComb_Pi_2"};
+
+  TFile *fInput = new TFile(tree_path.data(), "READ");
+  TTreeReader fReader("tree_real_data", fInput);
+  std::vector<TTreeReaderValue<float>> fValues;
+  for (int iFeature = 0; iFeature < nFeatures; ++iFeature) {
+    fValues.emplace_back(fReader, names[iFeature]);
+  }
+
+  std::vector<double> table;
+  while (fReader.Next()) {
+    for (auto &value : fValues) {
+      table.push_back(*value);
+    }
+  }
+  fInput->Close();
+
+  const size_t nCandInFile = table.size() / nFeatures;
+  std::vector<double> features;
+  for (int iRepeat = 0; iRepeat < nRepeat; ++iRepeat) {
+    features.insert(features.end(), table.begin(), table.end());
+  }
+  const size_t nCand = nCandInFile * nRepeat;
+
+  AliExternalBDT *fBDT = new AliExternalBDT();
+  fBDT->SetNThreads(nThreads);
+  if (!fBDT->LoadXGBoostModel(model_path.data())) {
+    return 1;
+  }
+
+  std::vector<double> singleScores(nCand), batchScores(nCand);
+
+  TStopwatch timer;
+  timer.Start();
+  for (size_t iCand = 0; iCand < nCand; ++iCand) {
+    singleScores[iCand] = fBDT->Predict(&features[iCand * nFeatures], nFeatures, true);
+  }
+  timer.Stop();
+  const double singleTime = timer.RealTime();
+
+  timer.Start();
+  std::vector<float> batchFeatures(features.begin(), features.end());
+  if (!fBDT->PredictBatch(batchFeatures.data(), nCand, nFeatures, batchScores.data(), true)) {
+    return 1;
+  }
+  timer.Stop();
+  const double batchTime = timer.RealTime();
+  delete fBDT;
+
+  for (size_t iCand = 0; iCand < nCand; ++iCand) {
+    if (std::abs(singleScores[iCand] - batchScores[iCand]) > DELTA) {
+      std::cout << "BENCHMARK: Fail! Batch and single-row scores differ for candidate " << iCand << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "Candidates: " << nCand << ", threads: " << nThreads << std::endl;
+  std::cout << Form("Single-row: %.3f s (%.0f candidates/s)", singleTime, nCand / singleTime) << std::endl;
+  std::cout << Form("Batched:    %.3f s (%.0f candidates/s)", batchTime, nCand / batchTime) << std::endl;
+  std::cout << "BENCHMARK: Success!" << std::endl;
+  return 0;
+}
@@ -32,6 +32,12 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <TF1.h>
+#include <TROOT.h>
+#include <TRandom3.h>
+#include <RVersion.h>
+#include <TVirtualMutex.h>
+#include <algorithm>
+#include <thread>
 
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
@@ -172,7 +178,18 @@ AliGlauberMC::AliGlauberMC(Option_t* NA, Option_t* NB, Double_t xsect) :
   fOmega(0),
   fSig0(0),
   fLambda(0),
-  fSigFluc(0)
+  fSigFluc(0),
+  fNThreads(1),
+  fRandom(0),
+  fXA(),
+  fYA(),
+  fSigA(),
+  fXB(),
+  fYB(),
+  fSigB(),
+  fCellStart(),
+  fCellNucleons(),
+  fCandidates()
 {
   //ctor
   for (UInt_t i=0; i<(sizeof(fdNdEtaParam)/sizeof(fdNdEtaParam[0])); i++)
@@ -189,6 +206,7 @@ AliGlauberMC::~AliGlauberMC()
 {
   //dtor
   delete fnt;
+  delete fSigFluc;
 }
 
 //______________________________________________________________________________
@@ -203,7 +221,7 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fQAN(in.fQAN),
   fBN(in.fBN),
   fQBN(in.fQBN),
-  fnt(in.fnt),
+  fnt(0),
   fMeanX2(in.fMeanX2),
   fMeanY2(in.fMeanY2),
   fMeanXY(in.fMeanXY),
@@ -322,9 +340,20 @@ AliGlauberMC::AliGlauberMC(const AliGlauberMC& in):
   fOmega(in.fOmega),
   fSig0(in.fSig0),
   fLambda(in.fLambda),
-  fSigFluc(in.fSigFluc)
+  fSigFluc(in.fSigFluc ? new TF1(*in.fSigFluc) : 0),
+  fNThreads(in.fNThreads),
+  fRandom(in.fRandom),
+  fXA(),
+  fYA(),
+  fSigA(),
+  fXB(),
+  fYB(),
+  fSigB(),
+  fCellStart(),
+  fCellNucleons(),
+  fCandidates()
 {
-  //copy ctor
+  //copy ctor, the copy owns its nuclei and sigNN parameterization and books its own ntuple
   memcpy(fdNdEtaParam,in.fdNdEtaParam,sizeof(fdNdEtaParam));
 }
 
@@ -453,60 +482,125 @@ AliGlauberMC& AliGlauberMC::operator=(const AliGlauberMC& in)
   fSxyCom=in.fSxyCom;
   fX=in.fX;
   fNpp=in.fNpp;
+  fNThreads=in.fNThreads;
+  fRandom=in.fRandom;
   return *this;
 }
 
+//______________________________________________________________________________
+void AliGlauberMC::InitSigFluc()
+{
+  // parameterization of the fluctuating sigNN, created once
+  if (!fSigFluc) {
+    fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
+    fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
+    cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
+  }
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMC::ThrowSigFluc()
+{
+  // random sigNN from the fluctuation parameterization, from fRandom if set
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+  if (fRandom) return fSigFluc->GetRandom(fRandom);
+#endif
+  return fSigFluc->GetRandom();
+}
+
+//______________________________________________________________________________
+TRandom *AliGlauberMC::GetRandomGenerator() const
+{
+  return fRandom ? fRandom : gRandom;
+}
+
 //______________________________________________________________________________
 Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
 {
   // prepare event
 
-  if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-  }
+  if (fDoFluc) InitSigFluc();
 
   fANucleus.ThrowNucleons(-bgen/2.);
   fNucleonsA = fANucleus.GetNucleons();
   fAN = fANucleus.GetN();
   fQAN = fAN * 3;
   //fAN = 3 * fANucleus.GetN(); // for Pb, Number of quark = 3*208;
+  fXA.resize(fAN);
+  fYA.resize(fAN);
+  fSigA.resize(fAN);
   for (Int_t i = 0; i<fAN; i++)
   {
     AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(i));
     nucleonA->SetInNucleusA();
     nucleonA->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonA->SetSigNN(fSigFluc->GetRandom());
+      nucleonA->SetSigNN(ThrowSigFluc());
+    fXA[i] = nucleonA->GetX();
+    fYA[i] = nucleonA->GetY();
+    fSigA[i] = nucleonA->GetSigNN();
   }
   fBNucleus.ThrowNucleons(bgen/2.);
   fNucleonsB = fBNucleus.GetNucleons();
   //fBN = 3 * fBNucleus.GetN(); // Number of quark = number of nucleus*3;
   fBN = fBNucleus.GetN();
   fQBN = fBN * 3;
+  fXB.resize(fBN);
+  fYB.resize(fBN);
+  fSigB.resize(fBN);
   for (Int_t i = 0; i<fBN; i++)
   {
     AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
     nucleonB->SetInNucleusB();
     nucleonB->SetSigNN(fXSect);
     if (fDoFluc)
-      nucleonB->SetSigNN(fSigFluc->GetRandom());
+      nucleonB->SetSigNN(ThrowSigFluc());
+    fXB[i] = nucleonB->GetX();
+    fYB[i] = nucleonB->GetY();
+    fSigB[i] = nucleonB->GetSigNN();
   }
 
   if (fDoFluc) {
-    if (!fSigFluc) {
-      fSigFluc = new TF1("fSigFluc","[0]*x/[3]/(x/[3]+[1])*exp(-((x/[1]/[3]-1)/[2])^2)",0,250);
-      fSigFluc->SetParameters(1,fSig0,fOmega,fLambda);
-      cout << "Setting fluc: " << fSig0 << " " << fOmega << " " << fLambda << endl;
-    }
-    fXSect = fSigFluc->GetRandom();
+    fXSect = ThrowSigFluc();
   }
   // "ball" diameter = distance at which two balls interact
   Double_t d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
 
+  // transverse cell list of the nucleons of A, cells not smaller than the largest interaction distance:
+  // only the nucleons of A in the 3x3 cells around a nucleon of B can collide with it
+  Double_t d2Max = d2;
+  if (fDoFluc) {
+    Double_t sigMax = 0;
+    for (Int_t j = 0; j<fAN; j++) sigMax = TMath::Max(sigMax,fSigA[j]);
+    for (Int_t i = 0; i<fBN; i++) sigMax = TMath::Max(sigMax,fSigB[i]);
+    d2Max = sigMax/(TMath::Pi()*10);
+  }
+  const Int_t kMaxCells = 64;          // per dimension
+  Double_t xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+  for (Int_t j = 0; j<fAN; j++) {
+    if (j==0 || fXA[j]<xMin) xMin = fXA[j];
+    if (j==0 || fXA[j]>xMax) xMax = fXA[j];
+    if (j==0 || fYA[j]<yMin) yMin = fYA[j];
+    if (j==0 || fYA[j]>yMax) yMax = fYA[j];
+  }
+  Double_t cellSize = TMath::Sqrt(d2Max)*(1+1e-9);   // margin for the rounding in the cell index
+  cellSize = TMath::Max(cellSize,TMath::Max(xMax-xMin,yMax-yMin)/(kMaxCells-1));
+  if (!(cellSize>0)) cellSize = 1;
+  const Int_t nCellsX = Int_t((xMax-xMin)/cellSize)+1;
+  const Int_t nCellsY = Int_t((yMax-yMin)/cellSize)+1;
+  fCellStart.assign(nCellsX*nCellsY+1,0);
+  fCellNucleons.resize(fAN);
+  for (Int_t j = 0; j<fAN; j++) {
+    Int_t cell = Int_t((fXA[j]-xMin)/cellSize)*nCellsY + Int_t((fYA[j]-yMin)/cellSize);
+    ++fCellStart[cell+1];
+  }
+  for (Int_t c = 0; c<nCellsX*nCellsY; c++) fCellStart[c+1] += fCellStart[c];
+  fCandidates.assign(fCellStart.begin(),fCellStart.end()-1);   // fill position per cell
+  for (Int_t j = 0; j<fAN; j++) {
+    Int_t cell = Int_t((fXA[j]-xMin)/cellSize)*nCellsY + Int_t((fYA[j]-yMin)/cellSize);
+    fCellNucleons[fCandidates[cell]++] = j;
+  }
+
   Double_t bNN   = 0;
   Double_t Nco   = 0;
   Double_t Ncohc = 0; // hard core
@@ -514,30 +608,46 @@ Bool_t AliGlauberMC::CalcEvent(Double_t bgen)
   // for each of the A nucleons in nucleus B
   for (Int_t i = 0; i<fBN; i++)
   {
+    Double_t cx = TMath::Floor((fXB[i]-xMin)/cellSize);
+    Double_t cy = TMath::Floor((fYB[i]-yMin)/cellSize);
+    if (cx < -1 || cx > nCellsX || cy < -1 || cy > nCellsY) continue;
+    Int_t ixMin = TMath::Max(Int_t(cx)-1,0), ixMax = TMath::Min(Int_t(cx)+1,nCellsX-1);
+    Int_t iyMin = TMath::Max(Int_t(cy)-1,0), iyMax = TMath::Min(Int_t(cy)+1,nCellsY-1);
+    // candidates in increasing index, same order of the sums as the loop over all the pairs
+    fCandidates.clear();
+    for (Int_t ix = ixMin; ix<=ixMax; ix++) {
+      for (Int_t iy = iyMin; iy<=iyMax; iy++) {
+        Int_t cell = ix*nCellsY + iy;
+        fCandidates.insert(fCandidates.end(),fCellNucleons.begin()+fCellStart[cell],fCellNucleons.begin()+fCellStart[cell+1]);
+      }
+    }
+    std::sort(fCandidates.begin(),fCandidates.end());
     AliGlauberNucleon *nucleonB=(AliGlauberNucleon*)(fNucleonsB->UncheckedAt(i));
-    for (Int_t j = 0 ; j < fAN ; j++)
+    for (UInt_t k = 0 ; k < fCandidates.size() ; k++)
     {
-      AliGlauberNucleon *nucleonA=(AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j));
-      Double_t dx = nucleonB->GetX()-nucleonA->GetX();
-      Double_t dy = nucleonB->GetY()-nucleonA->GetY();
+      Int_t j = fCandidates[k];
+      Double_t dx = fXB[i]-fXA[j];
+      Double_t dy = fYB[i]-fYA[j];
       Double_t dij = dx*dx+dy*dy;
       if (fDoFluc) {
 	//fXSect = nucleonA->GetSigNN();
 	//fXSect = (nucleonA->GetSigNN()+nucleonB->GetSigNN())/2.;
-	fXSect = TMath::Max(nucleonA->GetSigNN(),nucleonB->GetSigNN());
-	d2 = (Double_t)fXSect/(TMath::Pi()*10); // in fm^2
+	d2 = TMath::Max(fSigA[j],fSigB[i])/(TMath::Pi()*10); // in fm^2
       }
       if (dij < d2)
       {
 	bNN += dij;
 	++Nco;
         nucleonB->Collide();
-        nucleonA->Collide();
+        ((AliGlauberNucleon*)(fNucleonsA->UncheckedAt(j)))->Collide();
 	if (dij<d2/4)
 	  ++Ncohc;
       }
     }
   }
+  // with fluctuations the cross section of the last pair is kept (stored in the ntuple)
+  if (fDoFluc && fAN>0 && fBN>0)
+    fXSect = TMath::Max(fSigA[fAN-1],fSigB[fBN-1]);
 
   if (Nco>0) {
     fNcollw = Ncohc;
@@ -1267,7 +1377,7 @@ Int_t AliGlauberMC::NegativeBinomialRandom(Int_t k, Double_t nmean) const
   {
     array[i] = NegativeBinomialDistribution(i,k,nmean) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandomGenerator()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 
 }
@@ -1278,7 +1388,7 @@ Int_t AliGlauberMC::NegativeBinomialRandomSV(Double_t k, Double_t nbar) const
   // negative binomial distribution generator, S. Voloshin, 09-May-2007
   Double_t sum=0.;
   Int_t i=0;
-  Double_t ran=gRandom->Rndm();
+  Double_t ran=GetRandomGenerator()->Rndm();
   Double_t trm=1./pow(1.+nbar/k,k);
   if (trm==0.)
   {
@@ -1308,7 +1418,7 @@ Int_t AliGlauberMC::DoubleNegativeBinomialRandom( Int_t k,
   {
     array[i] = alpha*NegativeBinomialDistribution(i,k,nmean)+(1-alpha)*NegativeBinomialDistribution(i,k2,nmean2) + array[i-1];
   }
-  Double_t r = gRandom->Uniform(0,1);
+  Double_t r = GetRandomGenerator()->Uniform(0,1);
   return TMath::BinarySearch(fMaxPlot,array,r)+2;
 }
 
@@ -1506,7 +1616,7 @@ Bool_t AliGlauberMC::NextEvent(Double_t bgen)
   {
     if(bgen<0||!succes) //get impactparameter
     {
-      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*gRandom->Rndm()+fBMin*fBMin);
+      bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*GetRandomGenerator()->Rndm()+fBMin*fBMin);
     }
     if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
   }
@@ -1694,87 +1804,166 @@ void AliGlauberMC::Run(Int_t nevents)
                       "Npart:Ncoll:B:MeanX:MeanY:MeanX2:MeanY2:MeanXY:VarX:VarY:VarXY:MeanXSystem:MeanYSystem:MeanXA:MeanYA:MeanXB:MeanYB:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:dNdEta:dNdEtaGBW:dNdEtaTwoNBD:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:signn:Ncollw");
     fnt->SetDirectory(0);
   }
+  Int_t q = (fNThreads > 1) ? RunParallel(nevents) : RunEvents(nevents, fnt, kTRUE);
+  Int_t u = nevents - q;
+  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+Int_t AliGlauberMC::RunEvents(Int_t nevents, TNtuple *nt, Bool_t verbose)
+{
+  // generate nevents events and fill the ntuple, returns the number of events with participants
   Int_t q = 0;
-  Int_t u = 0;
   for (Int_t i = 0; i<nevents; i++)
   {
+    if(!NextEvent()) continue;
+    q++;
+    FillNtuple(nt);
+    if (verbose && (i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+  }
+  return q;
+}
 
-    if(!NextEvent())
-    {
-      u++;
-      continue;
-    }
+//______________________________________________________________________________
+Int_t AliGlauberMC::RunParallel(Int_t nevents)
+{
+  // Generate the events with fNThreads threads. Each thread runs a copy of the generator with its own nuclei
+  // and random generator (seeded from gRandom), on a block of consecutive events. The ntuples of the threads are
+  // appended in thread order: the output is reproducible for a given gRandom seed and number of threads.
+  // ROOT::EnableThreadSafety() has to be called by the caller (see macros/runGlauberMC.C).
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+  if (!gGlobalMutex)
+  {
+    cout << "AliGlauberMC::Run: ROOT::EnableThreadSafety() not called, running in one thread" << endl;
+    return RunEvents(nevents, fnt, kTRUE);
+  }
+  if (fDoFluc) InitSigFluc(); // copied to the workers
+  const Int_t nThreads = TMath::Max(1,TMath::Min(fNThreads,nevents));
+  std::vector<AliGlauberMC*> workers(nThreads);
+  std::vector<TRandom*> generators(nThreads);
+  TString varList;
+  for (Int_t b = 0; b<fnt->GetNbranches(); b++)
+  {
+    if (b>0) varList += ":";
+    varList += fnt->GetListOfBranches()->At(b)->GetName();
+  }
+  for (Int_t t = 0; t<nThreads; t++)
+  {
+    // set up in the main thread: the copies own their TF1s and the ntuple
+    AliGlauberMC *worker = new AliGlauberMC(*this);
+    worker->fEvents = 0;
+    worker->fTotalEvents = 0;
+    worker->fnt = new TNtuple(fnt->GetName(),fnt->GetTitle(),varList);
+    worker->fnt->SetDirectory(0);
+    generators[t] = new TRandom3(1+gRandom->Integer(kMaxInt));
+    worker->SetRandom(generators[t]);
+    workers[t] = worker;
+  }
 
-    q++;
-    Float_t v[48];
-    v[0]  = GetNpart();
-    v[1]  = GetNcoll();
-    v[2]  = fBMC;
-    v[3]  = fMeanXParts;
-    v[4]  = fMeanYParts;
-    v[5]  = fMeanX2Parts;
-    v[6]  = fMeanY2Parts;
-    v[7]  = fMeanXYParts;
-    v[8]  = fSx2Parts;
-    v[9]  = fSy2Parts;
-    v[10] = fSxyParts;
-    v[11] = fMeanXSystem;
-    v[12] = fMeanYSystem;
-    v[13] = fMeanXA;
-    v[14] = fMeanYA;
-    v[15] = fMeanXB;
-    v[16] = fMeanYB;
-    v[17] = GetEccentricity();
-    v[18] = GetStoa();
-    v[19] = GetEccentricityColl();
-    v[20] = GetEccentricityCom();
-    v[21] = GetEccentricityPart();
-    v[22] = GetEccentricityPartColl();
-    v[23] = GetEccentricityPartCom();
-    if (fDoPartProd)
-    {
-      v[24] = GetdNdEta();
-      v[25] = GetdNdEta();
-      v[26] = v[24]+v[25];
-    }
-    else
+  std::vector<Int_t> accepted(nThreads,0);
+  std::vector<std::thread> threads;
+  for (Int_t t = 0; t<nThreads; t++)
+  {
+    Int_t first = Int_t(Long64_t(nevents)*t/nThreads);
+    Int_t last  = Int_t(Long64_t(nevents)*(t+1)/nThreads);
+    threads.push_back(std::thread([&workers,&accepted,t,first,last]() {
+      accepted[t] = workers[t]->RunEvents(last-first,workers[t]->fnt,kFALSE);
+    }));
+  }
+  for (UInt_t t = 0; t<threads.size(); t++) threads[t].join();
+
+  Int_t q = 0;
+  for (Int_t t = 0; t<nThreads; t++)
+  {
+    AliGlauberMC *worker = workers[t];
+    for (Long64_t i = 0; i<worker->fnt->GetEntries(); i++)
     {
-      v[24] = 0;
-      v[25] = 0;
-      v[26] = 0;
+      worker->fnt->GetEntry(i);
+      fnt->Fill(worker->fnt->GetArgs());
     }
-    v[27]=fXSect;
-
-    Float_t mytAA=-999;
-    if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
-    v[28]=mytAA;
-    //_____________epsilon2,3,4,4_______
-    v[29] = GetEpsilon2Part();
-    v[30] = GetEpsilon3Part();
-    v[31] = GetEpsilon4Part();
-    v[32] = GetEpsilon5Part();
-    v[33] = GetEpsilon2Coll();
-    v[34] = GetEpsilon3Coll();
-    v[35] = GetEpsilon4Coll();
-    v[36] = GetEpsilon5Coll();
-    v[37] = GetEpsilon2Com();
-    v[38] = GetEpsilon3Com();
-    v[39] = GetEpsilon4Com();
-    v[40] = GetEpsilon5Com();
-    v[41] = GetPsi2();
-    v[42] = GetPsi3();
-    v[43] = GetPsi4();
-    v[44] = GetPsi5();
-    v[45] = fBNN;
-    v[46] = fXSect;
-    v[47] = fNcollw;
-
-    //always at the end
-    fnt->Fill(v);
-
-    if ((i%100)==0) std::cout << "Generating Event # " << i << "... \r" << flush;
+    q += accepted[t];
+    fEvents += worker->fEvents;
+    fTotalEvents += worker->fTotalEvents;
+    if (worker->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = worker->fMaxNpartFound;
+    delete worker;
+    delete generators[t];
   }
-  std::cout << "Generating Event # " << nevents << "... \r" << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+  return q;
+#else
+  cout << "AliGlauberMC::Run: parallel generation needs ROOT >= 6.24, running in one thread" << endl;
+  return RunEvents(nevents, fnt, kTRUE);
+#endif
+}
+
+//______________________________________________________________________________
+void AliGlauberMC::FillNtuple(TNtuple *nt)
+{
+  // fill the results of the current event
+  Float_t v[48];
+  v[0]  = GetNpart();
+  v[1]  = GetNcoll();
+  v[2]  = fBMC;
+  v[3]  = fMeanXParts;
+  v[4]  = fMeanYParts;
+  v[5]  = fMeanX2Parts;
+  v[6]  = fMeanY2Parts;
+  v[7]  = fMeanXYParts;
+  v[8]  = fSx2Parts;
+  v[9]  = fSy2Parts;
+  v[10] = fSxyParts;
+  v[11] = fMeanXSystem;
+  v[12] = fMeanYSystem;
+  v[13] = fMeanXA;
+  v[14] = fMeanYA;
+  v[15] = fMeanXB;
+  v[16] = fMeanYB;
+  v[17] = GetEccentricity();
+  v[18] = GetStoa();
+  v[19] = GetEccentricityColl();
+  v[20] = GetEccentricityCom();
+  v[21] = GetEccentricityPart();
+  v[22] = GetEccentricityPartColl();
+  v[23] = GetEccentricityPartCom();
+  if (fDoPartProd)
+  {
+    v[24] = GetdNdEta();
+    v[25] = GetdNdEta();
+    v[26] = v[24]+v[25];
+  }
+  else
+  {
+    v[24] = 0;
+    v[25] = 0;
+    v[26] = 0;
+  }
+  v[27]=fXSect;
+
+  Float_t mytAA=-999;
+  if (GetNcoll()>0) mytAA=GetNcoll()/fXSect;
+  v[28]=mytAA;
+  //_____________epsilon2,3,4,4_______
+  v[29] = GetEpsilon2Part();
+  v[30] = GetEpsilon3Part();
+  v[31] = GetEpsilon4Part();
+  v[32] = GetEpsilon5Part();
+  v[33] = GetEpsilon2Coll();
+  v[34] = GetEpsilon3Coll();
+  v[35] = GetEpsilon4Coll();
+  v[36] = GetEpsilon5Coll();
+  v[37] = GetEpsilon2Com();
+  v[38] = GetEpsilon3Com();
+  v[39] = GetEpsilon4Com();
+  v[40] = GetEpsilon5Com();
+  v[41] = GetPsi2();
+  v[42] = GetPsi3();
+  v[43] = GetPsi4();
+  v[44] = GetPsi5();
+  v[45] = fBNN;
+  v[46] = fXSect;
+  v[47] = fNcollw;
+
+  //always at the end
+  nt->Fill(v);
 }
 
 //---------------------------------------------------------------------------------
@@ -16,9 +16,11 @@
 #include "AliGlauberNucleus.h"
 #include <Riostream.h>
 #include <TNamed.h>
+#include <vector>
 
 class TObjArray;
 class TNtuple;
+class TRandom;
 
 using std::cout;
 using std::endl;
@@ -100,6 +102,8 @@ public:
    void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
    void   SetDoFluc(Double_t omega, Double_t sig0, Double_t lam, Bool_t on=kTRUE) 
             {fDoFluc=on;fOmega=omega;fSig0=sig0;fLambda=lam;}
+   void   SetNumberOfThreads(Int_t n) {fNThreads = n;}
+   void   SetRandom(TRandom *rnd) {fRandom=rnd; fANucleus.SetRandom(rnd); fBNucleus.SetRandom(rnd);}
    static void       PrintVersion()         {cout << "AliGlauberMC " << Version() << endl;}
    static const char *Version()             {return "v1.2";}
    static void       RunAndSaveNtuple( Int_t n,
@@ -251,9 +255,26 @@ private:
    Double_t     fSig0;           //regularization parameter 
    Double_t     fLambda;         //lambda parameter
    TF1         *fSigFluc;        //!parameterization for fluctuating sigNN
+   Int_t        fNThreads;       //number of threads used by Run (events split in blocks, one random generator per thread)
+   TRandom     *fRandom;         //!random generator, gRandom if not set (not owned)
+   std::vector<Double_t> fXA;    //!x of the nucleons in nucleus A (current event)
+   std::vector<Double_t> fYA;    //!y of the nucleons in nucleus A
+   std::vector<Double_t> fSigA;  //!sigNN of the nucleons in nucleus A
+   std::vector<Double_t> fXB;    //!x of the nucleons in nucleus B
+   std::vector<Double_t> fYB;    //!y of the nucleons in nucleus B
+   std::vector<Double_t> fSigB;  //!sigNN of the nucleons in nucleus B
+   std::vector<Int_t> fCellStart;      //!first entry of each transverse cell in fCellNucleons
+   std::vector<Int_t> fCellNucleons;   //!nucleons of A sorted by cell
+   std::vector<Int_t> fCandidates;     //!nucleons of A in the cells around a nucleon of B
    Bool_t       CalcResults(Double_t bgen);
+   void         InitSigFluc();
+   Double_t     ThrowSigFluc();
+   TRandom     *GetRandomGenerator() const;
+   void         FillNtuple(TNtuple *nt);
+   Int_t        RunEvents(Int_t nevents, TNtuple *nt, Bool_t verbose);
+   Int_t        RunParallel(Int_t nevents);
 
-   ClassDef(AliGlauberMC,4)
+   ClassDef(AliGlauberMC,5)
 };
 
 #endif
@@ -30,6 +30,7 @@
 #include <TObjArray.h>
 #include <TF1.h>
 #include <TRandom.h>
+#include <RVersion.h>
 #include "AliGlauberNucleon.h"
 #include "AliGlauberNucleus.h"
 
@@ -49,7 +50,8 @@ AliGlauberNucleus::AliGlauberNucleus(Option_t* iname, Int_t iN, Double_t iR, Dou
   fF(0),
   fTrials(0),
   fFunction(ifunc),
-  fNucleons(NULL)
+  fNucleons(NULL),
+  fRandom(NULL)
 {
    if (fN==0) {
       cout << "Setting up nucleus " << iname << endl;
@@ -76,10 +78,11 @@ AliGlauberNucleus::AliGlauberNucleus(const AliGlauberNucleus& in):
   fMinDist(in.fMinDist),
   fF(in.fF),
   fTrials(in.fTrials),
-  fFunction(in.fFunction),
-  fNucleons(NULL)
+  fFunction(in.fFunction ? new TF1(*in.fFunction) : NULL),
+  fNucleons(NULL),
+  fRandom(in.fRandom)
 {
-  //copy ctor
+  //copy ctor, the copy owns its density function
   if (in.fNucleons)
     fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
 }
@@ -96,7 +99,9 @@ AliGlauberNucleus& AliGlauberNucleus::operator=(const AliGlauberNucleus& in)
   fMinDist=in.fMinDist;
   fF=in.fF;
   fTrials=in.fTrials;
-  fFunction=in.fFunction;
+  delete fFunction;
+  fFunction=in.fFunction ? new TF1(*in.fFunction) : NULL;
+  fRandom=in.fRandom;
   delete fNucleons;
   fNucleons=static_cast<TObjArray*>((in.fNucleons)->Clone());
   fNucleons->SetOwner();
@@ -225,9 +230,21 @@ void AliGlauberNucleus::SetW(Double_t iw)
    }
 }
 
+//______________________________________________________________________________
+Double_t AliGlauberNucleus::ThrowRadius() const
+{
+   // radius according to rho(r), from fRandom if set
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,24,0)
+   if (fRandom) return fFunction->GetRandom(fRandom);
+#endif
+   return fFunction->GetRandom();
+}
+
 //______________________________________________________________________________
 void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
 {
+   TRandom *rnd = fRandom ? fRandom : gRandom;
+
    if (fNucleons==0) {
       fNucleons=new TObjArray(fN);
       fNucleons->SetOwner();
@@ -246,9 +263,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
    Bool_t hulthen = (TString(GetName())=="dh");
    if (fN==2 && hulthen) { //special treatmeant for Hulten
 
-      Double_t r = fFunction->GetRandom()/2;
-      Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-      Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+      Double_t r = ThrowRadius()/2;
+      Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*rnd->Rndm() - 1 ;
       Double_t stheta = sqrt(1-ctheta*ctheta);
      
       AliGlauberNucleon *nucleon1=(AliGlauberNucleon*)(fNucleons->UncheckedAt(0));
@@ -270,9 +287,9 @@ void AliGlauberNucleus::ThrowNucleons(Double_t xshift)
       nucleon->Reset();
       while(1) {
          fTrials++;
-         Double_t r = fFunction->GetRandom();
-         Double_t phi = gRandom->Rndm() * 2 * TMath::Pi() ;
-         Double_t ctheta = 2*gRandom->Rndm() - 1 ;
+         Double_t r = ThrowRadius();
+         Double_t phi = rnd->Rndm() * 2 * TMath::Pi() ;
+         Double_t ctheta = 2*rnd->Rndm() - 1 ;
          Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
          Double_t x = r * stheta * cos(phi) + xshift;
          Double_t y = r * stheta * sin(phi);      
@@ -18,6 +18,7 @@
 #include <TNamed.h>
 class TObjArray;
 class TF1;
+class TRandom;
 
 class AliGlauberNucleus : public TNamed {
 private:
@@ -30,8 +31,10 @@ private:
    Int_t      fTrials;     //Store trials needed to complete nucleus
    TF1*       fFunction;   //Probability density function rho(r)
    TObjArray* fNucleons;   //Array of nucleons
+   TRandom*   fRandom;     //!Random generator, gRandom if not set (not owned)
 
    void       Lookup(Option_t* name);
+   Double_t   ThrowRadius() const;
 
 public:
    AliGlauberNucleus(Option_t* iname="Au", Int_t iN=0, Double_t iR=0, Double_t ia=0, Double_t iw=0, TF1* ifunc=0);
@@ -47,14 +50,16 @@ public:
    Double_t   GetW()             const {return fW;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
+   Double_t   GetMinDist()       const {return fMinDist;}
    void       SetN(Int_t in)           {fN=in;}
    void       SetR(Double_t ir);
    void       SetA(Double_t ia);
    void       SetW(Double_t iw);
    void       SetMinDist(Double_t min) {fMinDist=min;}
+   void       SetRandom(TRandom *rnd)  {fRandom=rnd;}
    void       ThrowNucleons(Double_t xshift=0.);
 
-   ClassDef(AliGlauberNucleus,1)
+   ClassDef(AliGlauberNucleus,2)
 };
 
 #endif
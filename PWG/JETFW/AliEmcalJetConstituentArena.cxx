@@ -0,0 +1,76 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include "AliEmcalJetConstituentArena.h"
+
+namespace PWG {
+namespace JETFW {
+
+AliEmcalJetConstituentArena::AliEmcalJetConstituentArena() :
+  fGlobalIndex(),
+  fIsCluster(),
+  fPt(),
+  fEta(),
+  fPhi(),
+  fE(),
+  fJetOffset(),
+  fJetCount()
+{
+}
+
+void AliEmcalJetConstituentArena::Clear()
+{
+  // clear() keeps the capacity of the vectors
+  fGlobalIndex.clear();
+  fIsCluster.clear();
+  fPt.clear();
+  fEta.clear();
+  fPhi.clear();
+  fE.clear();
+  fJetOffset.clear();
+  fJetCount.clear();
+}
+
+UInt_t AliEmcalJetConstituentArena::AddJet()
+{
+  fJetOffset.push_back(fGlobalIndex.size());
+  fJetCount.push_back(0);
+  return fJetOffset.size() - 1;
+}
+
+void AliEmcalJetConstituentArena::AddConstituent(Int_t globalIndex, Bool_t isCluster, Double_t pt, Double_t eta, Double_t phi, Double_t e)
+{
+  fGlobalIndex.push_back(globalIndex);
+  fIsCluster.push_back(isCluster);
+  fPt.push_back(pt);
+  fEta.push_back(eta);
+  fPhi.push_back(phi);
+  fE.push_back(e);
+  fJetCount.back()++;
+}
+
+}
+}
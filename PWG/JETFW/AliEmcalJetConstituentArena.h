@@ -0,0 +1,182 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALJETCONSTITUENTARENA_H
+#define ALIEMCALJETCONSTITUENTARENA_H
+
+#include <vector>
+#include <Rtypes.h>
+
+/**
+ * @namespace PWG
+ * @brief Basic namespace for general framework objects
+ */
+namespace PWG {
+
+/**
+ * @namespace JETFW
+ * @brief Namespace for objects belonging to the ALICE jet framework
+ * @ingroup JETFW
+ */
+namespace JETFW {
+
+/**
+ * @class AliEmcalJetConstituentArena
+ * @brief Contiguous storage of the constituents of all the jets of a jet collection
+ * @ingroup JETFW
+ *
+ * The global index, the type (particle or cluster) and the kinematics of the
+ * constituents of all the jets of an event are stored in flat arrays, jet after
+ * jet. Each jet is described by the offset and the number of its constituents
+ * in the arrays. Clear() keeps the allocated memory, so that the arena can be
+ * refilled event after event without allocations once the largest event has
+ * been seen.
+ *
+ * The constituents of a jet are accessed via a JetView, which can be used in
+ * range-based for loops:
+ *
+ * ~~~{.cxx}
+ * for (auto constituent : arena.GetJet(ijet)) {
+ *   if (constituent.IsCluster()) continue;
+ *   sum += constituent.Pt();
+ * }
+ * ~~~
+ */
+class AliEmcalJetConstituentArena {
+public:
+
+  /**
+   * @class Constituent
+   * @brief Lightweight reference to a constituent in the arena
+   */
+  class Constituent {
+  public:
+    Constituent(const AliEmcalJetConstituentArena *arena, UInt_t index) : fArena(arena), fIndex(index) {}
+
+    Int_t    GetGlobalIndex() const { return fArena->fGlobalIndex[fIndex]; }
+    Bool_t   IsCluster()      const { return fArena->fIsCluster[fIndex];   }
+    Double_t Pt()             const { return fArena->fPt[fIndex];          }
+    Double_t Eta()            const { return fArena->fEta[fIndex];         }
+    Double_t Phi()            const { return fArena->fPhi[fIndex];         }
+    Double_t E()              const { return fArena->fE[fIndex];           }
+
+  private:
+    const AliEmcalJetConstituentArena *fArena;   ///< arena holding the constituent
+    UInt_t                             fIndex;   ///< position of the constituent in the arena
+  };
+
+  /**
+   * @class ConstituentIterator
+   * @brief Forward iterator over the constituents of a jet
+   */
+  class ConstituentIterator {
+  public:
+    ConstituentIterator(const AliEmcalJetConstituentArena *arena, UInt_t index) : fArena(arena), fIndex(index) {}
+
+    Constituent          operator*()                                  const { return Constituent(fArena, fIndex); }
+    ConstituentIterator &operator++()                                       { ++fIndex; return *this;            }
+    bool                 operator!=(const ConstituentIterator &other) const { return fIndex != other.fIndex;      }
+    bool                 operator==(const ConstituentIterator &other) const { return fIndex == other.fIndex;      }
+
+  private:
+    const AliEmcalJetConstituentArena *fArena;   ///< arena holding the constituents
+    UInt_t                             fIndex;   ///< current position in the arena
+  };
+
+  /**
+   * @class JetView
+   * @brief (offset, count) view of the constituents of one jet
+   */
+  class JetView {
+  public:
+    JetView(const AliEmcalJetConstituentArena *arena, UInt_t offset, UInt_t count) : fArena(arena), fOffset(offset), fCount(count) {}
+
+    UInt_t              GetNConstituents()  const { return fCount;                                      }
+    UInt_t              GetOffset()         const { return fOffset;                                     }
+    Constituent         At(UInt_t i)        const { return Constituent(fArena, fOffset + i);            }
+    ConstituentIterator begin()             const { return ConstituentIterator(fArena, fOffset);        }
+    ConstituentIterator end()               const { return ConstituentIterator(fArena, fOffset + fCount); }
+
+  private:
+    const AliEmcalJetConstituentArena *fArena;   ///< arena holding the constituents
+    UInt_t                             fOffset;  ///< position of the first constituent of the jet
+    UInt_t                             fCount;   ///< number of constituents of the jet
+  };
+
+  AliEmcalJetConstituentArena();
+  ~AliEmcalJetConstituentArena() {}
+
+  /**
+   * @brief Remove all jets and constituents, keeping the allocated memory
+   */
+  void Clear();
+
+  /**
+   * @brief Start a new jet, the following constituents are added to it
+   * @return Index of the new jet in the arena
+   */
+  UInt_t AddJet();
+
+  /**
+   * @brief Add a constituent to the last jet
+   * @param[in] globalIndex Index of the constituent in the global index map
+   * @param[in] isCluster True for cluster constituents, false for particle constituents
+   * @param[in] pt Transverse momentum
+   * @param[in] eta Pseudorapidity
+   * @param[in] phi Azimuthal angle
+   * @param[in] e Energy
+   */
+  void AddConstituent(Int_t globalIndex, Bool_t isCluster, Double_t pt, Double_t eta, Double_t phi, Double_t e);
+
+  UInt_t   GetNJets()                      const { return fJetOffset.size();   }
+  UInt_t   GetNConstituents()              const { return fGlobalIndex.size(); }
+  JetView  GetJet(UInt_t ijet)             const { return JetView(this, fJetOffset[ijet], fJetCount[ijet]); }
+
+  /**
+   * @brief Direct access to the flat arrays, for vectorised loops
+   */
+  const Int_t    *GetGlobalIndexArray()    const { return fGlobalIndex.data(); }
+  const Double_t *GetPtArray()             const { return fPt.data();          }
+  const Double_t *GetEtaArray()            const { return fEta.data();         }
+  const Double_t *GetPhiArray()            const { return fPhi.data();         }
+  const Double_t *GetEArray()              const { return fE.data();           }
+
+private:
+  std::vector<Int_t>     fGlobalIndex;     ///< global index of the constituents
+  std::vector<Bool_t>    fIsCluster;       ///< true for cluster constituents
+  std::vector<Double_t>  fPt;              ///< transverse momentum of the constituents
+  std::vector<Double_t>  fEta;             ///< pseudorapidity of the constituents
+  std::vector<Double_t>  fPhi;             ///< azimuthal angle of the constituents
+  std::vector<Double_t>  fE;               ///< energy of the constituents
+  std::vector<UInt_t>    fJetOffset;       ///< position of the first constituent of each jet
+  std::vector<UInt_t>    fJetCount;        ///< number of constituents of each jet
+};
+
+}
+
+}
+
+#endif /* ALIEMCALJETCONSTITUENTARENA_H */
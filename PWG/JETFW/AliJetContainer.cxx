@@ -66,7 +66,10 @@ AliJetContainer::AliJetContainer():
   fGeom(0),
   fRunNumber(0),
   fTpcHolePos(0),
-  fTpcHoleWidth(0)
+  fTpcHoleWidth(0),
+  fConstituentArena(),
+  fConstituentArenaFilled(kFALSE),
+  fNDroppedArenaClusters(0)
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -110,7 +113,10 @@ AliJetContainer::AliJetContainer(const char *name):
   fGeom(0),
   fRunNumber(0),
   fTpcHolePos(0),
-  fTpcHoleWidth(0)
+  fTpcHoleWidth(0),
+  fConstituentArena(),
+  fConstituentArenaFilled(kFALSE),
+  fNDroppedArenaClusters(0)
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -163,7 +169,10 @@ AliJetContainer::AliJetContainer(EJetType_t jetType, EJetAlgo_t jetAlgo, ERecoSc
   fLocalRho(0),
   fRhoMass(0),
   fGeom(0),
-  fRunNumber(0)
+  fRunNumber(0),
+  fConstituentArena(),
+  fConstituentArenaFilled(kFALSE),
+  fNDroppedArenaClusters(0)
 {
   fBaseClassName = "AliEmcalJet";
   SetClassName("AliEmcalJet");
@@ -179,6 +188,107 @@ void AliJetContainer::SetArray(const AliVEvent *event)
   // Set jet array
 
   AliEmcalContainer::SetArray(event);
+  fConstituentArenaFilled = kFALSE;
+}
+
+/**
+ * Calls the base class method, then marks the constituent arena as out of date:
+ * it is refilled on the first access in the new event.
+ * @param event The event to be processed
+ */
+void AliJetContainer::NextEvent(const AliVEvent *event)
+{
+  AliParticleContainer::NextEvent(event);
+  fConstituentArenaFilled = kFALSE;
+}
+
+/**
+ * Access to the constituents of all the jets of the event, stored contiguously.
+ * The arena is filled on the first call in each event, with one entry per jet
+ * in the jet array (accepted or not), in the same order.
+ * @return Constituent arena of the jets of the current event
+ */
+const PWG::JETFW::AliEmcalJetConstituentArena &AliJetContainer::GetConstituentArena()
+{
+  if (!fConstituentArenaFilled) FillConstituentArena();
+  return fConstituentArena;
+}
+
+/**
+ * Access to the constituents of one jet via the constituent arena.
+ * @param i Index position of the jet in the jet array
+ * @return View of the jet constituents (empty if the index is out of range)
+ */
+PWG::JETFW::AliEmcalJetConstituentArena::JetView AliJetContainer::GetJetConstituents(Int_t i)
+{
+  const PWG::JETFW::AliEmcalJetConstituentArena &arena = GetConstituentArena();
+  if (i < 0 || i >= (Int_t)arena.GetNJets()) return PWG::JETFW::AliEmcalJetConstituentArena::JetView(&arena, 0, 0);
+  return arena.GetJet(i);
+}
+
+/**
+ * Fills the constituent arena with the constituents of all the jets in the jet array.
+ * The kinematics are taken from the AliEmcalJetConstituent objects of the jets when
+ * they were filled by the jet finder. Otherwise particles are retrieved via the global
+ * index map and clusters via the connected cluster container; cluster constituents
+ * which cannot be retrieved (not in the connected cluster container, or no cluster
+ * container connected) are left out and counted, see GetNDroppedArenaClusters.
+ */
+void AliJetContainer::FillConstituentArena()
+{
+  fConstituentArena.Clear();
+  fConstituentArenaFilled = kTRUE;
+  if (!fClArray) return;
+
+  AliTLorentzVector mom;
+  Int_t nDropped = 0;
+  const Int_t nJets = fClArray->GetEntriesFast();
+  for (Int_t ijet = 0; ijet < nJets; ijet++) {
+    fConstituentArena.AddJet();
+    const AliEmcalJet *jet = static_cast<const AliEmcalJet*>(fClArray->At(ijet));
+    if (!jet) continue;
+
+    if (jet->GetNumberOfParticleConstituents() == jet->GetNumberOfTracks()) {
+      for (const auto &part : jet->GetParticleConstituents()) {
+        fConstituentArena.AddConstituent(part.GetGlobalIndex(), kFALSE, part.Pt(), part.Eta(), part.Phi(), part.E());
+      }
+    }
+    else {
+      for (Int_t it = 0; it < jet->GetNumberOfTracks(); it++) {
+        AliVParticle *part = jet->Track(it);
+        if (!part) continue;
+        fConstituentArena.AddConstituent(jet->TrackAt(it), kFALSE, part->Pt(), part->Eta(), part->Phi(), part->E());
+      }
+    }
+
+    if (jet->GetNumberOfClusterConstituents() == jet->GetNumberOfClusters()) {
+      for (const auto &clus : jet->GetClusterConstituents()) {
+        fConstituentArena.AddConstituent(clus.GetGlobalIndex(), kTRUE, clus.Pt(), clus.Eta(), clus.Phi(), clus.E());
+      }
+    }
+    else if (fClusterContainer) {
+      for (Int_t ic = 0; ic < jet->GetNumberOfClusters(); ic++) {
+        auto local = AliClusterContainer::GetEmcalContainerIndexMap().LocalIndexFromGlobalIndex(jet->ClusterAt(ic));
+        if (local.second != fClusterContainer->GetArray() || !fClusterContainer->GetMomentum(mom, local.first)) {
+          nDropped++;
+          continue;
+        }
+        fConstituentArena.AddConstituent(jet->ClusterAt(ic), kTRUE, mom.Pt(), mom.Eta(), mom.Phi(), mom.E());
+      }
+    }
+    else {
+      nDropped += jet->GetNumberOfClusters();
+    }
+  }
+
+  if (nDropped > 0) {
+    if (fNDroppedArenaClusters == 0) {
+      AliWarning(Form("%s: %d jet cluster constituents not found in the cluster container %s, left out of the constituent arena",
+                      GetName(), nDropped, fClusterContainer ? fClusterContainer->GetName() : "(none)"));
+    }
+    AliDebug(2, Form("%s: %d jet cluster constituents left out of the constituent arena", GetName(), nDropped));
+    fNDroppedArenaClusters += nDropped;
+  }
 }
 
 /**
@@ -20,6 +20,7 @@ class AliLocalRhoParameter;
 #include "AliLog.h"
 #include "AliVEvent.h"
 #include "AliEmcalJet.h"
+#include "AliEmcalJetConstituentArena.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<AliEmcalJet, EMCALIterableContainer::operator_star_object<AliEmcalJet> > AliJetIterableContainer;
@@ -185,6 +186,7 @@ class AliJetContainer : public AliParticleContainer {
   ERecoScheme_t               GetRecombinationScheme()              const    {return fRecombinationScheme; }
 
   void                        SetArray(const AliVEvent *event);
+  void                        NextEvent(const AliVEvent *event);
   AliParticleContainer       *GetParticleContainer() const                   {return fParticleContainer;}
   AliClusterContainer        *GetClusterContainer() const                    {return fClusterContainer;}
   Double_t                    GetFractionSharedPt(const AliEmcalJet *jet, AliParticleContainer *cont2 = 0x0) const;
@@ -199,6 +201,10 @@ class AliJetContainer : public AliParticleContainer {
 
   const AliJetIterableMomentumContainer      all_momentum() const;
   const AliJetIterableMomentumContainer      accepted_momentum() const;
+
+  const PWG::JETFW::AliEmcalJetConstituentArena                &GetConstituentArena();
+  PWG::JETFW::AliEmcalJetConstituentArena::JetView              GetJetConstituents(Int_t i);
+  Long64_t                                                      GetNDroppedArenaClusters() const { return fNDroppedArenaClusters; }
 #endif
 
  protected:
@@ -235,6 +241,11 @@ class AliJetContainer : public AliParticleContainer {
   Int_t                       fRunNumber;            //!<! run number
   Double_t                    fTpcHolePos;           ///<   position(in radians) of the malfunctioning TPC sector
   Double_t                    fTpcHoleWidth;         ///<   width of the malfunctioning TPC area
+  PWG::JETFW::AliEmcalJetConstituentArena fConstituentArena; //!<! constituents of all the jets of the event
+  Bool_t                      fConstituentArenaFilled; //!<! constituent arena filled for the current event
+  Long64_t                    fNDroppedArenaClusters;  //!<! cluster constituents left out of the constituent arena (all events)
+
+  void                        FillConstituentArena();
  private:
   AliJetContainer(const AliJetContainer& obj); // copy constructor
   AliJetContainer& operator=(const AliJetContainer& other); // assignment
@@ -39,6 +39,10 @@
 #include "TArrayD.h"
 #include "THnSparse.h"
 #include "TMath.h"
+#include "TAxis.h"
+#include "TBuffer.h"
+
+#include <vector>
 
 templateClassImp(AliTHnT)
 
@@ -53,7 +57,12 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT() :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0),
+  fShardLastVars(0),
+  fShardLastBins(0)
 {
   // Constructor
 }
@@ -69,7 +78,12 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const Char_t* name, const Char_t*
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0),
+  fShardLastVars(0),
+  fShardLastBins(0)
 {
   // Constructor
 
@@ -106,7 +120,12 @@ AliTHnT<TemplateArray, TemplateType>::AliTHnT(const AliTHnT &c) :
   axisCache(0),
   fNbinsCache(0),
   fLastVars(0),
-  fLastBins(0)
+  fLastBins(0),
+  fNShards(0),
+  fShardValues(0),
+  fShardSumw2(0),
+  fShardLastVars(0),
+  fShardLastBins(0)
 {
   //
   // AliTHnT copy constructor
@@ -128,6 +147,7 @@ AliTHnT<TemplateArray, TemplateType>::~AliTHnT()
   // Destructor
   
   DeleteContainers();
+  DeleteShards();
   
   delete[] fValues;
   delete[] fSumw2;
@@ -243,6 +263,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     return 1;
   
   AliCFContainer::Merge(list);
+  
+  ReduceShards();
 
   TIterator* iter = list->MakeIterator();
   TObject* obj;
@@ -253,6 +275,8 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
     AliTHnT* entry = dynamic_cast<AliTHnT*> (obj);
     if (entry == 0) 
       continue;
+    
+    entry->ReduceShards();
 
     for (Int_t i=0; i<fNSteps; i++)
     {
@@ -282,84 +306,301 @@ Long64_t AliTHnT<TemplateArray, TemplateType>::Merge(TCollection* list)
 }
 
 template <class TemplateArray, typename TemplateType>
-void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+void AliTHnT<TemplateArray, TemplateType>::InitCache()
 {
-  // fills an entry
+  // fills the axis cache, needs to be done before filling from several threads
 
-  // fill axis cache
-  if (!axisCache)
+  axisCache = new TAxis*[fNVars];
+  fNbinsCache = new Int_t[fNVars];
+  for (Int_t i=0; i<fNVars; i++)
   {
-    axisCache = new TAxis*[fNVars];
-    fNbinsCache = new Int_t[fNVars];
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      axisCache[i] = GetAxis(i, 0);
-      fNbinsCache[i] = axisCache[i]->GetNbins();
-    }
-    
-    fLastVars = new Double_t[fNVars];
-    fLastBins = new Int_t[fNVars];
-    
-    // initial values to prevent checking for 0 below
-    for (Int_t i=0; i<fNVars; i++)
-    {
-      fLastBins[i] = axisCache[i]->FindBin(var[i]);
-      fLastVars[i] = var[i];
-    }
+    axisCache[i] = GetAxis(i, 0);
+    fNbinsCache[i] = axisCache[i]->GetNbins();
   }
   
-  // calculate global bin index
+  fLastVars = new Double_t[fNVars];
+  fLastBins = new Int_t[fNVars];
+  
+  // NaN never compares equal, i.e. the first bins are always calculated
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    fLastBins[i] = 0;
+    fLastVars[i] = TMath::QuietNaN();
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBin(const Double_t* var, Double_t* lastVars, Int_t* lastBins)
+{
+  // calculates the global bin index for the values <var>, returns -1 for under/overflow
+  // lastVars and lastBins are the caches of the last used bins (per shard)
+
   Long64_t bin = 0;
   for (Int_t i=0; i<fNVars; i++)
   {
     bin *= fNbinsCache[i];
     
     Int_t tmpBin = 0;
-    if (fLastVars[i] == var[i])
-      tmpBin = fLastBins[i];
+    if (lastVars[i] == var[i])
+      tmpBin = lastBins[i];
     else
     {
       tmpBin = axisCache[i]->FindBin(var[i]);
-      fLastBins[i] = tmpBin;
-      fLastVars[i] = var[i];
+      lastBins[i] = tmpBin;
+      lastVars[i] = var[i];
     }
     //Printf("%d", tmpBin);
 
     // under/overflow not supported
     if (tmpBin < 1 || tmpBin > fNbinsCache[i])
-      return;
+      return -1;
     
     // bins start from 0 here
     bin += tmpBin - 1;
 //     Printf("%lld", bin);
   }
+  
+  return bin;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::AddEntry(TemplateArray** values, TemplateArray** sumw2, Long64_t bin, Int_t istep, Double_t weight)
+{
+  // adds an entry to the global bin <bin> of the containers <values> and <sumw2> (of this object or of a shard)
+  
+  Bool_t verbose = (values == fValues);
 
-  if (!fValues[istep])
+  if (!values[istep])
   {
-    fValues[istep] = new TemplateArray(fNBins);
-    AliInfo(Form("Created values container for step %d", istep));
+    values[istep] = new TemplateArray(fNBins);
+    if (verbose)
+      AliInfo(Form("Created values container for step %d", istep));
   }
 
   if (weight != 1)
   {
     // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
-    if (!fSumw2[istep])
+    if (!sumw2[istep])
     {
-      fSumw2[istep] = new TemplateArray(*fValues[istep]);
-      AliInfo(Form("Created sumw2 container for step %d", istep));
+      sumw2[istep] = new TemplateArray(*values[istep]);
+      if (verbose)
+        AliInfo(Form("Created sumw2 container for step %d", istep));
     }
   }
 
-  fValues[istep]->GetArray()[bin] += weight;
-  if (fSumw2[istep])
-    fSumw2[istep]->GetArray()[bin] += weight * weight;
+  values[istep]->GetArray()[bin] += weight;
+  if (sumw2[istep])
+    sumw2[istep]->GetArray()[bin] += weight * weight;
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry
+
+  // fill axis cache
+  if (!axisCache)
+    InitCache();
   
-//   Printf("%f", fValues[istep][bin]);
+  // calculate global bin index
+  Long64_t bin = GetGlobalBin(var, fLastVars, fLastBins);
+  if (bin < 0)
+    return;
+
+  AddEntry(fValues, fSumw2, bin, istep, weight);
   
   // debug
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillN(Int_t nEntries, const Double_t *vars, const Int_t *steps, const Double_t *weights, Int_t shard)
+{
+  // fills <nEntries> entries at once
+  //   vars contains fNVars values per entry (entry after entry)
+  //   steps contains the step per entry (if 0, step 0 is filled)
+  //   weights contains the weight per entry (if 0, the weight is 1)
+  //   if shard >= 0, the private containers of this shard are filled (see FillShard)
+  // the global bin indices are calculated axis by axis for all entries before the filling
+  
+  if (nEntries <= 0)
+    return;
+
+  if (shard < -1 || shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d requested, but only %d shards exist. Call SetNShards first.", shard, fNShards));
+    return;
+  }
+
+  if (!axisCache)
+    InitCache();
+  
+  std::vector<Long64_t> bins(nEntries, 0);
+  for (Int_t i=0; i<fNVars; i++)
+  {
+    TAxis* axis = axisCache[i];
+    const Int_t nBins = fNbinsCache[i];
+    
+    if (axis->GetXbins()->fN == 0)
+    {
+      // equidistant bins: same arithmetic as TAxis::FindBin
+      const Double_t xMin = axis->GetXmin();
+      const Double_t xMax = axis->GetXmax();
+      for (Int_t n=0; n<nEntries; n++)
+      {
+        const Double_t x = vars[(Long64_t) n * fNVars + i];
+        const Int_t tmpBin = (x < xMin) ? 0 : ((x < xMax) ? 1 + Int_t(nBins * (x - xMin) / (xMax - xMin)) : nBins + 1);
+        bins[n] = (bins[n] < 0 || tmpBin < 1 || tmpBin > nBins) ? -1 : bins[n] * nBins + tmpBin - 1;
+      }
+    }
+    else
+    {
+      for (Int_t n=0; n<nEntries; n++)
+      {
+        const Int_t tmpBin = axis->FindBin(vars[(Long64_t) n * fNVars + i]);
+        bins[n] = (bins[n] < 0 || tmpBin < 1 || tmpBin > nBins) ? -1 : bins[n] * nBins + tmpBin - 1;
+      }
+    }
+  }
+  
+  TemplateArray** values = (shard >= 0) ? fShardValues[shard] : fValues;
+  TemplateArray** sumw2  = (shard >= 0) ? fShardSumw2[shard]  : fSumw2;
+  for (Int_t n=0; n<nEntries; n++)
+  {
+    if (bins[n] < 0)
+      continue;
+    AddEntry(values, sumw2, bins[n], (steps) ? steps[n] : 0, (weights) ? weights[n] : 1.);
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::SetNShards(Int_t nShards)
+{
+  // creates <nShards> private fill buffers, each one can be filled by one thread with FillShard / FillN
+  // already filled shards are added to this object first
+  // needs to be called before the threads start filling
+  
+  ReduceShards();
+  DeleteShards();
+  
+  if (!axisCache)
+    InitCache();
+
+  if (nShards <= 0)
+    return;
+  
+  fNShards = nShards;
+  fShardValues = new TemplateArray**[fNShards];
+  fShardSumw2 = new TemplateArray**[fNShards];
+  fShardLastVars = new Double_t*[fNShards];
+  fShardLastBins = new Int_t*[fNShards];
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    fShardValues[s] = new TemplateArray*[fNSteps];
+    fShardSumw2[s] = new TemplateArray*[fNSteps];
+    memset(fShardValues[s], 0, fNSteps*sizeof(TemplateArray*));
+    memset(fShardSumw2[s], 0, fNSteps*sizeof(TemplateArray*));
+    
+    fShardLastVars[s] = new Double_t[fNVars];
+    fShardLastBins[s] = new Int_t[fNVars];
+    for (Int_t i=0; i<fNVars; i++)
+    {
+      fShardLastBins[s][i] = 0;
+      fShardLastVars[s][i] = TMath::QuietNaN();
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight)
+{
+  // fills an entry into the private containers of shard <shard>
+  // different shards can be filled concurrently, one shard must only be filled by one thread at a time
+  
+  if (shard < 0 || shard >= fNShards)
+  {
+    AliFatal(Form("Shard %d requested, but only %d shards exist. Call SetNShards first.", shard, fNShards));
+    return;
+  }
+
+  Long64_t bin = GetGlobalBin(var, fShardLastVars[shard], fShardLastBins[shard]);
+  if (bin < 0)
+    return;
+
+  AddEntry(fShardValues[shard], fShardSumw2[shard], bin, istep, weight);
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::ReduceShards()
+{
+  // adds the content of the shards to this object (in the order of the shards) and resets the shards
+  
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      TemplateArray* shardValues = fShardValues[s][i];
+      TemplateArray* shardSumw2 = fShardSumw2[s][i];
+      if (!shardValues)
+        continue;
+      
+      if (!fValues[i])
+        fValues[i] = new TemplateArray(fNBins);
+      // entries filled so far have weight 1, see Fill
+      if (shardSumw2 && !fSumw2[i])
+        fSumw2[i] = new TemplateArray(*fValues[i]);
+      
+      TemplateType* target = fValues[i]->GetArray();
+      const TemplateType* source = shardValues->GetArray();
+      for (Long64_t l = 0; l<fNBins; l++)
+        target[l] += source[l];
+      
+      if (fSumw2[i])
+      {
+        // a shard without sumw2 has only been filled with weight 1
+        target = fSumw2[i]->GetArray();
+        source = (shardSumw2) ? shardSumw2->GetArray() : shardValues->GetArray();
+        for (Long64_t l = 0; l<fNBins; l++)
+          target[l] += source[l];
+      }
+      
+      delete shardValues;
+      delete shardSumw2;
+      fShardValues[s][i] = 0;
+      fShardSumw2[s][i] = 0;
+    }
+  }
+}
+
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::DeleteShards()
+{
+  // deletes the shards (without adding their content)
+  
+  for (Int_t s=0; s<fNShards; s++)
+  {
+    for (Int_t i=0; i<fNSteps; i++)
+    {
+      delete fShardValues[s][i];
+      delete fShardSumw2[s][i];
+    }
+    delete[] fShardValues[s];
+    delete[] fShardSumw2[s];
+    delete[] fShardLastVars[s];
+    delete[] fShardLastBins[s];
+  }
+  delete[] fShardValues;
+  delete[] fShardSumw2;
+  delete[] fShardLastVars;
+  delete[] fShardLastBins;
+  
+  fNShards = 0;
+  fShardValues = 0;
+  fShardSumw2 = 0;
+  fShardLastVars = 0;
+  fShardLastBins = 0;
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
@@ -448,6 +689,7 @@ void AliTHnT<TemplateArray, TemplateType>::FillParent()
 {
   // fills the information stored in the buffer in this class into the baseclass containers
   
+  ReduceShards();
   FillContainer(this);
 }
 
@@ -531,5 +773,23 @@ void AliTHnT<TemplateArray, TemplateType>::ReduceAxis()
   }
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::Streamer(TBuffer &R__b)
+{
+  // Stream an object of class AliTHnT.
+  // The shards are transient: their content is added to the object before writing
+  
+  if (R__b.IsReading())
+  {
+    DeleteShards();
+    R__b.ReadClassBuffer(AliTHnT::Class(), this);
+  }
+  else
+  {
+    ReduceShards();
+    R__b.WriteClassBuffer(AliTHnT::Class(), this);
+  }
+}
+
 template class AliTHnT<TArrayF, Float_t>;
 template class AliTHnT<TArrayD, Double_t>;
@@ -9,6 +9,10 @@
 // Use AliTHn instead of AliCFContainer and your memory consumption will be drastically reduced
 // As AliTHn derives from AliCFContainer, you can just replace your current AliCFContainer object by AliTHn
 // Once you have the merged output, call FillParent() and you can use AliCFContainer as usual
+//
+// For filling from several threads, call SetNShards(nThreads) and use FillShard(shard, ...) or FillN(..., shard)
+// with a different shard index per thread. The shards are added to the object at FillParent() / Merge() / ReduceShards()
+// and when the object is written (the filling threads must have finished by then)
 
 #include "TObject.h"
 #include "TString.h"
@@ -26,6 +30,10 @@ public:
   AliTHnBase(const Char_t* name, const Char_t* title,const Int_t nSelStep, const Int_t nVarIn, const Int_t* nBinIn) : AliCFContainer(name, title, nSelStep, nVarIn, nBinIn) { }
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void FillN(Int_t nEntries, const Double_t *vars, const Int_t *steps, const Double_t *weights = 0, Int_t shard = -1) = 0;
+  virtual void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.) = 0;
+  virtual void SetNShards(Int_t nShards) = 0;
+  virtual void ReduceShards() = 0;
   virtual void FillParent() = 0;
   virtual void FillContainer(AliCFContainer* cont) = 0;
 
@@ -48,6 +56,10 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  virtual void FillN(Int_t nEntries, const Double_t *vars, const Int_t *steps, const Double_t *weights = 0, Int_t shard = -1);
+  virtual void FillShard(Int_t shard, const Double_t *var, Int_t istep, Double_t weight=1.);
+  virtual void SetNShards(Int_t nShards);
+  virtual void ReduceShards();
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -65,7 +77,11 @@ class AliTHnT : public AliTHnBase
   
 protected:
   void Init();
+  void InitCache();
+  void DeleteShards();
   Long64_t GetGlobalBinIndex(const Int_t* binIdx);
+  Long64_t GetGlobalBin(const Double_t* var, Double_t* lastVars, Int_t* lastBins);
+  void AddEntry(TemplateArray** values, TemplateArray** sumw2, Long64_t bin, Int_t istep, Double_t weight);
   
   Long64_t fNBins;   // number of total bins
   Int_t    fNVars;   // number of variables
@@ -78,6 +94,12 @@ protected:
   Double_t* fLastVars; //! caching of last used bins (in many loops some vars are the same for a while)
   Int_t* fLastBins; //! caching of last used bins (in many loops some vars are the same for a while)
   
+  Int_t fNShards;                //! number of fill shards (0: shards not used)
+  TemplateArray*** fShardValues; //! [fNShards][fNSteps] private data containers of the shards
+  TemplateArray*** fShardSumw2;  //! [fNShards][fNSteps] private data containers of the shards
+  Double_t** fShardLastVars;     //! [fNShards] fLastVars per shard
+  Int_t** fShardLastBins;        //! [fNShards] fLastBins per shard
+  
   ClassDef(AliTHnT, 5) // THn like container
 };
 
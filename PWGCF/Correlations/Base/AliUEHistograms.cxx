@@ -25,6 +25,7 @@
 #include "AliUEHistograms.h"
 
 #include "AliCFContainer.h"
+#include "AliTHn.h"
 #include "AliBasicParticle.h"
 #include "AliVParticle.h"
 #include "AliAODTrack.h"
@@ -37,8 +38,75 @@
 #include "TMath.h"
 #include "TLorentzVector.h"
 
+#include <algorithm>
+#include <vector>
+
 ClassImp(AliUEHistograms)
 
+namespace
+{
+  // TObject bit used to flag resonance daughters in FillCorrelations
+  const UInt_t kResonanceDaughterFlag = 1 << 14;
+  
+  // structure-of-arrays copy of the particle properties used in the pair loop of FillCorrelations
+  // the values are stored with the same precision with which they enter the object-based loop
+  struct AliUEParticleSoA
+  {
+    std::vector<Double_t> fPt;          // Pt()
+    std::vector<Double_t> fPhi;         // Phi()
+    std::vector<Float_t>  fPtF;         // Pt() in single precision (inv mass and two-track cut)
+    std::vector<Float_t>  fPhiF;        // Phi() in single precision (inv mass and two-track cut)
+    std::vector<Float_t>  fEta;         // Eta()
+    std::vector<Int_t>    fCharge;      // Charge()
+    std::vector<Float_t>  fChargeF;     // Charge() as float (two-track cut)
+    std::vector<UInt_t>   fUniqueID;    // TObject unique ID (AliBasicParticle::IsEqual)
+    std::vector<Long64_t> fEventIndex;  // AliBasicParticle event index
+    std::vector<Double_t> fASinMin;     // ASin(0.075 * r / pt) at the minimum radius of the two-track cut
+    std::vector<Double_t> fASinMax;     // ASin(0.075 * r / pt) at the maximum radius of the two-track cut
+    std::vector<Double_t> fEfficiency;  // efficiency correction factor
+    std::vector<UChar_t>  fFlags;       // resonance daughter flag
+    Bool_t fBasic;                      // all particles are AliBasicParticles (not derived)
+    
+    void Fill(TObjArray* array, Bool_t needEventIndex, Float_t minRadius)
+    {
+      Int_t n = array->GetEntriesFast();
+      fPt.resize(n); fPhi.resize(n); fPtF.resize(n); fPhiF.resize(n); fEta.resize(n);
+      fCharge.resize(n); fChargeF.resize(n); fUniqueID.resize(n); fEventIndex.resize(n);
+      fASinMin.resize(n); fASinMax.resize(n); fEfficiency.assign(n, 1); fFlags.assign(n, 0);
+      fBasic = kTRUE;
+      
+      for (Int_t i=0; i<n; i++)
+      {
+        AliVParticle* particle = (AliVParticle*) array->UncheckedAt(i);
+        fPt[i] = particle->Pt();
+        fPhi[i] = particle->Phi();
+        fEta[i] = particle->Eta();
+        fCharge[i] = particle->Charge();
+        fUniqueID[i] = particle->GetUniqueID();
+        if (particle->IsA() != AliBasicParticle::Class())
+          fBasic = kFALSE;
+        if (needEventIndex)
+        {
+          AliBasicParticle* particleBasic = dynamic_cast<AliBasicParticle*>(particle);
+          if (!particleBasic)
+            AliFatalGeneral("AliUEHistograms", "If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+          fEventIndex[i] = particleBasic->GetEventIndex();
+        }
+      }
+      
+      // derived quantities, no virtual calls: vectorizable
+      for (Int_t i=0; i<n; i++)
+      {
+        fPtF[i] = fPt[i];
+        fPhiF[i] = fPhi[i];
+        fChargeF[i] = fCharge[i];
+        fASinMin[i] = TMath::ASin(0.075 * minRadius / fPtF[i]);
+        fASinMax[i] = TMath::ASin(0.075 * (Float_t) 2.5 / fPtF[i]);
+      }
+    }
+  };
+}
+
 const Int_t AliUEHistograms::fgkUEHists = 3;
 
 AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const char* binning) : 
@@ -85,6 +153,7 @@ AliUEHistograms::AliUEHistograms(const char* name, const char* histograms, const
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fUseSoAKernels(kTRUE),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -266,6 +335,7 @@ AliUEHistograms::AliUEHistograms(const AliUEHistograms &c) :
   fPtOrder(kTRUE),
   fTwoTrackCutMinRadius(0.8),
   fCheckEventNumberInCorrelation(kFALSE),
+  fUseSoAKernels(kTRUE),
   fRunNumber(0),
   fMergeCount(1)
 {
@@ -565,6 +635,282 @@ void AliUEHistograms::Fill(AliVParticle* leadingMC, AliVParticle* leadingReco)
   }
 }
 
+//____________________________________________________________________
+void AliUEHistograms::CreateTwoTrackHistograms()
+{
+  // creates the control histograms of the two-track efficiency cut
+
+  // do not add this hists to the directory
+  Bool_t oldStatus = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(kFALSE);
+
+  fTwoTrackDistancePt[0] = new TH3F("fTwoTrackDistancePt[0]", ";#Delta#eta;#Delta#varphi^{*}_{min};#Delta p_{T}", 100, -0.15, 0.15, 100, -0.05, 0.05, 20, 0, 10);
+  fTwoTrackDistancePt[1] = (TH3F*) fTwoTrackDistancePt[0]->Clone("fTwoTrackDistancePt[1]");
+
+  TH1::AddDirectory(oldStatus);
+}
+
+//____________________________________________________________________
+Bool_t AliUEHistograms::AcceptTrigger(Float_t eta, Int_t charge) const
+{
+  // trigger particle selection of FillCorrelations
+
+  if (fTriggerRestrictEta > 0 && TMath::Abs(eta) > fTriggerRestrictEta)
+    return kFALSE;
+
+  if (fOnlyOneEtaSide != 0)
+  {
+    if (fOnlyOneEtaSide * eta < 0)
+      return kFALSE;
+  }
+
+  if (fTriggerSelectCharge != 0)
+    if (charge * fTriggerSelectCharge < 0)
+      return kFALSE;
+
+  return kTRUE;
+}
+
+//____________________________________________________________________
+Bool_t AliUEHistograms::AcceptPair(Float_t triggerEta, Double_t triggerPt, Int_t triggerCharge, Float_t eta, Double_t pt, Int_t charge) const
+{
+  // pair selections of FillCorrelations which do not fill histograms
+  // written without branches, so that it can be evaluated for many associated particles in one loop
+
+  Int_t chargeProduct = charge * triggerCharge;
+
+  Bool_t ok = kTRUE;
+  ok &= !(fPtOrder && pt >= triggerPt);
+  ok &= !(fAssociatedSelectCharge != 0 && charge * fAssociatedSelectCharge < 0);
+  ok &= !(fSelectCharge == 1 && chargeProduct > 0); // skip like sign
+  ok &= !(fSelectCharge == 2 && chargeProduct < 0); // skip unlike sign
+  ok &= !(fOnlyOneAssocEtaSide != 0 && fOnlyOneAssocEtaSide * eta < 0);
+  ok &= !(fEtaOrdering && triggerEta < 0 && eta < triggerEta);
+  ok &= !(fEtaOrdering && triggerEta > 0 && eta > triggerEta);
+  return ok;
+}
+
+//____________________________________________________________________
+void AliUEHistograms::GetResonanceHypothesis(Double_t& resonanceMass, Double_t& massDaughter1, Double_t& massDaughter2) const
+{
+  // masses used to identify the resonance daughters rejected with fRejectResonanceDaughters
+
+  switch (fRejectResonanceDaughters)
+  {
+    case 1: resonanceMass = 1.2; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // method test
+    case 2: resonanceMass = 0.4976; massDaughter1 = 0.1396; massDaughter2 = massDaughter1; break; // k0
+    case 3: resonanceMass = 1.115; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // lambda
+    default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
+  }
+}
+
+//____________________________________________________________________
+Bool_t AliUEHistograms::IsResonanceDaughterPair(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Double_t resonanceMass, Double_t massDaughter1, Double_t massDaughter2)
+{
+  // returns kTRUE if the pair is a candidate of the resonance given by GetResonanceHypothesis
+
+  const Double_t interval = 0.02;
+
+  Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, massDaughter1, massDaughter2);
+
+  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
+  {
+    mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, massDaughter1, massDaughter2);
+
+    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
+      return kTRUE;
+  }
+
+  return kFALSE;
+}
+
+//____________________________________________________________________
+Bool_t AliUEHistograms::RejectResonancePair(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2)
+{
+  // cuts on conversions and resonances, to be called for unlike-sign pairs only
+  // fills fControlConvResoncances and returns kTRUE if the pair is rejected
+
+  // conversions
+  if (fCutConversionsV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.510e-3, 0.510e-3);
+
+    if (mass < fCutConversionsV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.510e-3, 0.510e-3);
+
+      fControlConvResoncances->Fill(0.0, mass);
+
+      if (mass < fCutConversionsV*fCutConversionsV)
+        return kTRUE;
+    }
+  }
+
+  // K0s
+  if (fCutK0sV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+
+    const Float_t kK0smass = 0.4976;
+
+    if (TMath::Abs(mass - kK0smass*kK0smass) < fCutK0sV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+
+      fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
+
+      if (mass > (kK0smass-fCutK0sV)*(kK0smass-fCutK0sV) && mass < (kK0smass+fCutK0sV)*(kK0smass+fCutK0sV))
+        return kTRUE;
+    }
+  }
+
+  // Lambda
+  if (fCutLambdaV > 0)
+  {
+    Float_t mass1 = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.9383);
+    Float_t mass2 = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.9383, 0.1396);
+
+    const Float_t kLambdaMass = 1.115;
+
+    if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
+    {
+      mass1 = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.9383);
+
+      fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
+
+      if (mass1 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass1 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
+        return kTRUE;
+    }
+    if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
+    {
+      mass2 = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.9383, 0.1396);
+
+      fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
+
+      if (mass2 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass2 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
+        return kTRUE;
+    }
+  }
+
+  // Phi
+  if (fCutPhiV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.4937, 0.4937);
+
+    const Float_t kPhimass = 1.019;
+
+    if (TMath::Abs(mass - kPhimass*kPhimass) < fCutPhiV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.4937, 0.4937);
+
+      fControlConvResoncances->Fill(3, mass - kPhimass*kPhimass);
+
+      if (mass > (kPhimass-fCutPhiV)*(kPhimass-fCutPhiV) && mass < (kPhimass+fCutPhiV)*(kPhimass+fCutPhiV))
+        return kTRUE;
+    }
+  }
+
+  // Rho
+  if (fCutRhoV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+
+    const Float_t kRhomass = 0.770;
+
+    if (TMath::Abs(mass - kRhomass*kRhomass) < fCutRhoV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, 0.1396, 0.1396);
+
+      fControlConvResoncances->Fill(4, mass - kRhomass*kRhomass);
+
+      if (mass > (kRhomass-fCutRhoV)*(kRhomass-fCutRhoV) && mass < (kRhomass+fCutRhoV)*(kRhomass+fCutRhoV))
+        return kTRUE;
+    }
+  }
+
+  // User-defined cut
+  if (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0)
+  {
+    Float_t mass = GetInvMassSquaredCheap(pt1, eta1, phi1, pt2, eta2, phi2, fCutCustomFirst, fCutCustomSecond);
+
+    if (TMath::Abs(mass - fCutCustomMass*fCutCustomMass) < fCutCustomV * 5)
+    {
+      mass = GetInvMassSquared(pt1, eta1, phi1, pt2, eta2, phi2, fCutCustomFirst, fCutCustomSecond);
+
+      fControlConvResoncances->Fill(5, mass - fCutCustomMass*fCutCustomMass);
+
+      if (mass > (fCutCustomMass-fCutCustomV)*(fCutCustomMass-fCutCustomV) && mass < (fCutCustomMass+fCutCustomV)*(fCutCustomMass+fCutCustomV))
+        return kTRUE;
+    }
+  }
+
+  return kFALSE;
+}
+
+//____________________________________________________________________
+Bool_t AliUEHistograms::RejectTwoTrackPair(Float_t deta, Float_t dphistar1, Float_t dphistar2, Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t bSign, Float_t twoTrackEfficiencyCutValue)
+{
+  // two-track efficiency cut, to be called for pairs with |deta| < twoTrackEfficiencyCutValue * 2.5 * 3
+  // dphistar1 and dphistar2 are dphi* at fTwoTrackCutMinRadius and at 2.5 m
+  // fills fTwoTrackDistancePt and returns kTRUE if the pair is rejected
+  //
+  // the variables & cuthave been developed by the HBT group
+  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+
+  const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
+
+  // check first boundaries to see if is worth to loop and find the minimum
+  if (!(TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0))
+    return kFALSE;
+
+  Float_t dphistarminabs = 1e5;
+  Float_t dphistarmin = 1e5;
+  for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01)
+  {
+    Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
+
+    Float_t dphistarabs = TMath::Abs(dphistar);
+
+    if (dphistarabs < dphistarminabs)
+    {
+      dphistarmin = dphistar;
+      dphistarminabs = dphistarabs;
+    }
+  }
+
+  fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+
+  if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
+    return kTRUE;
+
+  fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
+
+  return kFALSE;
+}
+
+//____________________________________________________________________
+Double_t AliUEHistograms::WrapDeltaPhi(Double_t dphi)
+{
+  // moves delta phi into the range -pi/2 ... 3/2 pi
+
+  dphi = (dphi > 1.5 * TMath::Pi()) ? dphi - TMath::TwoPi() : dphi;
+  dphi = (dphi < -0.5 * TMath::Pi()) ? dphi + TMath::TwoPi() : dphi;
+  return dphi;
+}
+
+//____________________________________________________________________
+Double_t AliUEHistograms::GetEfficiencyCorrection(THnF* correction, Double_t eta, Double_t pt, Double_t centrality, Double_t zVtx)
+{
+  // returns the efficiency correction factor for a particle
+
+  Int_t effVars[4];
+  effVars[0] = correction->GetAxis(0)->FindBin(eta);
+  effVars[1] = correction->GetAxis(1)->FindBin(pt);
+  effVars[2] = correction->GetAxis(2)->FindBin(centrality);
+  effVars[3] = correction->GetAxis(3)->FindBin(zVtx);
+  return correction->GetBinContent(effVars);
+}
+
 //____________________________________________________________________
 void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency)
 {
@@ -574,513 +920,514 @@ void AliUEHistograms::FillCorrelations(Double_t centrality, Float_t zVtx, AliUEH
   //
   // if mixed is non-0, mixed events are filled, the trigger particle is from particles, the associated from mixed
   // if weight < 0, then the pt of the associated particle is filled as weight
+  //
+  // by default the pair loop runs on structure-of-arrays copies of the particles (FillCorrelationsSoA),
+  // SetUseSoAKernels(kFALSE) switches to the object-based loop (FillCorrelationsReference). Both give the same output.
+  // The selections are shared by the two loops (AcceptTrigger, AcceptPair, RejectResonancePair, RejectTwoTrackPair, ...)
+
+  if (twoTrackEfficiencyCut && !fTwoTrackDistancePt[0])
+    CreateTwoTrackHistograms();
+
+  // if particles is not set, just fill event statistics
+  if (particles)
+  {
+    if (fUseSoAKernels)
+      FillCorrelationsSoA(centrality, zVtx, step, particles, mixed, weight, firstTime, twoTrackEfficiencyCut, bSign, twoTrackEfficiencyCutValue, applyEfficiency);
+    else
+      FillCorrelationsReference(centrality, zVtx, step, particles, mixed, weight, firstTime, twoTrackEfficiencyCut, bSign, twoTrackEfficiencyCutValue, applyEfficiency);
+  }
+
+  fCentralityDistribution->Fill(centrality);
+  fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
+  FillEvent(centrality, step);
+}
+
+//____________________________________________________________________
+void AliUEHistograms::FillCorrelationsReference(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency)
+{
+  // object-based pair loop of FillCorrelations, see there for the arguments
   
   Bool_t fillpT = kFALSE;
   if (weight < 0)
     fillpT = kTRUE;
   
-  if (twoTrackEfficiencyCut && !fTwoTrackDistancePt[0])
-  {
-    // do not add this hists to the directory
-    Bool_t oldStatus = TH1::AddDirectoryStatus();
-    TH1::AddDirectory(kFALSE);
-
-    fTwoTrackDistancePt[0] = new TH3F("fTwoTrackDistancePt[0]", ";#Delta#eta;#Delta#varphi^{*}_{min};#Delta p_{T}", 100, -0.15, 0.15, 100, -0.05, 0.05, 20, 0, 10);
-    fTwoTrackDistancePt[1] = (TH3F*) fTwoTrackDistancePt[0]->Clone("fTwoTrackDistancePt[1]");
-
-    TH1::AddDirectory(oldStatus);
-  }
-
   // Eta() is extremely time consuming, therefore cache it for the inner loop here:
   TObjArray* input = (mixed) ? mixed : particles;
   TArrayF eta(input->GetEntriesFast());
   for (Int_t i=0; i<input->GetEntriesFast(); i++)
     eta[i] = ((AliVParticle*) input->UncheckedAt(i))->Eta();
   
-  // if particles is not set, just fill event statistics
-  if (particles)
-  {
-    Int_t jMax = particles->GetEntriesFast();
-    if (mixed)
-      jMax = mixed->GetEntriesFast();
+  Int_t jMax = particles->GetEntriesFast();
+  if (mixed)
+    jMax = mixed->GetEntriesFast();
     
-    TH1* triggerWeighting = 0;
-    if (fWeightPerEvent)
+  TH1* triggerWeighting = 0;
+  if (fWeightPerEvent)
+  {
+    TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
+    triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
+  
+    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
-      TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
-      triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
+      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+      
+      if (!AcceptTrigger(triggerParticle->Eta(), triggerParticle->Charge()))
+	continue;
+      
+      triggerWeighting->Fill(triggerParticle->Pt());
+    }
+  }
     
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-      {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
-	
-	// some optimization
-	Float_t triggerEta = triggerParticle->Eta();
-
-	if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
-	  continue;
+  // identify K, Lambda candidates and flag those particles
+  // a TObject bit is used for this
+  if (fRejectResonanceDaughters > 0)
+  {
+    Double_t resonanceMass = -1;
+    Double_t massDaughter1 = -1;
+    Double_t massDaughter2 = -1;
+    GetResonanceHypothesis(resonanceMass, massDaughter1, massDaughter2);
 
-	if (fOnlyOneEtaSide != 0)
-	{
-	  if (fOnlyOneEtaSide * triggerEta < 0)
-	    continue;
-	}
-	
-	if (fTriggerSelectCharge != 0)
-	  if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
-	    continue;
-	
-	triggerWeighting->Fill(triggerParticle->Pt());
-      }
-    }
+    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+      particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
+    if (mixed)
+      for (Int_t i=0; i<jMax; i++)
+	mixed->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
     
-    // identify K, Lambda candidates and flag those particles
-    // a TObject bit is used for this
-    const UInt_t kResonanceDaughterFlag = 1 << 14;
-    if (fRejectResonanceDaughters > 0)
+    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
     {
-      Double_t resonanceMass = -1;
-      Double_t massDaughter1 = -1;
-      Double_t massDaughter2 = -1;
-      const Double_t interval = 0.02;
+      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
       
-      switch (fRejectResonanceDaughters)
+      for (Int_t j=0; j<jMax; j++)
       {
-	case 1: resonanceMass = 1.2; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // method test
-	case 2: resonanceMass = 0.4976; massDaughter1 = 0.1396; massDaughter2 = massDaughter1; break; // k0
-	case 3: resonanceMass = 1.115; massDaughter1 = 0.1396; massDaughter2 = 0.9383; break; // lambda
-	default: AliFatal(Form("Invalid setting %d", fRejectResonanceDaughters));
-      }
-
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-	particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
-      if (mixed)
-	for (Int_t i=0; i<jMax; i++)
-	  mixed->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
+	if (!mixed && i == j)
+	  continue;
       
-      for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-      {
-	AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+	AliVParticle* particle = 0;
+	if (!mixed)
+	  particle = (AliVParticle*) particles->UncheckedAt(j);
+	else
+	  particle = (AliVParticle*) mixed->UncheckedAt(j);
 	
-	for (Int_t j=0; j<jMax; j++)
+	// check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
+	if (fCheckEventNumberInCorrelation)
 	{
-	  if (!mixed && i == j)
-	    continue;
-	
-	  AliVParticle* particle = 0;
-	  if (!mixed)
-	    particle = (AliVParticle*) particles->UncheckedAt(j);
-	  else
-	    particle = (AliVParticle*) mixed->UncheckedAt(j);
-	  
-	  // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
-	  if (fCheckEventNumberInCorrelation)
+	  AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
+	  AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
+	  if(!triggerParticleBasic || !particleBasic)
 	  {
-	    AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-	    AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-	    if(!triggerParticleBasic || !particleBasic)
-	    {
-	      AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-	      continue;
-	    }
-	
-	    if(triggerParticleBasic->IsInSameEvent(particleBasic))
-	      continue;
-	  }
-	  else if (mixed && triggerParticle->IsEqual(particle))
+	    AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
 	    continue;
-	  
-	  if (triggerParticle->Charge() * particle->Charge() > 0)
-	    continue;
-      
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
-	      
-	  if (TMath::Abs(mass - resonanceMass*resonanceMass) < interval*5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), massDaughter1, massDaughter2);
-
-	    if (mass > (resonanceMass-interval)*(resonanceMass-interval) && mass < (resonanceMass+interval)*(resonanceMass+interval))
-	    {
-	      triggerParticle->SetBit(kResonanceDaughterFlag);
-	      particle->SetBit(kResonanceDaughterFlag);
-	      
-// 	      Printf("Flagged %d %d %f", i, j, TMath::Sqrt(mass));
-	    }
 	  }
+      
+	  if(triggerParticleBasic->IsInSameEvent(particleBasic))
+	    continue;
+	}
+	else if (mixed && triggerParticle->IsEqual(particle))
+	  continue;
+	
+	if (triggerParticle->Charge() * particle->Charge() > 0)
+	  continue;
+    
+	if (IsResonanceDaughterPair(triggerParticle->Pt(), triggerParticle->Eta(), triggerParticle->Phi(), particle->Pt(), particle->Eta(), particle->Phi(), resonanceMass, massDaughter1, massDaughter2))
+	{
+	  triggerParticle->SetBit(kResonanceDaughterFlag);
+	  particle->SetBit(kResonanceDaughterFlag);
 	}
       }
     }
+  }
     
-    for (Int_t i=0; i<particles->GetEntriesFast(); i++)
-    {
-      AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+  for (Int_t i=0; i<particles->GetEntriesFast(); i++)
+  {
+    AliVParticle* triggerParticle = (AliVParticle*) particles->UncheckedAt(i);
+    
+    // some optimization
+    Float_t triggerEta = triggerParticle->Eta();
+    
+    if (!AcceptTrigger(triggerEta, triggerParticle->Charge()))
+      continue;
       
-      // some optimization
-      Float_t triggerEta = triggerParticle->Eta();
+    if (fRejectResonanceDaughters > 0)
+      if (triggerParticle->TestBit(kResonanceDaughterFlag))
+	continue;
       
-      if (fTriggerRestrictEta > 0 && TMath::Abs(triggerEta) > fTriggerRestrictEta)
+    for (Int_t j=0; j<jMax; j++)
+    {
+      if (!mixed && i == j)
 	continue;
-
-      if (fOnlyOneEtaSide != 0)
+    
+      AliVParticle* particle = 0;
+      if (!mixed)
+	particle = (AliVParticle*) particles->UncheckedAt(j);
+      else
+	particle = (AliVParticle*) mixed->UncheckedAt(j);
+      
+      // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
+      if (fCheckEventNumberInCorrelation)
       {
-	if (fOnlyOneEtaSide * triggerEta < 0)
+	AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
+	AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
+	if(!triggerParticleBasic || !particleBasic)
+	  AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
+    
+	if(triggerParticleBasic->IsInSameEvent(particleBasic))
 	  continue;
       }
+      else if (mixed && triggerParticle->IsEqual(particle))
+	continue;
       
-      if (fTriggerSelectCharge != 0)
-	if (triggerParticle->Charge() * fTriggerSelectCharge < 0)
-	  continue;
-	
+      if (!AcceptPair(triggerEta, triggerParticle->Pt(), triggerParticle->Charge(), eta[j], particle->Pt(), particle->Charge()))
+	continue;
+
       if (fRejectResonanceDaughters > 0)
-	if (triggerParticle->TestBit(kResonanceDaughterFlag))
-	{
-// 	  Printf("Skipped i=%d", i);
+	if (particle->TestBit(kResonanceDaughterFlag))
 	  continue;
-	}
-	
-      for (Int_t j=0; j<jMax; j++)
-      {
-        if (!mixed && i == j)
-          continue;
-      
-        AliVParticle* particle = 0;
-        if (!mixed)
-          particle = (AliVParticle*) particles->UncheckedAt(j);
-        else
-          particle = (AliVParticle*) mixed->UncheckedAt(j);
-        
-        // check if both particles point to the same element (does not occur for mixed events, but if subsets are mixed within the same event)
-        if (fCheckEventNumberInCorrelation)
-        {
-          AliBasicParticle* triggerParticleBasic = dynamic_cast<AliBasicParticle*>(triggerParticle);
-          AliBasicParticle* particleBasic        = dynamic_cast<AliBasicParticle*>(particle);
-          if(!triggerParticleBasic || !particleBasic)
-            AliFatal("If fCheckEventNumberInCorrelation is set, particle must be derived from AliBasicParticle");
-      
-          if(triggerParticleBasic->IsInSameEvent(particleBasic))
-            continue;
-        }
-        else if (mixed && triggerParticle->IsEqual(particle))
-          continue;
-        
-        if (fPtOrder)
-	  if (particle->Pt() >= triggerParticle->Pt())
-	    continue;
-	
-	if (fAssociatedSelectCharge != 0)
-	  if (particle->Charge() * fAssociatedSelectCharge < 0)
-	    continue;
 
-        if (fSelectCharge > 0)
-        {
-          // skip like sign
-          if (fSelectCharge == 1 && particle->Charge() * triggerParticle->Charge() > 0)
-            continue;
-            
-          // skip unlike sign
-          if (fSelectCharge == 2 && particle->Charge() * triggerParticle->Charge() < 0)
-            continue;
-        }
-        
-        if (fOnlyOneAssocEtaSide != 0)
-          if (fOnlyOneAssocEtaSide * eta[j] < 0)
-            continue;
-
-	if (fEtaOrdering)
-	{
-	  if (triggerEta < 0 && eta[j] < triggerEta)
-	    continue;
-	  if (triggerEta > 0 && eta[j] > triggerEta)
-	    continue;
-	}
-
-	if (fRejectResonanceDaughters > 0)
-	  if (particle->TestBit(kResonanceDaughterFlag))
-	  {
-// 	    Printf("Skipped j=%d", j);
-	    continue;
-	  }
+      // conversions and resonances
+      if (particle->Charge() * triggerParticle->Charge() < 0)
+	if (RejectResonancePair(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi()))
+	  continue;
 
-	// conversions
-	if (fCutConversionsV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+      if (twoTrackEfficiencyCut)
+      {
+	Float_t phi1 = triggerParticle->Phi();
+	Float_t pt1 = triggerParticle->Pt();
+	Float_t charge1 = triggerParticle->Charge();
 	  
-	  if (mass < fCutConversionsV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.510e-3, 0.510e-3);
+	Float_t phi2 = particle->Phi();
+	Float_t pt2 = particle->Pt();
+	Float_t charge2 = particle->Charge();
 	    
-	    fControlConvResoncances->Fill(0.0, mass);
-
-	    if (mass < fCutConversionsV*fCutConversionsV) 
-	      continue;
-	  }
-	}
-	
-	// K0s
-	if (fCutK0sV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	  
-	  const Float_t kK0smass = 0.4976;
-	  
-	  if (TMath::Abs(mass - kK0smass*kK0smass) < fCutK0sV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
+	Float_t deta = triggerEta - eta[j];
 	    
-	    fControlConvResoncances->Fill(1, mass - kK0smass*kK0smass);
-
-	    if (mass > (kK0smass-fCutK0sV)*(kK0smass-fCutK0sV) && mass < (kK0smass+fCutK0sV)*(kK0smass+fCutK0sV))
-	      continue;
-	  }
-	}
-
-	// Lambda
-	if (fCutLambdaV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
+	// optimization
+	if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	{
-	  Float_t mass1 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-	  Float_t mass2 = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
+	  Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
+	  Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
 	  
-	  const Float_t kLambdaMass = 1.115;
-
-	  if (TMath::Abs(mass1 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
-	  {
-	    mass1 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.9383);
-
-	    fControlConvResoncances->Fill(2, mass1 - kLambdaMass*kLambdaMass);
-	    
-	    if (mass1 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass1 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
-	      continue;
-	  }
-	  if (TMath::Abs(mass2 - kLambdaMass*kLambdaMass) < fCutLambdaV * 5)
-	  {
-	    mass2 = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.9383, 0.1396);
-
-	    fControlConvResoncances->Fill(2, mass2 - kLambdaMass*kLambdaMass);
-
-	    if (mass2 > (kLambdaMass-fCutLambdaV)*(kLambdaMass-fCutLambdaV) && mass2 < (kLambdaMass+fCutLambdaV)*(kLambdaMass+fCutLambdaV))
-	      continue;
-	  }
+	  if (RejectTwoTrackPair(deta, dphistar1, dphistar2, phi1, pt1, charge1, phi2, pt2, charge2, bSign, twoTrackEfficiencyCutValue))
+	    continue;
 	}
+      }
+      
+      Double_t vars[6];
+      vars[0] = triggerEta - eta[j];
+      vars[1] = particle->Pt();
+      vars[2] = triggerParticle->Pt();
+      vars[3] = centrality;
+      vars[4] = WrapDeltaPhi(triggerParticle->Phi() - particle->Phi());
+      vars[5] = zVtx;
+      
+      if (fillpT)
+	weight = particle->Pt();
+      
+      Double_t useWeight = weight;
+      if (applyEfficiency)
+      {
+	if (fEfficiencyCorrectionAssociated)
+	  useWeight *= GetEfficiencyCorrection(fEfficiencyCorrectionAssociated, eta[j], vars[1], vars[3], vars[5]);
+	if (fEfficiencyCorrectionTriggers)
+	  useWeight *= GetEfficiencyCorrection(fEfficiencyCorrectionTriggers, triggerEta, vars[2], vars[3], vars[5]);
+      }
 
-        // Phi
-	if (fCutPhiV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-	{
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.4937, 0.4937);
-	  
-	  const Float_t kPhimass = 1.019;
-	  
-	  if (TMath::Abs(mass - kPhimass*kPhimass) < fCutPhiV * 5)
-	  {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.4937, 0.4937);
-	    
-	    fControlConvResoncances->Fill(3, mass - kPhimass*kPhimass);
-	    
-	    if (mass > (kPhimass-fCutPhiV)*(kPhimass-fCutPhiV) && mass < (kPhimass+fCutPhiV)*(kPhimass+fCutPhiV))
-	      continue;
-	  }
-	}	
+      if (fWeightPerEvent)
+      {
+	Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
+	useWeight /= triggerWeighting->GetBinContent(weightBin);
+      }
+  
+      // fill all in toward region and do not use the other regions
+      fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+    }
+ 
+    if (firstTime)
+    {
+      // once per trigger particle
+      Double_t vars[3];
+      vars[0] = triggerParticle->Pt();
+      vars[1] = centrality;
+      vars[2] = zVtx;
 
-        // Rho
-	if (fCutRhoV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-        {
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	  
-	  const Float_t kRhomass = 0.770;
-	  
-	  if (TMath::Abs(mass - kRhomass*kRhomass) < fCutRhoV * 5)
-          {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), 0.1396, 0.1396);
-	    
-	    fControlConvResoncances->Fill(4, mass - kRhomass*kRhomass);
-	    
-	    if (mass > (kRhomass-fCutRhoV)*(kRhomass-fCutRhoV) && mass < (kRhomass+fCutRhoV)*(kRhomass+fCutRhoV))
-	      continue;
-	  }
-	}
+      Double_t useWeight = 1;
+      if (fEfficiencyCorrectionTriggers && applyEfficiency)
+	useWeight *= GetEfficiencyCorrection(fEfficiencyCorrectionTriggers, triggerEta, vars[0], vars[1], vars[2]);
 
-        // User-defined cut
-	if (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0 && particle->Charge() * triggerParticle->Charge() < 0)
-        {
-	  Float_t mass = GetInvMassSquaredCheap(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), fCutCustomFirst, fCutCustomSecond);
-	  
-	  if (TMath::Abs(mass - fCutCustomMass*fCutCustomMass) < fCutCustomV * 5)
-          {
-	    mass = GetInvMassSquared(triggerParticle->Pt(), triggerEta, triggerParticle->Phi(), particle->Pt(), eta[j], particle->Phi(), fCutCustomFirst, fCutCustomSecond);
-	    
-	    fControlConvResoncances->Fill(5, mass - fCutCustomMass*fCutCustomMass);
-	    
-	    if (mass > (fCutCustomMass-fCutCustomV)*(fCutCustomMass-fCutCustomV) && mass < (fCutCustomMass+fCutCustomV)*(fCutCustomMass+fCutCustomV))
-	      continue;
-	  }
-	}
+      if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
+	fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
 
-	if (twoTrackEfficiencyCut)
-	{
-	  // the variables & cuthave been developed by the HBT group 
-	  // see e.g. https://indico.cern.ch/materialDisplay.py?contribId=36&sessionId=6&materialId=slides&confId=142700
+      if (fWeightPerEvent)
+      {
+	// leads effectively to a filling of one entry per filled trigger particle pT bin
+	Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
+	useWeight /= triggerWeighting->GetBinContent(weightBin);
+      }
+      
+      fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
+
+      // QA
+      fCorrelationpT->Fill(centrality, triggerParticle->Pt());
+      fCorrelationEta->Fill(centrality, triggerEta);
+      fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
+      fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
+      fYieldsEtaPhiPT->Fill(triggerParticle->Pt(), triggerEta, triggerParticle->Phi());
+    }
+  }
+    
+  if (triggerWeighting)
+  {
+    delete triggerWeighting;
+    triggerWeighting = 0;
+  }
+}
+  
+//____________________________________________________________________
+void AliUEHistograms::FillCorrelationsSoA(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency)
+{
+  // structure-of-arrays pair loop of FillCorrelations, see there for the arguments
+  //
+  // the particles are copied once into flat buffers. Per trigger particle, the pair selections which do not fill histograms,
+  // delta eta and delta phi are evaluated for all associated particles in one pass over the buffers, the remaining cuts
+  // are done for the accepted pairs in the original order. If the track histogram is an AliTHn, the pairs of a trigger
+  // particle are filled at once with AliTHnBase::FillN, which computes the bin indices axis by axis for all pairs.
+  // The entries are added in the same order, so that the output is identical to FillCorrelationsReference
+  
+  Bool_t fillpT = kFALSE;
+  if (weight < 0)
+    fillpT = kTRUE;
+  
+  AliUEParticleSoA trig;
+  AliUEParticleSoA mixedSoA;
+  trig.Fill(particles, fCheckEventNumberInCorrelation, fTwoTrackCutMinRadius);
+  AliUEParticleSoA& assoc = (mixed) ? mixedSoA : trig;
+  if (mixed)
+    mixedSoA.Fill(mixed, fCheckEventNumberInCorrelation, fTwoTrackCutMinRadius);
+  
+  Int_t iMax = particles->GetEntriesFast();
+  Int_t jMax = (mixed) ? mixed->GetEntriesFast() : iMax;
+  
+  // efficiency corrections only depend on one particle of the pair
+  if (applyEfficiency && fEfficiencyCorrectionAssociated)
+    for (Int_t j=0; j<jMax; j++)
+      assoc.fEfficiency[j] = GetEfficiencyCorrection(fEfficiencyCorrectionAssociated, assoc.fEta[j], assoc.fPt[j], centrality, zVtx);
+  // the trigger efficiency is kept in a separate buffer as trig and assoc are the same object for same-event correlations
+  std::vector<Double_t> triggerEfficiency(iMax, 1);
+  if (applyEfficiency && fEfficiencyCorrectionTriggers)
+    for (Int_t i=0; i<iMax; i++)
+      triggerEfficiency[i] = GetEfficiencyCorrection(fEfficiencyCorrectionTriggers, trig.fEta[i], trig.fPt[i], centrality, zVtx);
+  
+  TH1* triggerWeighting = 0;
+  if (fWeightPerEvent)
+  {
+    TAxis* axis = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->GetGrid(0)->GetGrid()->GetAxis(2);
+    triggerWeighting = new TH1F("triggerWeighting", "", axis->GetNbins(), axis->GetXbins()->GetArray());
+  
+    for (Int_t i=0; i<iMax; i++)
+      if (AcceptTrigger(trig.fEta[i], trig.fCharge[i]))
+	triggerWeighting->Fill(trig.fPt[i]);
+  }
+  
+  // returns kTRUE if the pair (i, j) must not be correlated because both are the same particle or from the same event
+  auto isSameParticleOrEvent = [&](Int_t i, Int_t j) -> Bool_t
+  {
+    if (!mixed && i == j)
+      return kTRUE;
+    if (fCheckEventNumberInCorrelation)
+      return trig.fEventIndex[i] == assoc.fEventIndex[j];
+    if (mixed)
+    {
+      if (trig.fBasic)
+	return trig.fUniqueID[i] == assoc.fUniqueID[j];
+      return particles->UncheckedAt(i)->IsEqual(mixed->UncheckedAt(j));
+    }
+    return kFALSE;
+  };
+  
+  // identify K, Lambda candidates and flag those particles
+  // a TObject bit is used for this (the same object can be in particles and mixed)
+  if (fRejectResonanceDaughters > 0)
+  {
+    Double_t resonanceMass = -1;
+    Double_t massDaughter1 = -1;
+    Double_t massDaughter2 = -1;
+    GetResonanceHypothesis(resonanceMass, massDaughter1, massDaughter2);
 
-	  Float_t phi1 = triggerParticle->Phi();
-	  Float_t pt1 = triggerParticle->Pt();
-	  Float_t charge1 = triggerParticle->Charge();
-	    
-	  Float_t phi2 = particle->Phi();
-	  Float_t pt2 = particle->Pt();
-	  Float_t charge2 = particle->Charge();
-	      
-	  Float_t deta = triggerEta - eta[j];
-	      
-	  // optimization
-	  if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
-	  {
-	    // check first boundaries to see if is worth to loop and find the minimum
-	    Float_t dphistar1 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, fTwoTrackCutMinRadius, bSign);
-	    Float_t dphistar2 = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, 2.5, bSign);
-	    
-	    const Float_t kLimit = twoTrackEfficiencyCutValue * 3;
-
-	    Float_t dphistarminabs = 1e5;
-	    Float_t dphistarmin = 1e5;
-	    if (TMath::Abs(dphistar1) < kLimit || TMath::Abs(dphistar2) < kLimit || dphistar1 * dphistar2 < 0)
-	    {
-	      for (Double_t rad=fTwoTrackCutMinRadius; rad<2.51; rad+=0.01) 
-	      {
-		Float_t dphistar = GetDPhiStar(phi1, pt1, charge1, phi2, pt2, charge2, rad, bSign);
-
-		Float_t dphistarabs = TMath::Abs(dphistar);
-		
-		if (dphistarabs < dphistarminabs)
-		{
-		  dphistarmin = dphistar;
-		  dphistarminabs = dphistarabs;
-		}
-	      }
-	      
-	      fTwoTrackDistancePt[0]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	      
-	      if (dphistarminabs < twoTrackEfficiencyCutValue && TMath::Abs(deta) < twoTrackEfficiencyCutValue)
-	      {
-// 		Printf("Removed track pair %d %d with %f %f %f %f %f %f %f %f %f", i, j, deta, dphistarminabs, phi1, pt1, charge1, phi2, pt2, charge2, bSign);
-		continue;
-	      }
-
-    	      fTwoTrackDistancePt[1]->Fill(deta, dphistarmin, TMath::Abs(pt1 - pt2));
-	    }
-	  }
-	}
-        
-        Double_t vars[6];
-        vars[0] = triggerEta - eta[j];
-        vars[1] = particle->Pt();
-        vars[2] = triggerParticle->Pt();
-        vars[3] = centrality;
-        vars[4] = triggerParticle->Phi() - particle->Phi();
-        if (vars[4] > 1.5 * TMath::Pi()) 
-          vars[4] -= TMath::TwoPi();
-        if (vars[4] < -0.5 * TMath::Pi())
-          vars[4] += TMath::TwoPi();
-	vars[5] = zVtx;
-	
-	if (fillpT)
-	  weight = particle->Pt();
+    for (Int_t i=0; i<iMax; i++)
+      particles->UncheckedAt(i)->ResetBit(kResonanceDaughterFlag);
+    if (mixed)
+      for (Int_t j=0; j<jMax; j++)
+	mixed->UncheckedAt(j)->ResetBit(kResonanceDaughterFlag);
+    
+    for (Int_t i=0; i<iMax; i++)
+    {
+      for (Int_t j=0; j<jMax; j++)
+      {
+	if (trig.fCharge[i] * assoc.fCharge[j] > 0)
+	  continue;
 	
-	Double_t useWeight = weight;
-	if (applyEfficiency)
-	{
-	  if (fEfficiencyCorrectionAssociated)
-	  {
-	    Int_t effVars[4];
-	    // associated particle
-	    effVars[0] = fEfficiencyCorrectionAssociated->GetAxis(0)->FindBin(eta[j]);
-	    effVars[1] = fEfficiencyCorrectionAssociated->GetAxis(1)->FindBin(vars[1]); //pt
-	    effVars[2] = fEfficiencyCorrectionAssociated->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionAssociated->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    
-	    // 	  Printf("%d %d %d %d %f", effVars[0], effVars[1], effVars[2], effVars[3], fEfficiencyCorrectionAssociated->GetBinContent(effVars));
-	  
-	    useWeight *= fEfficiencyCorrectionAssociated->GetBinContent(effVars);
-	  }
-	  if (fEfficiencyCorrectionTriggers)
-	  {
-	    Int_t effVars[4];
-
-	    effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	    effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[2]); //pt
-	    effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[3]); //centrality
-	    effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[5]); //zVtx
-	    useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
-	  }
-	}
-
-	if (fWeightPerEvent)
+	if (isSameParticleOrEvent(i, j))
+	  continue;
+    
+	if (IsResonanceDaughterPair(trig.fPtF[i], trig.fEta[i], trig.fPhiF[i], assoc.fPtF[j], assoc.fEta[j], assoc.fPhiF[j], resonanceMass, massDaughter1, massDaughter2))
 	{
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[2]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
+	  particles->UncheckedAt(i)->SetBit(kResonanceDaughterFlag);
+	  ((mixed) ? mixed : particles)->UncheckedAt(j)->SetBit(kResonanceDaughterFlag);
 	}
+      }
+    }
     
-        // fill all in toward region and do not use the other regions
-	fNumberDensityPhi->GetTrackHist(AliUEHist::kToward)->Fill(vars, step, useWeight);
+    for (Int_t i=0; i<iMax; i++)
+      trig.fFlags[i] = particles->UncheckedAt(i)->TestBit(kResonanceDaughterFlag);
+    if (mixed)
+      for (Int_t j=0; j<jMax; j++)
+	assoc.fFlags[j] = mixed->UncheckedAt(j)->TestBit(kResonanceDaughterFlag);
+  }
+  
+  // per-pair buffers filled by the kernel below
+  std::vector<UChar_t> accept(jMax);
+  std::vector<Float_t> deltaEta(jMax);
+  std::vector<Double_t> deltaPhi(jMax);
+  
+  // accepted pairs of one trigger particle, filled at once if the track histogram is an AliTHn
+  AliCFContainer* trackHist = fNumberDensityPhi->GetTrackHist(AliUEHist::kToward);
+  AliTHnBase* trackHistTHn = dynamic_cast<AliTHnBase*> (trackHist);
+  std::vector<Double_t> pairVars;
+  std::vector<Double_t> pairWeights;
+  std::vector<Int_t> pairSteps;
+  if (trackHistTHn)
+  {
+    pairVars.resize(6 * jMax);
+    pairWeights.resize(jMax);
+    pairSteps.assign(jMax, step);
+  }
+  
+  const Bool_t anyMassCut = (fCutConversionsV > 0 || fCutK0sV > 0 || fCutLambdaV > 0 || fCutPhiV > 0 || fCutRhoV > 0 || (fCutCustomMass > 0 && fCutCustomFirst > 0 && fCutCustomSecond > 0 && fCutCustomV > 0));
+  
+  for (Int_t i=0; i<iMax; i++)
+  {
+    Float_t triggerEta = trig.fEta[i];
+    Double_t triggerPt = trig.fPt[i];
+    Double_t triggerPhi = trig.fPhi[i];
+    Int_t triggerCharge = trig.fCharge[i];
+    
+    if (!AcceptTrigger(triggerEta, triggerCharge))
+      continue;
+      
+    if (fRejectResonanceDaughters > 0)
+      if (trig.fFlags[i])
+	continue;
+    
+    Double_t triggerWeight = 1;
+    if (fWeightPerEvent)
+      triggerWeight = triggerWeighting->GetBinContent(triggerWeighting->GetXaxis()->FindBin(triggerPt));
+    
+    // kernel: selections without side effects, delta eta and delta phi for all associated particles
+    for (Int_t j=0; j<jMax; j++)
+    {
+      accept[j] = AcceptPair(triggerEta, triggerPt, triggerCharge, assoc.fEta[j], assoc.fPt[j], assoc.fCharge[j]) & !(fRejectResonanceDaughters > 0 && assoc.fFlags[j]);
+      deltaEta[j] = triggerEta - assoc.fEta[j];
+      deltaPhi[j] = WrapDeltaPhi(triggerPhi - assoc.fPhi[j]);
+    }
+    
+    Int_t nPairs = 0;
+    for (Int_t j=0; j<jMax; j++)
+    {
+      if (!accept[j])
+	continue;
+      
+      if (isSameParticleOrEvent(i, j))
+	continue;
+      
+      // conversions and resonances
+      if (anyMassCut && assoc.fCharge[j] * triggerCharge < 0)
+	if (RejectResonancePair(trig.fPtF[i], triggerEta, trig.fPhiF[i], assoc.fPtF[j], assoc.fEta[j], assoc.fPhiF[j]))
+	  continue;
 
-// 	Printf("%.2f %.2f --> %.2f", triggerEta, eta[j], vars[0]);
-      }
- 
-      if (firstTime)
+      if (twoTrackEfficiencyCut)
       {
-        // once per trigger particle
-        Double_t vars[3];
-        vars[0] = triggerParticle->Pt();
-        vars[1] = centrality;
-	vars[2] = zVtx;
-
-	Double_t useWeight = 1;
-	if (fEfficiencyCorrectionTriggers && applyEfficiency)
+	// see FillCorrelationsReference, the bending terms at the boundaries are precomputed per particle
+	Float_t deta = deltaEta[j];
+	    
+	if (TMath::Abs(deta) < twoTrackEfficiencyCutValue * 2.5 * 3)
 	{
-	  Int_t effVars[4];
+	  Float_t dphistar1 = GetDPhiStarFromASin(trig.fPhiF[i], trig.fChargeF[i], trig.fASinMin[i], assoc.fPhiF[j], assoc.fChargeF[j], assoc.fASinMin[j], bSign);
+	  Float_t dphistar2 = GetDPhiStarFromASin(trig.fPhiF[i], trig.fChargeF[i], trig.fASinMax[i], assoc.fPhiF[j], assoc.fChargeF[j], assoc.fASinMax[j], bSign);
 	  
-	  // trigger particle
-	  effVars[0] = fEfficiencyCorrectionTriggers->GetAxis(0)->FindBin(triggerEta);
-	  effVars[1] = fEfficiencyCorrectionTriggers->GetAxis(1)->FindBin(vars[0]); //pt
-	  effVars[2] = fEfficiencyCorrectionTriggers->GetAxis(2)->FindBin(vars[1]); //centrality
-	  effVars[3] = fEfficiencyCorrectionTriggers->GetAxis(3)->FindBin(vars[2]); //zVtx
-	  useWeight *= fEfficiencyCorrectionTriggers->GetBinContent(effVars);
+	  if (RejectTwoTrackPair(deta, dphistar1, dphistar2, trig.fPhiF[i], trig.fPtF[i], trig.fChargeF[i], assoc.fPhiF[j], assoc.fPtF[j], assoc.fChargeF[j], bSign, twoTrackEfficiencyCutValue))
+	    continue;
 	}
+      }
+      
+      if (fillpT)
+	weight = assoc.fPt[j];
+      
+      Double_t useWeight = weight;
+      if (applyEfficiency)
+      {
+	if (fEfficiencyCorrectionAssociated)
+	  useWeight *= assoc.fEfficiency[j];
+	if (fEfficiencyCorrectionTriggers)
+	  useWeight *= triggerEfficiency[i];
+      }
 
-	if (TMath::Abs(triggerEta) < 0.8 && triggerParticle->Pt() > 0)
-	  fInvYield2->Fill(centrality, triggerParticle->Pt(), useWeight / triggerParticle->Pt());
-
-	if (fWeightPerEvent)
-	{
-	  // leads effectively to a filling of one entry per filled trigger particle pT bin
-	  Int_t weightBin = triggerWeighting->GetXaxis()->FindBin(vars[0]);
-// 	  Printf("Using weight %f", triggerWeighting->GetBinContent(weightBin));
-	  useWeight /= triggerWeighting->GetBinContent(weightBin);
-	}
-	
-        fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
-
-	// QA
-        fCorrelationpT->Fill(centrality, triggerParticle->Pt());
-        fCorrelationEta->Fill(centrality, triggerEta);
-        fCorrelationPhi->Fill(centrality, triggerParticle->Phi());
-	fYields->Fill(centrality, triggerParticle->Pt(), triggerEta);
-	fYieldsEtaPhiPT->Fill(triggerParticle->Pt(), triggerEta, triggerParticle->Phi());
-	
-/*        if (dynamic_cast<AliAODTrack*>(triggerParticle))
-          fITSClusterMap->Fill(((AliAODTrack*) triggerParticle)->GetITSClusterMap(), centrality, triggerParticle->Pt());*/
+      if (fWeightPerEvent)
+	useWeight /= triggerWeight;
+      
+      Double_t vars[6];
+      vars[0] = deltaEta[j];
+      vars[1] = assoc.fPt[j];
+      vars[2] = triggerPt;
+      vars[3] = centrality;
+      vars[4] = deltaPhi[j];
+      vars[5] = zVtx;
+  
+      // fill all in toward region and do not use the other regions
+      if (trackHistTHn)
+      {
+	std::copy(vars, vars + 6, pairVars.begin() + 6 * nPairs);
+	pairWeights[nPairs++] = useWeight;
       }
+      else
+	trackHist->Fill(vars, step, useWeight);
     }
     
-    if (triggerWeighting)
+    if (trackHistTHn && nPairs > 0)
+      trackHistTHn->FillN(nPairs, &pairVars[0], &pairSteps[0], &pairWeights[0]);
+ 
+    if (firstTime)
     {
-      delete triggerWeighting;
-      triggerWeighting = 0;
+      // once per trigger particle
+      Double_t vars[3];
+      vars[0] = triggerPt;
+      vars[1] = centrality;
+      vars[2] = zVtx;
+
+      Double_t useWeight = 1;
+      if (fEfficiencyCorrectionTriggers && applyEfficiency)
+	useWeight *= triggerEfficiency[i];
+
+      if (TMath::Abs(triggerEta) < 0.8 && triggerPt > 0)
+	fInvYield2->Fill(centrality, triggerPt, useWeight / triggerPt);
+
+      if (fWeightPerEvent)
+	useWeight /= triggerWeight;
+      
+      fNumberDensityPhi->GetEventHist()->Fill(vars, step, useWeight);
+
+      // QA
+      fCorrelationpT->Fill(centrality, triggerPt);
+      fCorrelationEta->Fill(centrality, triggerEta);
+      fCorrelationPhi->Fill(centrality, triggerPhi);
+      fYields->Fill(centrality, triggerPt, triggerEta);
+      fYieldsEtaPhiPT->Fill(triggerPt, triggerEta, triggerPhi);
     }
   }
   
-  fCentralityDistribution->Fill(centrality);
-  fCentralityCorrelation->Fill(centrality, particles->GetEntriesFast());
-  FillEvent(centrality, step);
+  if (triggerWeighting)
+  {
+    delete triggerWeighting;
+    triggerWeighting = 0;
+  }
 }
   
 //____________________________________________________________________
@@ -1374,6 +1721,7 @@ void AliUEHistograms::Copy(TObject& c) const
   target.fPtOrder = fPtOrder;
   target.fTwoTrackCutMinRadius = fTwoTrackCutMinRadius;
   target.fCheckEventNumberInCorrelation = fCheckEventNumberInCorrelation;
+  target.fUseSoAKernels = fUseSoAKernels;
 }
 
 //____________________________________________________________________
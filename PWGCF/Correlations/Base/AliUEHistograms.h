@@ -106,6 +106,7 @@ class AliUEHistograms : public TNamed
   void SetTwoTrackCutMinRadius(Float_t min) { fTwoTrackCutMinRadius = min; }
 
   void SetCheckEventNumberInCorrelation(Bool_t val) { fCheckEventNumberInCorrelation = val; }
+  void SetUseSoAKernels(Bool_t flag) { fUseSoAKernels = flag; }
   void ExtendTrackingEfficiency(Bool_t verbose = kFALSE);
   void Reset();
 
@@ -120,9 +121,23 @@ protected:
   void FillRegion(AliUEHist::Region region, Float_t zVtx, AliUEHist::CFStep step, AliVParticle* leading, TList* list, Int_t multiplicity);
   Int_t CountParticles(TList* list, Float_t ptMin);
   void DeleteContainers();
+  void FillCorrelationsSoA(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency);
+  void FillCorrelationsReference(Double_t centrality, Float_t zVtx, AliUEHist::CFStep step, TObjArray* particles, TObjArray* mixed, Float_t weight, Bool_t firstTime, Bool_t twoTrackEfficiencyCut, Float_t bSign, Float_t twoTrackEfficiencyCutValue, Bool_t applyEfficiency);
   inline Float_t GetInvMassSquared(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetInvMassSquaredCheap(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Float_t m0_1, Float_t m0_2);
   inline Float_t GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign);
+  inline Float_t GetDPhiStarFromASin(Float_t phi1, Float_t charge1, Double_t asin1, Float_t phi2, Float_t charge2, Double_t asin2, Float_t bSign);
+  
+  // selections shared by FillCorrelationsSoA and FillCorrelationsReference (defined in the cxx file)
+  void CreateTwoTrackHistograms();
+  inline Bool_t AcceptTrigger(Float_t eta, Int_t charge) const;
+  inline Bool_t AcceptPair(Float_t triggerEta, Double_t triggerPt, Int_t triggerCharge, Float_t eta, Double_t pt, Int_t charge) const;
+  inline void GetResonanceHypothesis(Double_t& resonanceMass, Double_t& massDaughter1, Double_t& massDaughter2) const;
+  inline Bool_t IsResonanceDaughterPair(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2, Double_t resonanceMass, Double_t massDaughter1, Double_t massDaughter2);
+  inline Bool_t RejectResonancePair(Float_t pt1, Float_t eta1, Float_t phi1, Float_t pt2, Float_t eta2, Float_t phi2);
+  inline Bool_t RejectTwoTrackPair(Float_t deta, Float_t dphistar1, Float_t dphistar2, Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t bSign, Float_t twoTrackEfficiencyCutValue);
+  inline static Double_t WrapDeltaPhi(Double_t dphi);
+  inline static Double_t GetEfficiencyCorrection(THnF* correction, Double_t eta, Double_t pt, Double_t centrality, Double_t zVtx);
   
   static const Int_t fgkUEHists; // number of histograms
 
@@ -177,12 +192,13 @@ protected:
   Float_t fTwoTrackCutMinRadius; // min radius for TTR cut
 
   Bool_t fCheckEventNumberInCorrelation; // do not correlate two particles from the same event (only works for AliBasicParticles)
+  Bool_t fUseSoAKernels;         // run the pair loop of FillCorrelations on structure-of-arrays copies of the particles (same output as the object-based loop)
 
   Long64_t fRunNumber;           // run number that has been processed
   
   Int_t fMergeCount;		// counts how many objects have been merged together
   
-  ClassDef(AliUEHistograms, 33)  // underlying event histogram container
+  ClassDef(AliUEHistograms, 34)  // underlying event histogram container
 };
 
 Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign)
@@ -191,7 +207,16 @@ Float_t AliUEHistograms::GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1,
   // calculates dphistar
   //
   
-  Float_t dphistar = phi1 - phi2 - charge1 * bSign * TMath::ASin(0.075 * radius / pt1) + charge2 * bSign * TMath::ASin(0.075 * radius / pt2);
+  return GetDPhiStarFromASin(phi1, charge1, TMath::ASin(0.075 * radius / pt1), phi2, charge2, TMath::ASin(0.075 * radius / pt2), bSign);
+}
+
+Float_t AliUEHistograms::GetDPhiStarFromASin(Float_t phi1, Float_t charge1, Double_t asin1, Float_t phi2, Float_t charge2, Double_t asin2, Float_t bSign)
+{ 
+  //
+  // calculates dphistar from the precomputed bending terms asin1/2 = ASin(0.075 * radius / pt1/2)
+  //
+  
+  Float_t dphistar = phi1 - phi2 - charge1 * bSign * asin1 + charge2 * bSign * asin2;
   
   static const Double_t kPi = TMath::Pi();
   
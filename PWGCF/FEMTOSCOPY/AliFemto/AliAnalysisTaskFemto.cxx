@@ -85,7 +85,8 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto(TString name,
   fConfigTMacro(NULL),
   fSaveConfigTMacro(NULL),
   fUserName(aUserName),
-  fconfigFunName(aConfigFunName)
+  fconfigFunName(aConfigFunName),
+  fNumberOfThreads(0)
 {
   // Constructor.
   // Input slot #0 works with an Ntuple
@@ -141,7 +142,8 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto(TString name,
   fConfigTMacro(NULL),
   fSaveConfigTMacro(false),
   fUserName(aUserName),
-  fconfigFunName(aConfigFunName)
+  fconfigFunName(aConfigFunName),
+  fNumberOfThreads(0)
 {
   // Constructor.
   // Input slot #0 works with an Ntuple
@@ -192,7 +194,8 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto(const AliAnalysisTaskFemto &aFemtoTas
   fConfigTMacro(aFemtoTask.fConfigTMacro),
   fSaveConfigTMacro(aFemtoTask.fSaveConfigTMacro),
   fUserName(aFemtoTask.fUserName),
-  fconfigFunName(aFemtoTask.fconfigFunName)
+  fconfigFunName(aFemtoTask.fconfigFunName),
+  fNumberOfThreads(aFemtoTask.fNumberOfThreads)
 {
   // copy constructor
 }
@@ -247,6 +250,7 @@ AliAnalysisTaskFemto &AliAnalysisTaskFemto::operator=(const AliAnalysisTaskFemto
   fSaveConfigTMacro = aFemtoTask.fSaveConfigTMacro;
   fUserName = aFemtoTask.fUserName;
   fconfigFunName = aFemtoTask.fconfigFunName;
+  fNumberOfThreads = aFemtoTask.fNumberOfThreads;
 
   return *this;
 }
@@ -648,6 +652,9 @@ void AliAnalysisTaskFemto::CreateOutputObjects()
   }
 
   SetFemtoManager(femto_manager);
+  if (fNumberOfThreads > 0) {
+    fManager->SetNumberOfThreads(fNumberOfThreads);
+  }
 
   fOutputList = fManager->Analysis(0)->GetOutputList();
   fOutputList->SetOwner(kTRUE);
@@ -1121,6 +1128,11 @@ void AliAnalysisTaskFemto::SaveConfigTMacro(Bool_t save)
   fSaveConfigTMacro = save;
 }
 
+void AliAnalysisTaskFemto::SetNumberOfThreads(Int_t n)
+{
+  fNumberOfThreads = n;
+}
+
 void AliAnalysisTaskFemto::SetGRIDUserName(TString aUserName)
 {
   fUserName = aUserName;
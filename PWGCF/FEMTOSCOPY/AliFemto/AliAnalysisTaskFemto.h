@@ -128,6 +128,10 @@ public:
   void SaveConfigTMacro(Bool_t save);
   void SetGRIDUserName(TString aUserName);
 
+  /// Process the analyses of the manager with n threads
+  /// (see AliFemtoManager::SetNumberOfThreads)
+  void SetNumberOfThreads(Int_t n);
+
 protected:
   AliESDEvent          *fESD;          //!<! ESD object
   AliESDpid            *fESDpid;       //!<! ESDpid object
@@ -173,10 +177,11 @@ protected:
   Bool_t fSaveConfigTMacro; //flag to save config TMacro in output list
   TString fUserName; //GRID user name
   TString fconfigFunName; //name of the config fucntion (like "ConfigFemtoAnalysis")
+  Int_t fNumberOfThreads; //threads processing the analyses of the manager (0: as set in the config)
 
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskFemto, 3);
+  ClassDef(AliAnalysisTaskFemto, 4);
   /// \endcond
 };
 
@@ -222,7 +227,8 @@ AliAnalysisTaskFemto::AliAnalysisTaskFemto():
   fConfigTMacro(NULL),
   fSaveConfigTMacro(false),
   fUserName(),
-  fconfigFunName()
+  fconfigFunName(),
+  fNumberOfThreads(0)
 {
   /* no-op */
 }
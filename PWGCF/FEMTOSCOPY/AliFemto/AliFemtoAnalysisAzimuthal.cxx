@@ -282,6 +282,7 @@ void AliFemtoAnalysisAzimuthal::MakePairs(const char* typeIn, AliFemtoParticleCo
   int swpart = fNeventsProcessed % 2;
 
   AliFemtoPair* tPair = new AliFemtoPair;
+  tPair->SetRandom(PairRandom());
   AliFemtoCorrFctnIterator tCorrFctnIter;
   AliFemtoParticleIterator tPartIter1, tPartIter2;
 
@@ -40,7 +40,9 @@ fNumEventsToMix(0),
 fMultMin(multMin),
 fMultMax(multMax),
 fPerformSharedDaughterCut(kFALSE),
-fIdenticalParticles(false)
+fIdenticalParticles(false),
+fRandom(),
+fUseOwnRandom(false)
 {
   if(fIdenticalParticles) srand(std::time(0));
   // Default constructor
@@ -61,7 +63,9 @@ fNumEventsToMix(a.fNumEventsToMix),
 fMultMin(a.fMultMin),
 fMultMax(a.fMultMax),
 fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-fIdenticalParticles(a.fIdenticalParticles)
+fIdenticalParticles(a.fIdenticalParticles),
+fRandom(a.fRandom),
+fUseOwnRandom(a.fUseOwnRandom)
 {
   // Copy constructor
   
@@ -210,6 +214,8 @@ AliFemtoEventAnalysis& AliFemtoEventAnalysis::operator=(const AliFemtoEventAnaly
 
   fNumEventsToMix = aAna.fNumEventsToMix;
   fIdenticalParticles = aAna.fIdenticalParticles;
+  fRandom = aAna.fRandom;
+  fUseOwnRandom = aAna.fUseOwnRandom;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   
   return *this;
@@ -300,7 +306,7 @@ void AliFemtoEventAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent)
   
   if(fIdenticalParticles)
   {
-    double random_variable = (double)rand()/RAND_MAX;
+    double random_variable = fUseOwnRandom ? fRandom.Rndm() : (double)rand()/RAND_MAX;
    
     if(random_variable < 0.5) AddParticles("first", collection1);
     else                      AddParticles("second", collection1);
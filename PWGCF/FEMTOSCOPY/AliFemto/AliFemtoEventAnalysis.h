@@ -14,6 +14,8 @@
 #include "AliFemtoParticleCollection.h"
 #include "AliFemtoV0SharedDaughterCut.h"
 
+#include <TRandom3.h>
+
 class AliFemtoEventAnalysis : public AliFemtoAnalysis
 {
 public:
@@ -39,6 +41,9 @@ public:
   void SetSecondParticleCut(AliFemtoParticleCut* TheSecondParticleCut);
 
   void SetIdenticalParticles(bool identical);
+  /// Seed of the generator splitting identical particles between the two
+  /// collections. Without a seed the split uses rand().
+  void SetRandomSeed(UInt_t seed);
   
   void AddParticles(const char* typeIn, AliFemtoParticleCollection *partCollection, bool mixing = false);
   
@@ -84,6 +89,8 @@ protected:
 
 private:
   bool fIdenticalParticles; // is the analysis of identical particles
+  TRandom3 fRandom;         //!<! generator of this analysis, independent of the other analyses
+  bool fUseOwnRandom;       //!<! fRandom was seeded, otherwise rand() is used
   
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -140,6 +147,12 @@ inline void AliFemtoEventAnalysis::SetSecondParticleCut(AliFemtoParticleCut* x)
   x->SetAnalysis(this);
 }
 
+inline void AliFemtoEventAnalysis::SetRandomSeed(UInt_t seed)
+{
+  fRandom.SetSeed(seed);
+  fUseOwnRandom = true;
+}
+
 inline void AliFemtoEventAnalysis::SetIdenticalParticles(bool identical)
 {
   fIdenticalParticles = identical;
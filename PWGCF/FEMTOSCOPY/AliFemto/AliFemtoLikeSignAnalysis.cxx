@@ -146,6 +146,7 @@ void AliFemtoLikeSignAnalysis::ProcessEvent(const AliFemtoEvent* hbtEvent) {
       // We only ever need ONE pair, and we can just keep changing internal pointers
       // this should help speed things up
       AliFemtoPair* tThePair = new AliFemtoPair;
+      tThePair->SetRandom(PairRandom());
 
       AliFemtoParticleIterator tPartIter1;
       AliFemtoParticleIterator tPartIter2;
@@ -8,10 +8,23 @@
 ///////////////////////////////////////////////////////////////////////////
 
 #include "AliFemtoManager.h"
+#include "AliFemtoSimpleAnalysis.h"
+#include "AliFemtoVertexAnalysis.h"
+#include "AliFemtoVertexMultAnalysis.h"
+#include "AliFemtoModelCorrFctn.h"
 //#include "AliFemtoParticleCollection.h"
 //#include "AliFemtoTrackCut.h"
 //#include "AliFemtoV0Cut.h"
 #include <cstdio>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+
+#include <TROOT.h>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -20,12 +33,129 @@
 #endif
 
 
+/// \class AliFemtoManagerWorkers
+/// \brief Pool of threads calling ProcessEvent of the analyses
+///
+/// The calling thread takes part in the work; Process() returns when all
+/// the analyses have processed the event.
+///
+class AliFemtoManagerWorkers {
+public:
+  AliFemtoManagerWorkers(int nThreads);
+  ~AliFemtoManagerWorkers();
+
+  void Process(const AliFemtoAnalysisCollection &analyses, const AliFemtoEvent *event);
+
+private:
+  AliFemtoManagerWorkers(const AliFemtoManagerWorkers&);
+  AliFemtoManagerWorkers& operator=(const AliFemtoManagerWorkers&);
+
+  void Run();
+  void ProcessAnalyses();
+
+  std::vector<std::thread> fThreads;
+  std::mutex fMutex;
+  std::condition_variable fStart;     ///< signals a new event (or stop) to the workers
+  std::condition_variable fDone;      ///< signals the last worker finished
+  std::vector<AliFemtoAnalysis*> fAnalyses;
+  const AliFemtoEvent *fEvent;
+  std::atomic<size_t> fNextAnalysis;  ///< index of the next analysis to process
+  unsigned long fGeneration;          ///< number of events given to the workers
+  int fBusy;                          ///< workers still processing the current event
+  bool fStop;
+};
+
+AliFemtoManagerWorkers::AliFemtoManagerWorkers(int nThreads):
+  fThreads(),
+  fMutex(),
+  fStart(),
+  fDone(),
+  fAnalyses(),
+  fEvent(nullptr),
+  fNextAnalysis(0),
+  fGeneration(0),
+  fBusy(0),
+  fStop(false)
+{
+  // histograms or other ROOT objects may be created while processing
+  ROOT::EnableThreadSafety();
+  for (int i = 1; i < nThreads; ++i) {
+    fThreads.emplace_back(&AliFemtoManagerWorkers::Run, this);
+  }
+}
+
+AliFemtoManagerWorkers::~AliFemtoManagerWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fStop = true;
+  }
+  fStart.notify_all();
+  for (auto &thread : fThreads) {
+    thread.join();
+  }
+}
+
+void AliFemtoManagerWorkers::Process(const AliFemtoAnalysisCollection &analyses,
+                                     const AliFemtoEvent *event)
+{
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    fAnalyses.assign(analyses.begin(), analyses.end());
+    fEvent = event;
+    fNextAnalysis = 0;
+    fBusy = fThreads.size();
+    ++fGeneration;
+  }
+  fStart.notify_all();
+
+  ProcessAnalyses();
+
+  std::unique_lock<std::mutex> lock(fMutex);
+  fDone.wait(lock, [this] { return fBusy == 0; });
+}
+
+void AliFemtoManagerWorkers::ProcessAnalyses()
+{
+  for (size_t i = fNextAnalysis++; i < fAnalyses.size(); i = fNextAnalysis++) {
+    fAnalyses[i]->ProcessEvent(fEvent);
+  }
+}
+
+void AliFemtoManagerWorkers::Run()
+{
+  unsigned long generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(fMutex);
+      fStart.wait(lock, [&] { return fStop || fGeneration != generation; });
+      if (fStop) {
+        return;
+      }
+      generation = fGeneration;
+    }
+
+    ProcessAnalyses();
+
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      last = (--fBusy == 0);
+    }
+    if (last) {
+      fDone.notify_one();
+    }
+  }
+}
+
 
 //____________________________
 AliFemtoManager::AliFemtoManager():
   fAnalysisCollection(nullptr),
   fEventReader(nullptr),
-  fEventWriterCollection(nullptr)
+  fEventWriterCollection(nullptr),
+  fNumberOfThreads(1),
+  fWorkers(nullptr)
 {
   // default constructor
   fAnalysisCollection = new AliFemtoAnalysisCollection;
@@ -35,7 +165,9 @@ AliFemtoManager::AliFemtoManager():
 AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
   fAnalysisCollection(new AliFemtoAnalysisCollection),
   fEventReader(aManager.fEventReader),
-  fEventWriterCollection(new AliFemtoEventWriterCollection)
+  fEventWriterCollection(new AliFemtoEventWriterCollection),
+  fNumberOfThreads(aManager.fNumberOfThreads),
+  fWorkers(nullptr)
 {
   // copy constructor
   for (auto *analysis : *aManager.fAnalysisCollection) {
@@ -50,6 +182,7 @@ AliFemtoManager::AliFemtoManager(const AliFemtoManager& aManager):
 AliFemtoManager::~AliFemtoManager()
 {
   // destructor
+  delete fWorkers;
   delete fEventReader;
   // now delete each Analysis in the Collection, and then the Collection itself
   for (auto *analysis : *fAnalysisCollection) {
@@ -71,7 +204,7 @@ AliFemtoManager& AliFemtoManager::operator=(const AliFemtoManager& aManager)
   }
 
   fEventReader = aManager.fEventReader;
-
+  SetNumberOfThreads(aManager.fNumberOfThreads);
 
   for (auto *analysis : *fAnalysisCollection) {
     delete analysis;
@@ -128,6 +261,10 @@ int AliFemtoManager::Init()
 void AliFemtoManager::Finish()
 {
   // Initialize finish procedures
+  // stop the worker threads, they are started again if more events come
+  delete fWorkers;
+  fWorkers = nullptr;
+
   // EventReader
   if (fEventReader) {
     fEventReader->Finish();
@@ -209,9 +346,34 @@ int AliFemtoManager::ProcessEvent()
     writer->WriteHbtEvent(currentHbtEvent);
   }
 
+  if (!fWorkers && fNumberOfThreads > 1 && fAnalysisCollection->size() > 1) {
+    if (AnalysesAreIndependent()) {
+      // rand() is shared by the threads: give every analysis its own
+      // generator, with a different seed so that cut variations do not
+      // draw correlated numbers
+      UInt_t seed = 0;
+      for (auto *analysis : *fAnalysisCollection) {
+        auto *simple = static_cast<AliFemtoSimpleAnalysis*>(analysis);
+        ++seed;
+        if (!simple->HasRandomSeed()) {
+          simple->SetRandomSeed(seed);
+        }
+      }
+      fWorkers = new AliFemtoManagerWorkers(fNumberOfThreads);
+    } else {
+      std::cerr << "W-AliFemtoManager::ProcessEvent: analyses share objects, use model correlation"
+              " functions or are not simple/vertex analyses, processing them serially\n";
+      fNumberOfThreads = 1;
+    }
+  }
+
   // loop over all the Analysis
-  for (auto *analysis : *fAnalysisCollection) {
-    analysis->ProcessEvent(currentHbtEvent);
+  if (fWorkers) {
+    fWorkers->Process(*fAnalysisCollection, currentHbtEvent);
+  } else {
+    for (auto *analysis : *fAnalysisCollection) {
+      analysis->ProcessEvent(currentHbtEvent);
+    }
   }
 
   if (currentHbtEvent) {
@@ -221,3 +383,52 @@ int AliFemtoManager::ProcessEvent()
 
   return 0;    // 0 = "good return"
 }       // ProcessEvent
+//____________________________
+void AliFemtoManager::SetNumberOfThreads(int n)
+{
+  // set the number of threads processing the analyses, the worker pool is
+  // (re)created on the next event
+  if (n != fNumberOfThreads) {
+    delete fWorkers;
+    fWorkers = nullptr;
+  }
+  fNumberOfThreads = n;
+}
+//____________________________
+bool AliFemtoManager::AnalysesAreIndependent() const
+{
+  // return false if a cut or correlation function is owned by two analyses,
+  // if an analysis is not known to be safe (its pair building is that of
+  // AliFemtoSimpleAnalysis, with the analysis' own random generator), or if
+  // a correlation function uses a model manager (the weight generators and
+  // freeze-out generators are not thread safe)
+  std::set<const void*> used;
+  for (auto *analysis : *fAnalysisCollection) {
+    const std::type_info &type = typeid(*analysis);
+    if (type != typeid(AliFemtoSimpleAnalysis)
+        && type != typeid(AliFemtoVertexAnalysis)
+        && type != typeid(AliFemtoVertexMultAnalysis)) {
+      return false;
+    }
+    auto *simple = static_cast<AliFemtoSimpleAnalysis*>(analysis);
+
+    std::set<const void*> objects = {simple->EventCut(),
+                                     simple->FirstParticleCut(),
+                                     simple->SecondParticleCut(),
+                                     simple->PairCut()};
+    for (auto *cf : *simple->CorrFctnCollection()) {
+      if (dynamic_cast<AliFemtoModelCorrFctn*>(cf)) {
+        return false;
+      }
+      objects.insert(cf);
+    }
+    objects.erase(nullptr);
+
+    for (auto *obj : objects) {
+      if (!used.insert(obj).second) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -19,6 +19,7 @@
 #include "AliFemtoEventReader.h"
 #include "AliFemtoEventWriter.h"
 
+class AliFemtoManagerWorkers;
 
 /// \class AliFemtoManager
 /// \brief Main class for managing femtoscopic analyses
@@ -43,12 +44,34 @@
 /// operator private prevents potential dangling pointer (segfault)
 /// errors.
 ///
+/// The analyses are processed serially unless threads are explicitly
+/// requested with `SetNumberOfThreads(n)` (n > 1). Even then the manager
+/// keeps the serial loop unless every analysis is an
+/// AliFemtoSimpleAnalysis, AliFemtoVertexAnalysis or
+/// AliFemtoVertexMultAnalysis, no cut or correlation function object is
+/// shared between analyses, and no correlation function is an
+/// AliFemtoModelCorrFctn (model weight generators are not thread safe).
+/// Each event is then shared read-only by a pool of n threads; every
+/// analysis sees the events in the serial order and draws the random pair
+/// ordering from its own generator (AliFemtoSimpleAnalysis::SetRandomSeed;
+/// analyses without a seed get the seed of their position in the
+/// collection, 1, 2, ...). Serial runs keep rand() unless a seed is set.
+/// Cuts or correlation functions relying on global state (gRandom, rand(),
+/// static members) still must not be run with threads.
+///
 class AliFemtoManager {
 
 private:
   AliFemtoAnalysisCollection* fAnalysisCollection;       ///< Collection of analyzes
   AliFemtoEventReader*        fEventReader;              ///< Event reader
   AliFemtoEventWriterCollection* fEventWriterCollection; ///< Event writer collection
+  int fNumberOfThreads;                                  ///< Threads processing the analyses (<=1 serial)
+  AliFemtoManagerWorkers* fWorkers;                      //!<! Worker pool, created on the first event
+
+  /// Check that the analyses are of a known thread safe type, share no cut
+  /// or correlation function object and use no model correlation function,
+  /// so they can be processed in parallel
+  bool AnalysesAreIndependent() const;
 
   AliFemtoManager(const AliFemtoManager& aManager);
   AliFemtoManager& operator=(const AliFemtoManager& aManager);
@@ -70,6 +93,9 @@ public:
   AliFemtoEventReader* EventReader();
   void SetEventReader(AliFemtoEventReader* r);
 
+  void SetNumberOfThreads(int n);  ///< Process the analyses with n threads
+  int NumberOfThreads() const;
+
   /// Calls `Init()` on all owned EventWriters
   ///
   /// Returns 0 for success, 1 for failure.
@@ -99,4 +125,6 @@ inline void AliFemtoManager::SetEventWriter(AliFemtoEventWriter* writer){fEventW
 inline AliFemtoEventReader* AliFemtoManager::EventReader(){return fEventReader;}
 inline void AliFemtoManager::SetEventReader(AliFemtoEventReader* reader){fEventReader = reader;}
 
+inline int AliFemtoManager::NumberOfThreads() const{return fNumberOfThreads;}
+
 #endif
@@ -8,6 +8,7 @@
 //                                                                       //
 ///////////////////////////////////////////////////////////////////////////
 #include <TMath.h>
+#include <TRandom.h>
 #include "AliFemtoPair.h"
 
 double AliFemtoPair::fgMaxDuInner = .8;
@@ -19,6 +20,7 @@ double AliFemtoPair::fgMaxDzOuter = 3.2;
 AliFemtoPair::AliFemtoPair():
   fTrack1(nullptr),
   fTrack2(nullptr),
+  fRandom(nullptr),
   fPairAngleEP(0.0),
   fNonIdParNotCalculated(0.0),
   fDKSide(0.0),
@@ -59,6 +61,7 @@ AliFemtoPair::AliFemtoPair():
 AliFemtoPair::AliFemtoPair(AliFemtoParticle* a, AliFemtoParticle* b):
   fTrack1(a),
   fTrack2(b),
+  fRandom(nullptr),
   fPairAngleEP(0.0),
   fNonIdParNotCalculated(0.0),
   fDKSide(0.0),
@@ -130,6 +133,7 @@ AliFemtoPair::~AliFemtoPair()
 AliFemtoPair::AliFemtoPair(const AliFemtoPair &aPair):
   fTrack1(aPair.fTrack1),
   fTrack2(aPair.fTrack2),
+  fRandom(aPair.fRandom),
   fPairAngleEP(aPair.fPairAngleEP),
   fNonIdParNotCalculated(aPair.fNonIdParNotCalculated),
   fDKSide(aPair.fDKSide),
@@ -174,6 +178,7 @@ AliFemtoPair& AliFemtoPair::operator=(const AliFemtoPair &aPair)
 
   fTrack1 = aPair.fTrack1;
   fTrack2 = aPair.fTrack2;
+  fRandom = aPair.fRandom;
 
   fPairAngleEP = aPair.fPairAngleEP;
 
@@ -280,6 +285,11 @@ AliFemtoLorentzVector AliFemtoPair::FourMomentumDiff() const
   return temp;
 }
 //__________________________________
+double AliFemtoPair::RandomUniform() const
+{
+  return fRandom ? fRandom->Rndm() : rand()/(double)RAND_MAX;
+}
+//__________________________________
 void AliFemtoPair::QYKPCMS(double& qP, double& qT, double& q0) const
 {
   // Yano-Koonin-Podgoretskii Parametrisation in CMS
@@ -290,7 +300,7 @@ void AliFemtoPair::QYKPCMS(double& qP, double& qT, double& q0) const
   const AliFemtoLorentzVector &l2 = fTrack2->FourMomentum();
 
   // random ordering of the particles
-  AliFemtoLorentzVector l = (rand()/(double)RAND_MAX > 0.50)
+  AliFemtoLorentzVector l = (RandomUniform() > 0.50)
                           ? l1 - l2
                           : l2 - l1;
 
@@ -333,7 +343,7 @@ void AliFemtoPair::QYKPLCMS(double& qP, double& qT, double& q0) const
   AliFemtoLorentzVector l2boosted = l2.boost(l);
 
   // caculate the momentum difference with random ordering of the particle
-  if ( rand()/(double)RAND_MAX >0.50) {
+  if ( RandomUniform() > 0.50) {
     l = l1boosted-l2boosted;
   } else {
     l = l2boosted-l1boosted;
@@ -364,7 +374,7 @@ void AliFemtoPair::QYKPPF(double& qP, double& qT, double& q0) const
   AliFemtoLorentzVector l2boosted = l2.boost(l);
 
   // caculate the momentum difference with random ordering of the particle
-  if ( rand()/(double)RAND_MAX > 0.50) {
+  if ( RandomUniform() > 0.50) {
     l = l1boosted-l2boosted;
   } else {
     l = l2boosted-l1boosted;
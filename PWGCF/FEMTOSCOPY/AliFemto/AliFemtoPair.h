@@ -27,6 +27,8 @@ namespace std {
 #include "AliFemtoParticle.h"
 #include "AliFemtoTypes.h"
 
+class TRandom;
+
 class AliFemtoPair {
 public:
   AliFemtoPair();
@@ -42,6 +44,10 @@ public:
   void SetTrack1(const AliFemtoParticle* trkPtr);
   void SetTrack2(const AliFemtoParticle* trkPtr);
 
+  /// Generator used for the random particle ordering of the YKP
+  /// momenta (not owned). When unset, the C library rand() is used.
+  void SetRandom(TRandom *random) { fRandom = random; }
+
   AliFemtoLorentzVector FourMomentumDiff() const;
   AliFemtoLorentzVector FourMomentumSum() const;
   double QInv() const;
@@ -224,6 +230,7 @@ public:
 private:
   AliFemtoParticle* fTrack1; // Link to the first track in the pair
   AliFemtoParticle* fTrack2; // Link to the second track in the pair
+  TRandom* fRandom;          // Generator for the random particle ordering (not owned)
 
   double fPairAngleEP;	//Pair emission angle wrt EP
 
@@ -282,6 +289,9 @@ private:
   /// First item in pair is pointer to weight, second is the weight
   mutable std::pair<std::intptr_t, double> fFemtoWeightCache[3];
 
+  /// Uniform number in [0,1] from fRandom, or from rand() when unset
+  double RandomUniform() const;
+
   static double fgMaxDuInner; // Minimum cluster separation in x in inner TPC padrow
   static double fgMaxDzInner; // Minimum cluster separation in z in inner TPC padrow
   static double fgMaxDuOuter; // Minimum cluster separation in x in outer TPC padrow
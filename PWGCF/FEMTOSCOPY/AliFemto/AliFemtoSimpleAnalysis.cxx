@@ -13,6 +13,10 @@
 #include <string>
 #include <iostream>
 #include <iterator>
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <cmath>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -183,7 +187,10 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPairKStarMax(0.0),
+  fRandom(),
+  fUseOwnRandom(false)
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -205,7 +212,10 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPairKStarMax(a.fPairKStarMax),
+  fRandom(a.fRandom),
+  fUseOwnRandom(a.fUseOwnRandom)
 {
   /// Copy constructor
 
@@ -402,6 +412,9 @@ AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAn
   fVerbose = aAna.fVerbose;
   fPerformSharedDaughterCut = aAna.fPerformSharedDaughterCut;
   fEnablePairMonitors = aAna.fEnablePairMonitors;
+  fPairKStarMax = aAna.fPairKStarMax;
+  fRandom = aAna.fRandom;
+  fUseOwnRandom = aAna.fUseOwnRandom;
 
   return *this;
 }
@@ -593,6 +606,11 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
   }
   //  int swpart = ((long int) partCollection1) % 2;
 
+  if (fPairKStarMax > 0.0) {
+    MakePairsKStarPreselected(these_are_real_pairs, partCollection1, partCollection2, enablePairMonitors);
+    return;
+  }
+
   // Used to swap particle 1 & 2 in identical-particle analysis
   // to avoid any implicit ordering in the event collection
   // "Seed" this here.
@@ -622,6 +640,7 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
 
   // Create the pair outside the loop - only allocate once
   AliFemtoPair* tPair = new AliFemtoPair;
+  tPair->SetRandom(PairRandom());
 
   // Begin the outer loop
   for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
@@ -655,28 +674,232 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
         swpart = !swpart;
       }
 
-      // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
+      ProcessPair(tPair, these_are_real_pairs, enablePairMonitors);
+
+    }    // loop over second particle
+  }      // loop over first particle
+
+  // we are done with the pair
+  delete tPair;
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ProcessPair(AliFemtoPair *pair,
+                                         bool realPair,
+                                         Bool_t enablePairMonitors)
+{
+  // check if the pair passes the cut
+  bool tmpPassPair = fPairCut->Pass(pair);
+
+  // This is a condition for speed reasons
+  if (enablePairMonitors) {
+    fPairCut->FillCutMonitor(pair, tmpPassPair);
+  }
+
+  // If pair passes cut, loop over CF's and add pair to real/mixed
+  if (tmpPassPair) {
+    for (auto &tCorrFctn : *fCorrFctnCollection) {
+      if (realPair)
+        tCorrFctn->AddRealPair(pair);
+      else
+        tCorrFctn->AddMixedPair(pair);
+    } // loop over correlation functions
+  }
+}
+
+namespace {
+
+/// Four-momentum, mass, pt and rapidity of a particle, used to reject
+/// pairs before an AliFemtoPair is filled
+struct KStarCandidate {
+  double px, py, pz, e, m2, pt, y;
+  unsigned int index;       // position in the particle collection
+  unsigned int collection;  // 1 or 2, collection of the particle
+
+  KStarCandidate(const AliFemtoParticle *part, unsigned int idx, unsigned int coll):
+    index(idx),
+    collection(coll)
+  {
+    const AliFemtoLorentzVector &p = part->FourMomentum();
+    px = p.x();
+    py = p.y();
+    pz = p.z();
+    e = p.e();
+    m2 = std::max(0.0, p.m2());
+    pt = std::sqrt(px*px + py*py);
+    y = (e > std::fabs(pz)) ? 0.5 * std::log((e + pz) / (e - pz))
+                            : (pz > 0 ? 1e30 : -1e30);
+  }
+
+  bool operator<(const KStarCandidate &other) const
+    { return y < other.y; }
+
+  /// Order used to assign a pair to one of its particles: the one with the
+  /// lower pt (then the lower index, then the first collection) looks for
+  /// the other. It is strict for any two candidates, so that exactly one of
+  /// the two searches accepts a pair
+  bool IsSofterThan(const KStarCandidate &other) const
+  {
+    if (pt != other.pt) {
+      return pt < other.pt;
+    }
+    if (index != other.index) {
+      return index < other.index;
+    }
+    return collection < other.collection;
+  }
+};
 
-      // This is a condition for speed reasons
-      if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
+/// k* of the pair, computed as in AliFemtoPair::CalcNonIdPar()
+double CandidateKStar(const KStarCandidate &p1, const KStarCandidate &p2)
+{
+  const double tPx = p1.px + p2.px,
+               tPy = p1.py + p2.py,
+               tPz = p1.pz + p2.pz,
+               tPE = p1.e + p2.e;
+  const double tPinv = std::sqrt(tPE*tPE - tPz*tPz - tPx*tPx - tPy*tPy);
+  const double tQinvL = (p1.e-p2.e)*(p1.e-p2.e) - (p1.px-p2.px)*(p1.px-p2.px)
+                      - (p1.py-p2.py)*(p1.py-p2.py) - (p1.pz-p2.pz)*(p1.pz-p2.pz);
+  const double tQ = (p1.m2 - p2.m2) / tPinv;
+  return std::sqrt(tQ*tQ - tQinvL) / 2;
+}
+
+void FillCandidates(AliFemtoParticleCollection *collection, unsigned int collectionId,
+                    std::vector<AliFemtoParticle*> &particles,
+                    std::vector<KStarCandidate> &candidates,
+                    double &minMass, double &maxMass)
+{
+  particles.assign(collection->begin(), collection->end());
+  candidates.clear();
+  candidates.reserve(particles.size());
+  minMass = 1e30;
+  maxMass = 0.0;
+  for (unsigned int i = 0; i < particles.size(); ++i) {
+    candidates.emplace_back(particles[i], i, collectionId);
+    const double m = std::sqrt(candidates.back().m2);
+    minMass = std::min(minMass, m);
+    maxMass = std::max(maxMass, m);
+  }
+  std::sort(candidates.begin(), candidates.end());
+}
+
+/// Maximal rapidity difference of a particle (mass m1, transverse momentum
+/// pt1) with any particle of a collection (masses in [minMass2, maxMass2],
+/// transverse momenta above minPt2) for k* to be below kStarMax.
+///
+/// k* grows with the invariant mass M of the pair, which must stay below
+/// sqrt(m1^2 + k*^2) + sqrt(m2^2 + k*^2), and
+/// M^2 >= (m1 + m2)^2 + 2 (m1 m2 + pt1 pt2) (cosh(dy) - 1).
+double MaxDeltaRapidity(double m1, double pt1, double minMass2, double maxMass2,
+                        double minPt2, double kStarMax)
+{
+  const double k2 = kStarMax * kStarMax,
+               maxM = std::sqrt(m1*m1 + k2) + std::sqrt(maxMass2*maxMass2 + k2),
+               denom = 2 * (m1 * minMass2 + pt1 * minPt2);
+  if (denom <= 0.0) {
+    return 1e30;
+  }
+  const double coshMax = 1.0 + (maxM*maxM - (m1 + minMass2)*(m1 + minMass2)) / denom;
+  return std::acosh(std::max(1.0, coshMax));
+}
+
+/// Append to `pairs` the (index in `soft`'s collection, index in `hard`'s
+/// collection) of the pairs with k* <= kStarMax for which the particle of
+/// `soft` is the softer one. `hard` must be sorted in rapidity.
+///
+/// As the partner is harder, pt1 is used as the lower bound of its pt in
+/// the rapidity window, which is thus computed for each particle.
+void FindKStarPairs(const std::vector<KStarCandidate> &soft,
+                    const std::vector<KStarCandidate> &hard,
+                    double minMassHard, double maxMassHard,
+                    double kStarMax, bool swapped,
+                    std::vector<std::pair<unsigned int, unsigned int>> &pairs)
+{
+  for (const auto &c1 : soft) {
+    const double dyMax = MaxDeltaRapidity(std::sqrt(c1.m2), c1.pt, minMassHard,
+                                          maxMassHard, c1.pt, kStarMax);
+    auto itStart = std::lower_bound(hard.begin(), hard.end(), c1.y - dyMax,
+                                    [](const KStarCandidate &c, double y) { return c.y < y; });
+    auto itEnd = std::upper_bound(itStart, hard.end(), c1.y + dyMax,
+                                  [](double y, const KStarCandidate &c) { return y < c.y; });
+
+    for (auto it2 = itStart; it2 != itEnd; ++it2) {
+      if (!c1.IsSofterThan(*it2) || !(CandidateKStar(c1, *it2) <= kStarMax)) {
+        continue;
+      }
+      if (swapped) {
+        pairs.emplace_back(it2->index, c1.index);
+      } else {
+        pairs.emplace_back(c1.index, it2->index);
       }
+    }
+  }
+}
+
+} // namespace
 
-      // If pair passes cut, loop over CF's and add pair to real/mixed
-      if (tmpPassPair) {
-        for (auto &tCorrFctn : *fCorrFctnCollection) {
-          if (these_are_real_pairs)
-            tCorrFctn->AddRealPair(tPair);
-          else
-            tCorrFctn->AddMixedPair(tPair);
-        } // loop over correlation functions
+//_________________________
+void AliFemtoSimpleAnalysis::MakePairsKStarPreselected(bool realPairs,
+                                                       AliFemtoParticleCollection *partCollection1,
+                                                       AliFemtoParticleCollection *partCollection2,
+                                                       Bool_t enablePairMonitors)
+{
+  // Same pairs as MakePairs, without those with k* > fPairKStarMax.
+  // The collections are sorted in rapidity and each particle looks for its
+  // harder partners inside the rapidity window allowed by the k* limit,
+  // testing the k* of the four-momenta. The pairs found are then processed
+  // in the order of MakePairs, with the same particle swapping for
+  // identical particles, so the correlation functions receive the same
+  // pairs in the same order as with MakePairs and a k* cut in the pair cut.
+
+  const bool identical = (partCollection2 == nullptr);
+
+  std::vector<AliFemtoParticle*> particles1, particles2;
+  std::vector<KStarCandidate> candidates1, candidates2;
+  double minMass1, maxMass1, minMass2, maxMass2;
+  FillCandidates(partCollection1, 1, particles1, candidates1, minMass1, maxMass1);
+
+  // (outer, inner) indices of the pairs, as in the loops of MakePairs
+  std::vector<std::pair<unsigned int, unsigned int>> pairs;
+  if (identical) {
+    FindKStarPairs(candidates1, candidates1, minMass1, maxMass1, fPairKStarMax, false, pairs);
+    for (auto &pair : pairs) {
+      if (pair.first > pair.second) {
+        std::swap(pair.first, pair.second);
       }
+    }
+  } else {
+    FillCandidates(partCollection2, 2, particles2, candidates2, minMass2, maxMass2);
+    FindKStarPairs(candidates1, candidates2, minMass2, maxMass2, fPairKStarMax, false, pairs);
+    FindKStarPairs(candidates2, candidates1, minMass1, maxMass1, fPairKStarMax, true, pairs);
+  }
+  std::sort(pairs.begin(), pairs.end());
 
-    }    // loop over second particle
-  }      // loop over first particle
+  // MakePairs flips swpart after each pair, i.e. the value for a pair is
+  // given by the parity of its position in the loops
+  const bool swpartSeed = fNeventsProcessed % 2;
+  const unsigned long long n = particles1.size();
+
+  AliFemtoPair* tPair = new AliFemtoPair;
+  tPair->SetRandom(PairRandom());
+
+  for (const auto &pair : pairs) {
+    AliFemtoParticle *part1 = particles1[pair.first];
+    if (!identical) {
+      tPair->SetTrack1(part1);
+      tPair->SetTrack2(particles2[pair.second]);
+    } else {
+      AliFemtoParticle *part2 = particles1[pair.second];
+      const unsigned long long i = pair.first,
+                               j = pair.second,
+                               position = i * (n - 1) - i * (i - 1) / 2 + (j - i - 1);
+      const bool swpart = swpartSeed != (position % 2 == 1);
+      tPair->SetTrack1(swpart ? part2 : part1);
+      tPair->SetTrack2(swpart ? part1 : part2);
+    }
+
+    ProcessPair(tPair, realPairs, enablePairMonitors);
+  }
 
-  // we are done with the pair
   delete tPair;
 }
 //_________________________
@@ -16,6 +16,8 @@
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
 
+#include <TRandom3.h>
+
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
 
@@ -40,6 +42,12 @@ class AliFemtoPicoEvent;
 /// - specify how many events are to be strored in the mixing buffer for
 ///  background construction
 ///
+/// - optionally, if all correlation functions are limited to small relative
+///  momenta, set the maximal k* with SetPairKStarMax. Pairs above it are
+///  rejected from the four-momenta of the particles before the pair cut is
+///  called, and the particles are sorted in rapidity so that only partners
+///  which can be below the k* limit are looped over.
+///
 /// Then, when the analysis is run, for each event, the EventBegin is
 /// called before any processing is done, then the ProcessEvent is called
 /// which takes care of creating real and mixed pairs and sending them
@@ -99,6 +107,20 @@ public:
   void SetEnablePairMonitors(Bool_t aEnable);
   Bool_t EnablePairMonitors();
 
+  /// Pairs with k* above kStarMax are never built: they are not seen by the
+  /// pair cut (nor its monitors) and the correlation functions.
+  /// A value <= 0 (default) disables the preselection.
+  void SetPairKStarMax(double kStarMax);
+  double PairKStarMax() const;
+
+  /// Seed of the generator used for the random particle ordering of the
+  /// pairs (YKP momenta). Without a seed the pairs use rand(), as before;
+  /// with one the analysis owns its generator, so its results do not depend
+  /// on other analyses or on the thread it runs in. AliFemtoManager gives
+  /// each analysis without a seed its own one when it runs them in threads.
+  void SetRandomSeed(UInt_t seed);
+  bool HasRandomSeed() const;
+
   unsigned int NumEventsToMix() const;
   void SetNumEventsToMix(const unsigned int& NumberOfEventsToMix);
   AliFemtoPicoEvent* CurrentPicoEvent();
@@ -159,6 +181,15 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Pair loop of MakePairs with the k* preselection (see SetPairKStarMax)
+  void MakePairsKStarPreselected(bool realPairs,
+                                 AliFemtoParticleCollection* ParticlesPassingCut1,
+                                 AliFemtoParticleCollection* ParticlesPassingCut2,
+                                 Bool_t enablePairMonitors);
+
+  /// Apply the pair cut and pass the pair to the correlation functions
+  void ProcessPair(AliFemtoPair* pair, bool realPair, Bool_t enablePairMonitors);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -177,6 +208,12 @@ protected:
   Bool_t fVerbose;
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
+  double fPairKStarMax;                              ///< Pairs with larger k* are rejected before the pair cut (<=0 no preselection)
+  TRandom3 fRandom;                                  //!<! Generator given to the pairs of this analysis
+  bool fUseOwnRandom;                                //!<! fRandom was seeded, otherwise the pairs use rand()
+
+  /// Generator for the pairs, nullptr to keep rand()
+  TRandom* PairRandom();
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -305,4 +342,30 @@ inline void AliFemtoSimpleAnalysis::SetEnablePairMonitors(Bool_t aEnable)
   fEnablePairMonitors = aEnable;
 }
 
+inline void AliFemtoSimpleAnalysis::SetPairKStarMax(double kStarMax)
+{
+  fPairKStarMax = kStarMax;
+}
+
+inline double AliFemtoSimpleAnalysis::PairKStarMax() const
+{
+  return fPairKStarMax;
+}
+
+inline void AliFemtoSimpleAnalysis::SetRandomSeed(UInt_t seed)
+{
+  fRandom.SetSeed(seed);
+  fUseOwnRandom = true;
+}
+
+inline bool AliFemtoSimpleAnalysis::HasRandomSeed() const
+{
+  return fUseOwnRandom;
+}
+
+inline TRandom* AliFemtoSimpleAnalysis::PairRandom()
+{
+  return fUseOwnRandom ? &fRandom : nullptr;
+}
+
 #endif
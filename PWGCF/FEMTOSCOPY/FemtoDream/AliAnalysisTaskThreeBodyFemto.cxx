@@ -930,12 +930,12 @@ void AliAnalysisTaskThreeBodyFemto::FillTripletDistributionMEPP(std::vector<std:
   for (auto iPart1 = ParticleSE->begin(); iPart1 != ParticleSE->end(); ++iPart1) {
     // loop over second particle ...
     for (int iDepth1 = 0; iDepth1 < (int) MixedEvent1Container->GetMixingDepth(); ++iDepth1) {    
-      std::vector<AliFemtoDreamBasePart> iEvent2 = MixedEvent1Container->GetEvent(iDepth1);
+      std::vector<AliFemtoDreamBasePart> &iEvent2 = MixedEvent1Container->GetEvent(iDepth1);
       for ( auto iPart2 = iEvent2.begin(); iPart2 != iEvent2.end(); ++iPart2) {
         int iDepth2 = 0;
         if(speciesME1==speciesME2) iDepth2 = iDepth1+1; 
         for ( ; iDepth2 < (int) MixedEvent2Container->GetMixingDepth(); ++iDepth2) {
-          std::vector<AliFemtoDreamBasePart> iEvent3 = MixedEvent2Container->GetEvent(iDepth2);
+          std::vector<AliFemtoDreamBasePart> &iEvent3 = MixedEvent2Container->GetEvent(iDepth2);
           for ( auto iPart3 = iEvent3.begin(); iPart3 != iEvent3.end(); ++iPart3) {
             bool Pair12 = true;
             bool Pair23 = true;
@@ -1012,11 +1012,11 @@ void AliAnalysisTaskThreeBodyFemto::FillTripletDistributionMEPPTEST(std::vector<
   for (auto iPart1 = ParticleSE->begin(); iPart1 != ParticleSE->end(); ++iPart1) {
     // loop over second particle ...
     for (int iDepth1 = 0; iDepth1 < (int) MixedEvent1Container->GetMixingDepth(); ++iDepth1) {    
-      std::vector<AliFemtoDreamBasePart> iEvent2 = MixedEvent1Container->GetEvent(iDepth1);
+      std::vector<AliFemtoDreamBasePart> &iEvent2 = MixedEvent1Container->GetEvent(iDepth1);
       for ( auto iPart2 = iEvent2.begin(); iPart2 != iEvent2.end(); ++iPart2) {
         for ( auto iDepth2 = 0; iDepth2 < (int) MixedEvent2Container->GetMixingDepth(); ++iDepth2) {
           if(iDepth1==iDepth2) continue;
-          std::vector<AliFemtoDreamBasePart> iEvent3 = MixedEvent2Container->GetEvent(iDepth2);
+          std::vector<AliFemtoDreamBasePart> &iEvent3 = MixedEvent2Container->GetEvent(iDepth2);
           for ( auto iPart3 = iEvent3.begin(); iPart3 != iEvent3.end(); ++iPart3) {
             // Now we have the three particles, lets create their Lorentz vectors  
             TLorentzVector part1_LorVec, part2_LorVec, part3_LorVec;
@@ -1061,7 +1061,7 @@ void AliAnalysisTaskThreeBodyFemto::FillPairDistributionME(std::vector<std::vect
   for (auto iPart1 = ParticleSE->begin(); iPart1 != ParticleSE->end(); ++iPart1) {
     // loop over second particle ...
     for (int iDepth1 = 0; iDepth1 < (int) MixedEvent1Container->GetMixingDepth(); ++iDepth1) {    
-      std::vector<AliFemtoDreamBasePart> iEvent2 = MixedEvent1Container->GetEvent(iDepth1);
+      std::vector<AliFemtoDreamBasePart> &iEvent2 = MixedEvent1Container->GetEvent(iDepth1);
       for ( auto iPart2 = iEvent2.begin(); iPart2 != iEvent2.end(); ++iPart2) {
         if(speciesSE==0 && speciesME1 ==0){
           if(!DeltaEtaDeltaPhi(*iPart1,*iPart2,false,11, fEventTripletPhiThetaArray[16],fEventTripletPhiThetaArray[17], Config)){continue;}
@@ -1109,7 +1109,7 @@ void AliAnalysisTaskThreeBodyFemto::FillTripletDistributionSE2ME1(std::vector<st
     for(;iPart2 != ParticleSE2->end(); ++iPart2)
     {
       for ( int iDepth1 = 0; iDepth1 < (int) MixedEventContainer->GetMixingDepth(); ++iDepth1) {
-        std::vector<AliFemtoDreamBasePart> iEvent3 = MixedEventContainer->GetEvent(iDepth1);
+        std::vector<AliFemtoDreamBasePart> &iEvent3 = MixedEventContainer->GetEvent(iDepth1);
         for ( auto iPart3 = iEvent3.begin(); iPart3 != iEvent3.end(); ++iPart3) {
           // Now we have the three particles, lets create their Lorentz vectors  
           TLorentzVector part1_LorVec, part2_LorVec, part3_LorVec;
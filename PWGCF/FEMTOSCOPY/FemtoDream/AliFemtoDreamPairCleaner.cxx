@@ -161,15 +161,16 @@ void AliFemtoDreamPairCleaner::CleanDecay(
 }
 
 void AliFemtoDreamPairCleaner::StoreParticle(
-    std::vector<AliFemtoDreamBasePart> Particles) {
-  std::vector<AliFemtoDreamBasePart> tmpParticles;
-  for (auto itPart : Particles) {
+    const std::vector<AliFemtoDreamBasePart> &Particles) {
+  fParticles.emplace_back();
+  std::vector<AliFemtoDreamBasePart> &tmpParticles = fParticles.back();
+  tmpParticles.reserve(Particles.size());
+  for (auto &itPart : Particles) {
     if (itPart.UseParticle()) {
       tmpParticles.push_back(itPart);
       fCounter++;
     }
   }
-  fParticles.push_back(tmpParticles);
 }
 void AliFemtoDreamPairCleaner::ResetArray() {
   fCounter = 0;
@@ -12,13 +12,17 @@
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer()
     : fPartBuffer(),
-      fMixingDepth(0) {
+      fMixingDepth(0),
+      fFirstEvent(0),
+      fNEvents(0) {
 
 }
 
 AliFemtoDreamPartContainer::AliFemtoDreamPartContainer(int MixingDepth)
-    : fPartBuffer(),
-      fMixingDepth(MixingDepth) {
+    : fPartBuffer(MixingDepth),
+      fMixingDepth(MixingDepth),
+      fFirstEvent(0),
+      fNEvents(0) {
 
 }
 
@@ -36,6 +40,8 @@ AliFemtoDreamPartContainer& AliFemtoDreamPartContainer::operator=(
 //  }
   this->fMixingDepth = obj.fMixingDepth;
   this->fPartBuffer = obj.fPartBuffer;
+  this->fFirstEvent = obj.fFirstEvent;
+  this->fNEvents = obj.fNEvents;
   return (*this);
 }
 
@@ -43,32 +49,33 @@ AliFemtoDreamPartContainer::~AliFemtoDreamPartContainer() {
 }
 
 void AliFemtoDreamPartContainer::SetEvent(
-    std::vector<AliFemtoDreamBasePart> &Particles) {
-  if (!(fPartBuffer.size() < fMixingDepth)) {
-//    std::cout << "Popping Front" << std::endl;
-    fPartBuffer.pop_front();
+    const std::vector<AliFemtoDreamBasePart> &Particles) {
+  if (fMixingDepth == 0) {
+    return;
+  }
+  unsigned int slot;
+  if (fNEvents < fMixingDepth) {
+    slot = (fFirstEvent + fNEvents) % fMixingDepth;
+    fNEvents++;
+  } else {
+    //Overwrite the oldest event, the assignment reuses its memory
+    slot = fFirstEvent;
+    fFirstEvent = (fFirstEvent + 1) % fMixingDepth;
   }
-  fPartBuffer.push_back(Particles);
-//  std::cout << "PartBuffer Size: "<<fPartBuffer.size()<<'\t'<<"Input Size: "
-//      << Particles.size() << '\n';
+  fPartBuffer[slot] = Particles;
   return;
 }
 
 void AliFemtoDreamPartContainer::PrintLastEvent() {
-  for (std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt =
-      fPartBuffer.begin(); itEvt != fPartBuffer.end(); ++itEvt) {
-    std::cout << "Printing Last Event with size: " << itEvt->size() << '\n';
-    for (std::vector<AliFemtoDreamBasePart>::iterator itPart = itEvt->begin();
-        itPart != itEvt->end(); ++itPart) {
+  for (unsigned int iEvt = 0; iEvt < fNEvents; ++iEvt) {
+    std::vector<AliFemtoDreamBasePart> &Event = GetEvent(iEvt);
+    std::cout << "Printing Last Event with size: " << Event.size() << '\n';
+    for (std::vector<AliFemtoDreamBasePart>::iterator itPart = Event.begin();
+        itPart != Event.end(); ++itPart) {
       TVector3 P(itPart->GetMomentum());
       std::cout << "Px: " << P.X() << '\t' << "Py: " << P.Y() << '\t' << "Pz: "
                 << P.Z() << std::endl;
     }
   }
 }
-std::vector<AliFemtoDreamBasePart> &AliFemtoDreamPartContainer::GetEvent(
-    int Depth) {
-  std::deque<std::vector<AliFemtoDreamBasePart>>::iterator itEvt = fPartBuffer
-      .begin() + Depth;
-  return *itEvt;
-}
+
@@ -7,7 +7,6 @@
 
 #ifndef ALIFEMTODREAMPARTCONTAINER_H_
 #define ALIFEMTODREAMPARTCONTAINER_H_
-#include <deque>
 #include <vector>
 #include "Rtypes.h"
 
@@ -16,6 +15,11 @@
 //Class Containing the Particles from previous Events up to a certain mixing
 //depth for one Particle Species and Mult/ZVtx Bin
 //ZVtx bin.
+//The events are kept in a ring of MixingDepth slots allocated once: a new
+//event is copied into the slot of the oldest one, so that the particle
+//vectors (and the vectors inside the particles) keep their capacity and
+//no allocations are needed once the buffer is full. GetEvent returns a
+//reference to the slot, the consumers should not copy it.
 class AliFemtoDreamPartContainer {
  public:
   AliFemtoDreamPartContainer();
@@ -23,19 +27,21 @@ class AliFemtoDreamPartContainer {
   AliFemtoDreamPartContainer& operator=(const AliFemtoDreamPartContainer& obj);
   virtual ~AliFemtoDreamPartContainer();
   void PrintLastEvent();
-  void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles);
-  std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer() const {
-    return fPartBuffer;
+  void SetEvent(const std::vector<AliFemtoDreamBasePart> &Particles);
+  //Depth 0 is the oldest event in the buffer
+  std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth) {
+    return fPartBuffer[(fFirstEvent + Depth) % fMixingDepth];
   }
   ;
-  std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth);
   unsigned int GetMixingDepth() const {
-    return fPartBuffer.size();
+    return fNEvents;
   }
   ;
  private:
-  std::deque<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
-  unsigned int fMixingDepth;ClassDef(AliFemtoDreamPartContainer,2)
+  std::vector<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
+  unsigned int fMixingDepth;
+  unsigned int fFirstEvent;
+  unsigned int fNEvents;ClassDef(AliFemtoDreamPartContainer,3)
   ;
 };
 
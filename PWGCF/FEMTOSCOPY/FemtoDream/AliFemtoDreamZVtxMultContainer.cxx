@@ -9,12 +9,14 @@
 #include "AliFemtoDreamZVtxMultContainer.h"
 #include "TLorentzVector.h"
 #include "TDatabasePDG.h"
+#include "AliLog.h"
 #include "TVector2.h"
 
 ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
     : fPartContainer(0),
       fPDGParticleSpecies(0),
+      fMassParticleSpecies(0),
       fWhichPairs(){
 }
 
@@ -23,16 +25,34 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
     : fPartContainer(conf->GetNParticles(),
                      AliFemtoDreamPartContainer(conf->GetMixingDepth())),
       fPDGParticleSpecies(conf->GetPDGCodes()),
+      fMassParticleSpecies(),
       fWhichPairs(conf->GetWhichPairs()){
   TDatabasePDG::Instance()->AddParticle("deuteron", "deuteron", 1.8756134,
                                         kTRUE, 0.0, 1, "Nucleus", 1000010020);
   TDatabasePDG::Instance()->AddAntiParticle("anti-deuteron", -1000010020);
+  //Look up the masses once instead of for every pair, codes which are not
+  //(yet) known to TDatabasePDG are looked up when they are first needed
+  for (auto itPDG : fPDGParticleSpecies) {
+    TParticlePDG *particle = TDatabasePDG::Instance()->GetParticle(itPDG);
+    fMassParticleSpecies.push_back(particle ? particle->Mass() : -1.);
+  }
 }
 
 AliFemtoDreamZVtxMultContainer::~AliFemtoDreamZVtxMultContainer() {
   // TODO Auto-generated destructor stub
 }
 
+double AliFemtoDreamZVtxMultContainer::LookUpMass(double &mass, int PDG) {
+  TParticlePDG *particle = TDatabasePDG::Instance()->GetParticle(PDG);
+  if (!particle) {
+    AliFatalGeneral("AliFemtoDreamZVtxMultContainer",
+                    Form("PDG code %d not found in TDatabasePDG", PDG));
+    return 0.;
+  }
+  mass = particle->Mass();
+  return mass;
+}
+
 void AliFemtoDreamZVtxMultContainer::SetEvent(
     std::vector<std::vector<AliFemtoDreamBasePart>> &Particles) {
   //This method sets the particles of an event only in the case, that
@@ -62,17 +82,20 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
   int HistCounter = 0;
   //First loop over all the different Species
   auto itPDGPar1 = fPDGParticleSpecies.begin();
+  auto itMassPar1 = fMassParticleSpecies.begin();
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
       ++itSpec1) {
     auto itPDGPar2 = fPDGParticleSpecies.begin();
     itPDGPar2 += itSpec1 - Particles.begin();
+    auto itMassPar2 = fMassParticleSpecies.begin();
+    itMassPar2 += itSpec1 - Particles.begin();
     for (auto itSpec2 = itSpec1; itSpec2 != Particles.end(); ++itSpec2) {
       HigherMath->FillPairCounterSE(HistCounter, itSpec1->size(),
                                     itSpec2->size());
       //Now loop over the actual Particles and correlate them
       for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
           ++itPart1) {
-        AliFemtoDreamBasePart part1 = *itPart1;
+        AliFemtoDreamBasePart &part1 = *itPart1;
         std::vector<AliFemtoDreamBasePart>::iterator itPart2;
         if (itSpec1 == itSpec2) {
           itPart2 = itPart1 + 1;
@@ -80,16 +103,14 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
           itPart2 = itSpec2->begin();
         }
         while (itPart2 != itSpec2->end()) {
-          AliFemtoDreamBasePart part2 = *itPart2;
+          AliFemtoDreamBasePart &part2 = *itPart2;
           TLorentzVector PartOne, PartTwo;
           PartOne.SetXYZM(
               itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-              itPart1->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
+              itPart1->GetMomentum().Z(), GetMass(*itMassPar1, *itPDGPar1));
           PartTwo.SetXYZM(
               itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-              itPart2->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+              itPart2->GetMomentum().Z(), GetMass(*itMassPar2, *itPDGPar2));
           float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
           if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
                                                RelativeK, true, false)) {
@@ -111,8 +132,10 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
       }
       ++HistCounter;
       itPDGPar2++;
+      itMassPar2++;
     }
     itPDGPar1++;
+    itMassPar1++;
   }
 }
 
@@ -121,6 +144,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
   int HistCounter = 0;
   auto itPDGPar1 = fPDGParticleSpecies.begin();
+  auto itMassPar1 = fMassParticleSpecies.begin();
   //First loop over all the different Species
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
       ++itSpec1) {
@@ -128,6 +152,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     //Particle1 + Particle2 == Particle2 + Particle 1
     int SkipPart = itSpec1 - Particles.begin();
     auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
+    auto itMassPar2 = fMassParticleSpecies.begin() + SkipPart;
     for (auto itSpec2 = fPartContainer.begin() + SkipPart;
         itSpec2 != fPartContainer.end(); ++itSpec2) {
       if (itSpec1->size() > 0) {
@@ -135,7 +160,8 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
                                              (int) itSpec2->GetMixingDepth());
       }
       for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
+        //Reference to the mixing buffer, no copy of the event
+        std::vector<AliFemtoDreamBasePart> &ParticlesOfEvent = itSpec2->GetEvent(
             iDepth);
         HigherMath->FillPairCounterME(HistCounter, itSpec1->size(),
                                       ParticlesOfEvent.size());
@@ -147,12 +173,10 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
             TLorentzVector PartOne, PartTwo;
             PartOne.SetXYZM(
                 itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-                itPart1->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
+                itPart1->GetMomentum().Z(), GetMass(*itMassPar1, *itPDGPar1));
             PartTwo.SetXYZM(
                 itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-                itPart2->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+                itPart2->GetMomentum().Z(), GetMass(*itMassPar2, *itPDGPar2));
             float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
             if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
                                                  RelativeK, false, false)) {
@@ -174,7 +198,9 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
       }
       ++HistCounter;
       ++itPDGPar2;
+      ++itMassPar2;
     }
     ++itPDGPar1;
+    ++itMassPar1;
   }
 }
@@ -41,8 +41,14 @@ class AliFemtoDreamZVtxMultContainer {
   }
   ;
  private:
+  //mass of a species, taken from TDatabasePDG when it was not known before
+  double GetMass(double &mass, int PDG) {
+    return (mass >= 0) ? mass : LookUpMass(mass, PDG);
+  }
+  double LookUpMass(double &mass, int PDG);
   std::vector<AliFemtoDreamPartContainer> fPartContainer;
   std::vector<int> fPDGParticleSpecies;
+  std::vector<double> fMassParticleSpecies;
   std::vector<unsigned int> fWhichPairs;
 //  std::vector<bool> fRejPairs;
 //  bool fDoDeltaEtaDeltaPhiCut;
@@ -50,7 +56,7 @@ class AliFemtoDreamZVtxMultContainer {
 //  float fDeltaPhiMax;
 //  float fDeltaPhiEtaMax;
 
-ClassDef(AliFemtoDreamZVtxMultContainer, 4)
+ClassDef(AliFemtoDreamZVtxMultContainer, 5)
   ;
 };
 
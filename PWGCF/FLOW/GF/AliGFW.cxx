@@ -78,13 +78,13 @@ Int_t AliGFW::CreateRegions() {
   //for(auto pitr = fRegions.begin(); pitr!=fRegions.end(); pitr++) pitr->PrintStructure();
   Int_t nRegions=0;
   for(auto pItr=fRegions.begin(); pItr!=fRegions.end(); pItr++) {
-    AliGFWCumulant *lCumulant = new AliGFWCumulant();
+    AliGFWCumulant lCumulant;
     if(pItr->NparVec.size()) {
-      lCumulant->CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
+      lCumulant.CreateComplexVectorArrayVarPower(pItr->Nhar, pItr->NparVec, pItr->NpT);
     } else {
-      lCumulant->CreateComplexVectorArray(pItr->Nhar, pItr->Npar, pItr->NpT);
+      lCumulant.CreateComplexVectorArray(pItr->Nhar, pItr->Npar, pItr->NpT);
     };
-    fCumulants.push_back(*lCumulant);
+    fCumulants.push_back(lCumulant);
     ++nRegions;
   };
   if(nRegions) fInitialized=kTRUE;
@@ -93,11 +93,34 @@ Int_t AliGFW::CreateRegions() {
 void AliGFW::Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask, Double_t SecondWeight) {
   if(!fInitialized) CreateRegions();
   if(!fInitialized) return;
+  ClearCalculated(); //Q-vectors change, so do the correlations
   for(Int_t i=0;i<(Int_t)fRegions.size();++i) {
     if(fRegions.at(i).EtaMin<eta && fRegions.at(i).EtaMax>eta && (fRegions.at(i).BitMask&mask))
       fCumulants.at(i).FillArray(eta,ptin,phi,weight,SecondWeight);
   };
 };
+void AliGFW::Fill(Int_t nTracks, const Double_t *eta, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Int_t *mask, const Double_t *SecondWeight) {
+  if(!fInitialized) CreateRegions();
+  if(!fInitialized) return;
+  ClearCalculated();
+  //For each region, collect the tracks in its acceptance and fill them at once
+  for(Int_t i=0;i<(Int_t)fRegions.size();++i) {
+    const Region &lRegion = fRegions.at(i);
+    fBatchPt.clear();
+    fBatchPhi.clear();
+    fBatchWeight.clear();
+    fBatchSecondWeight.clear();
+    for(Int_t j=0;j<nTracks;j++) {
+      if(!(lRegion.EtaMin<eta[j] && lRegion.EtaMax>eta[j] && (lRegion.BitMask&mask[j]))) continue;
+      fBatchPt.push_back(ptin[j]);
+      fBatchPhi.push_back(phi[j]);
+      fBatchWeight.push_back(weight[j]);
+      fBatchSecondWeight.push_back(SecondWeight?SecondWeight[j]:-1);
+    };
+    if(fBatchPt.size())
+      fCumulants.at(i).FillArray((Int_t)fBatchPt.size(),fBatchPt.data(),fBatchPhi.data(),fBatchWeight.data(),fBatchSecondWeight.data());
+  };
+};
 TComplex AliGFW::TwoRec(Int_t n1, Int_t n2, Int_t p1, Int_t p2, Int_t ptbin, AliGFWCumulant *r1, AliGFWCumulant *r2, AliGFWCumulant *r3) {
   TComplex part1 = r1->Vec(n1,p1,ptbin);
   TComplex part2 = r2->Vec(n2,p2,ptbin);
@@ -113,6 +136,12 @@ TComplex AliGFW::RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGF
   //Only valid for 1 particle of interest though!
   if(hars.size()<2) return qpoi->Vec(hars.at(0),pows.at(0),ptbin);
   if(hars.size()<3) return TwoRec(hars.at(0), hars.at(1),pows.at(0),pows.at(1), ptbin, qpoi, qref, qol);
+  //The same sub-correlators appear many times in the recursion (and in different configurations), so they are calculated once per event
+  vector<Int_t> lKey = {CumulantIndex(qpoi), CumulantIndex(qref), CumulantIndex(qol), ptbin};
+  lKey.insert(lKey.end(),hars.begin(),hars.end());
+  lKey.insert(lKey.end(),pows.begin(),pows.end());
+  auto lCalculated = fCalculatedCorr.find(lKey);
+  if(lCalculated!=fCalculatedCorr.end()) return lCalculated->second;
   Int_t harlast=hars.at(hars.size()-1);
   Int_t powlast=pows.at(pows.size()-1);
   hars.erase(hars.end()-1);
@@ -129,12 +158,12 @@ TComplex AliGFW::RecursiveCorr(AliGFWCumulant *qpoi, AliGFWCumulant *qref, AliGF
     //-- This is not aplicable anymore, since the overlap is explicitly specified
     formula-=RecursiveCorr(qpoi, qref, qol, ptbin, lhars, lpows);
   };
+  fCalculatedCorr[lKey] = formula;
   return formula;
 };
 void AliGFW::Clear() {
   for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs();
-  fCalculatedNames.clear();
-  fCalculatedQs.clear();
+  ClearCalculated();
 };
 TComplex AliGFW::Calculate(TString config, Bool_t SetHarmsToZero) {
   if(config.EqualTo("")) {
@@ -146,15 +175,14 @@ TComplex AliGFW::Calculate(TString config, Bool_t SetHarmsToZero) {
   TComplex ret(1,0);
   while(config.Tokenize(tmp,sz1,"}")) {
     if(SetHarmsToZero) SetHarmonicsToZero(tmp);
-    /*Int_t ind=FindCalculated(tmp);
-    if(ind>=0) {
-      ret*=fCalculatedQs.at(ind);
+    auto lCalculated = fCalculated.find(tmp);
+    if(lCalculated!=fCalculated.end()) {
+      ret*=lCalculated->second;
       continue;
-    };*/
+    };
     TComplex val=CalculateSingle(tmp);
     ret*=val;
-    fCalculatedQs.push_back(val);
-    fCalculatedNames.push_back(tmp);
+    fCalculated[tmp]=val;
   };
   return ret;
 };
@@ -304,13 +332,6 @@ Int_t AliGFW::FindRegionByName(TString refName) {
   for(Int_t i=0;i<(Int_t)fRegions.size();i++) if(fRegions.at(i).rName.EqualTo(refName)) return i;
   return -1;
 };
-Int_t AliGFW::FindCalculated(TString identifier) {
-  if(fCalculatedNames.size()==0) return -1;
-  for(Int_t i=0;i<(Int_t)fCalculatedNames.size();i++) {
-    if(fCalculatedNames.at(i).EqualTo(identifier)) return i;
-  };
-  return -1;
-};
 Bool_t AliGFW::SetHarmonicsToZero(TString &instr) {
   TString tmp;
   Ssiz_t sz1=0, sz2;
@@ -8,6 +8,7 @@ Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 #include <vector>
 #include <utility>
 #include <algorithm>
+#include <map>
 #include "TString.h"
 #include "TObjArray.h"
 using std::vector;
@@ -56,6 +57,8 @@ class AliGFW {
   void AddRegion(TString refName, Int_t lNhar, Int_t *lNparVec, Double_t lEtaMin, Double_t lEtaMax, Int_t lNpT=1, Int_t BitMask=1);
   Int_t CreateRegions();
   void Fill(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Int_t mask, Double_t secondWeight=-1);
+  //Batch fill of nTracks tracks; secondWeight can be 0 (not used)
+  void Fill(Int_t nTracks, const Double_t *eta, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Int_t *mask, const Double_t *secondWeight=0);
   void Clear();// { for(auto ptr = fCumulants.begin(); ptr!=fCumulants.end(); ++ptr) ptr->ResetQs(); };
   AliGFWCumulant GetCumulant(Int_t index) { return fCumulants.at(index); };
   TComplex Calculate(TString config, Bool_t SetHarmsToZero=kFALSE);
@@ -71,9 +74,14 @@ class AliGFW {
   void AddRegion(Region inreg) { fRegions.push_back(inreg); };
   Region GetRegion(Int_t index) { return fRegions.at(index); };
   Int_t FindRegionByName(TString refName);
-  vector<TString> fCalculatedNames;
-  vector<TComplex> fCalculatedQs;
-  Int_t FindCalculated(TString identifier);
+  std::map<TString, TComplex> fCalculated; //Results of CalculateSingle for the current event
+  std::map<vector<Int_t>, TComplex> fCalculatedCorr; //Results of RecursiveCorr for the current event
+  vector<Int_t> fBatchPt; //Buffers for the batch fill
+  vector<Double_t> fBatchPhi;
+  vector<Double_t> fBatchWeight;
+  vector<Double_t> fBatchSecondWeight;
+  Int_t CumulantIndex(AliGFWCumulant *cumulant) { return cumulant?(cumulant-fCumulants.data()):-1; };
+  void ClearCalculated() { fCalculated.clear(); fCalculatedCorr.clear(); };
   //Calculateing functions:
   TComplex Calculate(Int_t poi, Int_t ref, vector<Int_t> hars, Int_t ptbin=0); //For differential, need POI and reference
   TComplex Calculate(Int_t poi, vector<Int_t> hars); //For integrated case
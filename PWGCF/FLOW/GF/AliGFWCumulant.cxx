@@ -3,16 +3,22 @@ Author: Vytautas Vislavicius
 Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 */
 #include "AliGFWCumulant.h"
+#include <algorithm>
 
 AliGFWCumulant::AliGFWCumulant():
-  fQvector(0),
+  fQRe(),
+  fQIm(),
+  fOffsets(),
+  fBlockSize(0),
   fUsed(kBlank),
   fNEntries(-1),
   fN(1),
   fPow(1),
   fPt(1),
-  fFilledPts(0),
-  fInitialized(kFALSE)
+  fFilledPts(),
+  fInitialized(kFALSE),
+  fMaxPow(0),
+  fPrefactors()
 {
 };
 
@@ -21,53 +27,68 @@ AliGFWCumulant::~AliGFWCumulant()
   //printf("Destructor (?) for some reason called?\n");
   //DestroyComplexVectorArray();
 };
+void AliGFWCumulant::AddTrack(Int_t ptin, Double_t phi, Double_t weight, Double_t SecondWeight) {
+  //Weight prefactor for each power; multiplication is cheaper than power
+  //Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
+  //this is important when POIs are a subset of REFs and have different weights than REFs
+  Double_t *lPrefactors = fPrefactors.data();
+  lPrefactors[0] = 1;
+  for(Int_t lPow=1; lPow<fMaxPow; lPow++)
+    lPrefactors[lPow] = lPrefactors[lPow-1]*((SecondWeight>0 && lPow>1)?SecondWeight:weight);
+  //cos(n*phi) and sin(n*phi) from the angle-addition recurrence, only one sin/cos per track
+  const Double_t lCos1 = TMath::Cos(phi);
+  const Double_t lSin1 = TMath::Sin(phi);
+  Double_t lCos = 1;
+  Double_t lSin = 0;
+  Double_t *lQRe = fQRe.data() + ptin*fBlockSize;
+  Double_t *lQIm = fQIm.data() + ptin*fBlockSize;
+  for(Int_t lN = 0; lN<fN; lN++) {
+    Double_t *lQReN = lQRe + fOffsets[lN];
+    Double_t *lQImN = lQIm + fOffsets[lN];
+    const Int_t lNPow = fPowVec[lN];
+    for(Int_t lPow=0; lPow<lNPow; lPow++) {
+      lQReN[lPow] += lPrefactors[lPow]*lCos;
+      lQImN[lPow] += lPrefactors[lPow]*lSin;
+    };
+    const Double_t lCosNext = lCos*lCos1 - lSin*lSin1;
+    lSin = lSin*lCos1 + lCos*lSin1;
+    lCos = lCosNext;
+  };
+};
 void AliGFWCumulant::FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t weight, Double_t SecondWeight) {
   if(!fInitialized)
     CreateComplexVectorArray(1,1,1);
   if(fPt==1) ptin=0; //If one bin, then just fill it straight; otherwise, if ptin is out-of-range, do not fill
   else if(ptin<0 || ptin>=fPt) return;
   fFilledPts[ptin] = kTRUE;
-  for(Int_t lN = 0; lN<fN; lN++) {
-    Double_t lSin = TMath::Sin(lN*phi); //No need to recalculate for each power
-    Double_t lCos = TMath::Cos(lN*phi); //No need to recalculate for each power
-    for(Int_t lPow=0; lPow<PW(lN); lPow++) {
-      Double_t lPrefactor = 0;
-      //Dont calculate it twice; multiplication is cheaper that power
-      //Also, if second weight is specified, then keep the first weight with power no more than 1, and us the other weight otherwise
-      //this is important when POIs are a subset of REFs and have different weights than REFs
-      if(SecondWeight>0 && lPow>1) lPrefactor = TMath::Power(SecondWeight, lPow-1)*weight;
-      else lPrefactor = TMath::Power(weight,lPow);
-      Double_t qsin = lPrefactor * lSin;
-      Double_t qcos = lPrefactor * lCos;
-      fQvector[ptin][lN][lPow](fQvector[ptin][lN][lPow].Re()+qcos,fQvector[ptin][lN][lPow].Im()+qsin);//+=TComplex(qcos,qsin);
-    };
-  };
+  AddTrack(ptin,phi,weight,SecondWeight);
   Inc();
 };
+void AliGFWCumulant::FillArray(Int_t nTracks, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Double_t *SecondWeight) {
+  if(!fInitialized)
+    CreateComplexVectorArray(1,1,1);
+  for(Int_t i=0; i<nTracks; i++) {
+    Int_t lPtIn = (fPt==1)?0:ptin[i];
+    if(lPtIn<0 || lPtIn>=fPt) continue;
+    fFilledPts[lPtIn] = kTRUE;
+    AddTrack(lPtIn,phi[i],weight[i],SecondWeight?SecondWeight[i]:-1);
+    Inc();
+  };
+};
 void AliGFWCumulant::ResetQs() {
   if(!fNEntries) return; //If 0 entries, then no need to reset. Otherwise, if -1, then just initialized and need to set to 0.
-  for(Int_t i=0; i<fPt; i++) {
-    fFilledPts[i] = kFALSE;
-    for(Int_t lN=0;lN<fN;lN++) {
-      for(Int_t lPow=0;lPow<PW(lN);lPow++) {
-  	       fQvector[i][lN][lPow](0.,0.);
-      };
-    };
-  };
+  std::fill(fFilledPts.begin(),fFilledPts.end(),kFALSE);
+  std::fill(fQRe.begin(),fQRe.end(),0.);
+  std::fill(fQIm.begin(),fQIm.end(),0.);
   fNEntries=0;
 };
 void AliGFWCumulant::DestroyComplexVectorArray() {
   if(!fInitialized) return;
-  for(Int_t l_n = 0; l_n<fN; l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      delete [] fQvector[i][l_n];
-    };
-  };
-  for(Int_t i=0;i<fPt;i++) {
-    delete [] fQvector[i];
-  };
-  delete [] fQvector;
-  delete [] fFilledPts;
+  fQRe.clear();
+  fQIm.clear();
+  fOffsets.clear();
+  fFilledPts.clear();
+  fPrefactors.clear();
   fInitialized=kFALSE;
   fNEntries=-1;
 };
@@ -83,23 +104,30 @@ void AliGFWCumulant::CreateComplexVectorArrayVarPower(Int_t N, vector<Int_t> Pow
   fN=N;
   fPow=0;
   fPt=Pt;
-  fFilledPts = new Bool_t[Pt];
   fPowVec = PowVec;
-  fQvector = new TComplex**[fPt];
-  for(Int_t i=0;i<fPt;i++) {
-    fQvector[i] = new TComplex*[fN];
-  };
+  fMaxPow = 1;
+  fOffsets.resize(fN);
+  Int_t lSize=0;
   for(Int_t l_n=0;l_n<fN;l_n++) {
-    for(Int_t i=0;i<fPt;i++) {
-      fQvector[i][l_n] = new TComplex[PW(l_n)];
-    };
+    fOffsets[l_n] = lSize;
+    lSize += PW(l_n);
+    if(PW(l_n)>fMaxPow) fMaxPow = PW(l_n);
   };
+  fBlockSize = lSize;
+  fQRe.resize(fPt*fBlockSize);
+  fQIm.resize(fPt*fBlockSize);
+  fFilledPts.resize(fPt);
+  fPrefactors.resize(fMaxPow);
   ResetQs();
   fInitialized=kTRUE;
 };
 TComplex AliGFWCumulant::Vec(Int_t n, Int_t p, Int_t ptbin) {
   if(!fInitialized) return 0;
   if(ptbin>=fPt || ptbin<0) ptbin=0;
-  if(n>=0) return fQvector[ptbin][n][p];
-  return TComplex::Conjugate(fQvector[ptbin][-n][p]);
+  if(n>=0) {
+    Int_t ind = ptbin*fBlockSize+fOffsets[n]+p;
+    return TComplex(fQRe[ind],fQIm[ind]);
+  };
+  Int_t ind = ptbin*fBlockSize+fOffsets[-n]+p;
+  return TComplex(fQRe[ind],-fQIm[ind]);
 };
@@ -8,6 +8,7 @@ Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 #include "TNamed.h"
 #include "TMath.h"
 #include "TAxis.h"
+#include <vector>
 using std::vector;
 class AliGFWCumulant {
  public:
@@ -15,12 +16,19 @@ class AliGFWCumulant {
   ~AliGFWCumulant();
   void ResetQs();
   void FillArray(Double_t eta, Int_t ptin, Double_t phi, Double_t weight=1, Double_t SecondWeight=-1);
+  //Batch fill of nTracks tracks. SecondWeight can be 0 (not used)
+  void FillArray(Int_t nTracks, const Int_t *ptin, const Double_t *phi, const Double_t *weight, const Double_t *SecondWeight=0);
   enum UsedFlags_t {kBlank = 0, kFull=1, kPt=2};
   void SetType(UInt_t infl) { DestroyComplexVectorArray(); fUsed = infl; };
   void Inc() { fNEntries++; };
   Int_t GetN() { return fNEntries; };
   // protected:
-  TComplex ***fQvector;
+  //Q-vectors are stored as flat arrays of real and imaginary parts: one block of fBlockSize per pT bin,
+  //within the block, harmonic n starts at fOffsets[n] and holds PW(n) powers
+  vector<Double_t> fQRe; //! Real parts
+  vector<Double_t> fQIm; //! Imaginary parts
+  vector<Int_t> fOffsets; //! Offsets of harmonics within a pT-bin block
+  Int_t fBlockSize; //! Size of a pT-bin block
   UInt_t fUsed;
   Int_t fNEntries;
   //Q-vectors. Could be done recursively, but maybe defining each one of them explicitly is easier to read
@@ -29,13 +37,17 @@ class AliGFWCumulant {
   Int_t fPow; //! Power
   vector<Int_t> fPowVec; //! Powers array
   Int_t fPt; //!fPt bins
-  Bool_t *fFilledPts;
+  vector<Bool_t> fFilledPts;
   Bool_t fInitialized; //Arrays are initialized
   void CreateComplexVectorArray(Int_t N=1, Int_t P=1, Int_t Pt=1);
   void CreateComplexVectorArrayVarPower(Int_t N=1, vector<Int_t> Pvec={1}, Int_t Pt=1);
   Int_t PW(Int_t ind) { return fPowVec.at(ind); }; //No checks to speed up, be carefull!!!
   void DestroyComplexVectorArray();
-  Bool_t IsPtBinFilled(Int_t ptb) { if(!fFilledPts) return kFALSE; return fFilledPts[ptb]; };
+  Bool_t IsPtBinFilled(Int_t ptb) { if(!fInitialized) return kFALSE; return fFilledPts[ptb]; };
+ private:
+  Int_t fMaxPow; //! Maximal power over all harmonics
+  vector<Double_t> fPrefactors; //! Weight prefactors per power, buffer for filling
+  void AddTrack(Int_t ptin, Double_t phi, Double_t weight, Double_t SecondWeight);
 };
 
 #endif
@@ -49,7 +49,10 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlan(),
+  fFillPlanClassOffsets(),
+  fFillPlanReady(kFALSE)
 {
   //
   // Constructor
@@ -71,7 +74,10 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlan(),
+  fFillPlanClassOffsets(),
+  fFillPlanReady(kFALSE)
 {
   //
   // Constructor
@@ -131,6 +137,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fFillPlanReady = kFALSE;
 }
 
 //_________________________________________________________________
@@ -144,6 +151,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fFillPlanReady = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -286,6 +294,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a histogram
   //
+  fFillPlanReady = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -431,6 +440,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF or THnFSparseF
   //
+  fFillPlanReady = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -484,6 +494,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
   //
   // add a multi-dimensional histogram THnF or THnSparseF with equal or variable bin widths
   //
+  fFillPlanReady = kFALSE;
   THashList* hList = (THashList*)fMainList.FindObject(histClass);
   if(!hList) {
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram list " << histClass << " not found!" << endl;
@@ -620,152 +631,185 @@ THnF* AliHistogramManager::CreateHistogram( const Char_t* name, const Char_t* ti
 
 
 //__________________________________________________________________
-void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
-  //
-  //  fill a class of histograms
-  //
-  THashList* hList = (THashList*)fMainList.FindObject(className);
-  if(!hList) {
-    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
-    cout << "         Histogram list not filled" << endl; */
-    return;
-  }
-  if(!hList) {
-    return;
-  }
-    
-  TIter next(hList);
-  TObject* h=0x0;
-  Bool_t isProfile;
-  Bool_t isTHn;
-  Int_t thnDim=0;
-  Bool_t isSparse=kFALSE;
-  Double_t fillValues[20]={0.0};
-  Int_t uid = 0;
-  Int_t varX=-1, varY=-1, varZ=-1, varT=-1, varW=-1;
-  Int_t dimension=0;
-  while((h=next())) {
-    Bool_t allVarsGood = kTRUE;
-    uid = h->GetUniqueID();
-    isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
-    isTHn = ((uid%100)>10 ? kTRUE : kFALSE);      
-    if(isTHn) thnDim = (uid%100)-10;        // the excess over 10 from the last 2 digits give the dimension of the THn
-    if(isTHn && ((TString)h->ClassName()).Contains("Sparse")) isSparse = kTRUE;
-    dimension = 0;
-    if(!isTHn) dimension = ((TH1*)h)->GetDimension();
-        
-    uid = (uid-(uid%100))/100;
-    varX = -1;
-    varY = -1;
-    varZ = -1;
-    varT = -1;
-    varW = -1;
-    if(uid>0) {
-      varW = uid%(fNVars+1)-1;
-      if(varW==0) varW=AliReducedVarManager::kNothing;
-      uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
-      if(uid>0) varT = uid - 1;
-      //cout << "Filling " << h->GetName() << " with varT " << varT << endl;
-    }
-        
-    if(!isTHn) {
-      varX = ((TH1*)h)->GetXaxis()->GetUniqueID();
-      if(fUsedVars[varX]) {
-        switch(dimension) {
+void AliHistogramManager::CompileFillPlan() {
+  //
+  // Decode the type and the variables of all the booked histograms into a flat list of fill steps,
+  //   ordered by histogram class. Histograms using variables which are not flagged as used are never filled
+  //   and are left out. The index of each histogram class in the plan is stored as its UniqueID.
+  //
+  fFillPlan.clear();
+  fFillPlanClassOffsets.clear();
+
+  TIter nextClass(&fMainList);
+  THashList* hList=0x0;
+  Int_t iclass=0;
+  while((hList=(THashList*)nextClass())) {
+    hList->SetUniqueID(iclass++);
+    fFillPlanClassOffsets.push_back(fFillPlan.size());
+
+    TIter next(hList);
+    TObject* h=0x0;
+    while((h=next())) {
+      FillStep step;
+      step.fHist = h;
+      step.fNVars = 0;
+      step.fVarW = AliReducedVarManager::kNothing;
+      Int_t varT = -1;
+
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);   // units digit encodes the isProfile
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+      Int_t thnDim = (isTHn ? (uid%100)-10 : 0);          // the excess over 10 from the last 2 digits give the dimension of the THn
+      uid = (uid-(uid%100))/100;
+      if(uid>0) {
+        step.fVarW = uid%(fNVars+1)-1;
+        if(step.fVarW==0) step.fVarW=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) varT = uid - 1;
+      }
+
+      if(isTHn) {
+        if(thnDim>kMaxFillVars) continue;
+        step.fKind = kFillTHn;
+        for(Int_t idim=0;idim<thnDim;++idim)
+          step.fVars[step.fNVars++] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
+      }
+      else {
+        TH1* h1 = (TH1*)h;
+        switch(h1->GetDimension()) {
           case 1:
-            if(isProfile) {
-              varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-              if(!fUsedVars[varY]) break;
-              if(varW>AliReducedVarManager::kNothing) { 
-                if(!fUsedVars[varW]) break;
-                ((TProfile*)h)->Fill(values[varX],values[varY],values[varW]);
-              }
-              else 
-                ((TProfile*)h)->Fill(values[varX],values[varY]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH1F*)h)->Fill(values[varX],values[varW]);
-              }
-              else
-                ((TH1F*)h)->Fill(values[varX]);
-            }
+            step.fKind = (isProfile ? kFillTProfile : kFillTH1);
+            step.fVars[step.fNVars++] = h1->GetXaxis()->GetUniqueID();
+            if(isProfile) step.fVars[step.fNVars++] = h1->GetYaxis()->GetUniqueID();
           break;
           case 2:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            if(isProfile) {
-              varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-              if(!fUsedVars[varZ]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TProfile2D*)h)->Fill(values[varX],values[varY],values[varZ]);        
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH2F*)h)->Fill(values[varX],values[varY], values[varW]);
-              }
-              else
-                ((TH2F*)h)->Fill(values[varX],values[varY]);
-            }
+            step.fKind = (isProfile ? kFillTProfile2D : kFillTH2);
+            step.fVars[step.fNVars++] = h1->GetXaxis()->GetUniqueID();
+            step.fVars[step.fNVars++] = h1->GetYaxis()->GetUniqueID();
+            if(isProfile) step.fVars[step.fNVars++] = h1->GetZaxis()->GetUniqueID();
           break;
           case 3:
-            varY = ((TH1*)h)->GetYaxis()->GetUniqueID();
-            if(!fUsedVars[varY]) break;
-            varZ = ((TH1*)h)->GetZaxis()->GetUniqueID();
-            if(!fUsedVars[varZ]) break;
+            step.fKind = (isProfile ? kFillTProfile3D : kFillTH3);
+            step.fVars[step.fNVars++] = h1->GetXaxis()->GetUniqueID();
+            step.fVars[step.fNVars++] = h1->GetYaxis()->GetUniqueID();
+            step.fVars[step.fNVars++] = h1->GetZaxis()->GetUniqueID();
             if(isProfile) {
-              if(!fUsedVars[varT]) break;
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT],values[varW]);
-              }
-              else
-                ((TProfile3D*)h)->Fill(values[varX],values[varY],values[varZ],values[varT]);
-            }
-            else {
-              if(varW>AliReducedVarManager::kNothing) {
-                if(!fUsedVars[varW]) break;
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ],values[varW]);
-              }
-              else
-                ((TH3F*)h)->Fill(values[varX],values[varY],values[varZ]);
+              if(varT<0) continue;
+              step.fVars[step.fNVars++] = varT;
             }
           break;
           default:
-          break;
-        }  // end switch
-      }
-    }  // end if(!isTHn)
-    else {
-      for(Int_t idim=0;idim<thnDim;++idim) {
-        if (isSparse) {
-          allVarsGood &= fUsedVars[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnSparseF*)h)->GetAxis(idim)->GetUniqueID()];
-        } else {
-          allVarsGood &= fUsedVars[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-          fillValues[idim] = values[((THnF*)h)->GetAxis(idim)->GetUniqueID()];
-        }
-      }
-      if(allVarsGood) {
-        if(varW>AliReducedVarManager::kNothing) {
-          if(fUsedVars[varW]) {
-            if (isSparse) ((THnSparseF*)h)->Fill(fillValues,values[varW]);
-            else          ((THnF*)h)->Fill(fillValues,values[varW]);
-          }
-        }
-        else {
-          if (isSparse) ((THnSparseF*)h)->Fill(fillValues);
-          else          ((THnF*)h)->Fill(fillValues);
+            continue;
         }
       }
+
+      Bool_t allVarsGood = kTRUE;
+      for(Int_t ivar=0;ivar<step.fNVars;++ivar) allVarsGood &= fUsedVars[step.fVars[ivar]];
+      if(step.fVarW>AliReducedVarManager::kNothing) allVarsGood &= fUsedVars[step.fVarW];
+      if(allVarsGood) fFillPlan.push_back(step);
     }
   }
+  fFillPlanClassOffsets.push_back(fFillPlan.size());
+  fFillPlanReady = kTRUE;
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassId(const Char_t* className) {
+  //
+  //  get the integer handle of a histogram class, to be used with FillHistClass(Int_t, ...)
+  //  The handles stay valid when new histograms or classes are booked
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) return -1;
+  if(!fFillPlanReady) CompileFillPlan();
+  return hList->GetUniqueID();
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillStepValues(const FillStep& step, const Float_t* values) const {
+  //
+  //  fill one histogram of the fill plan
+  //
+  const Int_t* v = step.fVars;
+  const Bool_t weighted = (step.fVarW>AliReducedVarManager::kNothing);
+  switch(step.fKind) {
+    case kFillTH1:
+      if(weighted) ((TH1F*)step.fHist)->Fill(values[v[0]],values[step.fVarW]);
+      else         ((TH1F*)step.fHist)->Fill(values[v[0]]);
+    break;
+    case kFillTProfile:
+      if(weighted) ((TProfile*)step.fHist)->Fill(values[v[0]],values[v[1]],values[step.fVarW]);
+      else         ((TProfile*)step.fHist)->Fill(values[v[0]],values[v[1]]);
+    break;
+    case kFillTH2:
+      if(weighted) ((TH2F*)step.fHist)->Fill(values[v[0]],values[v[1]],values[step.fVarW]);
+      else         ((TH2F*)step.fHist)->Fill(values[v[0]],values[v[1]]);
+    break;
+    case kFillTProfile2D:
+      if(weighted) ((TProfile2D*)step.fHist)->Fill(values[v[0]],values[v[1]],values[v[2]],values[step.fVarW]);
+      else         ((TProfile2D*)step.fHist)->Fill(values[v[0]],values[v[1]],values[v[2]]);
+    break;
+    case kFillTH3:
+      if(weighted) ((TH3F*)step.fHist)->Fill(values[v[0]],values[v[1]],values[v[2]],values[step.fVarW]);
+      else         ((TH3F*)step.fHist)->Fill(values[v[0]],values[v[1]],values[v[2]]);
+    break;
+    case kFillTProfile3D:
+      if(weighted) ((TProfile3D*)step.fHist)->Fill(values[v[0]],values[v[1]],values[v[2]],values[v[3]],values[step.fVarW]);
+      else         ((TProfile3D*)step.fHist)->Fill(values[v[0]],values[v[1]],values[v[2]],values[v[3]]);
+    break;
+    case kFillTHn:
+      {
+        Double_t fillValues[kMaxFillVars];
+        for(Int_t idim=0;idim<step.fNVars;++idim) fillValues[idim] = values[v[idim]];
+        if(weighted) ((THnBase*)step.fHist)->Fill(fillValues,values[step.fVarW]);
+        else         ((THnBase*)step.fHist)->Fill(fillValues);
+      }
+    break;
+    default:
+    break;
+  }
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values) {
+  //
+  //  fill a class of histograms
+  //
+  THashList* hList = (THashList*)fMainList.FindObject(className);
+  if(!hList) {
+    /*cout << "Warning in AliHistogramManager::FillHistClass(): Histogram list " << className << " not found!" << endl;
+    cout << "         Histogram list not filled" << endl; */
+    return;
+  }
+  if(!fFillPlanReady) CompileFillPlan();
+  FillHistClass(Int_t(hList->GetUniqueID()), values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classId, Float_t* values) {
+  //
+  //  fill a class of histograms, using the handle from GetHistClassId()
+  //
+  if(!fFillPlanReady) CompileFillPlan();
+  if(classId<0 || classId+1>=Int_t(fFillPlanClassOffsets.size())) return;
+  for(Int_t istep=fFillPlanClassOffsets[classId]; istep<fFillPlanClassOffsets[classId+1]; ++istep)
+    FillStepValues(fFillPlan[istep], values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classId, Float_t* values, Int_t nEntries, Int_t stride /*=AliReducedVarManager::kNVars*/) {
+  //
+  //  fill a class of histograms nEntries times, e.g. for all the pairs of an event,
+  //  with the value arrays values, values+stride, ..., values+(nEntries-1)*stride
+  //  Each histogram is filled with all the entries before moving to the next one
+  //
+  if(!fFillPlanReady) CompileFillPlan();
+  if(classId<0 || classId+1>=Int_t(fFillPlanClassOffsets.size())) return;
+  for(Int_t istep=fFillPlanClassOffsets[classId]; istep<fFillPlanClassOffsets[classId+1]; ++istep) {
+    const FillStep& step = fFillPlan[istep];
+    for(Int_t ientry=0; ientry<nEntries; ++ientry)
+      FillStepValues(step, values+ientry*stride);
+  }
 }
 
 //__________________________________________________________________
@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -68,7 +70,10 @@ class AliHistogramManager : public TObject {
                         Int_t nDimensions,
                         TAxis* axis);
   
+  Int_t GetHistClassId(const Char_t* className);     // integer handle of a histogram class (-1 if not defined)
   void FillHistClass(const Char_t* className, Float_t* values);
+  void FillHistClass(Int_t classId, Float_t* values);
+  void FillHistClass(Int_t classId, Float_t* values, Int_t nEntries, Int_t stride=AliReducedVarManager::kNVars);  // fill nEntries value arrays stored one after the other
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -106,7 +111,25 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // Fill plan: the histograms of all classes with their decoded type and variables, compiled once after booking
+  enum FillKind {
+    kFillTH1=0, kFillTProfile, kFillTH2, kFillTProfile2D, kFillTH3, kFillTProfile3D, kFillTHn
+  };
+  enum {kMaxFillVars=20};
+  struct FillStep {
+    TObject* fHist;               // histogram
+    Int_t fKind;                  // FillKind
+    Int_t fNVars;                 // number of variables
+    Int_t fVars[kMaxFillVars];    // variables in the order of the Fill() arguments
+    Int_t fVarW;                  // weight variable, kNothing if not weighted
+  };
+  std::vector<FillStep> fFillPlan;            //! fill steps of all histogram classes
+  std::vector<Int_t> fFillPlanClassOffsets;   //! first fill step of each histogram class (number of classes + 1 entries)
+  Bool_t fFillPlanReady;                      //! the fill plan matches the booked histograms
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  void CompileFillPlan();
+  void FillStepValues(const FillStep& step, const Float_t* values) const;
   
   ClassDef(AliHistogramManager, 4)
 };
@@ -22,6 +22,7 @@ using std::flush;
 #include "AliReducedVarManager.h"
 #include "AliReducedBaseTrack.h"
 #include "AliReducedTrackInfo.h"
+#include "AliReducedPairInfo.h"
 
 ClassImp(AliMixingHandler);
 
@@ -45,9 +46,14 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fVariables(),
   fNMixingVariables(0),
   fHistos(0x0),
+  fHistClassIds(),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fUseCompactPools(kFALSE),
+  fCompactPools(),
+  fPairMass2(),
+  fLegEnergies()
 {
   // 
   // default constructor
@@ -85,9 +91,14 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fVariables(),
   fNMixingVariables(0),
   fHistos(0x0),
+  fHistClassIds(),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fUseCompactPools(kFALSE),
+  fCompactPools(),
+  fPairMass2(),
+  fLegEnergies()
 {
   //
   // Named constructor
@@ -182,6 +193,13 @@ void AliMixingHandler::Init() {
   fPoolsLeg1.Expand(size); fPoolsLeg1.SetOwner(kTRUE);
   fPoolsLeg2.Expand(size); fPoolsLeg2.SetOwner(kTRUE);
   
+  if(fUseCompactPools && !CompactPoolsSupported()) {
+    cout << "AliMixingHandler::Init(): WARNING The compact pools cannot be used with this setup or with the flow and EMCal pair variables!" << endl;
+    cout << "                   Copies of the tracks will be pooled instead" << endl;
+    fUseCompactPools = kFALSE;
+  }
+  if(fUseCompactPools) fCompactPools.resize(size);
+  
   fPoolSize.Set(fNParallelCuts*size);
   for(Int_t i=0;i<fNParallelCuts*size;++i) fPoolSize[i] = 0;
   
@@ -221,6 +239,18 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   Int_t category = FindEventCategory(values);
   if(category<0) return;   // event characteristics outside the defined ranges
   
+  if(fUseCompactPools) {
+    CompactPool& pool = fCompactPools[category];
+    AddCompactLegs(pool.fLeg1, leg1List);
+    AddCompactLegs(pool.fLeg2, leg2List);
+    ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
+    if(mixingMask) {
+      RunCompactEventMixing(pool,mixingMask,type,values);
+      ResetPoolSizes(mixingMask,category);
+    }
+    return;
+  }
+  
   TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
   if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
   leg1PoolP->SetOwner(kTRUE);
@@ -425,18 +455,34 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
-  for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
-    TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
-    TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
-    if(!leg1Pool) continue;
-    if(!leg2Pool) continue;
+  // number of categories in which events were pooled
+  Int_t nPools = fPoolsLeg1.GetEntries();
+  if(fUseCompactPools) {
+    nPools = 0;
+    for(UInt_t icateg=0; icateg<fCompactPools.size(); ++icateg)
+      if(!fCompactPools[icateg].fLeg1.fEventFirstLeg.empty()) nPools++;
+  }
+  
+  for(Int_t icateg=0; icateg<nPools; ++icateg) {
+    TClonesArray *leg1Pool = 0x0;
+    TClonesArray *leg2Pool = 0x0;
+    if(fUseCompactPools) {
+      if(fCompactPools[icateg].fLeg1.fEventFirstLeg.empty()) continue;
+    }
+    else {
+      leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
+      leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
+      if(!leg1Pool) continue;
+      if(!leg2Pool) continue;
+    }
     
     for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) {
        Int_t bin = GetBinFromCategory(iVar, icateg);
        values[fVariables[iVar]] = 0.5*(fVariableLimits[iVar][bin] + fVariableLimits[iVar][bin+1]);
     }
     
-    RunEventMixing(leg1Pool,leg2Pool,mixingMask,type,values);
+    if(fUseCompactPools) RunCompactEventMixing(fCompactPools[icateg],mixingMask,type,values);
+    else                 RunEventMixing(leg1Pool,leg2Pool,mixingMask,type,values);
     ResetPoolSizes(mixingMask,icateg);
   }  // end loop over categories
 }
@@ -453,7 +499,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
   Int_t entries = leg1Pool->GetEntries();
   if(entries<2) return;
   
-  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  if(fHistClassIds.empty()) InitHistClassIds();
   
   TIter iterEv1Leg1Pool(leg1Pool);
   TIter iterEv1Leg2Pool(leg2Pool);
@@ -492,31 +538,22 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
           if(fMixingSetup==kMixCorrelation)   AliReducedVarManager::FillCorrelationInfo(ev1Leg1, ev2Leg2, values);
           ULong_t pairCutMask = IsPairSelected(values, 1);
           if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
+          if(fMixingSetup==kMixResonanceLegs) FillMixedPairHistograms(testFlags2, pairCutMask, 1, values);
           for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
             if((testFlags2)&(ULong_t(1)<<ibit)) { 
               //AliReducedVarManager::FillPairMEflow(ev1Leg1, ev2Leg2, values, ibit);
-              if(fMixingSetup==kMixResonanceLegs) {
-                if (fNParallelPairCuts>1) {
-                  for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-                    if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                    fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+1)->GetName(), values);
-                  }
-                } else {
-                  fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
-                }
-              }
               if(fMixingSetup==kMixCorrelation) {
                 Int_t pairType = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->PairType();
                 if (fNParallelPairCuts>1) {
                   ULong_t pairCutMaskCorr = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->GetQualityFlags();
                   for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
                     if (!((pairCutMaskCorr)&(ULong_t(1)<<jbit))) continue;
-                    if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*fNParallelCuts+pairType)->GetName(), values);
-                    else              fHistos->FillHistClass(histClassArr->At(ibit+jbit*fNParallelCuts)->GetName(), values);
+                    if (fMixLikeSign) fHistos->FillHistClass(fHistClassIds[ibit*3+jbit*fNParallelCuts+pairType], values);
+                    else              fHistos->FillHistClass(fHistClassIds[ibit+jbit*fNParallelCuts], values);
                   }
                 } else {
-                  if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+pairType)->GetName(), values);
-                  else              fHistos->FillHistClass(histClassArr->At(ibit)->GetName(), values);
+                  if (fMixLikeSign) fHistos->FillHistClass(fHistClassIds[ibit*3+pairType], values);
+                  else              fHistos->FillHistClass(fHistClassIds[ibit], values);
                 }
               }
             }
@@ -537,19 +574,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
 	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg1, type, values);
       ULong_t pairCutMask = IsPairSelected(values, 0);
       if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
-	  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-        if((testFlags2)&(ULong_t(1)<<ibit)) {
-            //AliReducedVarManager::FillPairMEflow(ev1Leg1, ev2Leg1, values, ibit);
-            if (fNParallelPairCuts>1) {
-                for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-                    if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                    fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+0)->GetName(), values);
-                }
-            } else {
-                fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
-            }
-        }
-      }
+      FillMixedPairHistograms(testFlags2, pairCutMask, 0, values);
 	}  // end loop over the ev2-leg1 list
   }  // end loop over the ev1-leg1 list
       
@@ -575,19 +600,7 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
             AliReducedVarManager::FillPairInfoME(ev1Leg2, ev2Leg2, type, values);
             ULong_t pairCutMask = IsPairSelected(values, 2);
             if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
-            for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
-                //AliReducedVarManager::FillPairMEflow(ev1Leg2, ev2Leg2, values, ibit);
-                if((testFlags2)&(ULong_t(1)<<ibit)) {
-                    if (fNParallelPairCuts>1) {
-                        for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
-                            if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                            fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+2)->GetName(), values);
-                        }
-                    } else {
-                        fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
-                    }
-                }
-            }
+            FillMixedPairHistograms(testFlags2, pairCutMask, 2, values);
         }  // end loop over the ev2-leg2 list
      }  // end loop over the ev1-leg2 list
    }  // end second event loop
@@ -659,6 +672,239 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
 }
 
 
+//_________________________________________________________________________
+void AliMixingHandler::InitHistClassIds() {
+  //
+  // Get the histogram manager handles of the histogram classes in fHistClassNames
+  //
+  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  fHistClassIds.resize(histClassArr->GetEntries());
+  for(Int_t i=0; i<histClassArr->GetEntries(); ++i)
+    fHistClassIds[i] = fHistos->GetHistClassId(histClassArr->At(i)->GetName());
+  delete histClassArr;
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::FillMixedPairHistograms(ULong_t testFlags, ULong_t pairCutMask, Int_t pairType, Float_t* values) {
+  //
+  // Fill the histograms of a mixed pair, for the track cuts in testFlags and the pair cuts in pairCutMask
+  // NOTE: pairType is 0 for leg1-leg1, 1 for leg1-leg2 and 2 for leg2-leg2 pairs (kMixResonanceLegs setup)
+  //
+  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+    if(!((testFlags)&(ULong_t(1)<<ibit))) continue;
+    if (fNParallelPairCuts>1) {
+      for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
+        if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
+        fHistos->FillHistClass(fHistClassIds[ibit*3+jbit*3*fNParallelCuts+pairType], values);
+      }
+    } else {
+      fHistos->FillHistClass(fHistClassIds[ibit*3+pairType], values);
+    }
+  }
+}
+
+
+//_________________________________________________________________________
+Bool_t AliMixingHandler::CompactPoolsSupported() const {
+  //
+  // The compact pools keep only the leg kinematics, so they can be used only for the resonance mixing
+  // and if no pair variable computed from other leg information (EMCal matching, event plane Q vectors) is used
+  //
+  if(fMixingSetup!=kMixResonanceLegs) return kFALSE;
+  const Int_t nLegVars = 8;
+  const Int_t legVars[nLegVars] = {
+    AliReducedVarManager::kPairLegEMCALmatchedEnergy, AliReducedVarManager::kPairLegEMCALmatchedEnergy+1,
+    AliReducedVarManager::kPairVZEROFlowSPNom+0*6+1, AliReducedVarManager::kPairVZEROFlowSPDenom+0*6+1,
+    AliReducedVarManager::kPairVZEROFlowSPNom+1*6+1, AliReducedVarManager::kPairVZEROFlowSPDenom+1*6+1,
+    AliReducedVarManager::kPairTPCFlowSPNom+1, AliReducedVarManager::kPairTPCFlowSPDenom+1
+  };
+  for(Int_t i=0; i<nLegVars; ++i)
+    if(AliReducedVarManager::GetUsedVar((AliReducedVarManager::Variables)legVars[i])) return kFALSE;
+  return kTRUE;
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::AddCompactLegs(CompactLegs& legs, TList* list) {
+  //
+  // Add the kinematics and cut masks of the tracks in list as a new event of a compact pool
+  //
+  if(legs.fEventFirstLeg.empty()) legs.fEventFirstLeg.push_back(0);
+  if(list) {
+    TIter next(list);
+    AliReducedBaseTrack* track=0x0;
+    while((track=(AliReducedBaseTrack*)next())) {
+      legs.fPx.push_back(track->Px());
+      legs.fPy.push_back(track->Py());
+      legs.fPz.push_back(track->Pz());
+      legs.fP.push_back(track->P());
+      legs.fPt.push_back(track->Pt());
+      legs.fCharge.push_back(track->Charge());
+      legs.fITSLayer0.push_back(track->IsA()==AliReducedTrackInfo::Class() ? ((AliReducedTrackInfo*)track)->ITSLayerHit(0) : -1);
+      legs.fFlags.push_back(track->GetFlags());
+    }
+  }
+  legs.fEventFirstLeg.push_back(legs.fFlags.size());
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::RunCompactEventMixing(CompactPool& pool, ULong_t mixingMask, Int_t type, Float_t* values) {
+  //
+  // Run event mixing over a compact pool. The pairs and the pair variables are the same as in RunEventMixing()
+  // and the pairs are filled in the same order: for each leg1 of the first event the cross pairs and then the
+  // leg1-leg1 pairs, followed by the leg2-leg2 pairs of the legs2 of the first event
+  //
+  Int_t entries = pool.fLeg1.GetNEvents();
+  if(entries<2) return;
+
+  if(fHistClassIds.empty()) InitHistClassIds();
+
+  // leg energies with the mass assumptions of the first (m1) and second (m2) leg of the pair
+  Float_t m1 = 0.0; Float_t m2 = 0.0;
+  AliReducedVarManager::GetLegMassAssumption(type,m1,m2);
+  const CompactLegs* legs[4] = {&pool.fLeg1, &pool.fLeg1, &pool.fLeg2, &pool.fLeg2};
+  const Float_t masses[4] = {m1, m2, m1, m2};
+  for(Int_t i=0; i<4; ++i) {
+    const std::vector<Float_t>& p = legs[i]->fP;
+    fLegEnergies[i].resize(p.size());
+    for(UInt_t il=0; il<p.size(); ++il)
+      fLegEnergies[i][il] = TMath::Sqrt(masses[i]*masses[i]+p[il]*p[il]);
+  }
+
+  for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
+    for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop
+      if(iev1==iev2) continue;
+      for(Int_t i=pool.fLeg1.fEventFirstLeg[iev1]; i<pool.fLeg1.fEventFirstLeg[iev1+1]; ++i) {
+        // cross pairs (ev1-leg1 - ev2-leg2)
+        MixCompactLegs(pool.fLeg1, fLegEnergies[0], i, i+1, pool.fLeg2, fLegEnergies[3], iev2, m1, m2, mixingMask, 1, type, values);
+        // like pairs (ev1-leg1 - ev2-leg1)
+        if(fMixLikeSign)
+          MixCompactLegs(pool.fLeg1, fLegEnergies[0], i, i+1, pool.fLeg1, fLegEnergies[1], iev2, m1, m2, mixingMask, 0, type, values);
+      }
+      if(!fMixLikeSign) continue;
+      // like pairs (ev1-leg2 - ev2-leg2)
+      MixCompactLegs(pool.fLeg2, fLegEnergies[2], pool.fLeg2.fEventFirstLeg[iev1], pool.fLeg2.fEventFirstLeg[iev1+1],
+                     pool.fLeg2, fLegEnergies[3], iev2, m1, m2, mixingMask, 2, type, values);
+    }  // end second event loop
+  }  // end first event loop
+
+  CleanCompactPool(pool, mixingMask);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::MixCompactLegs(const CompactLegs& legs1, const std::vector<Double_t>& energies1, Int_t first1, Int_t last1,
+                                      const CompactLegs& legs2, const std::vector<Double_t>& energies2, Int_t ev2,
+                                      Float_t m1, Float_t m2, ULong_t mixingMask, Int_t pairType, Int_t type, Float_t* values) {
+  //
+  // Make all the pairs between the legs [first1,last1) in legs1 and the legs of event ev2 in legs2, and fill the histograms
+  // The squared masses are computed at once for each leg of ev1 with all the legs of ev2,
+  //   the other pair variables are filled as in AliReducedVarManager::FillPairInfoME()
+  //
+  const Int_t first2 = legs2.fEventFirstLeg[ev2];
+  const Int_t n2 = legs2.fEventFirstLeg[ev2+1]-first2;
+  if(first1==last1 || n2==0) return;
+
+  const Bool_t fillMass = AliReducedVarManager::GetUsedVar(AliReducedVarManager::kMass);
+  if(Int_t(fPairMass2.size())<n2) fPairMass2.resize(n2);
+  Float_t* mass2 = &fPairMass2[0];
+  const Float_t* px2 = &legs2.fPx[first2];
+  const Float_t* py2 = &legs2.fPy[first2];
+  const Float_t* pz2 = &legs2.fPz[first2];
+  const Double_t* e2 = &energies2[first2];
+
+  AliReducedPairInfo pair;
+  pair.CandidateId(type);
+  for(Int_t i=first1; i<last1; ++i) {
+    // check that this leg has at least one common bit with the mixing mask
+    ULong_t testFlags1 = mixingMask & legs1.fFlags[i];
+    if(!testFlags1) continue;
+
+    const Float_t px1 = legs1.fPx[i];
+    const Float_t py1 = legs1.fPy[i];
+    const Float_t pz1 = legs1.fPz[i];
+    if(fillMass) {
+      const Double_t e1 = energies1[i];
+      for(Int_t j=0; j<n2; ++j)
+        mass2[j] = m1*m1+m2*m2 + 2.0*(e1*e2[j] - px1*px2[j] - py1*py2[j] - pz1*pz2[j]);
+    }
+
+    for(Int_t j=0; j<n2; ++j) {
+      // check that this leg has at least one common bit with the mixing mask and with the first leg
+      ULong_t testFlags2 = testFlags1 & legs2.fFlags[first2+j];
+      if(!testFlags2) continue;
+
+      const Int_t j2 = first2+j;
+      values[AliReducedVarManager::kPairTypeSPD] = (legs1.fITSLayer0[i]>=0 && legs2.fITSLayer0[j2]>=0 ? legs1.fITSLayer0[i]+legs2.fITSLayer0[j2] : -1.);
+      if(legs1.fCharge[i]*legs2.fCharge[j2]<0) pair.PairType(1);
+      else if(legs1.fCharge[i]>0)              pair.PairType(0);
+      else                                     pair.PairType(2);
+      values[AliReducedVarManager::kPairType] = pair.PairType();
+      values[AliReducedVarManager::kCandidateId] = type;
+      values[AliReducedVarManager::kPairChisquare] = -999.;
+      pair.PxPyPz(px1+px2[j], py1+py2[j], pz1+pz2[j]);
+
+      if(fillMass) {
+        values[AliReducedVarManager::kMass] = mass2[j];
+        if(values[AliReducedVarManager::kMass]<0.0) {
+          cout << "AliMixingHandler::MixCompactLegs(): Warning: Very small squared mass found. "
+               << "   Could be negative due to resolution of Float_t so it will be set to a small positive value." << endl;
+          cout << "   mass2: " << values[AliReducedVarManager::kMass] << endl;
+          values[AliReducedVarManager::kMass] = 0.0;
+        }
+        else
+          values[AliReducedVarManager::kMass] = TMath::Sqrt(values[AliReducedVarManager::kMass]);
+        pair.SetMass(values[AliReducedVarManager::kMass]);
+      }
+      AliReducedVarManager::FillPairKinematicsME(&pair, legs1.fPt[i], legs2.fPt[j2], values);
+      AliReducedVarManager::FillPairEfficiency(values);
+
+      ULong_t pairCutMask = IsPairSelected(values, pairType);
+      if(!pairCutMask) continue;   // fill histograms only if pair cuts are fulfilled
+      FillMixedPairHistograms(testFlags2, pairCutMask, pairType, values);
+    }  // end loop over the legs of the second event
+  }  // end loop over the legs of the first event
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::CleanCompactPool(CompactPool& pool, ULong_t mixingMask) {
+  //
+  // Unset the mixing flags, then remove the legs without enabled mixing flags and the events without legs left
+  //
+  CompactLegs* legs[2] = {&pool.fLeg1, &pool.fLeg2};
+  for(Int_t il=0; il<2; ++il)
+    for(UInt_t i=0; i<legs[il]->fFlags.size(); ++i) legs[il]->fFlags[i] &= ~mixingMask;
+
+  Int_t nEvents = pool.fLeg1.GetNEvents();
+  if(nEvents==0) return;
+  Int_t nKeptEvents = 0;
+  Int_t nKeptLegs[2] = {0, 0};
+  for(Int_t iev=0; iev<nEvents; ++iev) {
+    Int_t nLegs[2] = {0, 0};
+    for(Int_t il=0; il<2; ++il) {
+      CompactLegs& l = *legs[il];
+      for(Int_t i=l.fEventFirstLeg[iev]; i<l.fEventFirstLeg[iev+1]; ++i) {
+        if(!l.fFlags[i]) continue;
+        if(nKeptLegs[il]!=i) l.MoveLeg(i, nKeptLegs[il]);
+        nKeptLegs[il]++;
+        nLegs[il]++;
+      }
+    }
+    if(nLegs[0]+nLegs[1]==0) continue;
+    for(Int_t il=0; il<2; ++il) legs[il]->fEventFirstLeg[nKeptEvents] = nKeptLegs[il]-nLegs[il];
+    nKeptEvents++;
+  }
+  for(Int_t il=0; il<2; ++il) {
+    legs[il]->fEventFirstLeg[nKeptEvents] = nKeptLegs[il];
+    legs[il]->fEventFirstLeg.resize(nKeptEvents+1);
+    legs[il]->ResizeLegs(nKeptLegs[il]);
+  }
+}
+
+
 //_________________________________________________________________________
 ULong_t AliMixingHandler::IsPairSelected(Float_t* values, Int_t pairType) {
    //
@@ -713,6 +959,7 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
    cout << "Track downscale :: " << fDownscaleTracks << endl;
    cout << "No. parallel cuts :: " << fNParallelCuts << endl;
    cout << "Histogram class names :: " << fHistClassNames.Data() << endl;
+   cout << "Compact pools :: " << fUseCompactPools << endl;
   
    if(debugLevel<1) return;
   
@@ -736,6 +983,29 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       cout << endl;
       if(debugLevel<2) continue;
       
+      if(fUseCompactPools) {
+         const CompactPool& pool = fCompactPools[iCateg];
+         for(Int_t iev=0; iev<pool.fLeg1.GetNEvents(); ++iev) {
+            const CompactLegs* legs[2] = {&pool.fLeg1, &pool.fLeg2};
+            cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: "
+            << legs[0]->fEventFirstLeg[iev+1]-legs[0]->fEventFirstLeg[iev] << " / "
+            << legs[1]->fEventFirstLeg[iev+1]-legs[1]->fEventFirstLeg[iev] << endl;
+            if(debugLevel<3) continue;
+            
+            for(Int_t il=0; il<2; ++il) {
+               cout << "		Leg" << il+1 << " list" << endl;
+               for(Int_t itrack=legs[il]->fEventFirstLeg[iev]; itrack<legs[il]->fEventFirstLeg[iev+1]; ++itrack) {
+                  cout << "		track #" << itrack-legs[il]->fEventFirstLeg[iev] << " (p/px/py/pz/charge/flags) :: "
+                  << legs[il]->fP[itrack] << " / " << legs[il]->fPx[itrack] << " / "
+                  << legs[il]->fPy[itrack] << " / " << legs[il]->fPz[itrack] << "/" << Int_t(legs[il]->fCharge[itrack]) << " / " << flush;
+                  AliReducedVarManager::PrintBits(legs[il]->fFlags[itrack], fNParallelCuts);
+                  cout << endl;
+               }  // end loop over tracks
+            }
+         }  // end loop over events
+         continue;
+      }
+      
       TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(iCateg));
       if(!leg1PoolP) continue;
       TClonesArray &leg1Pool=*leg1PoolP;
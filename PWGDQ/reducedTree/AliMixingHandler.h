@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
@@ -45,6 +47,7 @@ public:
   void SetNParallelPairCuts(Int_t n) {fNParallelPairCuts = n;}
   void SetHistogramManager(AliHistogramManager* histos) {fHistos = histos;}
   void SetHistClassNames(const Char_t* names) {fHistClassNames = names;}
+  void SetUseCompactPools(Bool_t flag) {fUseCompactPools = flag;}
   void AddCrossPairsCut(AliReducedInfoCut* cut) {fCrossPairsCuts.Add(cut);}
   void AddOppositeSignPairsCut(AliReducedInfoCut* cut) {fCrossPairsCuts.Add(cut);}    // synonim function to AddCrossPairsCut() used for charged legs
   void AddLikePairsLeg1Cut(AliReducedInfoCut* cut) {fLikePairsLeg1Cuts.Add(cut);}
@@ -69,6 +72,7 @@ public:
   TString GetHistClassNames() const {return fHistClassNames;};
   Int_t GetNMixingVariables() const {return fNMixingVariables;}
   Int_t GetMixingSetup() const {return fMixingSetup;}
+  Bool_t GetUseCompactPools() const {return fUseCompactPools;}
   
   void Init();
   Int_t FindEventCategory(Float_t* values);
@@ -106,16 +110,58 @@ private:
   Int_t  fNMixingVariables;
   
   AliHistogramManager* fHistos;    // histogram manager
+  std::vector<Int_t> fHistClassIds;  //! histogram manager handles of the histogram classes in fHistClassNames
   
   TList fCrossPairsCuts;         // cut object for cross pairs 
   TList fLikePairsLeg1Cuts;    // cut object for LEG1 like pairs
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
+  // Compact pools: only the leg kinematics and track cut masks of the pooled events, stored contiguously.
+  // Supported for the resonance mixing setup, if the pair variables are not computed from the leg track details (flow, EMCal)
+  struct CompactLegs {
+    std::vector<Float_t> fPx;          // momentum components
+    std::vector<Float_t> fPy;
+    std::vector<Float_t> fPz;
+    std::vector<Float_t> fP;           // momentum
+    std::vector<Float_t> fPt;          // transverse momentum
+    std::vector<Char_t>  fCharge;      // charge
+    std::vector<Char_t>  fITSLayer0;   // hit in the first ITS layer (0 or 1), -1 if not an AliReducedTrackInfo
+    std::vector<ULong_t> fFlags;       // track cut mask
+    std::vector<Int_t>   fEventFirstLeg; // first leg of each pooled event, followed by the total number of legs
+    
+    Int_t GetNEvents() const {return (fEventFirstLeg.empty() ? 0 : Int_t(fEventFirstLeg.size())-1);}
+    void MoveLeg(Int_t from, Int_t to) {
+      fPx[to] = fPx[from]; fPy[to] = fPy[from]; fPz[to] = fPz[from]; fP[to] = fP[from]; fPt[to] = fPt[from];
+      fCharge[to] = fCharge[from]; fITSLayer0[to] = fITSLayer0[from]; fFlags[to] = fFlags[from];
+    }
+    void ResizeLegs(Int_t n) {
+      fPx.resize(n); fPy.resize(n); fPz.resize(n); fP.resize(n); fPt.resize(n);
+      fCharge.resize(n); fITSLayer0.resize(n); fFlags.resize(n);
+    }
+  };
+  struct CompactPool {
+    CompactLegs fLeg1;
+    CompactLegs fLeg2;
+  };
+  Bool_t fUseCompactPools;                 // use the compact pools instead of the TClonesArray pools of track copies
+  std::vector<CompactPool> fCompactPools;  //! compact pools, one per event category
+  std::vector<Float_t> fPairMass2;         //! squared masses of the pairs of one leg with all the legs of a mixed event
+  std::vector<Double_t> fLegEnergies[4];   //! energies of the pooled legs with the leg mass assumptions: leg1 (m1,m2), leg2 (m1,m2)
+  
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
+  void InitHistClassIds();
+  void FillMixedPairHistograms(ULong_t testFlags, ULong_t pairCutMask, Int_t pairType, Float_t* values);
+  Bool_t CompactPoolsSupported() const;
+  void AddCompactLegs(CompactLegs& legs, TList* list);
+  void RunCompactEventMixing(CompactPool& pool, ULong_t mixingMask, Int_t type, Float_t* values);
+  void MixCompactLegs(const CompactLegs& legs1, const std::vector<Double_t>& energies1, Int_t first1, Int_t last1,
+                      const CompactLegs& legs2, const std::vector<Double_t>& energies2, Int_t ev2,
+                      Float_t m1, Float_t m2, ULong_t mixingMask, Int_t pairType, Int_t type, Float_t* values);
+  void CleanCompactPool(CompactPool& pool, ULong_t mixingMask);
   
-  ClassDef(AliMixingHandler,4);
+  ClassDef(AliMixingHandler,5);
 };
 
 #endif
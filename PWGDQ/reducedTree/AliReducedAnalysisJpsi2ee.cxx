@@ -61,7 +61,8 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee() :
   fClusterTrackMatcherMultipleMatchesBefore(0x0),
   fClusterTrackMatcherMultipleMatchesAfter(0x0),
   fSkipMCEvent(kFALSE),
-  fMCJpsiPtWeights(0x0)
+  fMCJpsiPtWeights(0x0),
+  fPairHistClassIds()
 {
   //
   // default constructor
@@ -103,7 +104,8 @@ AliReducedAnalysisJpsi2ee::AliReducedAnalysisJpsi2ee(const Char_t* name, const C
   fClusterTrackMatcherMultipleMatchesBefore(0x0),
   fClusterTrackMatcherMultipleMatchesAfter(0x0),
   fSkipMCEvent(kFALSE),
-  fMCJpsiPtWeights(0x0)
+  fMCJpsiPtWeights(0x0),
+  fPairHistClassIds()
 {
   //
   // named constructor
@@ -554,18 +556,46 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
 }
 
 
+//___________________________________________________________________________
+const std::vector<Int_t>& AliReducedAnalysisJpsi2ee::GetPairHistClassIds(const TString& pairClass) {
+   //
+   // histogram manager handles of the pair histogram classes of a given pair class (e.g. PairSE),
+   //   indexed by (pairType*nTrackCuts + iTrackCut)*nPairCuts + iPairCut
+   //   The class names are built and looked up only once
+   //
+   std::vector<Int_t>& classIds = fPairHistClassIds[pairClass];
+   if(!classIds.empty()) return classIds;
+   
+   TString typeStr[3] = {"PP", "PM", "MM"};
+   Int_t nPairCuts = (fPairCuts.GetEntries()>1 ? fPairCuts.GetEntries() : 1);
+   for(Int_t pairType=0; pairType<3; ++pairType) {
+      for(Int_t iTrackCut=0; iTrackCut<fTrackCuts.GetEntries(); ++iTrackCut) {
+         for(Int_t iPairCut=0; iPairCut<nPairCuts; ++iPairCut) {
+            if (fPairCuts.GetEntries()>1)
+               classIds.push_back(fHistosManager->GetHistClassId(Form("%s%s_%s_%s", pairClass.Data(), typeStr[pairType].Data(),
+                                                                 fTrackCuts.At(iTrackCut)->GetName(), fPairCuts.At(iPairCut)->GetName())));
+            else
+               classIds.push_back(fHistosManager->GetHistClassId(Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(),
+                                                                 fTrackCuts.At(iTrackCut)->GetName())));
+         }
+      }
+   }
+   return classIds;
+}
+
 //___________________________________________________________________________
 void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t trackMask, ULong_t pairMask, Int_t pairType, TString pairClass /*="PairSE"*/, UInt_t mcDecisions /* = 0*/) {
    //
    // fill pair level histograms
    // NOTE: pairType can be 0,1 or 2 corresponding to ++, +- or -- pairs
    TString typeStr[3] = {"PP", "PM", "MM"};
+   const std::vector<Int_t>& classIds = GetPairHistClassIds(pairClass);
+   Int_t nTrackCuts = fTrackCuts.GetEntries();
    if (fPairCuts.GetEntries()>1) {
       for(Int_t iTrackCut=0; iTrackCut<fTrackCuts.GetEntries(); ++iTrackCut) {
          for(Int_t iPairCut=0; iPairCut<fPairCuts.GetEntries(); ++iPairCut) {
             if((trackMask & (ULong_t(1)<<iTrackCut)) && (pairMask & (ULong_t(1)<<iPairCut))) {
-               fHistosManager->FillHistClass(Form("%s%s_%s_%s", pairClass.Data(), typeStr[pairType].Data(),
-                                                  fTrackCuts.At(iTrackCut)->GetName(), fPairCuts.At(iPairCut)->GetName()), fValues);
+               fHistosManager->FillHistClass(classIds[(pairType*nTrackCuts+iTrackCut)*fPairCuts.GetEntries()+iPairCut], fValues);
                if(mcDecisions && pairType==1) {
                   for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                      if(mcDecisions & (UInt_t(1)<<iMC))
@@ -580,7 +610,7 @@ void AliReducedAnalysisJpsi2ee::FillPairHistograms(ULong_t trackMask, ULong_t pa
    } else {
       for(Int_t iTrackCut=0; iTrackCut<fTrackCuts.GetEntries(); ++iTrackCut) {
          if(trackMask & (ULong_t(1)<<iTrackCut)) {
-            fHistosManager->FillHistClass(Form("%s%s_%s", pairClass.Data(), typeStr[pairType].Data(), fTrackCuts.At(iTrackCut)->GetName()), fValues);
+            fHistosManager->FillHistClass(classIds[pairType*nTrackCuts+iTrackCut], fValues);
             if(mcDecisions && pairType==1) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisions & (UInt_t(1)<<iMC))
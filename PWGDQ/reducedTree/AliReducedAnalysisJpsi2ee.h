@@ -7,6 +7,9 @@
 
 #include <TList.h>
 
+#include <map>
+#include <vector>
+
 #include "AliReducedAnalysisTaskSE.h"
 #include "AliReducedInfoCut.h"
 #include "AliReducedBaseEvent.h"
@@ -161,6 +164,7 @@ protected:
   void FillTrackHistograms(TString trackClass = "Track");
   void FillTrackHistograms(AliReducedBaseTrack* track, TString trackClass = "Track");
   void FillPairHistograms(ULong_t trackMask, ULong_t pairMask, Int_t pairType, TString pairClass = "PairSE", UInt_t mcDecisions = 0);
+  const std::vector<Int_t>& GetPairHistClassIds(const TString& pairClass);
   void FillClusterHistograms(TString clusterClass="CaloCluster");
   void FillClusterHistograms(AliReducedCaloClusterInfo* cluster, TString clusterClass="CaloCluster");
   void FillMCTruthHistograms();
@@ -171,6 +175,8 @@ protected:
 
   Bool_t fSkipMCEvent;          // decision to skip MC event
   TH1F*  fMCJpsiPtWeights;            // weights vs pt to reject events depending on the jpsi true pt (needed to re-weights jpsi Pt distribution)
+
+  std::map<TString, std::vector<Int_t> > fPairHistClassIds;   //! histogram manager handles of the pair histogram classes, per pair class, pair type and cut
   
   ClassDef(AliReducedAnalysisJpsi2ee,13);
 };
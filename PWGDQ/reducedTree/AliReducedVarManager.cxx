@@ -2431,22 +2431,7 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     p.SetMass(values[kMass]);
   }
   
-  values[kPx] = p.Px();
-  values[kPy] = p.Py();
-  values[kPz] = p.Pz();
-  if(fgUsedVars[kPt] || fgUsedVars[kPtSquared]) {
-    values[kPt] = p.Pt();
-    if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
-  }
-  values[kPairLegPt] = t1->Pt();
-  values[kPairLegPt+1] = t2->Pt();
-  values[kPairLegPtSum] = t1->Pt() + t2->Pt();
-  if(fgUsedVars[kP])      values[kP]      = p.P();
-  if(fgUsedVars[kEta])    values[kEta]    = p.Eta();
-  if(fgUsedVars[kRap])    values[kRap]    = p.Rapidity();
-  if(fgUsedVars[kRapAbs]) values[kRapAbs] = TMath::Abs(p.Rapidity());
-  if(fgUsedVars[kPhi])    values[kPhi]    = p.Phi();
-  if(fgUsedVars[kTheta])  values[kTheta]  = p.Theta();
+  FillPairKinematicsME(&p, t1->Pt(), t2->Pt(), values);
   
   if ((fgUsedVars[kPairLegEMCALmatchedEnergy] || fgUsedVars[kPairLegEMCALmatchedEnergy+1]) &&
       (t1->IsA()==TRACK::Class()) && (t2->IsA()==TRACK::Class())) {
@@ -2456,6 +2441,40 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     values[kPairLegEMCALmatchedEnergy+1]  = ti2->MatchedEMCalClusterEnergy();
   }
 
+  FillPairEfficiency(values);
+  
+  FillPairMEflow(t1, t2, values);
+}
+
+//____________________________________________________________________________________
+void AliReducedVarManager::FillPairKinematicsME(PAIR* p, Float_t legPt1, Float_t legPt2, Float_t* values) {
+  //
+  // Fill the kinematic variables of a mixed event pair, whose momentum (and mass) are already set.
+  // NOTE: Used by FillPairInfoME() and by the compact pools of the mixing handler
+  //
+  values[kPx] = p->Px();
+  values[kPy] = p->Py();
+  values[kPz] = p->Pz();
+  if(fgUsedVars[kPt] || fgUsedVars[kPtSquared]) {
+    values[kPt] = p->Pt();
+    if(fgUsedVars[kPtSquared]) values[kPtSquared] = values[kPt]*values[kPt];
+  }
+  values[kPairLegPt] = legPt1;
+  values[kPairLegPt+1] = legPt2;
+  values[kPairLegPtSum] = legPt1 + legPt2;
+  if(fgUsedVars[kP])      values[kP]      = p->P();
+  if(fgUsedVars[kEta])    values[kEta]    = p->Eta();
+  if(fgUsedVars[kRap])    values[kRap]    = p->Rapidity();
+  if(fgUsedVars[kRapAbs]) values[kRapAbs] = TMath::Abs(p->Rapidity());
+  if(fgUsedVars[kPhi])    values[kPhi]    = p->Phi();
+  if(fgUsedVars[kTheta])  values[kTheta]  = p->Theta();
+}
+
+//____________________________________________________________________________________
+void AliReducedVarManager::FillPairEfficiency(Float_t* values) {
+  //
+  // Fill the pair efficiency from the pair efficiency map, using the already filled pair variables
+  //
   if((fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq]) && fgPairEffMap) {
     Int_t binX = 0;
     if (fgEffMapVarDependencyX!=kNothing) {
@@ -2488,8 +2507,6 @@ void AliReducedVarManager::FillPairInfoME(BASETRACK* t1, BASETRACK* t2, Int_t ty
     values[kOneOverPairEff]   = oneOverPairEff;
     values[kOneOverPairEffSq] = oneOverPairEff*oneOverPairEff;
   }
-  
-  FillPairMEflow(t1, t2, values);
 }
 
 //____________________________________________________________________________________
@@ -805,6 +805,9 @@ class AliReducedVarManager : public TObject {
   static void FillPairInfo(AliReducedPairInfo* leg1, AliReducedBaseTrack* leg2, Int_t type, Float_t* values);
   static void FillPairInfoME(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Int_t type, Float_t* values);
   static void FillPairMEflow(AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Float_t* values/*, Int_t idx=0*/);
+  static void FillPairKinematicsME(AliReducedPairInfo* p, Float_t legPt1, Float_t legPt2, Float_t* values);
+  static void FillPairEfficiency(Float_t* values);
+  static void GetLegMassAssumption(Int_t id, Float_t& m1, Float_t& m2);
   static void FillCorrelationInfo(AliReducedBaseTrack* p, AliReducedBaseTrack* t, Float_t* values);
   static void FillCaloClusterInfo(AliReducedCaloClusterInfo* cl, Float_t* values);
   static void FillPsiPrimeInfo(AliReducedBaseTrack* p, AliReducedBaseTrack* t1, AliReducedBaseTrack* t2, Float_t* values);//tariq
@@ -861,7 +864,6 @@ class AliReducedVarManager : public TObject {
                             Float_t &thetaHE, Float_t &phiHE, 
 			    Float_t &thetaCS, Float_t &phiCS,
 			    Float_t leg1Mass=fgkParticleMass[kElectron], Float_t leg2Mass=fgkParticleMass[kElectron]);
-  static void GetLegMassAssumption(Int_t id, Float_t& m1, Float_t& m2);
   static AliKFParticle BuildKFcandidate(AliReducedTrackInfo* track1, Float_t mh1, AliReducedTrackInfo* track2, Float_t mh2);
   static AliKFParticle BuildKFvertex( AliReducedEventInfo * event );
   
@@ -456,7 +456,10 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fFileNameBroken(NULL),
   fAllowOverlapHeaders(kTRUE),
   fTrackMatcherRunningMode(0),
-  fDoHBTHistoOutput(kFALSE)
+  fDoHBTHistoOutput(kFALSE),
+  fUsePhotonFeatureCache(kTRUE),
+  fPhotonFeatureCache(NULL),
+  fHistoPhotonFeatureCache(NULL)
 {
 
 }
@@ -857,7 +860,10 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fFileNameBroken(NULL),
   fAllowOverlapHeaders(kTRUE),
   fTrackMatcherRunningMode(0),
-  fDoHBTHistoOutput(kFALSE)
+  fDoHBTHistoOutput(kFALSE),
+  fUsePhotonFeatureCache(kTRUE),
+  fPhotonFeatureCache(NULL),
+  fHistoPhotonFeatureCache(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -917,6 +923,10 @@ AliAnalysisTaskGammaConvCalo::~AliAnalysisTaskGammaConvCalo()
     delete[] fMCGammaCandidates;
     fMCGammaCandidates = 0x0;
   }
+  if(fPhotonFeatureCache){
+    delete fPhotonFeatureCache;
+    fPhotonFeatureCache = 0x0;
+  }
 }
 //___________________________________________________________
 void AliAnalysisTaskGammaConvCalo::InitBack(){
@@ -1029,6 +1039,15 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
   fV0Reader = (AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;}// GetV0Reader
 
+  // the photon cut sets running on the photons of the same V0 reader share the quantities which do not depend on the cut values
+  if(fUsePhotonFeatureCache){
+    fPhotonFeatureCache = new AliConversionPhotonFeatureCache();
+    for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+      AliConversionPhotonCuts* photonCuts = (AliConversionPhotonCuts*)fCutArray->At(iCut);
+      if(photonCuts->GetV0ReaderName().CompareTo(fV0ReaderName) == 0) photonCuts->SetPhotonFeatureCache(fPhotonFeatureCache);
+    }
+  }
+
   if(fDoMesonAnalysis){ //Same Jet Finder MUST be used within same trainconfig
     if( ((AliConversionMesonCuts*)fMesonCutArray->At(0))->DoJetAnalysis())  fDoJetAnalysis = kTRUE;
     if( ((AliConversionMesonCuts*)fMesonCutArray->At(0))->DoJetQA())        fDoJetQA       = kTRUE;
@@ -3099,6 +3118,11 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
     fOutputContainer->Add(tBrokenFiles);
   }
 
+  if(fPhotonFeatureCache){
+    fHistoPhotonFeatureCache = AliConversionPhotonFeatureCache::CreateCounterHistogram();
+    fOutputContainer->Add(fHistoPhotonFeatureCache);
+  }
+
 
   PostData(1, fOutputContainer);
   Int_t nContainerOutput = 2;
@@ -3194,6 +3218,8 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
     RelabelAODPhotonCandidates(kTRUE);// In case of AODMC relabeling MC
     fV0Reader->RelabelAODs(kTRUE);
   }
+  // after the relabeling, the track labels of the photons stay fixed until the end of the event
+  if(fPhotonFeatureCache) fPhotonFeatureCache->NewEvent(fInputEvent);
 
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
 
@@ -3415,6 +3441,7 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
     fV0Reader->RelabelAODs(kFALSE);
   }
 
+  if(fPhotonFeatureCache) fPhotonFeatureCache->FillCounterHistogram(fHistoPhotonFeatureCache);
   PostData(1, fOutputContainer);
 }
 
@@ -11,6 +11,7 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonFeatureCache.h"
 #include "AliAnalysisManager.h"
 #include "AliAnalysisTaskConvJet.h"
 #include "AliAnalysisTaskJetOutlierRemoval.h"
@@ -84,6 +85,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     void SetAllowOverlapHeaders         ( Bool_t allowOverlapHeader )                       { fAllowOverlapHeaders = allowOverlapHeader   ;}
     void SetDoMaterialBudgetWeightingOfGammasForTrueMesons(Bool_t flag)                     { fDoMaterialBudgetWeightingOfGammasForTrueMesons = flag;}
     void SetDoHBTHistoOutput            ( Bool_t flag )                                     { fDoHBTHistoOutput = flag                    ;}
+    void SetUsePhotonFeatureCache       ( Bool_t flag )                                     { fUsePhotonFeatureCache = flag               ;}
 
     // Setting the cut lists for the conversion photons
     void SetEventCutList                ( Int_t nCuts,
@@ -584,12 +586,15 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     Bool_t                  fAllowOverlapHeaders;                               // enable overlapping headers for cluster selection
     Int_t                   fTrackMatcherRunningMode;                           // CaloTrackMatcher running mode
     Bool_t                  fDoHBTHistoOutput;                                  // switch for additional HBT output
+    Bool_t                  fUsePhotonFeatureCache;                             // share the cut independent photon quantities between the cut sets
+    AliConversionPhotonFeatureCache* fPhotonFeatureCache;                       //! per-event photon quantities shared by the photon cuts
+    TH1*                    fHistoPhotonFeatureCache;                           //! computed and reused values of the photon feature cache
 
   private:
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 62);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 63);
 };
 
 #endif
@@ -353,7 +353,10 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   tBrokenFiles(NULL),
   fFileNameBroken(NULL),
   fFileWasAlreadyReported(kFALSE),
-  fAODMCTrackArray(NULL)
+  fAODMCTrackArray(NULL),
+  fUsePhotonFeatureCache(kTRUE),
+  fPhotonFeatureCache(NULL),
+  fHistoPhotonFeatureCache(NULL)
 {
 
 }
@@ -652,7 +655,10 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   tBrokenFiles(NULL),
   fFileNameBroken(NULL),
   fFileWasAlreadyReported(kFALSE),
-  fAODMCTrackArray(NULL)
+  fAODMCTrackArray(NULL),
+  fUsePhotonFeatureCache(kTRUE),
+  fPhotonFeatureCache(NULL),
+  fHistoPhotonFeatureCache(NULL)
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -685,6 +691,10 @@ AliAnalysisTaskGammaConvV1::~AliAnalysisTaskGammaConvV1()
     delete[] fWeightCentrality;
     fWeightCentrality = 0x0;
   }
+  if(fPhotonFeatureCache){
+    delete fPhotonFeatureCache;
+    fPhotonFeatureCache = 0x0;
+  }
 
 }
 //___________________________________________________________
@@ -779,6 +789,15 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   fV0Reader=(AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;} // GetV0Reader
 
+  // the photon cut sets running on the photons of the same V0 reader share the quantities which do not depend on the cut values
+  if(fUsePhotonFeatureCache){
+    fPhotonFeatureCache = new AliConversionPhotonFeatureCache();
+    for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+      AliConversionPhotonCuts* photonCuts = (AliConversionPhotonCuts*)fCutArray->At(iCut);
+      if(photonCuts->GetV0ReaderName().CompareTo(fV0ReaderName) == 0) photonCuts->SetPhotonFeatureCache(fPhotonFeatureCache);
+    }
+  }
+
 
   if( ((AliConversionPhotonCuts*)fCutArray->At(0))->GetUseBDTPhotonCuts()){
       fEnableBDT  = kTRUE;
@@ -2240,6 +2259,11 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   tBrokenFiles->Branch("fileName",&fFileNameBroken);
   fOutputContainer->Add(tBrokenFiles);
 
+  if(fPhotonFeatureCache){
+    fHistoPhotonFeatureCache = AliConversionPhotonFeatureCache::CreateCounterHistogram();
+    fOutputContainer->Add(fHistoPhotonFeatureCache);
+  }
+
   OpenFile(1);
   PostData(1, fOutputContainer);
   Int_t nContainerOutput = 2;
@@ -2340,6 +2364,8 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     RelabelAODPhotonCandidates(kTRUE);    // In case of AODMC relabeling MC
     fV0Reader->RelabelAODs(kTRUE);
   }
+  // after the relabeling, the track labels of the photons stay fixed until the end of the event
+  if(fPhotonFeatureCache) fPhotonFeatureCache->NewEvent(fInputEvent);
   for(Int_t iCut = 0; iCut<fnCuts; iCut++){
     fiCut = iCut;
     AliConvEventCuts *iEventCut = dynamic_cast<AliConvEventCuts*>(fEventCutArray->At(iCut));
@@ -2545,6 +2571,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
     fV0Reader->RelabelAODs(kFALSE);
   }
 
+  if(fPhotonFeatureCache) fPhotonFeatureCache->FillCounterHistogram(fHistoPhotonFeatureCache);
   PostData(1, fOutputContainer);
 }
 //________________________________________________________________________
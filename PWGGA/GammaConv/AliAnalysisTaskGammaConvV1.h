@@ -10,6 +10,7 @@
 #include "AliGammaConversionAODBGHandler.h"
 #include "AliConversionAODBGHandlerRP.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonFeatureCache.h"
 #include "AliAnalysisManager.h"
 #include "AliAnalysisTaskConvJet.h"
 #include "TProfile2D.h"
@@ -46,6 +47,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetDoPlotVsCentrality(Bool_t flag)                       { fDoPlotVsCentrality         = flag    ;}
     void SetDoTHnSparse(Bool_t flag)                              { fDoTHnSparse                = flag    ;}
     void SetDoCentFlattening(Int_t flag)                          { fDoCentralityFlat           = flag    ;}
+    void SetUsePhotonFeatureCache(Bool_t flag)                    { fUsePhotonFeatureCache      = flag    ;}
     void ProcessPhotonCandidates();
     void SetFileNameBDT(TString filename) { fFileNameBDT = filename.Data() ;}
     void InitializeBDT();
@@ -404,12 +406,15 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     TObjString*                       fFileNameBroken;                            // string object for broken file name
     Bool_t                            fFileWasAlreadyReported;                    // to store if the current file was already marked broken
     TClonesArray*                     fAODMCTrackArray;                           //! pointer to track array
+    Bool_t                            fUsePhotonFeatureCache;                     // share the cut independent photon quantities between the cut sets
+    AliConversionPhotonFeatureCache*  fPhotonFeatureCache;                        //! per-event photon quantities shared by the photon cuts
+    TH1*                              fHistoPhotonFeatureCache;                   //! computed and reused values of the photon feature cache
 
   private:
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 50);
+    ClassDef(AliAnalysisTaskGammaConvV1, 52);
 };
 
 #endif
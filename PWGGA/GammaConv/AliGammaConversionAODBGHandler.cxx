@@ -47,7 +47,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler() :
 	fBGEvents(),
 	fBGEventsENeg(),
 	fBGEventsMeson(),
-	fBGEventsMCParticle()
+	fBGEventsMCParticle(),
+	fBGRings(),
+	fBGRingsENeg(),
+	fBGRingsMeson(),
+	fBGRingsMCParticle()
 {
 	// constructor
 }
@@ -70,7 +74,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t binsZ,Int_t
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fBGRings(binsZ,std::vector<BGRing<AliAODConversionPhoton> >(binsMultiplicity)),
+	fBGRingsENeg(binsZ,std::vector<BGRing<AliAODConversionPhoton> >(binsMultiplicity)),
+	fBGRingsMeson(binsZ,std::vector<BGRing<AliAODConversionMother> >(binsMultiplicity)),
+	fBGRingsMCParticle(binsZ,std::vector<BGRing<AliAODMCParticle> >(binsMultiplicity))
 {
 	// constructor
 }
@@ -95,7 +103,11 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(Int_t collisionSy
 	fBGEvents(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsENeg(binsZ,AliGammaConversionMultipicityVector(binsMultiplicity,AliGammaConversionBGEventVector(nEvents))),
 	fBGEventsMeson(binsZ,AliGammaConversionMotherMultipicityVector(binsMultiplicity,AliGammaConversionMotherBGEventVector(nEvents))),
-	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents)))
+	fBGEventsMCParticle(binsZ,AliGammaMCParticleMultipicityVector(binsMultiplicity,AliGammaMCParticleBGEventVector(nEvents))),
+	fBGRings(binsZ,std::vector<BGRing<AliAODConversionPhoton> >(binsMultiplicity)),
+	fBGRingsENeg(binsZ,std::vector<BGRing<AliAODConversionPhoton> >(binsMultiplicity)),
+	fBGRingsMeson(binsZ,std::vector<BGRing<AliAODConversionMother> >(binsMultiplicity)),
+	fBGRingsMCParticle(binsZ,std::vector<BGRing<AliAODMCParticle> >(binsMultiplicity))
 {
 	// constructor
     if(fNBinsMultiplicity>5) fNBinsMultiplicity = 5;
@@ -400,9 +412,17 @@ AliGammaConversionAODBGHandler::AliGammaConversionAODBGHandler(const AliGammaCon
 	fBGEvents(original.fBGEvents),
 	fBGEventsENeg(original.fBGEventsENeg),
 	fBGEventsMeson(original.fBGEventsMeson),
-	fBGEventsMCParticle(original.fBGEventsMCParticle)
+	fBGEventsMCParticle(original.fBGEventsMCParticle),
+	fBGRings(original.fBGRings),
+	fBGRingsENeg(original.fBGRingsENeg),
+	fBGRingsMeson(original.fBGRingsMeson),
+	fBGRingsMCParticle(original.fBGRingsMCParticle)
 {
 	//copy constructor	
+	RebuildEventPointers(fBGRings,fBGEvents);
+	RebuildEventPointers(fBGRingsENeg,fBGEventsENeg);
+	RebuildEventPointers(fBGRingsMeson,fBGEventsMeson);
+	RebuildEventPointers(fBGRingsMCParticle,fBGEventsMCParticle);
 }
 
 //_____________________________________________________________________________________________________________________________
@@ -655,15 +675,10 @@ void AliGammaConversionAODBGHandler::AddEvent(TList* const eventGammas,Double_t
 	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
 
 	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEvents[z][m][eventCounter][d]);
-	}
-	fBGEvents[z][m][eventCounter].clear();
-	
-	// add the gammas to the vector
+	// the gammas replace the oldest event in the storage of the bin
+	PlaceEventInRing(fBGRings[z][m],fBGEvents[z][m],eventCounter,eventGammas->GetEntries());
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
-		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEvents[z][m][eventCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventGammas->At(i))));
+		CopyObject(fBGEvents[z][m][eventCounter][i],*(AliAODConversionPhoton*)(eventGammas->At(i)));
 	}
 	fBGEventCounter[z][m]++;
 }
@@ -686,15 +701,10 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(TList* const eventMothers, Do
 	fBGEventVertex[z][m][eventCounter].fZ = zvalue;
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
-	//first clear the vector
-  for(UInt_t d=0;d<fBGEventsMeson[z][m][eventCounter].size();d++){
-		delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-	}
-	fBGEventsMeson[z][m][eventCounter].clear();
-	
-	// add the gammas to the vector
+	// the mesons replace the oldest event in the storage of the bin
+	PlaceEventInRing(fBGRingsMeson[z][m],fBGEventsMeson[z][m],eventCounter,eventMothers->GetEntries());
 	for(Int_t i=0; i< eventMothers->GetEntries();i++){
-		fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(*(AliAODConversionMother*)(eventMothers->At(i))));
+		CopyObject(fBGEventsMeson[z][m][eventCounter][i],*(AliAODConversionMother*)(eventMothers->At(i)));
 	}
 	fBGEventMesonCounter[z][m]++;
 }
@@ -714,15 +724,10 @@ void AliGammaConversionAODBGHandler::AddMesonEvent(const std::vector<AliAODConve
   fBGEventVertex[z][m][eventCounter].fZ = zvalue;
   fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
-  //first clear the vector
-  for(UInt_t d=0;d<fBGEvents[z][m][eventCounter].size();d++){
-    delete (AliAODConversionMother*)(fBGEventsMeson[z][m][eventCounter][d]);
-  }
-  fBGEventsMeson[z][m][eventCounter].clear();
-
-  // add the gammas to the vector
-  for(const auto &mother : eventMother){
-    fBGEventsMeson[z][m][eventCounter].push_back(new AliAODConversionMother(mother));
+  // the mesons replace the oldest event in the storage of the bin
+  PlaceEventInRing(fBGRingsMeson[z][m],fBGEventsMeson[z][m],eventCounter,eventMother.size());
+  for(UInt_t i=0; i<eventMother.size(); i++){
+    CopyObject(fBGEventsMeson[z][m][eventCounter][i],eventMother[i]);
   }
   fBGEventMesonCounter[z][m]++;
 }
@@ -738,21 +743,10 @@ void AliGammaConversionAODBGHandler::AddElectronEvent(TClonesArray* const eventE
 	}
 	Int_t eventENegCounter=fBGEventENegCounter[z][m];
 	
-	//first clear the vector
-	// cout<<"Size of vector: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-	//  cout<<"Checking the entries: Z="<<z<<", M="<<m<<", eventCounter="<<eventCounter<<endl;
-
-	//  cout<<"The size of this vector is: "<<fBGEvents[z][m][eventCounter].size()<<endl;
-    for(UInt_t d=0;d<fBGEventsENeg[z][m][eventENegCounter].size();d++){
-		delete (AliAODConversionPhoton*)(fBGEventsENeg[z][m][eventENegCounter][d]);
-	}
-
-	fBGEventsENeg[z][m][eventENegCounter].clear();
-
-	// add the electron to the vector
+	// the electrons replace the oldest event in the storage of the bin
+	PlaceEventInRing(fBGRingsENeg[z][m],fBGEventsENeg[z][m],eventENegCounter,eventENeg->GetEntriesFast());
 	for(Int_t i=0; i< eventENeg->GetEntriesFast();i++){
-		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsENeg[z][m][eventENegCounter].push_back(new AliAODConversionPhoton(*(AliAODConversionPhoton*)(eventENeg->At(i))));
+		CopyObject(fBGEventsENeg[z][m][eventENegCounter][i],*(AliAODConversionPhoton*)(eventENeg->At(i)));
 	}
 	fBGEventENegCounter[z][m]++;
 }
@@ -777,15 +771,10 @@ void AliGammaConversionAODBGHandler::AddMCParticleEvent(TList* const eventGammas
 	fBGEventVertex[z][m][eventCounter].fZ = zvalue;
 	fBGEventVertex[z][m][eventCounter].fEP = epvalue;
 
-        for(UInt_t d=0;d<fBGEventsMCParticle[z][m][eventCounter].size();d++){
-          delete (AliAODMCParticle*)(fBGEventsMCParticle[z][m][eventCounter][d]);
-	}
-	fBGEventsMCParticle[z][m][eventCounter].clear();
-
-	// add the gammas to the vector
+	// the particles replace the oldest event in the storage of the bin
+	PlaceEventInRing(fBGRingsMCParticle[z][m],fBGEventsMCParticle[z][m],eventCounter,eventGammas->GetEntries());
 	for(Int_t i=0; i< eventGammas->GetEntries();i++){
-		//    AliKFParticle *t = new AliKFParticle(*(AliKFParticle*)(eventGammas->At(i)));
-		fBGEventsMCParticle[z][m][eventCounter].push_back(new AliAODMCParticle(*(AliAODMCParticle*)(eventGammas->At(i))));
+		CopyObject(fBGEventsMCParticle[z][m][eventCounter][i],*(AliAODMCParticle*)(eventGammas->At(i)));
 	}
 	fBGMCParticleEventCounter[z][m]++;
 }
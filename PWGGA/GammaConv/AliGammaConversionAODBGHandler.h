@@ -11,6 +11,7 @@
 ////////////////////////////////////////////////
 
 #include <vector>
+#include <new>
 
 
 // --- ROOT system ---
@@ -49,6 +50,17 @@ class AliGammaConversionAODBGHandler : public TObject {
         typedef std::vector<AliAODMCParticleVector> AliGammaMCParticleBGEventVector;
 	typedef std::vector<AliGammaMCParticleBGEventVector> AliGammaMCParticleMultipicityVector;
 	typedef std::vector<AliGammaMCParticleMultipicityVector> AliAODMCParticleBGVector;
+
+	// Storage of the pool objects of one (z, multiplicity) bin: the event slots of the bin are filled in turn,
+	// each slot keeps its chunk of objects and reuses it for the next event placed in the slot. The event
+	// vectors above only hold pointers into the chunks.
+	template<class T> struct BGRing {
+		std::vector<std::vector<T> >	fSlots;		// chunk of objects of each event slot
+		BGRing() : fSlots() {}
+	};
+	typedef std::vector<std::vector<BGRing<AliAODConversionPhoton> > > AliGammaConversionBGRingVector;
+	typedef std::vector<std::vector<BGRing<AliAODConversionMother> > > AliGammaConversionMotherBGRingVector;
+	typedef std::vector<std::vector<BGRing<AliAODMCParticle> > > AliAODMCParticleBGRingVector;
 	
 
 	AliGammaConversionAODBGHandler();																							//constructor
@@ -92,6 +104,10 @@ class AliGammaConversionAODBGHandler : public TObject {
 
 	private:
 
+		template<class T> static void PlaceEventInRing(BGRing<T>& ring, std::vector<std::vector<T*> >& events, Int_t slot, Int_t nObjects);
+		template<class T> static void RebuildEventPointers(std::vector<std::vector<BGRing<T> > >& rings, std::vector<std::vector<std::vector<std::vector<T*> > > >& events);
+		template<class T> static void CopyObject(T* target, const T& source){ target->~T(); new (target) T(source); }
+
 		Int_t 								fNEvents; 						// number of events
 		Int_t ** 							fBGEventCounter;				//! bg counter
 		Int_t ** 							fBGEventENegCounter;			//! bg electron counter
@@ -108,7 +124,42 @@ class AliGammaConversionAODBGHandler : public TObject {
 		AliGammaConversionBGVector 			fBGEventsENeg; 					// electron background electron events
 		AliGammaConversionMotherBGVector                fBGEventsMeson; 				// neutral meson background events
 		AliAODMCParticleBGVector 	                fBGEventsMCParticle; 				// MC Particle background events
+		AliGammaConversionBGRingVector			fBGRings;						//! storage of the photon background events
+		AliGammaConversionBGRingVector			fBGRingsENeg;					//! storage of the electron background events
+		AliGammaConversionMotherBGRingVector		fBGRingsMeson;					//! storage of the neutral meson background events
+		AliAODMCParticleBGRingVector			fBGRingsMCParticle;				//! storage of the MC Particle background events
 		
-	ClassDef(AliGammaConversionAODBGHandler,8)
+	ClassDef(AliGammaConversionAODBGHandler,9)
 };
+
+//_____________________________________________________________________________________________________________________________
+template<class T>
+void AliGammaConversionAODBGHandler::PlaceEventInRing(BGRing<T>& ring, std::vector<std::vector<T*> >& events, Int_t slot, Int_t nObjects){
+	// Point the event vector of slot to nObjects objects of the chunk of the slot, to be overwritten with the new event.
+	// Only the chunk of the slot grows (its old event is being replaced), the other events keep their objects.
+	if(ring.fSlots.size() < events.size()) ring.fSlots.resize(events.size());
+	std::vector<T> &objects = ring.fSlots[slot];
+	if((Int_t)objects.size() < nObjects){
+		Int_t newSize = 2*objects.size();
+		if(newSize < nObjects) newSize = nObjects;
+		std::vector<T>(newSize).swap(objects);
+	}
+	events[slot].clear();
+	for(Int_t i = 0; i < nObjects; i++) events[slot].push_back(&objects[i]);
+}
+
+//_____________________________________________________________________________________________________________________________
+template<class T>
+void AliGammaConversionAODBGHandler::RebuildEventPointers(std::vector<std::vector<BGRing<T> > >& rings, std::vector<std::vector<std::vector<std::vector<T*> > > >& events){
+	// Point the events to the chunks of this handler (after a copy the pointers still refer to the original)
+	for(UInt_t z = 0; z < events.size() && z < rings.size(); z++){
+		for(UInt_t m = 0; m < events[z].size() && m < rings[z].size(); m++){
+			BGRing<T> &ring = rings[z][m];
+			for(UInt_t slot = 0; slot < events[z][m].size(); slot++){
+				std::vector<T*> &event = events[z][m][slot];
+				for(UInt_t j = 0; j < event.size(); j++) event[j] = &ring.fSlots[slot][j];
+			}
+		}
+	}
+}
 #endif
@@ -101,6 +101,7 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const char *name,const char *ti
   AliAnalysisCuts(name,title),
   fHistograms(NULL),
   fPIDResponse(NULL),
+  fPhotonFeatureCache(NULL),
   fDoLightOutput(0),
   fDoPlotTrackPID(kFALSE),
   fV0ReaderName("V0ReaderV1"),
@@ -282,6 +283,7 @@ AliConversionPhotonCuts::AliConversionPhotonCuts(const AliConversionPhotonCuts &
   AliAnalysisCuts(ref),
   fHistograms(NULL),
   fPIDResponse(NULL),
+  fPhotonFeatureCache(NULL),
   fDoLightOutput(ref.fDoLightOutput),
   fDoPlotTrackPID(ref.fDoPlotTrackPID),
   fV0ReaderName("V0ReaderV1"),
@@ -1858,8 +1860,8 @@ Float_t AliConversionPhotonCuts::GetKappaTPC(AliConversionPhotonBase *gamma, Ali
 
   Float_t KappaPlus, KappaMinus, Kappa;
   if(fDoElecDeDxPostCalibration){
-    CentrnSig[0]=fPIDResponse->NumberOfSigmasTPC(negTrack,AliPID::kElectron);
-    CentrnSig[1]=fPIDResponse->NumberOfSigmasTPC(posTrack,AliPID::kElectron);
+    CentrnSig[0]=GetNumberOfSigmas(negTrack,AliConversionPhotonFeatureCache::kNSigmaTPCElectron);
+    CentrnSig[1]=GetNumberOfSigmas(posTrack,AliConversionPhotonFeatureCache::kNSigmaTPCElectron);
     P[0]        =negTrack->P();
     P[1]        =posTrack->P();
     Eta[0]      =negTrack->Eta();
@@ -1867,8 +1869,8 @@ Float_t AliConversionPhotonCuts::GetKappaTPC(AliConversionPhotonBase *gamma, Ali
     KappaMinus = GetCorrectedElectronTPCResponse(negTrack->Charge(),CentrnSig[0],P[0],Eta[0],negTrack->GetTPCNcls(),gamma->GetConversionRadius());
     KappaPlus =  GetCorrectedElectronTPCResponse(posTrack->Charge(),CentrnSig[1],P[1],Eta[1],posTrack->GetTPCNcls(),gamma->GetConversionRadius());
   }else{
-    KappaMinus = fPIDResponse->NumberOfSigmasTPC(negTrack, AliPID::kElectron);
-    KappaPlus =  fPIDResponse->NumberOfSigmasTPC(posTrack, AliPID::kElectron);
+    KappaMinus = GetNumberOfSigmas(negTrack,AliConversionPhotonFeatureCache::kNSigmaTPCElectron);
+    KappaPlus =  GetNumberOfSigmas(posTrack,AliConversionPhotonFeatureCache::kNSigmaTPCElectron);
   }
   Kappa = ( TMath::Abs(KappaMinus) + TMath::Abs(KappaPlus) ) / 2.0 + 2.0*(KappaMinus+KappaPlus);
 
@@ -1926,7 +1928,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
   if(!fPIDResponse){AliError("No PID Response"); return kTRUE;}// if still missing fatal error
 
   Short_t Charge    = fCurrentTrack->Charge();
-  Double_t electronNSigmaTPC = fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kElectron);
+  Double_t electronNSigmaTPC = GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCElectron);
   Double_t electronNSigmaTPCCor=0.;
   Double_t P=0.;
   Double_t Eta=0.;
@@ -1959,12 +1961,12 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
     // TPC Pion Line
     if( fCurrentTrack->P()>fPIDMinPnSigmaAbovePionLine && fCurrentTrack->P()<fPIDMaxPnSigmaAbovePionLine ){
       if(fDoElecDeDxPostCalibration){
-        if( electronNSigmaTPCCor >fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
+        if( electronNSigmaTPCCor >fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCPion)<fPIDnSigmaAbovePionLine){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       } else{
-        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLine){
+        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCPion)<fPIDnSigmaAbovePionLine){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
@@ -1975,12 +1977,12 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
     // High Pt Pion rej
     if( fCurrentTrack->P()>fPIDMaxPnSigmaAbovePionLine ){
       if(fDoElecDeDxPostCalibration){
-        if( electronNSigmaTPCCor > fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
+        if( electronNSigmaTPCCor > fPIDnSigmaBelowElectronLine && electronNSigmaTPCCor < fPIDnSigmaAboveElectronLine && GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCPion)<fPIDnSigmaAbovePionLineHighPt){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       } else{
-        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion)<fPIDnSigmaAbovePionLineHighPt){
+        if( electronNSigmaTPC > fPIDnSigmaBelowElectronLine && electronNSigmaTPC < fPIDnSigmaAboveElectronLine && GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCPion)<fPIDnSigmaAbovePionLineHighPt){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
@@ -1992,7 +1994,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
 
   if(fDoKaonRejectionLowP == kTRUE && !fSwitchToKappa){
     if(fCurrentTrack->P()<fPIDMinPKaonRejectionLowP ){
-      if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kKaon))<fPIDnSigmaAtLowPAroundKaonLine){
+      if( TMath::Abs(GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCKaon))<fPIDnSigmaAtLowPAroundKaonLine){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
@@ -2002,7 +2004,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
 
   if(fDoProtonRejectionLowP == kTRUE && !fSwitchToKappa){
     if( fCurrentTrack->P()<fPIDMinPProtonRejectionLowP ){
-      if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kProton))<fPIDnSigmaAtLowPAroundProtonLine){
+      if( TMath::Abs(GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCProton))<fPIDnSigmaAtLowPAroundProtonLine){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
@@ -2012,7 +2014,7 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
 
   if(fDoPionRejectionLowP == kTRUE && !fSwitchToKappa){
     if( fCurrentTrack->P()<fPIDMinPPionRejectionLowP ){
-      if( TMath::Abs(fPIDResponse->NumberOfSigmasTPC(fCurrentTrack,AliPID::kPion))<fPIDnSigmaAtLowPAroundPionLine){
+      if( TMath::Abs(GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTPCPion))<fPIDnSigmaAtLowPAroundPionLine){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
@@ -2030,29 +2032,29 @@ Bool_t AliConversionPhotonCuts::dEdxCuts(AliVTrack *fCurrentTrack,AliConversionP
       Double_t dT = TOFsignal - t0 - times[0];
       fHistoTOFbefore->Fill(fCurrentTrack->P(),dT);
     }
-    if(fHistoTOFSigbefore) fHistoTOFSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigbefore) fHistoTOFSigbefore->Fill(fCurrentTrack->P(),GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTOFElectron));
     if(fUseTOFpid){
-      if(fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)>fTofPIDnSigmaAboveElectronLine ||
-        fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron)<fTofPIDnSigmaBelowElectronLine ){
+      if(GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTOFElectron)>fTofPIDnSigmaAboveElectronLine ||
+        GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTOFElectron)<fTofPIDnSigmaBelowElectronLine ){
         if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
         return kFALSE;
       }
     }
-    if(fHistoTOFSigafter)fHistoTOFSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasTOF(fCurrentTrack, AliPID::kElectron));
+    if(fHistoTOFSigafter)fHistoTOFSigafter->Fill(fCurrentTrack->P(),GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaTOFElectron));
   }
   cutIndex++; //8
 
   if((fCurrentTrack->GetStatus() & AliESDtrack::kITSpid)){
-    if(fHistoITSSigbefore) fHistoITSSigbefore->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigbefore) fHistoITSSigbefore->Fill(fCurrentTrack->P(),GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaITSElectron));
     if(fUseITSpid){
       if(fCurrentTrack->Pt()<=fMaxPtPIDITS){
-        if(fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)>fITSPIDnSigmaAboveElectronLine || fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron)<fITSPIDnSigmaBelowElectronLine ){
+        if(GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaITSElectron)>fITSPIDnSigmaAboveElectronLine || GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaITSElectron)<fITSPIDnSigmaBelowElectronLine ){
           if(fHistodEdxCuts)fHistodEdxCuts->Fill(cutIndex,fCurrentTrack->Pt());
           return kFALSE;
         }
       }
     }
-    if(fHistoITSSigafter)fHistoITSSigafter->Fill(fCurrentTrack->P(),fPIDResponse->NumberOfSigmasITS(fCurrentTrack, AliPID::kElectron));
+    if(fHistoITSSigafter)fHistoITSSigafter->Fill(fCurrentTrack->P(),GetNumberOfSigmas(fCurrentTrack,AliConversionPhotonFeatureCache::kNSigmaITSElectron));
   }
 
   cutIndex++; //9
@@ -2128,6 +2130,22 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
   //Returns pointer to the track with given ESD label
   //(Important for AOD implementation, since Track array in AOD data is different
   //from ESD array, but ESD tracklabels are stored in AOD Tracks)
+  //The lookup is done only once per event for all cut sets sharing the photon feature cache
+
+  if(fPhotonFeatureCache && fPhotonFeatureCache->IsCurrentEvent(event)){
+    AliVTrack * track = NULL;
+    if(!fPhotonFeatureCache->GetTrack(label, track)){
+      track = FindTrack(event, label);
+      fPhotonFeatureCache->SetTrack(label, track);
+    }
+    return track;
+  }
+  return FindTrack(event, label);
+}
+
+///________________________________________________________________________
+AliVTrack *AliConversionPhotonCuts::FindTrack(AliVEvent * event, Int_t label){
+  //Looks up the track with given ESD label in the event
 
   AliESDEvent * esdEvent = dynamic_cast<AliESDEvent*>(event);
   if(esdEvent) {
@@ -2157,6 +2175,27 @@ AliVTrack *AliConversionPhotonCuts::GetTrack(AliVEvent * event, Int_t label){
   return NULL;
 }
 
+///________________________________________________________________________
+Double_t AliConversionPhotonCuts::GetNumberOfSigmas(AliVTrack * track, AliConversionPhotonFeatureCache::EPIDFeature_t feature){
+  //Returns the PID response n sigma of the conversion leg,
+  //computed only once per event for all cut sets sharing the photon feature cache
+
+  Double_t nSigma = 0.;
+  if(fPhotonFeatureCache && fPhotonFeatureCache->GetPIDFeature(track, feature, nSigma)) return nSigma;
+
+  switch(feature){
+    case AliConversionPhotonFeatureCache::kNSigmaTPCElectron: nSigma = fPIDResponse->NumberOfSigmasTPC(track, AliPID::kElectron); break;
+    case AliConversionPhotonFeatureCache::kNSigmaTPCPion:     nSigma = fPIDResponse->NumberOfSigmasTPC(track, AliPID::kPion);     break;
+    case AliConversionPhotonFeatureCache::kNSigmaTPCKaon:     nSigma = fPIDResponse->NumberOfSigmasTPC(track, AliPID::kKaon);     break;
+    case AliConversionPhotonFeatureCache::kNSigmaTPCProton:   nSigma = fPIDResponse->NumberOfSigmasTPC(track, AliPID::kProton);   break;
+    case AliConversionPhotonFeatureCache::kNSigmaTOFElectron: nSigma = fPIDResponse->NumberOfSigmasTOF(track, AliPID::kElectron); break;
+    case AliConversionPhotonFeatureCache::kNSigmaITSElectron: nSigma = fPIDResponse->NumberOfSigmasITS(track, AliPID::kElectron); break;
+    default: break;
+  }
+  if(fPhotonFeatureCache) fPhotonFeatureCache->SetPIDFeature(track, feature, nSigma);
+  return nSigma;
+}
+
 ///________________________________________________________________________
 AliESDtrack *AliConversionPhotonCuts::GetESDTrack(AliESDEvent * event, Int_t label){
   //Returns pointer to the track with given ESD label
@@ -4558,6 +4597,11 @@ Bool_t AliConversionPhotonCuts::CosinePAngleCut(const AliConversionPhotonBase *
 ///________________________________________________________________________
 Double_t AliConversionPhotonCuts::GetCosineOfPointingAngle( const AliConversionPhotonBase * photon, AliVEvent * event) const{
   // calculates the pointing angle of the recalculated V0
+  // (once per event and photon for all cut sets sharing the photon feature cache)
+
+  Double_t cosinePointingAngle = -999;
+  Bool_t useCache = fPhotonFeatureCache && fPhotonFeatureCache->IsCurrentEvent(event);
+  if(useCache && fPhotonFeatureCache->GetCosineOfPointingAngle(photon, cosinePointingAngle)) return cosinePointingAngle;
 
   Double_t momV0[3] = {0,0,0};
   if(event->IsA()==AliESDEvent::Class()){
@@ -4582,10 +4626,10 @@ Double_t AliConversionPhotonCuts::GetCosineOfPointingAngle( const AliConversionP
   Double_t PosV02 = PosV0[0]*PosV0[0] + PosV0[1]*PosV0[1] + PosV0[2]*PosV0[2];
 
 
-  Double_t cosinePointingAngle = -999;
   if(momV02*PosV02 > 0.0)
     cosinePointingAngle = (PosV0[0]*momV0[0] +  PosV0[1]*momV0[1] + PosV0[2]*momV0[2] ) / TMath::Sqrt(momV02 * PosV02);
 
+  if(useCache) fPhotonFeatureCache->SetCosineOfPointingAngle(photon, cosinePointingAngle);
   return cosinePointingAngle;
 }
 
@@ -3,6 +3,7 @@
 
 #include "AliAODpidUtil.h"
 #include "AliConversionPhotonBase.h"
+#include "AliConversionPhotonFeatureCache.h"
 #include "AliAODConversionMother.h"
 #include "AliAODTrack.h"
 #include "AliESDtrack.h"
@@ -182,10 +183,14 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     void FillV0EtaAfterdEdxCuts(Float_t v0Eta){if(fHistoEtaDistV0sAfterdEdxCuts)fHistoEtaDistV0sAfterdEdxCuts->Fill(v0Eta);}
 
     void SetV0ReaderName(TString name){fV0ReaderName = name; return;}
+    TString GetV0ReaderName() const {return fV0ReaderName;}
+    void SetPhotonFeatureCache(AliConversionPhotonFeatureCache* cache){fPhotonFeatureCache = cache; return;}
     void SetProcessAODCheck(Bool_t flag){fProcessAODCheck = flag; return;}
 
     AliVTrack * GetTrack(AliVEvent * event, Int_t label);
+    AliVTrack * FindTrack(AliVEvent * event, Int_t label);
     AliESDtrack *GetESDTrack(AliESDEvent * event, Int_t label);
+    Double_t GetNumberOfSigmas(AliVTrack * track, AliConversionPhotonFeatureCache::EPIDFeature_t feature);
 
     ///Cut functions
     Bool_t SpecificTrackCuts(AliAODTrack * negTrack, AliAODTrack * posTrack,Int_t &cutIndex);
@@ -274,6 +279,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
   protected:
     TList*            fHistograms;                          ///< List of QA histograms
     AliPIDResponse*   fPIDResponse;                         ///< PID response
+    AliConversionPhotonFeatureCache* fPhotonFeatureCache;   //!<! per-event quantities shared with the other cut sets of the task, not owned
 
     Int_t            fDoLightOutput;                       ///< switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
     Bool_t            fDoPlotTrackPID;                       ///< switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
@@ -441,7 +447,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
 
   private:
     /// \cond CLASSIMP
-    ClassDef(AliConversionPhotonCuts,34)
+    ClassDef(AliConversionPhotonCuts,35)
     /// \endcond
 };
 
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved.   *
+ *                                                                          *
+ * Permission to use, copy, modify and distribute this software and its     *
+ * documentation strictly for non-commercial purposes is hereby granted     *
+ * without fee, provided that the above copyright notice appears in all     *
+ * copies and that both the copyright notice and this permission notice     *
+ * appear in the supporting documentation. The authors make no claims       *
+ * about the suitability of this software for any purpose. It is            *
+ * provided "as is" without express or implied warranty.                    *
+ ***************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Per-event cache of the photon candidate
+// quantities shared by the photon cut sets
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConversionPhotonFeatureCache.h"
+#include "AliConversionPhotonBase.h"
+#include "AliVEvent.h"
+#include "AliVTrack.h"
+#include "TH1D.h"
+
+/// \cond CLASSIMP
+ClassImp(AliConversionPhotonFeatureCache)
+/// \endcond
+
+//________________________________________________________________________
+AliConversionPhotonFeatureCache::AliConversionPhotonFeatureCache() :
+  TObject(),
+  fEvent(NULL),
+  fTracks(),
+  fPID(),
+  fPhotons(),
+  fNComputed(0),
+  fNReused(0)
+{
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureCache::NewEvent(const AliVEvent* event){
+  // forget the values of the previous event, has to be called before the first cut set processes the event
+  fEvent = event;
+  fTracks.clear();
+  fPID.clear();
+  fPhotons.clear();
+}
+
+//________________________________________________________________________
+TH1* AliConversionPhotonFeatureCache::CreateCounterHistogram(){
+  // counters of the cache for the output list of the task
+  TH1D* hist = new TH1D("PhotonFeatureCache","PhotonFeatureCache",2,-0.5,1.5);
+  hist->GetXaxis()->SetBinLabel(1,"computed");
+  hist->GetXaxis()->SetBinLabel(2,"reused");
+  return hist;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureCache::FillCounterHistogram(TH1* hist) const {
+  // the counters are cumulative, the histogram holds the values up to the current event
+  if(!hist) return;
+  hist->SetBinContent(1,fNComputed);
+  hist->SetBinContent(2,fNReused);
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonFeatureCache::GetTrack(Int_t label, AliVTrack*& track) const {
+  std::map<Int_t,AliVTrack*>::const_iterator it = fTracks.find(label);
+  if(it == fTracks.end()) return kFALSE;
+  track = it->second;
+  fNReused++;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureCache::SetTrack(Int_t label, AliVTrack* track){
+  fTracks[label] = track;
+  fNComputed++;
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonFeatureCache::GetPIDFeature(const AliVTrack* track, EPIDFeature_t feature, Double_t& value) const {
+  std::map<const AliVTrack*,PIDEntry>::const_iterator it = fPID.find(track);
+  if(it == fPID.end() || !TESTBIT(it->second.fValid,feature)) return kFALSE;
+  value = it->second.fValues[feature];
+  fNReused++;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureCache::SetPIDFeature(const AliVTrack* track, EPIDFeature_t feature, Double_t value){
+  PIDEntry& entry = fPID[track];
+  entry.fValues[feature] = value;
+  SETBIT(entry.fValid,feature);
+  fNComputed++;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureCache::GetPhotonKinematics(const AliConversionPhotonBase* photon, Double_t* kinematics){
+  kinematics[0] = photon->GetPx();
+  kinematics[1] = photon->GetPy();
+  kinematics[2] = photon->GetPz();
+  kinematics[3] = photon->GetConversionX();
+  kinematics[4] = photon->GetConversionY();
+  kinematics[5] = photon->GetConversionZ();
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonFeatureCache::GetCosineOfPointingAngle(const AliConversionPhotonBase* photon, Double_t& value) const {
+  std::map<const AliConversionPhotonBase*,PhotonEntry>::const_iterator it = fPhotons.find(photon);
+  if(it == fPhotons.end()) return kFALSE;
+  // values computed before the photon was modified are not valid anymore
+  Double_t kinematics[6];
+  GetPhotonKinematics(photon,kinematics);
+  for(Int_t i = 0; i < 6; i++){
+    if(kinematics[i] != it->second.fKinematics[i]) return kFALSE;
+  }
+  value = it->second.fCosPA;
+  fNReused++;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonFeatureCache::SetCosineOfPointingAngle(const AliConversionPhotonBase* photon, Double_t value){
+  PhotonEntry& entry = fPhotons[photon];
+  GetPhotonKinematics(photon,entry.fKinematics);
+  entry.fCosPA = value;
+  fNComputed++;
+}
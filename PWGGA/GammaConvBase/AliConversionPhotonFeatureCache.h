@@ -0,0 +1,97 @@
+#ifndef ALICONVERSIONPHOTONFEATURECACHE_H
+#define ALICONVERSIONPHOTONFEATURECACHE_H
+
+#include "TObject.h"
+#include <map>
+
+class AliVEvent;
+class AliVTrack;
+class TH1;
+class AliConversionPhotonBase;
+
+/**
+ * @class AliConversionPhotonFeatureCache
+ * @brief Per-event store of the photon candidate quantities which do not depend on the cut settings
+ * @ingroup GammaConv
+ *
+ * A task running many AliConversionPhotonCuts on the same photon candidates
+ * attaches one cache to all of them (AliConversionPhotonCuts::SetPhotonFeatureCache)
+ * and calls NewEvent() at the start of each event. The first cut set asking
+ * for a quantity computes and stores it, the other cut sets only compare it
+ * with their thresholds. Cached are:
+ *  - the track lookup by label (AliConversionPhotonCuts::GetTrack)
+ *  - the PID response n sigmas of the conversion legs
+ *  - the cosine of the pointing angle of the photon candidates
+ *
+ * The photon quantities are stored together with the photon momentum and
+ * conversion point, and are recomputed when the photon is modified within
+ * the event (e.g. rotated for the background estimate).
+ *
+ * Used by AliAnalysisTaskGammaConvV1 and AliAnalysisTaskGammaConvCalo, the
+ * tasks running several photon cut sets on the photons of one V0 reader.
+ * The numbers of computed and reused values are written to the output with
+ * CreateCounterHistogram / FillCounterHistogram.
+ */
+class AliConversionPhotonFeatureCache : public TObject {
+
+  public:
+    enum EPIDFeature_t {
+      kNSigmaTPCElectron=0,
+      kNSigmaTPCPion,
+      kNSigmaTPCKaon,
+      kNSigmaTPCProton,
+      kNSigmaTOFElectron,
+      kNSigmaITSElectron,
+      kNPIDFeatures
+    };
+
+    AliConversionPhotonFeatureCache();
+    virtual ~AliConversionPhotonFeatureCache() {}
+
+    void      NewEvent(const AliVEvent* event);
+    Bool_t    IsCurrentEvent(const AliVEvent* event) const { return event && event==fEvent; }
+
+    Bool_t    GetTrack(Int_t label, AliVTrack*& track) const;
+    void      SetTrack(Int_t label, AliVTrack* track);
+
+    Bool_t    GetPIDFeature(const AliVTrack* track, EPIDFeature_t feature, Double_t& value) const;
+    void      SetPIDFeature(const AliVTrack* track, EPIDFeature_t feature, Double_t value);
+
+    Bool_t    GetCosineOfPointingAngle(const AliConversionPhotonBase* photon, Double_t& value) const;
+    void      SetCosineOfPointingAngle(const AliConversionPhotonBase* photon, Double_t value);
+
+    Long64_t  GetNComputed() const { return fNComputed; }
+    Long64_t  GetNReused()   const { return fNReused;   }
+    static TH1* CreateCounterHistogram();
+    void      FillCounterHistogram(TH1* hist) const;
+
+  private:
+    struct PIDEntry {
+      Double_t fValues[kNPIDFeatures];                        ///< n sigmas, valid if the corresponding bit of fValid is set
+      UInt_t   fValid;                                        ///< bit mask of the filled values
+      PIDEntry() : fValid(0) {}
+    };
+
+    struct PhotonEntry {
+      Double_t fKinematics[6];                                ///< momentum and conversion point the values were computed for
+      Double_t fCosPA;                                        ///< cosine of the pointing angle
+    };
+
+    static void GetPhotonKinematics(const AliConversionPhotonBase* photon, Double_t* kinematics);
+
+    AliConversionPhotonFeatureCache(const AliConversionPhotonFeatureCache&); // not implemented
+    AliConversionPhotonFeatureCache& operator=(const AliConversionPhotonFeatureCache&); // not implemented
+
+    const AliVEvent*                                        fEvent;       //!<! event the cached values belong to
+    std::map<Int_t,AliVTrack*>                              fTracks;      //!<! tracks by label, including failed lookups
+    std::map<const AliVTrack*,PIDEntry>                     fPID;         //!<! n sigmas by track
+    std::map<const AliConversionPhotonBase*,PhotonEntry>    fPhotons;     //!<! photon quantities by candidate
+    Long64_t                                                fNComputed;   //!<! number of values computed and stored
+    mutable Long64_t                                        fNReused;     //!<! number of values taken from the cache
+
+    /// \cond CLASSIMP
+    ClassDef(AliConversionPhotonFeatureCache,1)
+    /// \endcond
+};
+
+#endif
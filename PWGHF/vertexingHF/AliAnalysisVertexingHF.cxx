@@ -70,6 +70,10 @@
 #include "AliCodeTimer.h"
 #include "AliMultSelection.h"
 #include <cstring>
+#ifdef R__USE_IMT
+#include <TROOT.h>
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 /// \cond CLASSIMP
 ClassImp(AliAnalysisVertexingHF);
@@ -161,7 +165,21 @@ fMassLambdaC(0.),
 fMassDstar(0.),
 fMassJpsi(0.),
 fMassPhi(0.),
-fMassK(0.)
+fMassK(0.),
+fFastPreselection(kFALSE),
+fFastDCATolerance(0.01),
+fNumberOfThreads(1),
+fChannelExecutor(0),
+fChannelWorkers(),
+fChannelBuffers(0),
+fChannelParent(0),
+fPairIndex(),
+fNPairTracks(0),
+fPairDCA(),
+fPairIn2ProngWindows(),
+fnPairsTested(0),
+fnPairsFitted(0),
+fnPairs2Prong(0)
 {
   /// Default constructor
 
@@ -260,7 +278,21 @@ fMassLambdaC(source.fMassLambdaC),
 fMassDstar(source.fMassDstar),
 fMassJpsi(source.fMassJpsi),
 fMassPhi(source.fMassPhi),
-fMassK(source.fMassK)
+fMassK(source.fMassK),
+fFastPreselection(source.fFastPreselection),
+fFastDCATolerance(source.fFastDCATolerance),
+fNumberOfThreads(source.fNumberOfThreads),
+fChannelExecutor(0),
+fChannelWorkers(),
+fChannelBuffers(0),
+fChannelParent(0),
+fPairIndex(),
+fNPairTracks(0),
+fPairDCA(),
+fPairIn2ProngWindows(),
+fnPairsTested(0),
+fnPairsFitted(0),
+fnPairs2Prong(0)
 {
   ///
   /// Copy constructor
@@ -356,13 +388,27 @@ AliAnalysisVertexingHF &AliAnalysisVertexingHF::operator=(const AliAnalysisVerte
   fMassJpsi = source.fMassJpsi;
   fMassPhi = source.fMassPhi;
   fMassK = source.fMassK;
+  fFastPreselection = source.fFastPreselection;
+  fFastDCATolerance = source.fFastDCATolerance;
+  fNumberOfThreads = source.fNumberOfThreads;
 
   return *this;
 }
 //----------------------------------------------------------------------------
 AliAnalysisVertexingHF::~AliAnalysisVertexingHF() {
   /// Destructor
+  if(fChannelParent) {
+    // primary vertex, track filters and AOD map belong to the main object
+    fV1=0; fV1AOD=0; fAODMap=0;
+    fTrackFilter=0; fTrackFilter2prongCentral=0; fTrackFilter3prongCentral=0;
+    fTrackFilterSoftPi=0; fTrackFilterBachelor=0;
+  }
   if(fV1) { delete fV1; fV1=0; }
+#ifdef R__USE_IMT
+  delete fChannelExecutor;
+#endif
+  for(Int_t i=0; i<kNChannelTasks; i++) delete fChannelWorkers[i];
+  delete fChannelBuffers;
   if(fV1AOD) { delete fV1AOD; fV1AOD=0; }
   delete fVertexerTracks;
   if(fTrackFilter) { delete fTrackFilter; fTrackFilter=0; }
@@ -508,70 +554,21 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
     return;
   }
 
-  // delete candidates from previous event and create references
-  Int_t iVerticesHF=0,iD0toKpi=0,iJPSItoEle=0,i3Prong=0,i4Prong=0,iDstar=0,iCascades=0,iLikeSign2Prong=0,iLikeSign3Prong=0;
+  // delete candidates from previous event
   aodVerticesHFTClArr->Delete();
-  iVerticesHF = aodVerticesHFTClArr->GetEntriesFast();
-  TClonesArray &verticesHFRef = *aodVerticesHFTClArr;
-  if(fD0toKpi || fDstar)   {
-    aodD0toKpiTClArr->Delete();
-    iD0toKpi = aodD0toKpiTClArr->GetEntriesFast();
-  }
-  if(fJPSItoEle) {
-    aodJPSItoEleTClArr->Delete();
-    iJPSItoEle = aodJPSItoEleTClArr->GetEntriesFast();
-  }
-  if(f3Prong) {
-    aodCharm3ProngTClArr->Delete();
-    i3Prong = aodCharm3ProngTClArr->GetEntriesFast();
-  }
-  if(f4Prong) {
-    aodCharm4ProngTClArr->Delete();
-    i4Prong = aodCharm4ProngTClArr->GetEntriesFast();
-  }
-  if(fDstar) {
-    aodDstarTClArr->Delete();
-    iDstar = aodDstarTClArr->GetEntriesFast();
-  }
-  if(fCascades) {
-    aodCascadesTClArr->Delete();
-    iCascades = aodCascadesTClArr->GetEntriesFast();
-  }
-  if(fLikeSign) {
-    aodLikeSign2ProngTClArr->Delete();
-    iLikeSign2Prong = aodLikeSign2ProngTClArr->GetEntriesFast();
-  }
-  if(fLikeSign3prong && f3Prong) {
-    aodLikeSign3ProngTClArr->Delete();
-    iLikeSign3Prong = aodLikeSign3ProngTClArr->GetEntriesFast();
-  }
-
-  TClonesArray &aodD0toKpiRef        = *aodD0toKpiTClArr;
-  TClonesArray &aodJPSItoEleRef      = *aodJPSItoEleTClArr;
-  TClonesArray &aodCharm3ProngRef    = *aodCharm3ProngTClArr;
-  TClonesArray &aodCharm4ProngRef    = *aodCharm4ProngTClArr;
-  TClonesArray &aodDstarRef          = *aodDstarTClArr;
-  TClonesArray &aodCascadesRef       = *aodCascadesTClArr;
-  TClonesArray &aodLikeSign2ProngRef = *aodLikeSign2ProngTClArr;
-  TClonesArray &aodLikeSign3ProngRef = *aodLikeSign3ProngTClArr;
-
-
-  AliAODRecoDecayHF2Prong *io2Prong  = 0;
-  AliAODRecoDecayHF3Prong *io3Prong  = 0;
-  AliAODRecoDecayHF4Prong *io4Prong  = 0;
-  AliAODRecoCascadeHF     *ioCascade = 0;
-
-  Int_t    iTrkP1,iTrkP2,iTrkN1,iTrkN2,iTrkSoftPi,trkEntries,iv0,nv0;
-  Double_t xdummy,ydummy,dcap1n1,dcap1n2,dcap2n1,dcap1p2,dcan1n2,dcap2n2,dcaCasc;
-  Bool_t   okD0=kFALSE,okJPSI=kFALSE,ok3Prong=kFALSE,ok4Prong=kFALSE;
-  Bool_t   okDstar=kFALSE,okD0fromDstar=kFALSE;
-  Bool_t   okCascades=kFALSE;
-  AliESDtrack *postrack1 = 0;
-  AliESDtrack *postrack2 = 0;
-  AliESDtrack *negtrack1 = 0;
-  AliESDtrack *negtrack2 = 0;
-  AliESDtrack *trackPi   = 0;
-  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
+  if(fD0toKpi || fDstar) aodD0toKpiTClArr->Delete();
+  if(fJPSItoEle) aodJPSItoEleTClArr->Delete();
+  if(f3Prong) aodCharm3ProngTClArr->Delete();
+  if(f4Prong) aodCharm4ProngTClArr->Delete();
+  if(fDstar) aodDstarTClArr->Delete();
+  if(fCascades) aodCascadesTClArr->Delete();
+  if(fLikeSign) aodLikeSign2ProngTClArr->Delete();
+  if(fLikeSign3prong && f3Prong) aodLikeSign3ProngTClArr->Delete();
+  TClonesArray *outputArrays[kNOutputArrays]={aodVerticesHFTClArr,aodD0toKpiTClArr,aodJPSItoEleTClArr,
+					      aodCharm3ProngTClArr,aodCharm4ProngTClArr,aodDstarTClArr,
+					      aodCascadesTClArr,aodLikeSign2ProngTClArr,aodLikeSign3ProngTClArr};
+
+  Int_t    trkEntries,nv0;
   Float_t dcaMax = fCutsD0toKpi->GetDCACut();
   if(fCutsJpsitoee) dcaMax=TMath::Max(dcaMax,fCutsJpsitoee->GetDCACut());
   if(fCutsDplustoKpipi) dcaMax=TMath::Max(dcaMax,fCutsDplustoKpipi->GetDCACut());
@@ -629,6 +626,141 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliDebug(1,Form(" Selected tracks: %d",nSeleTrks));
   fnSeleTrksTotal += nSeleTrks;
 
+  fMinPt3Prong=0.;
+  fMinPt3Prong=TMath::Min(fCutsDplustoKpipi->GetMinPtCandidate(),fCutsDstoKKpi->GetMinPtCandidate());
+  fMinPt3Prong=TMath::Min(fMinPt3Prong,fCutsLctopKpi->GetMinPtCandidate());
+
+  Double_t minPtV0=0.;
+  if(fCutsLctoV0) minPtV0=fCutsLctoV0->GetMinV0PtCut();
+  if(fCutsDstoK0sK){
+    Double_t minPtV0fromDs=fCutsDstoK0sK->GetMinV0PtCut();
+    if(minPtV0fromDs<minPtV0) minPtV0=minPtV0fromDs;
+  }
+  if(fCutsDplustoK0spi){
+    Double_t minPtV0fromDp=fCutsDplustoK0spi->GetMinV0PtCut();
+    if(minPtV0fromDp<minPtV0) minPtV0=minPtV0fromDp;
+  }
+
+  if(fFastPreselection) PreselectPairs(nSeleTrks,seleFlags,tracksAtVertex,dcaMax);
+
+  // with more than one thread the channel searches run as parallel tasks
+  // (AOD input only: with ESD input the candidates refer to the event tracks)
+  if(fNumberOfThreads>1 && fInputAOD && !fSecVtxWithKF) {
+    FindCandidatesInChannelTasks(event,trkEntries,nv0,nSeleTrks,seleTrksArray,tracksAtVertex,
+				 seleFlags,evtNumber,dcaMax,minPtV0,outputArrays);
+  } else {
+    FindCandidatesInChannels(event,kAllChannelTasks,trkEntries,nv0,nSeleTrks,seleTrksArray,tracksAtVertex,
+			     seleFlags,evtNumber,dcaMax,minPtV0,outputArrays);
+  }
+
+
+  //  AliDebug(1,Form(" Total HF vertices in event = %d;",
+  //		  (Int_t)aodVerticesHFTClArr->GetEntriesFast()));
+  if(fD0toKpi) {
+    AliDebug(1,Form(" D0->Kpi in event = %d;",
+		    (Int_t)aodD0toKpiTClArr->GetEntriesFast()));
+  }
+  if(fJPSItoEle) {
+    AliDebug(1,Form(" JPSI->ee in event = %d;",
+		    (Int_t)aodJPSItoEleTClArr->GetEntriesFast()));
+  }
+  if(f3Prong) {
+    AliDebug(1,Form(" Charm->3Prong in event = %d;",
+		    (Int_t)aodCharm3ProngTClArr->GetEntriesFast()));
+  }
+  if(f4Prong) {
+    AliDebug(1,Form(" Charm->4Prong in event = %d;\n",
+		    (Int_t)aodCharm4ProngTClArr->GetEntriesFast()));
+  }
+  if(fDstar) {
+    AliDebug(1,Form(" D*->D0pi in event = %d;\n",
+		    (Int_t)aodDstarTClArr->GetEntriesFast()));
+  }
+  if(fCascades){
+    AliDebug(1,Form(" cascades -> v0 + track in event = %d;\n",
+		    (Int_t)aodCascadesTClArr->GetEntriesFast()));
+  }
+  if(fLikeSign) {
+    AliDebug(1,Form(" Like-sign 2Prong in event = %d;\n",
+		    (Int_t)aodLikeSign2ProngTClArr->GetEntriesFast()));
+  }
+  if(fLikeSign3prong && f3Prong) {
+    AliDebug(1,Form(" Like-sign 3Prong in event = %d;\n",
+		    (Int_t)aodLikeSign3ProngTClArr->GetEntriesFast()));
+  }
+
+
+  delete [] seleFlags; seleFlags=NULL;
+  if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
+  tracksAtVertex.Delete();
+
+  if(fInputAOD) {
+    seleTrksArray.Delete();
+    if(fAODMap) { delete [] fAODMap; fAODMap=NULL; }
+  }
+
+
+  //printf("Trks: total %d  sele %d\n",fnTrksTotal,fnSeleTrksTotal);
+
+  return;
+}
+//----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FindCandidatesInChannels(AliVEvent *event,Int_t channels,
+						      Int_t trkEntries,Int_t nv0,Int_t nSeleTrks,
+						      const TObjArray &seleTrksArray,
+						      const TObjArray &tracksAtVertex,
+						      const UChar_t *seleFlags,const Int_t *evtNumber,
+						      Float_t dcaMax,Double_t minPtV0,
+						      TClonesArray **outputArrays)
+{
+  /// Candidate loops of FindCandidates for the channel tasks in the
+  /// channels mask (bit kTwoProngTask: D0, J/psi, D* and like-sign pairs;
+  /// kThreeProngTask: 3 prongs and like-sign triplets; kFourProngTask;
+  /// kCascadeTask: V0+track). The candidates are appended to outputArrays,
+  /// ordered as the enum kVerticesHFArray...kLikeSign3ProngArray
+
+  Bool_t doCascades = fCascades && (channels & (1<<kCascadeTask));
+  Bool_t do2Prong = (fD0toKpi || fJPSItoEle || fDstar || fLikeSign) && (channels & (1<<kTwoProngTask));
+  Bool_t do3Prong = f3Prong && (channels & (1<<kThreeProngTask));
+  Bool_t do4Prong = f4Prong && (channels & (1<<kFourProngTask));
+
+  Int_t iVerticesHF=outputArrays[kVerticesHFArray]->GetEntriesFast();
+  Int_t iD0toKpi=0,iJPSItoEle=0,i3Prong=0,i4Prong=0,iDstar=0,iCascades=0,iLikeSign2Prong=0,iLikeSign3Prong=0;
+  if(fD0toKpi || fDstar) iD0toKpi = outputArrays[kD0toKpiArray]->GetEntriesFast();
+  if(fJPSItoEle) iJPSItoEle = outputArrays[kJPSItoEleArray]->GetEntriesFast();
+  if(f3Prong) i3Prong = outputArrays[kCharm3ProngArray]->GetEntriesFast();
+  if(f4Prong) i4Prong = outputArrays[kCharm4ProngArray]->GetEntriesFast();
+  if(fDstar) iDstar = outputArrays[kDstarArray]->GetEntriesFast();
+  if(fCascades) iCascades = outputArrays[kCascadesArray]->GetEntriesFast();
+  if(fLikeSign) iLikeSign2Prong = outputArrays[kLikeSign2ProngArray]->GetEntriesFast();
+  if(fLikeSign3prong && f3Prong) iLikeSign3Prong = outputArrays[kLikeSign3ProngArray]->GetEntriesFast();
+
+  TClonesArray &verticesHFRef        = *outputArrays[kVerticesHFArray];
+  TClonesArray &aodD0toKpiRef        = *outputArrays[kD0toKpiArray];
+  TClonesArray &aodJPSItoEleRef      = *outputArrays[kJPSItoEleArray];
+  TClonesArray &aodCharm3ProngRef    = *outputArrays[kCharm3ProngArray];
+  TClonesArray &aodCharm4ProngRef    = *outputArrays[kCharm4ProngArray];
+  TClonesArray &aodDstarRef          = *outputArrays[kDstarArray];
+  TClonesArray &aodCascadesRef       = *outputArrays[kCascadesArray];
+  TClonesArray &aodLikeSign2ProngRef = *outputArrays[kLikeSign2ProngArray];
+  TClonesArray &aodLikeSign3ProngRef = *outputArrays[kLikeSign3ProngArray];
+
+  AliAODRecoDecayHF2Prong *io2Prong  = 0;
+  AliAODRecoDecayHF3Prong *io3Prong  = 0;
+  AliAODRecoDecayHF4Prong *io4Prong  = 0;
+  AliAODRecoCascadeHF     *ioCascade = 0;
+
+  Int_t    iTrkP1,iTrkP2,iTrkN1,iTrkN2,iTrkSoftPi,iv0;
+  Double_t xdummy,ydummy,dcap1n1,dcap1n2,dcap2n1,dcap1p2,dcan1n2,dcap2n2,dcaCasc;
+  Bool_t   okD0=kFALSE,okJPSI=kFALSE,ok3Prong=kFALSE,ok4Prong=kFALSE;
+  Bool_t   okDstar=kFALSE,okD0fromDstar=kFALSE;
+  Bool_t   okCascades=kFALSE;
+  AliESDtrack *postrack1 = 0;
+  AliESDtrack *postrack2 = 0;
+  AliESDtrack *negtrack1 = 0;
+  AliESDtrack *negtrack2 = 0;
+  AliESDtrack *trackPi   = 0;
+  Double_t mompos1[3],mompos2[3],momneg1[3],momneg2[3];
 
   TObjArray *twoTrackArray1    = new TObjArray(2);
   TObjArray *twoTrackArray2    = new TObjArray(2);
@@ -646,22 +778,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   AliESDv0         *esdV0 = 0;
 
   Bool_t massCutOK=kTRUE;
-  
-  fMinPt3Prong=0.;
-  fMinPt3Prong=TMath::Min(fCutsDplustoKpipi->GetMinPtCandidate(),fCutsDstoKKpi->GetMinPtCandidate());
-  fMinPt3Prong=TMath::Min(fMinPt3Prong,fCutsLctopKpi->GetMinPtCandidate());
 
-  Double_t minPtV0=0.;
-  if(fCutsLctoV0) minPtV0=fCutsLctoV0->GetMinV0PtCut();
-  if(fCutsDstoK0sK){
-    Double_t minPtV0fromDs=fCutsDstoK0sK->GetMinV0PtCut();
-    if(minPtV0fromDs<minPtV0) minPtV0=minPtV0fromDs;
-  }
-  if(fCutsDplustoK0spi){
-    Double_t minPtV0fromDp=fCutsDplustoK0spi->GetMinV0PtCut();
-    if(minPtV0fromDp<minPtV0) minPtV0=minPtV0fromDp;
-  }
-   
   // LOOP ON  POSITIVE  TRACKS
   for(iTrkP1=0; iTrkP1<nSeleTrks; iTrkP1++) {
 
@@ -674,7 +791,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
     // Make cascades with V0+track
     //
-    if(fCascades) {
+    if(doCascades) {
       // loop on V0's
       for(iv0=0; iv0<nv0; iv0++){
 
@@ -833,6 +950,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       continue;
     }
 
+    if(!do2Prong && !do3Prong && !do4Prong) continue;
     if(!TESTBIT(seleFlags[iTrkP1],kBitDispl)) continue;
     if(postrack1->Charge()<0 && !fLikeSign) continue;
 
@@ -876,8 +994,12 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       negtrack1->GetPxPyPz(momneg1);
 
       // DCA between the two tracks
-      dcap1n1 = postrack1->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+      dcap1n1 = GetPairDCA(postrack1,iTrkP1,negtrack1,iTrkN1);
       if(dcap1n1>dcaMax) { negtrack1=0; continue; }
+      // with the fast preselection, pairs outside the 2 prong windows
+      // are vertexed only for the 3 and 4 prong candidates
+      Bool_t okPair2Prong = IsPairIn2ProngWindows(iTrkP1,iTrkN1);
+      if(!okPair2Prong && !do3Prong && !do4Prong) { negtrack1=0; continue; }
 
       // Vertexing
       twoTrackArray1->AddAt(postrack1,0);
@@ -889,7 +1011,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	continue;
       }
       // 2 prong candidate
-      if(fD0toKpi || fJPSItoEle || fDstar || fLikeSign) {
+      if(do2Prong && okPair2Prong) {
 
 	io2Prong = Make2Prong(twoTrackArray1,event,vertexp1n1,dcap1n1,okD0,okJPSI,okD0fromDstar);
 
@@ -1049,8 +1171,8 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       }
 
       twoTrackArray1->Clear();
-      if( (!f3Prong && !f4Prong) ||
-	  (isLikeSign2Prong && !f3Prong) ) {
+      if( (!do3Prong && !do4Prong) ||
+	  (isLikeSign2Prong && !do3Prong) ) {
 	negtrack1=0;
 	delete vertexp1n1;
 	continue;
@@ -1139,14 +1261,14 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 
 	//printf("********** %d %d %d\n",postrack1->GetID(),postrack2->GetID(),negtrack1->GetID());
 
-	dcap2n1 = postrack2->GetDCA(negtrack1,fBzkG,xdummy,ydummy);
+	dcap2n1 = GetPairDCA(postrack2,iTrkP2,negtrack1,iTrkN1);
 	if(dcap2n1>dcaMax) { postrack2=0; continue; }
-	dcap1p2 = postrack2->GetDCA(postrack1,fBzkG,xdummy,ydummy);
+	dcap1p2 = GetPairDCA(postrack2,iTrkP2,postrack1,iTrkP1);
 	if(dcap1p2>dcaMax) { postrack2=0; continue; }
 
 	// check invariant mass cuts for D+,Ds,Lc
         massCutOK=kTRUE;
-	if(f3Prong) {
+	if(do3Prong) {
 	  if(postrack2->Charge()>0) {
 	    threeTrackArray->AddAt(postrack1,0);
 	    threeTrackArray->AddAt(negtrack1,1);
@@ -1166,9 +1288,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	  }
 	}
 
-	if(f3Prong && !massCutOK) {
+	if(do3Prong && !massCutOK) {
 	  threeTrackArray->Clear();
-	  if(!f4Prong) {
+	  if(!do4Prong) {
 	    postrack2=0;
 	    continue;
 	  }
@@ -1179,7 +1301,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	twoTrackArray2->AddAt(negtrack1,1);
 
 	// 3 prong candidates
-	if(f3Prong && massCutOK) {
+	if(do3Prong && massCutOK) {
 	  
 	  AliAODVertex* secVert3PrAOD = ReconstructSecondaryVertex(threeTrackArray,dispersion);
 	  io3Prong = Make3Prong(threeTrackArray,event,secVert3PrAOD,dispersion,vertexp1n1,twoTrackArray2,dcap1n1,dcap2n1,dcap1p2,okForLcTopKpi,okForDsToKKpi,ok3Prong);
@@ -1225,7 +1347,7 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	}
 
 	// 4 prong candidates
-	if(f4Prong
+	if(do4Prong
 	   // don't make 4 prong with like-sign pairs and triplets
 	   && !isLikeSign2Prong && !isLikeSign3Prong
 	   // track-to-track dca cuts already now
@@ -1277,9 +1399,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	    SetParametersAtVertex(postrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkP2));
 	    SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 
-	    dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	    dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
 	    if(dcap1n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
-            dcap2n2 = postrack2->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+            dcap2n2 = GetPairDCA(postrack2,iTrkP2,negtrack2,iTrkN2);
             if(dcap2n2 > fCutsD0toKpipipi->GetDCACut()) { negtrack2=0; continue; }
 
 
@@ -1332,6 +1454,11 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
       } // end 2nd loop on positive tracks
 
       twoTrackArray2->Clear();
+      if(!do3Prong) {
+	negtrack1=0;
+	delete vertexp1n1;
+	continue;
+      }
 
       // 2nd LOOP  ON  NEGATIVE  TRACKS (for 3 prong -+-)
       for(iTrkN2=iTrkN1+1; iTrkN2<nSeleTrks; iTrkN2++) {
@@ -1410,9 +1537,9 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
 	SetParametersAtVertex(negtrack2,(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(iTrkN2));
 	//printf("********** %d %d %d\n",postrack1->GetID(),negtrack1->GetID(),negtrack2->GetID());
 
-	dcap1n2 = postrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcap1n2 = GetPairDCA(postrack1,iTrkP1,negtrack2,iTrkN2);
 	if(dcap1n2>dcaMax) { negtrack2=0; continue; }
-	dcan1n2 = negtrack1->GetDCA(negtrack2,fBzkG,xdummy,ydummy);
+	dcan1n2 = GetPairDCA(negtrack1,iTrkN1,negtrack2,iTrkN2);
 	if(dcan1n2>dcaMax) { negtrack2=0; continue; }
 
 	threeTrackArray->AddAt(negtrack1,0);
@@ -1493,43 +1620,6 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
     postrack1 = 0;
  }  // end 1st loop on positive tracks
 
-
-  //  AliDebug(1,Form(" Total HF vertices in event = %d;",
-  //		  (Int_t)aodVerticesHFTClArr->GetEntriesFast()));
-  if(fD0toKpi) {
-    AliDebug(1,Form(" D0->Kpi in event = %d;",
-		    (Int_t)aodD0toKpiTClArr->GetEntriesFast()));
-  }
-  if(fJPSItoEle) {
-    AliDebug(1,Form(" JPSI->ee in event = %d;",
-		    (Int_t)aodJPSItoEleTClArr->GetEntriesFast()));
-  }
-  if(f3Prong) {
-    AliDebug(1,Form(" Charm->3Prong in event = %d;",
-		    (Int_t)aodCharm3ProngTClArr->GetEntriesFast()));
-  }
-  if(f4Prong) {
-    AliDebug(1,Form(" Charm->4Prong in event = %d;\n",
-		    (Int_t)aodCharm4ProngTClArr->GetEntriesFast()));
-  }
-  if(fDstar) {
-    AliDebug(1,Form(" D*->D0pi in event = %d;\n",
-		    (Int_t)aodDstarTClArr->GetEntriesFast()));
-  }
-  if(fCascades){
-    AliDebug(1,Form(" cascades -> v0 + track in event = %d;\n",
-		    (Int_t)aodCascadesTClArr->GetEntriesFast()));
-  }
-  if(fLikeSign) {
-    AliDebug(1,Form(" Like-sign 2Prong in event = %d;\n",
-		    (Int_t)aodLikeSign2ProngTClArr->GetEntriesFast()));
-  }
-  if(fLikeSign3prong && f3Prong) {
-    AliDebug(1,Form(" Like-sign 3Prong in event = %d;\n",
-		    (Int_t)aodLikeSign3ProngTClArr->GetEntriesFast()));
-  }
-
-
   twoTrackArray1->Delete();  delete twoTrackArray1;
   twoTrackArray2->Delete();  delete twoTrackArray2;
   twoTrackArrayCasc->Delete();  delete twoTrackArrayCasc;
@@ -1537,17 +1627,143 @@ void AliAnalysisVertexingHF::FindCandidates(AliVEvent *event,
   threeTrackArray->Clear();
   threeTrackArray->Delete(); delete threeTrackArray;
   fourTrackArray->Delete();  delete fourTrackArray;
-  delete [] seleFlags; seleFlags=NULL;
-  if(evtNumber) {delete [] evtNumber; evtNumber=NULL;}
-  tracksAtVertex.Delete();
 
-  if(fInputAOD) {
-    seleTrksArray.Delete();
-    if(fAODMap) { delete [] fAODMap; fAODMap=NULL; }
+  return;
+}
+//----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::FindCandidatesInChannelTasks(AliVEvent *event,
+							  Int_t trkEntries,Int_t nv0,Int_t nSeleTrks,
+							  const TObjArray &seleTrksArray,
+							  const TObjArray &tracksAtVertex,
+							  const UChar_t *seleFlags,const Int_t *evtNumber,
+							  Float_t dcaMax,Double_t minPtV0,
+							  TClonesArray **outputArrays)
+{
+  /// Run the channel tasks of FindCandidatesInChannels in parallel, on a
+  /// thread pool created at the first event. Each task has its worker
+  /// (own AliVertexerTracks, cut objects and candidate buffers) and its own
+  /// copy of the selected tracks, whose parameters are reset at the primary
+  /// vertex in the loops. The buffers are moved to the output arrays in the
+  /// task order; each candidate array is filled by one task only, so its
+  /// content and order are the ones of the serial loops.
+  /// Without implicit MT support in ROOT the loops run serially.
+
+#ifdef R__USE_IMT
+  std::vector<Int_t> tasks;
+  if(fD0toKpi || fJPSItoEle || fDstar || fLikeSign) tasks.push_back(kTwoProngTask);
+  if(f3Prong) tasks.push_back(kThreeProngTask);
+  if(f4Prong) tasks.push_back(kFourProngTask);
+  if(fCascades) tasks.push_back(kCascadeTask);
+
+  if(!fChannelExecutor) {
+    ROOT::EnableThreadSafety();
+    fChannelExecutor = new ROOT::TThreadExecutor(TMath::Min(fNumberOfThreads,(Int_t)kNChannelTasks));
+  }
+  for(UInt_t i=0; i<tasks.size(); i++) {
+    if(!fChannelWorkers[tasks[i]]) fChannelWorkers[tasks[i]] = MakeChannelWorker();
+    SetupChannelWorker(fChannelWorkers[tasks[i]],event);
+  }
+
+  auto runTask = [&](UInt_t itask) {
+    AliAnalysisVertexingHF *worker = fChannelWorkers[tasks[itask]];
+    TObjArray trksArray(nSeleTrks);
+    for(Int_t i=0; i<nSeleTrks; i++) {
+      trksArray.AddLast(new AliESDtrack(*(AliESDtrack*)seleTrksArray.UncheckedAt(i)));
+    }
+    TClonesArray *buffers[kNOutputArrays];
+    for(Int_t j=0; j<kNOutputArrays; j++) {
+      buffers[j] = (TClonesArray*)worker->fChannelBuffers->UncheckedAt(j);
+      buffers[j]->Delete();
+    }
+    worker->FindCandidatesInChannels(event,1<<tasks[itask],trkEntries,nv0,nSeleTrks,trksArray,tracksAtVertex,
+				     seleFlags,evtNumber,dcaMax,minPtV0,buffers);
+    trksArray.Delete();
+  };
+  fChannelExecutor->Foreach(runTask,ROOT::TSeqU(tasks.size()));
+
+  // move the candidates to the output, in the task order
+  for(UInt_t i=0; i<tasks.size(); i++) {
+    for(Int_t j=0; j<kNOutputArrays; j++) {
+      TClonesArray *buffer = (TClonesArray*)fChannelWorkers[tasks[i]]->fChannelBuffers->UncheckedAt(j);
+      if(buffer->GetEntriesFast()>0) outputArrays[j]->AbsorbObjects(buffer);
+    }
   }
+#else
+  FindCandidatesInChannels(event,kAllChannelTasks,trkEntries,nv0,nSeleTrks,seleTrksArray,tracksAtVertex,
+			   seleFlags,evtNumber,dcaMax,minPtV0,outputArrays);
+#endif
 
-
-  //printf("Trks: total %d  sele %d\n",fnTrksTotal,fnSeleTrksTotal);
+  return;
+}
+//----------------------------------------------------------------------------
+AliAnalysisVertexingHF* AliAnalysisVertexingHF::MakeChannelWorker() const
+{
+  /// Copy of this object for a channel task, with its own vertexer,
+  /// cut objects, mass calculators and candidate buffers
+
+  AliAnalysisVertexingHF *worker = new AliAnalysisVertexingHF(*this);
+  worker->fChannelParent = this;
+  worker->fNumberOfThreads = 1;
+  worker->fMakeReducedRHF = fMakeReducedRHF;
+  worker->fVertexerTracks = new AliVertexerTracks(fBzkG);
+  worker->fCutsD0toKpi = fCutsD0toKpi ? new AliRDHFCutsD0toKpi(*fCutsD0toKpi) : 0x0;
+  worker->fCutsJpsitoee = fCutsJpsitoee ? new AliRDHFCutsJpsitoee(*fCutsJpsitoee) : 0x0;
+  worker->fCutsDplustoK0spi = fCutsDplustoK0spi ? new AliRDHFCutsDplustoK0spi(*fCutsDplustoK0spi) : 0x0;
+  worker->fCutsDplustoKpipi = fCutsDplustoKpipi ? new AliRDHFCutsDplustoKpipi(*fCutsDplustoKpipi) : 0x0;
+  worker->fCutsDstoK0sK = fCutsDstoK0sK ? new AliRDHFCutsDstoK0sK(*fCutsDstoK0sK) : 0x0;
+  worker->fCutsDstoKKpi = fCutsDstoKKpi ? new AliRDHFCutsDstoKKpi(*fCutsDstoKKpi) : 0x0;
+  worker->fCutsLctopKpi = fCutsLctopKpi ? new AliRDHFCutsLctopKpi(*fCutsLctopKpi) : 0x0;
+  worker->fCutsLctoV0 = fCutsLctoV0 ? new AliRDHFCutsLctoV0(*fCutsLctoV0) : 0x0;
+  worker->fCutsD0toKpipipi = fCutsD0toKpipipi ? new AliRDHFCutsD0toKpipipi(*fCutsD0toKpipipi) : 0x0;
+  worker->fCutsDStartoKpipi = fCutsDStartoKpipi ? new AliRDHFCutsDStartoKpipi(*fCutsDStartoKpipi) : 0x0;
+  Double_t d02[2]={0.,0.};
+  Double_t d03[3]={0.,0.,0.};
+  Double_t d04[4]={0.,0.,0.,0.};
+  worker->fMassCalc2 = new AliAODRecoDecay(0x0,2,0,d02);
+  worker->fMassCalc3 = new AliAODRecoDecay(0x0,3,1,d03);
+  worker->fMassCalc4 = new AliAODRecoDecay(0x0,4,0,d04);
+
+  // candidate buffers, same order and classes as the output arrays
+  worker->fChannelBuffers = new TObjArray(kNOutputArrays);
+  worker->fChannelBuffers->SetOwner();
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODVertex",0),kVerticesHFArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoDecayHF2Prong",0),kD0toKpiArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoDecayHF2Prong",0),kJPSItoEleArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoDecayHF3Prong",0),kCharm3ProngArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoDecayHF4Prong",0),kCharm4ProngArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoCascadeHF",0),kDstarArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoCascadeHF",0),kCascadesArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoDecayHF2Prong",0),kLikeSign2ProngArray);
+  worker->fChannelBuffers->AddAt(new TClonesArray("AliAODRecoDecayHF3Prong",0),kLikeSign3ProngArray);
+
+  return worker;
+}
+//----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::SetupChannelWorker(AliAnalysisVertexingHF *worker,AliVEvent *event) const
+{
+  /// Pass the event quantities to a channel worker (primary vertex, AOD map
+  /// and field are shared and only read by the tasks)
+
+  worker->fInputAOD = fInputAOD;
+  worker->fMixEvent = fMixEvent;
+  worker->fAODMapSize = fAODMapSize;
+  worker->fAODMap = fAODMap;
+  worker->fV1 = fV1;
+  worker->fV1AOD = fV1AOD;
+  worker->fMinPt3Prong = fMinPt3Prong;
+  worker->fBzkG = fBzkG;
+  if(worker->fVertexerTracks->GetFieldkG()!=fBzkG) worker->fVertexerTracks->SetFieldkG(fBzkG);
+
+  if(worker->fCutsD0toKpi) worker->fCutsD0toKpi->SetupPID(event);
+  if(worker->fCutsJpsitoee) worker->fCutsJpsitoee->SetupPID(event);
+  if(worker->fCutsDplustoK0spi) worker->fCutsDplustoK0spi->SetupPID(event);
+  if(worker->fCutsDplustoKpipi) worker->fCutsDplustoKpipi->SetupPID(event);
+  if(worker->fCutsDstoK0sK) worker->fCutsDstoK0sK->SetupPID(event);
+  if(worker->fCutsDstoKKpi) worker->fCutsDstoKKpi->SetupPID(event);
+  if(worker->fCutsLctopKpi) worker->fCutsLctopKpi->SetupPID(event);
+  if(worker->fCutsLctoV0) worker->fCutsLctoV0->SetupPID(event);
+  if(worker->fCutsD0toKpipipi) worker->fCutsD0toKpipipi->SetupPID(event);
+  if(worker->fCutsDStartoKpipi) worker->fCutsDStartoKpipi->SetupPID(event);
 
   return;
 }
@@ -2964,6 +3180,12 @@ void AliAnalysisVertexingHF::PrintStatus() const {
     printf("  D0->Kpipipi cuts:\n");
     if(fCutsD0toKpipipi) fCutsD0toKpipipi->PrintAll();
   }
+  if(fFastPreselection) {
+    printf("Fast preselection of the track pairs before the vertexing (DCA tolerance %.4f cm)\n",fFastDCATolerance);
+  }
+  if(fNumberOfThreads>1) {
+    printf("Channel searches run as parallel tasks on %d threads (AOD input)\n",fNumberOfThreads);
+  }
   if(fCascades) {
     printf("Reconstruct cascade candidates formed with v0s.\n");
     printf("  Lc -> k0s P & Lc -> L Pi cuts:\n");
@@ -3775,6 +3997,229 @@ void AliAnalysisVertexingHF::SetParametersAtVertex(AliESDtrack* esdt, const AliE
   return;
 }
 //-----------------------------------------------------------------------------
+void AliAnalysisVertexingHF::PreselectPairs(Int_t nSeleTrks,const UChar_t *seleFlags,
+					    const TObjArray &tracksAtVertex,Float_t dcaMax){
+  /// Fast preselection of the pairs of displaced tracks (SetFastPreselection),
+  /// run once per event before the candidate loops:
+  /// 1) in bulk, on flat arrays of the track parameters at the primary vertex:
+  ///    closest approach of the tangent lines; pairs with DCA above
+  ///    dcaMax+fFastDCATolerance or meeting outside the beam pipe are rejected;
+  /// 2) analytic DCA fit of the surviving pairs: the tracks are taken on
+  ///    their helix at the first vertex estimate and the closest approach of
+  ///    the tangents there is recomputed. This DCA replaces
+  ///    AliExternalTrackParam::GetDCA in the loops;
+  /// 3) invariant-mass windows (D0, J/psi, D0 from D*) and pointing angle
+  ///    (loosest cosThetaPoint cut) with the momenta at the fitted vertex.
+  /// Only the pairs passing 3) reach AliVertexerTracks for the 2 prong
+  /// candidates; 3 and 4 prongs are vertexed if all the pair DCAs pass.
+
+  fPairIndex.assign(nSeleTrks,-1);
+  fNPairTracks=0;
+  std::vector<Int_t> trkIndex;
+  for(Int_t i=0; i<nSeleTrks; i++) {
+    if(!TESTBIT(seleFlags[i],kBitDispl)) continue;
+    fPairIndex[i]=fNPairTracks++;
+    trkIndex.push_back(i);
+  }
+  const Int_t n=fNPairTracks;
+  const size_t nPairs=(size_t)n*(n-1)/2;
+  if(nPairs>fPairDCA.size()) {
+    fPairDCA.resize(nPairs);
+    fPairIn2ProngWindows.resize(nPairs);
+  }
+
+  // track parameters at the primary vertex, one array per quantity
+  std::vector<Double_t> x(n),y(n),z(n),ux(n),uy(n),uz(n);
+  Double_t xyz[3],mom[3];
+  for(Int_t k=0; k<n; k++) {
+    const AliExternalTrackParam *t=(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(trkIndex[k]);
+    t->GetXYZ(xyz);
+    t->GetPxPyPz(mom);
+    Double_t p=TMath::Sqrt(mom[0]*mom[0]+mom[1]*mom[1]+mom[2]*mom[2]);
+    if(p<=0.) p=1.;
+    x[k]=xyz[0]; y[k]=xyz[1]; z[k]=xyz[2];
+    ux[k]=mom[0]/p; uy[k]=mom[1]/p; uz[k]=mom[2]/p;
+  }
+
+  // 1) bulk preselection, one row of pairs at a time
+  const Double_t maxDCA=dcaMax+fFastDCATolerance;
+  std::vector<Double_t> dca2(n),r2(n),vx(n),vy(n),vz(n);
+  std::vector<size_t> survivors;
+  std::vector<Int_t> survivorTrks;
+  std::vector<Double_t> survivorVtx;
+  for(Int_t k1=0; k1<n-1; k1++) {
+    for(Int_t k2=k1+1; k2<n; k2++) {
+      Double_t wx=x[k1]-x[k2], wy=y[k1]-y[k2], wz=z[k1]-z[k2];
+      Double_t b=ux[k1]*ux[k2]+uy[k1]*uy[k2]+uz[k1]*uz[k2];
+      Double_t d=ux[k1]*wx+uy[k1]*wy+uz[k1]*wz;
+      Double_t e=ux[k2]*wx+uy[k2]*wy+uz[k2]*wz;
+      Double_t den=TMath::Max(1.-b*b,1.e-12);
+      Double_t s1=(b*e-d)/den, s2=(e-b*d)/den;
+      Double_t cx1=x[k1]+s1*ux[k1], cy1=y[k1]+s1*uy[k1], cz1=z[k1]+s1*uz[k1];
+      Double_t cx2=x[k2]+s2*ux[k2], cy2=y[k2]+s2*uy[k2], cz2=z[k2]+s2*uz[k2];
+      dca2[k2]=(cx1-cx2)*(cx1-cx2)+(cy1-cy2)*(cy1-cy2)+(cz1-cz2)*(cz1-cz2);
+      vx[k2]=0.5*(cx1+cx2); vy[k2]=0.5*(cy1+cy2); vz[k2]=0.5*(cz1+cz2);
+      r2[k2]=vx[k2]*vx[k2]+vy[k2]*vy[k2];
+    }
+    const size_t row=GetPairKey(k1,k1+1);
+    for(Int_t k2=k1+1; k2<n; k2++) {
+      const size_t key=row+(k2-k1-1);
+      fPairIn2ProngWindows[key]=kFALSE;
+      if(dca2[k2]>maxDCA*maxDCA || r2[k2]>8.) { // same beam pipe cut as ReconstructSecondaryVertex
+	fPairDCA[key]=kVeryBig;
+	continue;
+      }
+      survivors.push_back(key);
+      survivorTrks.push_back(k1);
+      survivorTrks.push_back(k2);
+      survivorVtx.push_back(vx[k2]);
+      survivorVtx.push_back(vy[k2]);
+      survivorVtx.push_back(vz[k2]);
+    }
+  }
+  fnPairsTested += nPairs;
+  fnPairsFitted += survivors.size();
+
+  // 2) analytic DCA fit and 3) mass windows and pointing
+  const Bool_t search2Prong = fD0toKpi || fJPSItoEle || fDstar;
+  Double_t minCosPoint=-2.;
+  if(search2Prong) {
+    minCosPoint=2.;
+    if(fD0toKpi) minCosPoint=TMath::Min(minCosPoint,GetLoosestCut(fCutsD0toKpi,"cosThetaPoint",-2.));
+    if(fJPSItoEle) minCosPoint=TMath::Min(minCosPoint,GetLoosestCut(fCutsJpsitoee,"cosThetaPoint",-2.));
+    if(fDstar) minCosPoint=TMath::Min(minCosPoint,GetLoosestCut(fCutsDStartoKpipi,"cosThetaPoint",-2.));
+  }
+  Double_t primVtx[3];
+  fV1->GetXYZ(primVtx);
+  Double_t pos1[3],mom1[3],pos2[3],mom2[3],vtx[3];
+  Double_t px[2],py[2],pz[2];
+  for(size_t is=0; is<survivors.size(); is++) {
+    const size_t key=survivors[is];
+    const AliExternalTrackParam *t1=(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(trkIndex[survivorTrks[2*is]]);
+    const AliExternalTrackParam *t2=(AliExternalTrackParam*)tracksAtVertex.UncheckedAt(trkIndex[survivorTrks[2*is+1]]);
+    if(!GetHelixTangentAt(t1,&survivorVtx[3*is],pos1,mom1) ||
+       !GetHelixTangentAt(t2,&survivorVtx[3*is],pos2,mom2)) {
+      fPairDCA[key]=kVeryBig;
+      continue;
+    }
+    const Double_t dca=GetTangentsClosestApproach(pos1,mom1,pos2,mom2,vtx);
+    fPairDCA[key]=dca;
+    if(!search2Prong || dca>dcaMax) continue;
+
+    // same prong order as in the loops: positive track first, or the
+    // first selected track for like-sign pairs
+    const Bool_t swap = t1->Charge()<0 && t2->Charge()>0;
+    const Double_t *momP = swap ? mom2 : mom1;
+    const Double_t *momN = swap ? mom1 : mom2;
+    px[0]=momP[0]; py[0]=momP[1]; pz[0]=momP[2];
+    px[1]=momN[0]; py[1]=momN[1]; pz[1]=momN[2];
+    Bool_t okMass=kFALSE;
+    if(!okMass && fD0toKpi)   okMass=SelectInvMassAndPtD0Kpi(px,py,pz);
+    if(!okMass && fJPSItoEle) okMass=SelectInvMassAndPtJpsiee(px,py,pz);
+    if(!okMass && fDstar)     okMass=SelectInvMassAndPtDstarD0pi(px,py,pz);
+    if(!okMass) continue;
+
+    Double_t flight[3]={vtx[0]-primVtx[0],vtx[1]-primVtx[1],vtx[2]-primVtx[2]};
+    Double_t ptot[3]={px[0]+px[1],py[0]+py[1],pz[0]+pz[1]};
+    Double_t norm=TMath::Sqrt((flight[0]*flight[0]+flight[1]*flight[1]+flight[2]*flight[2])*
+			      (ptot[0]*ptot[0]+ptot[1]*ptot[1]+ptot[2]*ptot[2]));
+    if(norm>0. && (flight[0]*ptot[0]+flight[1]*ptot[1]+flight[2]*ptot[2])<minCosPoint*norm) continue;
+
+    fPairIn2ProngWindows[key]=kTRUE;
+    fnPairs2Prong++;
+  }
+
+  return;
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::GetHelixTangentAt(const AliExternalTrackParam *t,const Double_t *vtx,
+						 Double_t *pos,Double_t *mom) const {
+  /// Point and momentum of the track on its helix, at the local x of the
+  /// vertex estimate vtx (analytic propagation, no material)
+
+  Double_t alpha=t->GetAlpha();
+  Double_t xloc=vtx[0]*TMath::Cos(alpha)+vtx[1]*TMath::Sin(alpha);
+  if(!t->GetXYZAt(xloc,fBzkG,pos)) return kFALSE;
+  if(!t->GetPxPyPzAt(xloc,fBzkG,mom)) return kFALSE;
+  return kTRUE;
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetTangentsClosestApproach(const Double_t *pos1,const Double_t *mom1,
+							     const Double_t *pos2,const Double_t *mom2,
+							     Double_t *vtx) const {
+  /// Distance of closest approach of the straight lines through pos1 and
+  /// pos2 along mom1 and mom2; vtx is the middle point of the closest approach
+
+  Double_t p1=TMath::Sqrt(mom1[0]*mom1[0]+mom1[1]*mom1[1]+mom1[2]*mom1[2]);
+  Double_t p2=TMath::Sqrt(mom2[0]*mom2[0]+mom2[1]*mom2[1]+mom2[2]*mom2[2]);
+  if(p1<=0. || p2<=0.) return kVeryBig;
+  Double_t u1[3],u2[3],w[3];
+  for(Int_t i=0; i<3; i++) {
+    u1[i]=mom1[i]/p1;
+    u2[i]=mom2[i]/p2;
+    w[i]=pos1[i]-pos2[i];
+  }
+  Double_t b=u1[0]*u2[0]+u1[1]*u2[1]+u1[2]*u2[2];
+  Double_t d=u1[0]*w[0]+u1[1]*w[1]+u1[2]*w[2];
+  Double_t e=u2[0]*w[0]+u2[1]*w[1]+u2[2]*w[2];
+  Double_t den=TMath::Max(1.-b*b,1.e-12);
+  Double_t s1=(b*e-d)/den, s2=(e-b*d)/den;
+  Double_t dca2=0.;
+  for(Int_t i=0; i<3; i++) {
+    Double_t c1=pos1[i]+s1*u1[i];
+    Double_t c2=pos2[i]+s2*u2[i];
+    vtx[i]=0.5*(c1+c2);
+    dca2+=(c1-c2)*(c1-c2);
+  }
+  return TMath::Sqrt(dca2);
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetLoosestCut(const AliRDHFCuts *cuts,const char *varName,Double_t noCut) const {
+  /// Loosest value over the pt bins of a lower cut (noCut if the variable
+  /// is not in the cut object)
+
+  if(!cuts || !cuts->GetVarNames() || !cuts->GetIsUpperCut()) return noCut;
+  for(Int_t iVar=0; iVar<cuts->GetNVars(); iVar++) {
+    if(cuts->GetVarNames()[iVar]!=varName || cuts->GetIsUpperCut()[iVar]) continue;
+    Double_t loosest=kVeryBig;
+    for(Int_t iPt=0; iPt<cuts->GetNPtBins(); iPt++) loosest=TMath::Min(loosest,(Double_t)cuts->GetCutValue(iVar,iPt));
+    return cuts->GetNPtBins()>0 ? loosest : noCut;
+  }
+  return noCut;
+}
+//-----------------------------------------------------------------------------
+size_t AliAnalysisVertexingHF::GetPairKey(Int_t k1,Int_t k2) const {
+  /// Position of the pair k1<k2 of displaced tracks in the pair tables
+  /// (upper triangle, row by row)
+
+  const AliAnalysisVertexingHF *table = fChannelParent ? fChannelParent : this;
+  return (size_t)k1*(2*table->fNPairTracks-k1-1)/2+(k2-k1-1);
+}
+//-----------------------------------------------------------------------------
+Double_t AliAnalysisVertexingHF::GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,AliESDtrack *trk2,Int_t iTrk2) const {
+  /// DCA between two selected displaced tracks with parameters at the
+  /// primary vertex: trk1->GetDCA(trk2), or the analytic DCA of
+  /// PreselectPairs with the fast preselection
+
+  if(!fFastPreselection) {
+    Double_t xdummy,ydummy;
+    return trk1->GetDCA(trk2,fBzkG,xdummy,ydummy);
+  }
+  const AliAnalysisVertexingHF *table = fChannelParent ? fChannelParent : this;
+  Int_t k1=table->fPairIndex[iTrk1], k2=table->fPairIndex[iTrk2];
+  return k1<k2 ? table->fPairDCA[GetPairKey(k1,k2)] : table->fPairDCA[GetPairKey(k2,k1)];
+}
+//-----------------------------------------------------------------------------
+Bool_t AliAnalysisVertexingHF::IsPairIn2ProngWindows(Int_t iTrk1,Int_t iTrk2) const {
+  /// Pair passing the mass windows and pointing of PreselectPairs
+  /// (always kTRUE without the fast preselection)
+
+  if(!fFastPreselection) return kTRUE;
+  const AliAnalysisVertexingHF *table = fChannelParent ? fChannelParent : this;
+  Int_t k1=table->fPairIndex[iTrk1], k2=table->fPairIndex[iTrk2];
+  return k1<k2 ? table->fPairIn2ProngWindows[GetPairKey(k1,k2)] : table->fPairIn2ProngWindows[GetPairKey(k2,k1)];
+}
+//-----------------------------------------------------------------------------
 void AliAnalysisVertexingHF::SetMasses(){
   /// Set the hadron mass values from TDatabasePDG
 
@@ -16,9 +16,12 @@
 #include <TNamed.h>
 #include <TList.h>
 
+#include <vector>
+
 #include "AliAnalysisFilter.h"
 #include "AliESDtrackCuts.h"
 
+namespace ROOT { class TThreadExecutor; }
 class AliPIDResponse;
 class AliESDVertex;
 class AliAODRecoDecay;
@@ -179,6 +182,21 @@ class AliAnalysisVertexingHF : public TNamed {
   void SetCutsDStartoKpipi(AliRDHFCutsDStartoKpipi* cuts) { fCutsDStartoKpipi = cuts; }
   AliRDHFCutsDStartoKpipi* GetCutsDStartoKpipi() const { return fCutsDStartoKpipi; }
   void SetMassCutBeforeVertexing(Bool_t flag) { fMassCutBeforeVertexing=flag; }
+  /// Fast candidate search: bulk preselection of the track pairs (DCA of the
+  /// tangent lines, invariant-mass windows, pointing angle) and analytic fit
+  /// of the pair DCA, with AliVertexerTracks only for the surviving
+  /// combinations. kFALSE (default) is the regression mode, with the output
+  /// of the full loops. dcaTolerance (cm) is added to the DCA cut in the bulk step
+  void SetFastPreselection(Bool_t flag=kTRUE,Double_t dcaTolerance=0.01) { fFastPreselection=flag; fFastDCATolerance=dcaTolerance; }
+  Bool_t GetFastPreselection() const { return fFastPreselection; }
+  /// Run the channel searches (D0, J/psi, D* and like-sign pairs; 3 prongs;
+  /// 4 prongs; cascades) as parallel tasks on a pool of n threads, with AOD
+  /// input and ROOT built with implicit MT (same output as n=1)
+  void SetNumberOfThreads(Int_t n) { fNumberOfThreads=n; }
+  Int_t GetNumberOfThreads() const { return fNumberOfThreads; }
+  Long64_t GetNPairsTested() const { return fnPairsTested; }
+  Long64_t GetNPairsFitted() const { return fnPairsFitted; }
+  Long64_t GetNPairs2Prong() const { return fnPairs2Prong; }
 
   void SetMasses();
   Bool_t CheckCutsConsistency();
@@ -250,6 +268,9 @@ class AliAnalysisVertexingHF : public TNamed {
  private:
   //
   enum { kBitDispl = 0, kBitSoftPi = 1, kBit3Prong = 2, kBitPionCompat = 3, kBitKaonCompat = 4, kBitProtonCompat = 5, kBitBachelor = 6};
+  enum { kTwoProngTask = 0, kThreeProngTask = 1, kFourProngTask = 2, kCascadeTask = 3, kNChannelTasks = 4, kAllChannelTasks = (1<<kNChannelTasks)-1 };
+  enum { kVerticesHFArray = 0, kD0toKpiArray, kJPSItoEleArray, kCharm3ProngArray, kCharm4ProngArray,
+         kDstarArray, kCascadesArray, kLikeSign2ProngArray, kLikeSign3ProngArray, kNOutputArrays };
 
   Bool_t fInputAOD; /// input from AOD (kTRUE) or ESD (kFALSE)
   Int_t fAODMapSize; /// size of fAODMap
@@ -346,6 +367,21 @@ class AliAnalysisVertexingHF : public TNamed {
   Int_t  fnSeleTrksTotal;
   Bool_t fMakeReducedRHF;// switch the reduction of dAOD size on/off
 
+  Bool_t fFastPreselection;   /// bulk pair preselection and analytic DCA fit before the vertexing
+  Double_t fFastDCATolerance; /// margin on the DCA cut for the straight-line DCA of the bulk step (cm)
+  Int_t  fNumberOfThreads;   /// threads running the channel searches (<=1: serial loops)
+  ROOT::TThreadExecutor *fChannelExecutor; //! thread pool of the channel tasks, created once (ROOT with implicit MT only)
+  AliAnalysisVertexingHF *fChannelWorkers[kNChannelTasks]; //! per-task copies with own vertexer and cuts
+  TObjArray *fChannelBuffers; //! candidate buffers of a channel worker
+  const AliAnalysisVertexingHF *fChannelParent; //! main object of a channel worker (owns vertex, AOD map and pair tables), 0 otherwise
+  std::vector<Int_t>    fPairIndex;  //! index of the selected tracks among the displaced ones (-1: not displaced)
+  Int_t    fNPairTracks;             //! number of displaced tracks in the event
+  std::vector<Double_t> fPairDCA;    //! analytic DCA of the pairs of displaced tracks (kVeryBig: rejected in bulk)
+  std::vector<UChar_t>  fPairIn2ProngWindows; //! pair in the 2 prong mass windows and pointing
+  Long64_t fnPairsTested;            //! pairs tested in bulk
+  Long64_t fnPairsFitted;            //! pairs fitted analytically
+  Long64_t fnPairs2Prong;            //! pairs passing the 2 prong windows
+
   Double_t fMassDzero;
   Double_t fMassDplus;
   Double_t fMassDs;
@@ -420,6 +456,26 @@ class AliAnalysisVertexingHF : public TNamed {
 				   Int_t &nSeleTrks,
 				   UChar_t *seleFlags,Int_t *evtNumber);
   void SetParametersAtVertex(AliESDtrack* esdt, const AliExternalTrackParam* extpar) const;
+  void FindCandidatesInChannels(AliVEvent *event,Int_t channels,
+				Int_t trkEntries,Int_t nv0,Int_t nSeleTrks,
+				const TObjArray &seleTrksArray,const TObjArray &tracksAtVertex,
+				const UChar_t *seleFlags,const Int_t *evtNumber,
+				Float_t dcaMax,Double_t minPtV0,TClonesArray **outputArrays);
+  void FindCandidatesInChannelTasks(AliVEvent *event,
+				    Int_t trkEntries,Int_t nv0,Int_t nSeleTrks,
+				    const TObjArray &seleTrksArray,const TObjArray &tracksAtVertex,
+				    const UChar_t *seleFlags,const Int_t *evtNumber,
+				    Float_t dcaMax,Double_t minPtV0,TClonesArray **outputArrays);
+  AliAnalysisVertexingHF* MakeChannelWorker() const;
+  void SetupChannelWorker(AliAnalysisVertexingHF *worker,AliVEvent *event) const;
+  void PreselectPairs(Int_t nSeleTrks,const UChar_t *seleFlags,const TObjArray &tracksAtVertex,Float_t dcaMax);
+  Bool_t GetHelixTangentAt(const AliExternalTrackParam *t,const Double_t *vtx,Double_t *pos,Double_t *mom) const;
+  Double_t GetTangentsClosestApproach(const Double_t *pos1,const Double_t *mom1,
+				      const Double_t *pos2,const Double_t *mom2,Double_t *vtx) const;
+  Double_t GetLoosestCut(const AliRDHFCuts *cuts,const char *varName,Double_t noCut) const;
+  size_t GetPairKey(Int_t k1,Int_t k2) const;
+  Double_t GetPairDCA(AliESDtrack *trk1,Int_t iTrk1,AliESDtrack *trk2,Int_t iTrk2) const;
+  Bool_t IsPairIn2ProngWindows(Int_t iTrk1,Int_t iTrk2) const;
 
   Bool_t SingleTrkCuts(AliESDtrack *trk,Float_t centralityperc, Bool_t &okDisplaced,Bool_t &okSoftPi, Bool_t &ok3prong, Bool_t &okBachelor) const;
 
@@ -429,7 +485,7 @@ class AliAnalysisVertexingHF : public TNamed {
 				  TObjArray *twoTrackArrayV0);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisVertexingHF,30);  // Reconstruction of HF decay candidates
+  ClassDef(AliAnalysisVertexingHF,34);  // Reconstruction of HF decay candidates
   /// \endcond
 };
 
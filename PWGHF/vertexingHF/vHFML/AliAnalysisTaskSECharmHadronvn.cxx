@@ -496,6 +496,7 @@ void AliAnalysisTaskSECharmHadronvn::UserCreateOutputObjects()
                 {
                     fMLResponse = new AliHFMLResponseDplustoKpipi("DplustoKpipiMLResponse", "DplustoKpipiMLResponse", fConfigPath.Data());
                     fMLResponse->MLResponseInit();
+                    fOutput->Add(fMLResponse->GetStartupTimeHisto());
                 }
             break;
             case kD0toKpi:
@@ -512,12 +513,14 @@ void AliAnalysisTaskSECharmHadronvn::UserCreateOutputObjects()
                 {
                     fMLResponse = new AliHFMLResponseDstoKKpi("DstoKKpiMLResponse", "DstoKKpiMLResponse", fConfigPath.Data());
                     fMLResponse->MLResponseInit();
+                    fOutput->Add(fMLResponse->GetStartupTimeHisto());
                 }
             break;
             case kLctopK0S:
                {
                     fMLResponse = new AliHFMLResponseLctoV0bachelor("LctopK0SMLResponse", "LctopK0SMLResponse", fConfigPath.Data());
                     fMLResponse->MLResponseInit();
+                    fOutput->Add(fMLResponse->GetStartupTimeHisto());
                }
             break;
         }
@@ -763,6 +763,7 @@ void AliAnalysisTaskSEDplus::UserCreateOutputObjects()
   {
     fMLResponse = new AliHFMLResponseDplustoKpipi("DplustoKpipiMLResponse", "DplustoKpipiMLResponse", fConfigPath.Data());
     fMLResponse->MLResponseInit();
+    fOutput->Add(fMLResponse->GetStartupTimeHisto());
   }
 
   PostData(1, fOutput);
@@ -479,6 +479,7 @@ void AliAnalysisTaskSEDs::UserCreateOutputObjects()
   if(fApplyML) {
     fMLResponse = new AliHFMLResponseDstoKKpi("DstoKKpiMLResponse", "DstoKKpiMLResponse", fConfigPath.Data());
     fMLResponse->MLResponseInit();
+    fOutput->Add(fMLResponse->GetStartupTimeHisto());
 
     if(fEnablePIDMLSparses)
       CreatePIDMLSparses();
@@ -397,6 +397,7 @@ void AliAnalysisTaskSEHFTreeCreatorApply::UserCreateOutputObjects()
     if(fConfigPath != ""){
       fMLResponse = new AliHFMLResponseDstoKKpi("DstoKKpiMLResponse", "DstoKKpiMLResponse", fConfigPath.Data());
       fMLResponse->MLResponseInit();
+      fListCounter->Add(fMLResponse->GetStartupTimeHisto());
     }
 
     OpenFile(6);
@@ -423,6 +424,7 @@ void AliAnalysisTaskSEHFTreeCreatorApply::UserCreateOutputObjects()
     if(fConfigPath != ""){
       fMLResponse = new AliHFMLResponseLctoV0bachelor("LctoV0bachelorMLResponse", "LctoV0bachelorMLResponse", fConfigPath.Data());
       fMLResponse->MLResponseInit();
+      fListCounter->Add(fMLResponse->GetStartupTimeHisto());
     }
 
     OpenFile(8);
@@ -0,0 +1,189 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include "AliAnalysisTaskRhoGrid.h"
+
+#include <algorithm>
+
+#include <TH2F.h>
+#include <TList.h>
+#include <TMath.h>
+
+#include "AliLog.h"
+#include "AliRhoParameter.h"
+#include "AliTLorentzVector.h"
+#include "AliClusterContainer.h"
+#include "AliParticleContainer.h"
+
+ClassImp(AliAnalysisTaskRhoGrid)
+
+AliAnalysisTaskRhoGrid::AliAnalysisTaskRhoGrid() :
+  AliAnalysisTaskRhoBase("AliAnalysisTaskRhoGrid"),
+  fGridSpacing(0.55),
+  fNCellsEta(0),
+  fNCellsPhi(0),
+  fGridEtaMin(0),
+  fGridPhiMin(0),
+  fCellSizeEta(0),
+  fCellSizePhi(0),
+  fCellPt(),
+  fHistRhovsCompareRho(0)
+{
+}
+
+AliAnalysisTaskRhoGrid::AliAnalysisTaskRhoGrid(const char *name, Bool_t histo) :
+  AliAnalysisTaskRhoBase(name, histo),
+  fGridSpacing(0.55),
+  fNCellsEta(0),
+  fNCellsPhi(0),
+  fGridEtaMin(0),
+  fGridPhiMin(0),
+  fCellSizeEta(0),
+  fCellSizePhi(0),
+  fCellPt(),
+  fHistRhovsCompareRho(0)
+{
+}
+
+void AliAnalysisTaskRhoGrid::UserCreateOutputObjects()
+{
+  if (!fCreateHisto)
+    return;
+
+  AliAnalysisTaskRhoBase::UserCreateOutputObjects();
+
+  if (!fCompareRhoName.IsNull()) {
+    fHistRhovsCompareRho = new TH2F("fHistRhovsCompareRho", "fHistRhovsCompareRho", fNbins, fMinBinPt, fMaxBinPt*2, fNbins, fMinBinPt, fMaxBinPt*2);
+    fHistRhovsCompareRho->GetXaxis()->SetTitle(Form("#rho %s (GeV/c * rad^{-1})", fCompareRhoName.Data()));
+    fHistRhovsCompareRho->GetYaxis()->SetTitle("#rho grid (GeV/c * rad^{-1})");
+    fOutput->Add(fHistRhovsCompareRho);
+  }
+}
+
+Bool_t AliAnalysisTaskRhoGrid::Run()
+{
+  std::fill(fCellPt.begin(), fCellPt.end(), 0.);
+
+  AliParticleContainer *partCont = 0;
+  TIter nextPartCont(&fParticleCollArray);
+  while ((partCont = static_cast<AliParticleContainer*>(nextPartCont()))) {
+    AliParticleIterableMomentumContainer itcont = partCont->accepted_momentum();
+    for (AliParticleIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+      Int_t ieta = TMath::FloorNint((it->first.Eta() - fGridEtaMin) / fCellSizeEta);
+      Int_t iphi = TMath::FloorNint((it->first.Phi_0_2pi() - fGridPhiMin) / fCellSizePhi);
+      if (ieta < 0 || ieta >= fNCellsEta || iphi < 0 || iphi >= fNCellsPhi) continue;
+      fCellPt[ieta * fNCellsPhi + iphi] += it->first.Pt();
+    }
+  }
+
+  AliClusterContainer *clusCont = 0;
+  TIter nextClusCont(&fClusterCollArray);
+  while ((clusCont = static_cast<AliClusterContainer*>(nextClusCont()))) {
+    AliClusterIterableMomentumContainer itcont = clusCont->accepted_momentum();
+    for (AliClusterIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+      Int_t ieta = TMath::FloorNint((it->first.Eta() - fGridEtaMin) / fCellSizeEta);
+      Int_t iphi = TMath::FloorNint((it->first.Phi_0_2pi() - fGridPhiMin) / fCellSizePhi);
+      if (ieta < 0 || ieta >= fNCellsEta || iphi < 0 || iphi >= fNCellsPhi) continue;
+      fCellPt[ieta * fNCellsPhi + iphi] += it->first.Pt();
+    }
+  }
+
+  Double_t rho = 0;
+
+  const Int_t nCells = fCellPt.size();
+  if (nCells > 0) {
+    // median of the cell pt, as TMath::Median: mean of the two central values for an even number of cells
+    std::vector<Double_t>::iterator mid = fCellPt.begin() + nCells / 2;
+    std::nth_element(fCellPt.begin(), mid, fCellPt.end());
+    rho = *mid;
+    if (nCells % 2 == 0) rho = 0.5 * (rho + *std::max_element(fCellPt.begin(), mid));
+    rho /= fCellSizeEta * fCellSizePhi;
+  }
+
+  fOutRho->SetVal(rho);
+
+  if (fScaleFunction) {
+    Double_t rhoScaled = rho * GetScaleFactor(fCent);
+    fOutRhoScaled->SetVal(rhoScaled);
+  }
+
+  return kTRUE;
+}
+
+Bool_t AliAnalysisTaskRhoGrid::FillHistograms()
+{
+  AliAnalysisTaskRhoBase::FillHistograms();
+
+  if (fCompareRho && fHistRhovsCompareRho) fHistRhovsCompareRho->Fill(fCompareRho->GetVal(), fOutRho->GetVal());
+
+  return kTRUE;
+}
+
+void AliAnalysisTaskRhoGrid::ExecOnce()
+{
+  AliAnalysisTaskRhoBase::ExecOnce();
+
+  fNCellsEta = 0;
+  fNCellsPhi = 0;
+  fCellPt.clear();
+
+  AliParticleContainer *partCont = GetParticleContainer(0);
+  if (!partCont) {
+    AliError(Form("%s: No particle container found! Rho will be 0...",GetName()));
+    return;
+  }
+  if (fGridSpacing < 1e-6) {
+    AliError(Form("%s: Grid spacing = %f < 1e-6! Rho will be 0...", GetName(), fGridSpacing));
+    return;
+  }
+
+  Double_t maxEta = partCont->GetParticleEtaMax();
+  Double_t minEta = partCont->GetParticleEtaMin();
+  Double_t maxPhi = partCont->GetParticlePhiMax();
+  Double_t minPhi = partCont->GetParticlePhiMin();
+
+  if (maxPhi > TMath::Pi() * 2) maxPhi = TMath::Pi() * 2;
+  if (minPhi < 0) minPhi = 0;
+
+  // number of cells rounded to the nearest integer, at least one
+  fNCellsEta = TMath::Max(1, TMath::Nint((maxEta - minEta) / fGridSpacing));
+  fNCellsPhi = TMath::Max(1, TMath::Nint((maxPhi - minPhi) / fGridSpacing));
+  fGridEtaMin = minEta;
+  fGridPhiMin = minPhi;
+  fCellSizeEta = (maxEta - minEta) / fNCellsEta;
+  fCellSizePhi = (maxPhi - minPhi) / fNCellsPhi;
+
+  if (fCellSizeEta * fCellSizePhi < 1e-6) {
+    AliError(Form("%s: Cell area = %f < 1e-6! Rho will be 0...", GetName(), fCellSizeEta * fCellSizePhi));
+    fNCellsEta = 0;
+    fNCellsPhi = 0;
+    return;
+  }
+
+  fCellPt.resize(fNCellsEta * fNCellsPhi);
+
+  AliInfo(Form("%s: %d x %d cells of %.3f x %.3f in eta x phi", GetName(), fNCellsEta, fNCellsPhi, fCellSizeEta, fCellSizePhi));
+}
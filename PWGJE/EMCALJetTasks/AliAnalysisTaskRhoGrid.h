@@ -0,0 +1,106 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIANALYSISTASKRHOGRID_H
+#define ALIANALYSISTASKRHOGRID_H
+
+#include <vector>
+
+#include "AliAnalysisTaskRhoBase.h"
+
+/**
+ * @class AliAnalysisTaskRhoGrid
+ * @brief Calculation of rho, method: median of the pt density of eta-phi grid cells.
+ * @ingroup PWGJEBASE
+ *
+ * The acceptance of the first particle container is divided in cells of about
+ * fGridSpacing x fGridSpacing in eta and phi (as FastJet's GridMedianBackgroundEstimator).
+ * The accepted particles and clusters of all the containers are summed in the cells
+ * in a single pass and rho is the median of the cell pt over the cell area.
+ * No jet finding is needed. When a kt-based rho is given with SetCompareRhoName(),
+ * the two are compared in the QA histograms.
+ */
+class AliAnalysisTaskRhoGrid : public AliAnalysisTaskRhoBase {
+
+ public:
+  /**
+   * @brief Default constructor.
+   */
+  AliAnalysisTaskRhoGrid();
+
+  /**
+   * @brief Constructor.
+   * @param name Name of the rho task
+   * @param histo If true QA/Debug histograms are created
+   */
+  AliAnalysisTaskRhoGrid(const char *name, Bool_t histo=kFALSE);
+
+  /**
+   * @brief Destructor
+   */
+  virtual ~AliAnalysisTaskRhoGrid() {}
+
+  /**
+   * @brief User create output objects, called at the beginning of the analysis.
+   */
+  void             UserCreateOutputObjects();
+
+  void             SetGridSpacing(Double_t s)      { fGridSpacing   = s    ; }
+
+ protected:
+  /**
+   * @brief Init the analysis, define the grid.
+   */
+  void             ExecOnce();
+
+  /**
+   * @brief Run the analysis.
+   * @return Always true
+   */
+  Bool_t           Run();
+
+  /**
+   * @brief Fill histograms.
+   * @return Always true
+   */
+  Bool_t           FillHistograms();
+
+  Double_t         fGridSpacing   ; ///< requested size of the grid cells in eta and phi
+  Int_t            fNCellsEta     ; //!<! number of cells in eta
+  Int_t            fNCellsPhi     ; //!<! number of cells in phi
+  Double_t         fGridEtaMin    ; //!<! lower eta edge of the grid
+  Double_t         fGridPhiMin    ; //!<! lower phi edge of the grid
+  Double_t         fCellSizeEta   ; //!<! cell size in eta
+  Double_t         fCellSizePhi   ; //!<! cell size in phi
+  std::vector<Double_t> fCellPt   ; //!<! summed pt of the cells, then pt density
+  TH2F            *fHistRhovsCompareRho; //!<! rho vs. rho to compare
+
+  AliAnalysisTaskRhoGrid(const AliAnalysisTaskRhoGrid&);             // not implemented
+  AliAnalysisTaskRhoGrid& operator=(const AliAnalysisTaskRhoGrid&);  // not implemented
+
+  ClassDef(AliAnalysisTaskRhoGrid, 1); // Rho task
+};
+#endif
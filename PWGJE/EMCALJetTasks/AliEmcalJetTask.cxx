@@ -53,6 +53,11 @@
 
 #include "AliEmcalJetTask.h"
 
+// FASTJET_HAVE_LIMITED_THREAD_SAFETY comes from fastjet/config.h, included by FJ_includes.h
+#if defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY) && defined(R__USE_IMT)
+#include <ROOT/TThreadExecutor.hxx>
+#endif
+
 using std::cout;
 using std::endl;
 using std::cerr;
@@ -98,10 +103,18 @@ AliEmcalJetTask::AliEmcalJetTask() :
   fEnableAliBasicParticleCompatibility(kFALSE),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fExtraJetAlgos(),
+  fExtraJetRadii(),
+  fNumberOfThreads(1),
   fJets(0),
   fFastJetWrapper("AliEmcalJetTask","AliEmcalJetTask"),
   fClusterContainerIndexMap(),
-  fParticleContainerIndexMap()
+  fParticleContainerIndexMap(),
+  fJetConfigurations(),
+  fSharedGhostSpec(),
+  fSharedGhosts(),
+  fSharedGhostArea(0),
+  fExecutor(0)
 {
 }
 
@@ -140,10 +153,18 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
   fEnableAliBasicParticleCompatibility(kFALSE),
   fLegacyMode(kFALSE),
   fFillGhost(kFALSE),
+  fExtraJetAlgos(),
+  fExtraJetRadii(),
+  fNumberOfThreads(1),
   fJets(0),
   fFastJetWrapper(name,name),
   fClusterContainerIndexMap(),
-  fParticleContainerIndexMap()
+  fParticleContainerIndexMap(),
+  fJetConfigurations(),
+  fSharedGhostSpec(),
+  fSharedGhosts(),
+  fSharedGhostArea(0),
+  fExecutor(0)
 {
 }
 
@@ -152,6 +173,9 @@ AliEmcalJetTask::AliEmcalJetTask(const char *name) :
  */
 AliEmcalJetTask::~AliEmcalJetTask()
 {
+#if defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY) && defined(R__USE_IMT)
+  delete fExecutor;
+#endif
 }
 
 /**
@@ -171,6 +195,37 @@ AliEmcalJetUtility* AliEmcalJetTask::AddUtility(AliEmcalJetUtility* utility)
   return utility;
 }
 
+/**
+ * Add a jet configuration to be clustered in addition to the main jet definition.
+ * All the additional configurations are clustered from the same input vectors
+ * with one shared set of ghosts. The jets are written to a separate branch,
+ * named as the branch of a jet finder task with this algorithm and radius.
+ * The other settings (jet type, recombination scheme, jet cuts) are the ones of the task.
+ * @param algo Jet algorithm
+ * @param radius Jet radius
+ */
+void AliEmcalJetTask::AddJetConfiguration(EJetAlgo_t algo, Double_t radius)
+{
+  if (IsLocked()) return;
+  if (algo == AliJetContainer::plugin_algorithm || algo == AliJetContainer::undefined_jet_algorithm) {
+    AliError(Form("%s: Jet algorithm %d not supported for additional jet configurations.", GetName(), algo));
+    return;
+  }
+  fExtraJetAlgos.push_back(algo);
+  fExtraJetRadii.push_back(radius);
+}
+
+/**
+ * Get the jet collection of an additional jet configuration.
+ * @param i Index of the configuration, in the order they were added
+ * @return Jet collection (null before the first event)
+ */
+TClonesArray* AliEmcalJetTask::GetConfigurationJets(Int_t i)
+{
+  if (i < 0 || i >= (Int_t)fJetConfigurations.size()) return 0;
+  return fJetConfigurations[i].fJets;
+}
+
 /**
  * This method is called once before analyzing the first event. It executes
  * the Init() method of all utilities (if any).
@@ -235,11 +290,15 @@ Bool_t AliEmcalJetTask::Run()
   InitEvent();
   // clear the jet array (normally a null operation)
   fJets->Delete();
+  for (auto &conf : fJetConfigurations) {
+    if (conf.fJets) conf.fJets->Delete();
+  }
   Int_t n = FindJets();
 
   if (n == 0) return kFALSE;
 
   FillJetBranch();
+  for (UInt_t iconf = 0; iconf < fJetConfigurations.size(); iconf++) FillConfigurationJetBranch(iconf);
 
   return kTRUE;
 }
@@ -323,11 +382,68 @@ Int_t AliEmcalJetTask::FindJets()
   if (fFastJetWrapper.GetInputVectors().size() == 0) return 0;
 
   // run jet finder
-  fFastJetWrapper.Run();
+  if (fJetConfigurations.empty()) {
+    fFastJetWrapper.Run();
+  }
+  else {
+    RunJetConfigurations();
+  }
 
   return fFastJetWrapper.GetInclusiveJets().size();
 }
 
+/**
+ * This method runs the jet finding of the main jet definition and of the additional
+ * jet configurations. The ghosts are generated once and shared by all of them: the
+ * FastJet wrapper clustering the main jet definition restarts its ghost generator from
+ * the state used for the shared ghosts, so that it places the same ghosts. With more than
+ * one thread, the clusterings are tasks of a thread pool created at the first event; this
+ * requires FastJet built with thread safety and ROOT with implicit MT, otherwise the
+ * clusterings run serially.
+ */
+void AliEmcalJetTask::RunJetConfigurations()
+{
+  std::vector<int> ghostStatus;
+  fSharedGhostSpec->get_random_status(ghostStatus);
+  fSharedGhosts.clear();
+  fSharedGhostSpec->add_ghosts(fSharedGhosts);
+  fFastJetWrapper.SetGhostRandomStatus(ghostStatus);
+
+  const std::vector<fastjet::PseudoJet>& inputs = fFastJetWrapper.GetInputVectors();
+  // task 0 is the main jet definition, task i the configuration i-1
+  auto clusterJets = [&](UInt_t itask) {
+    if (itask == 0) {
+      fFastJetWrapper.Run();
+      return;
+    }
+    JetConfiguration &conf = fJetConfigurations[itask - 1];
+    conf.fInclusiveJets.clear();
+    conf.fFailed = kFALSE;
+    try {
+      conf.fClustSeq.reset(new fastjet::ClusterSequenceActiveAreaExplicitGhosts(inputs, conf.fJetDef, fSharedGhosts, fSharedGhostArea));
+      conf.fInclusiveJets = conf.fClustSeq->inclusive_jets(0.0);
+    } catch (const fastjet::Error&) {
+      conf.fClustSeq.reset();
+      conf.fFailed = kTRUE;
+    }
+  };
+
+  const UInt_t nTasks = fJetConfigurations.size() + 1;
+#if defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY) && defined(R__USE_IMT)
+  if (fExecutor) {
+    fExecutor->Foreach(clusterJets, ROOT::TSeqU(nTasks));
+  }
+  else
+#endif
+  {
+    for (UInt_t itask = 0; itask < nTasks; itask++) clusterJets(itask);
+  }
+
+  for (auto &conf : fJetConfigurations) {
+    if (conf.fFailed) AliError(Form("%s: FJ Exception caught for jet collection %s.", GetName(), conf.fJetsName.Data()));
+  }
+}
+
 /**
  * This method fills the jet output branch (TClonesArray) with the jet found by the FastJet
  * wrapper. Before filling the jet branch, the utilities are prepared. Then the utilities are
@@ -386,6 +502,58 @@ void AliEmcalJetTask::FillJetBranch()
   TerminateUtilities();
 }
 
+/**
+ * This method fills the jet output branch of an additional jet configuration, with the same
+ * selection and jet properties as FillJetBranch(). Utilities are not applied.
+ * @param iconf Index of the jet configuration
+ */
+void AliEmcalJetTask::FillConfigurationJetBranch(Int_t iconf)
+{
+  JetConfiguration &conf = fJetConfigurations[iconf];
+  if (!conf.fJets || !conf.fClustSeq) return;
+
+  const std::vector<fastjet::PseudoJet> &jets_incl = conf.fInclusiveJets;
+  static Int_t indexes[9999] = {-1};
+  if (!GetSortedArray(indexes, jets_incl)) return;
+
+  AliDebug(1,Form("%d jets found in %s", (Int_t)jets_incl.size(), conf.fJetsName.Data()));
+  for (UInt_t ijet = 0, jetCount = 0; ijet < jets_incl.size(); ++ijet) {
+    Int_t ij = indexes[ijet];
+    Double_t jetArea = conf.fClustSeq->area(jets_incl[ij]);
+
+    if (jets_incl[ij].perp() < fMinJetPt) continue;
+    if (jetArea < fMinJetArea) continue;
+    if ((jets_incl[ij].eta() < fJetEtaMin) || (jets_incl[ij].eta() > fJetEtaMax) ||
+        (jets_incl[ij].phi() < fJetPhiMin) || (jets_incl[ij].phi() > fJetPhiMax))
+      continue;
+
+    AliEmcalJet *jet = new ((*conf.fJets)[jetCount])
+                      AliEmcalJet(jets_incl[ij].perp(), jets_incl[ij].eta(), jets_incl[ij].phi(), jets_incl[ij].m());
+    jet->SetLabel(ij);
+
+    fastjet::PseudoJet area(conf.fClustSeq->area_4vector(jets_incl[ij]));
+    jet->SetArea(area.perp());
+    jet->SetAreaEta(area.eta());
+    jet->SetAreaPhi(area.phi());
+    jet->SetAreaE(area.E());
+    jet->SetJetAcceptanceType(FindJetAcceptanceType(jet->Eta(), jet->Phi_0_2pi(), conf.fRadius));
+
+    std::vector<fastjet::PseudoJet> constituents(conf.fClustSeq->constituents(jets_incl[ij]));
+    FillJetConstituents(jet, constituents, constituents);
+
+    if (fGeom) {
+      if ((jet->Phi() > fGeom->GetArm1PhiMin() * TMath::DegToRad()) &&
+          (jet->Phi() < fGeom->GetArm1PhiMax() * TMath::DegToRad()) &&
+          (jet->Eta() > fGeom->GetArm1EtaMin()) &&
+          (jet->Eta() < fGeom->GetArm1EtaMax()))
+        jet->SetAxisInEmcal(kTRUE);
+    }
+
+    AliDebug(2,Form("Added jet n. %d to %s, pt = %f, area = %f, constituents = %d", jetCount, conf.fJetsName.Data(), jet->Pt(), jet->Area(), jet->GetNumberOfConstituents()));
+    jetCount++;
+  }
+}
+
 /**
  * Sorts jets by pT (decreasing)
  * @param[out] indexes This array is used to return the indexes of the jets ordered by pT
@@ -474,6 +642,8 @@ void AliEmcalJetTask::ExecOnce()
     fFastJetWrapper.SetLegacyMode(kTRUE);
   }
 
+  InitJetConfigurations();
+
   InitUtilities();
 
   AliAnalysisTaskEmcal::ExecOnce();
@@ -484,6 +654,51 @@ void AliEmcalJetTask::ExecOnce()
   fParticleContainerIndexMap.CopyMappingFrom(AliParticleContainer::GetEmcalContainerIndexMap(), fParticleCollArray);
 }
 
+/**
+ * This method is called once before analyzing the first event, from ExecOnce().
+ * It adds the jet branches of the additional jet configurations to the event and
+ * sets up their jet definitions and the generator of the shared ghosts, with the
+ * same ghost parameters as the FastJet wrapper.
+ */
+void AliEmcalJetTask::InitJetConfigurations()
+{
+  fJetConfigurations.clear();
+  if (fExtraJetAlgos.empty()) return;
+
+  fJetConfigurations.resize(fExtraJetAlgos.size());
+  for (UInt_t iconf = 0; iconf < fExtraJetAlgos.size(); iconf++) {
+    JetConfiguration &conf = fJetConfigurations[iconf];
+    conf.fJetAlgo = static_cast<EJetAlgo_t>(fExtraJetAlgos[iconf]);
+    conf.fRadius = fExtraJetRadii[iconf];
+    conf.fJetDef = fastjet::JetDefinition(ConvertToFJAlgo(conf.fJetAlgo), conf.fRadius, ConvertToFJRecoScheme(fRecombScheme), fastjet::Best);
+    conf.fJetsName = AliJetContainer::GenerateJetName(fJetType, conf.fJetAlgo, fRecombScheme, conf.fRadius, GetParticleContainer(0), GetClusterContainer(0), fJetsTag);
+
+    if (!(InputEvent()->FindListObject(conf.fJetsName))) {
+      conf.fJets = new TClonesArray("AliEmcalJet");
+      conf.fJets->SetName(conf.fJetsName);
+      ::Info("AliEmcalJetTask::ExecOnce", "Jet collection with name '%s' has been added to the event.", conf.fJetsName.Data());
+      InputEvent()->AddObject(conf.fJets);
+    }
+    else {
+      AliError(Form("%s: Object with name %s already in event! Skipping this jet configuration", GetName(), conf.fJetsName.Data()));
+    }
+  }
+
+  // same ghosts as fj wrapper: max rap 1, one repeat, default grid and kt scatter
+  fSharedGhostSpec.reset(new fastjet::GhostedAreaSpec(1., 1, fGhostArea, 1., 0.1, 1e-100));
+  fSharedGhostArea = fSharedGhostSpec->actual_ghost_area();
+
+  // print the banner before the first clustering, which can run in a worker thread
+  fastjet::ClusterSequence::print_banner();
+  if (fNumberOfThreads > 1) {
+#if defined(FASTJET_HAVE_LIMITED_THREAD_SAFETY) && defined(R__USE_IMT)
+    if (!fExecutor) fExecutor = new ROOT::TThreadExecutor(fNumberOfThreads);
+#else
+    AliWarning(Form("%s: FastJet without thread safety or ROOT without implicit MT, the jet configurations are clustered in one thread", GetName()));
+#endif
+  }
+}
+
 /**
  * This method is called for each jet. It loops over the jet constituents and
  * adds them to the jet object.
@@ -43,7 +43,11 @@ class AliEmcalJetUtility;
 #include "AliEmcalJet.h"
 #include "AliJetContainer.h"
 #if !(defined(__CINT__) || defined(__MAKECINT__))
+#include <memory>
 #include "AliEmcalContainerIndexMap.h"
+namespace ROOT {
+  class TThreadExecutor;
+}
 #endif
 
 namespace fastjet {
@@ -71,6 +75,13 @@ namespace fastjet {
  * and its derived classes. Utilities can be added via the AddUtility(AliEmcalJetUtility*) method.
  * All the utilities added in the list will be executed. Users can implement new utilities
  * deriving a new class from AliEmcalJetUtility to interface functionalities of the FastJet contribs.
+ *
+ * Additional (algorithm, radius) configurations can be added via AddJetConfiguration().
+ * They are clustered from the same input vectors and the same ghosts as the main jet
+ * definition, the ghosts being generated once per event, and each of them is written to
+ * its own jet branch. With SetNumberOfThreads() the clusterings run concurrently on a
+ * thread pool (FastJet built with thread safety and ROOT with implicit MT only).
+ * Utilities are only applied to the main jet definition.
  */
 class AliEmcalJetTask : public AliAnalysisTaskEmcal {
  public:
@@ -116,6 +127,8 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   void                   SetPhiRange(Double_t pmi, Double_t pma);
 
   AliEmcalJetUtility*    AddUtility(AliEmcalJetUtility* utility);
+  void                   AddJetConfiguration(EJetAlgo_t algo, Double_t radius);
+  void                   SetNumberOfThreads(Int_t n)                { if (IsLocked()) return; fNumberOfThreads  = n     ; }
 
   Double_t               GetGhostArea()                   { return fGhostArea         ; }
   const char*            GetJetsName()                    { return fJetsName.Data()   ; }
@@ -137,6 +150,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   TClonesArray*          GetJets()                        { return fJets              ; }
   TObjArray*             GetUtilities()                   { return fUtilities         ; }
+  Int_t                  GetNumberOfThreads()             { return fNumberOfThreads   ; }
+  Int_t                  GetNJetConfigurations()          { return fExtraJetAlgos.size(); }
+  TClonesArray*          GetConfigurationJets(Int_t i);
 
   void                   FillJetConstituents(AliEmcalJet *jet, std::vector<fastjet::PseudoJet>& constituents,
                                              std::vector<fastjet::PseudoJet>& constituents_sub, Int_t flag = 0, TString particlesSubName = "");
@@ -184,6 +200,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
 
   Int_t                  FindJets();
   void                   FillJetBranch();
+  void                   InitJetConfigurations();
+  void                   RunJetConfigurations();
+  void                   FillConfigurationJetBranch(Int_t iconf);
   void                   ExecOnce();
   void                   InitEvent();
   void                   InitUtilities();
@@ -227,6 +246,9 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   Bool_t                 fEnableAliBasicParticleCompatibility; ///< Flag to allow compatibility with AliBasicParticle constituents
   Bool_t                 fLegacyMode;             //!<!=true to enable FJ 2.x behavior
   Bool_t                 fFillGhost;              ///< =true ghost particles will be filled in AliEmcalJet obj
+  std::vector<Int_t>     fExtraJetAlgos;          ///< algorithms of the additional jet configurations
+  std::vector<Double_t>  fExtraJetRadii;          ///< radii of the additional jet configurations
+  Int_t                  fNumberOfThreads;        ///< number of threads clustering the jet configurations
 
   TClonesArray          *fJets;                   //!<!jet collection
   AliFJWrapper           fFastJetWrapper;         //!<!fastjet wrapper
@@ -237,6 +259,24 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   // Handle mapping between index and containers
   AliEmcalContainerIndexMap <AliClusterContainer, AliVCluster> fClusterContainerIndexMap;    //!<! Mapping between index and cluster containers
   AliEmcalContainerIndexMap <AliParticleContainer, AliVParticle> fParticleContainerIndexMap; //!<! Mapping between index and particle containers
+
+  /// Additional jet configuration, clustered with the shared ghosts
+  struct JetConfiguration {
+    JetConfiguration() : fJetAlgo(AliJetContainer::antikt_algorithm), fRadius(0), fJetsName(), fJets(0), fJetDef(), fClustSeq(), fInclusiveJets(), fFailed(kFALSE) {}
+    EJetAlgo_t                       fJetAlgo;        ///< jet algorithm
+    Double_t                         fRadius;         ///< jet radius
+    TString                          fJetsName;       ///< name of the jet collection
+    TClonesArray                    *fJets;           ///< jet collection
+    fastjet::JetDefinition           fJetDef;         ///< fastjet jet definition
+    std::unique_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> fClustSeq; ///< cluster sequence of the current event
+    std::vector<fastjet::PseudoJet>  fInclusiveJets;  ///< inclusive jets of the current event
+    Bool_t                           fFailed;         ///< fastjet exception caught in the current event
+  };
+  std::vector<JetConfiguration>    fJetConfigurations;   //!<! additional jet configurations
+  std::unique_ptr<fastjet::GhostedAreaSpec> fSharedGhostSpec; //!<! generator of the shared ghosts
+  std::vector<fastjet::PseudoJet>  fSharedGhosts;        //!<! ghosts shared by the additional jet configurations
+  Double_t                         fSharedGhostArea;     //!<! actual area of the shared ghosts
+  ROOT::TThreadExecutor           *fExecutor;            //!<! thread pool clustering the jet definitions, created once
 #endif
 
  private:
@@ -244,7 +284,7 @@ class AliEmcalJetTask : public AliAnalysisTaskEmcal {
   AliEmcalJetTask &operator=(const AliEmcalJetTask&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalJetTask, 30);
+  ClassDef(AliEmcalJetTask, 31);
   /// \endcond
 };
 #endif
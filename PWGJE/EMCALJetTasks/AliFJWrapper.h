@@ -143,6 +143,8 @@ class AliFJWrapper
   void SetEventSub(Bool_t b) {fEventSub = b;}
   void SetMaxDelR(Double_t r)  {fMaxDelR = r;}
   void SetAlpha(Double_t a)  {fAlpha = a;}
+  // state of the ghost random generator for the next Run(), to reproduce ghosts generated elsewhere with the same parameters
+  void SetGhostRandomStatus(const std::vector<int> &status) {fGhostRandomStatus = status;}
 
 
  protected:
@@ -236,6 +238,7 @@ class AliFJWrapper
   std::vector<double>                      fGRDenominator;    //!
   std::vector<double>                      fGRNumeratorSub;   //!
   std::vector<double>                      fGRDenominatorSub; //!
+  std::vector<int>                         fGhostRandomStatus; //!
 
   virtual void   SubtractBackground(const Double_t median_pt = -1);
 
@@ -340,6 +343,7 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fGRDenominator()
   , fGRNumeratorSub()
   , fGRDenominatorSub()
+  , fGhostRandomStatus()
 {
   // Constructor.
 }
@@ -411,6 +415,7 @@ void AliFJWrapper::Clear(const Option_t */*opt*/)
   fInputVectors.clear();
   fEventSubInputVectors.clear();
   fInputGhosts.clear();
+  fGhostRandomStatus.clear();
   fMedUsedForBgSub = 0;
 
   // for the moment brute force delete everything
@@ -709,6 +714,7 @@ Int_t AliFJWrapper::Run()
                                                fGridScatter,
                                                fKtScatter,
                                                fMeanGhostKt);
+    if (!fGhostRandomStatus.empty()) fGhostedAreaSpec->set_random_status(fGhostRandomStatus);
 
     fAreaDef = new fj::AreaDefinition(*fGhostedAreaSpec, fAreaType);
   }
@@ -50,6 +50,8 @@
 #include "TFile.h"
 #include "TMatrixD.h"
 #include "TRandom3.h"
+#include "TROOT.h"
+#include "TStopwatch.h"
 
 #include "AliHeader.h"  
 #include "AliGenEventHeader.h"  
@@ -113,6 +115,8 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fTrigger(AliTriggerAnalysis::kMB1) 
   , fAnalysisMode(kTPCAnalysisMode) 
   , fTreeSRedirector(0)
+  , fNumberOfWriterThreads(0)
+  , fStreamBufferSize(0)
   , fCentralityEstimator(0)
   , fLowPtTrackDownscaligF(0)
   , fLowPtV0DownscaligF(0)
@@ -155,6 +159,12 @@ ClassImp(AliAnalysisTaskFilteredTree)
   DefineOutput(6, TTree::Class());
   DefineOutput(7, TList::Class());
   DefineOutput(7, TList::Class());
+  for (Int_t iStream=0; iStream<kNStreams; iStream++) {
+    fStreamTime[iStream]=0;
+    fStreamWriteTime[iStream]=0;
+    fStreamClusterSize[iStream]=0;
+    fStreamFlushedEntries[iStream]=0;
+  }
   fChargedEffectiveMass=TDatabasePDG::Instance()->GetParticle(kProton)->Mass();  // use proton
   fV0EffectiveMass=TDatabasePDG::Instance()->GetParticle(kLambda0)->Mass();       // use Lambda mass
 }
@@ -206,6 +216,23 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   // Called once
 
   //
+  // Compression of the stream baskets in the ROOT implicit MT pool - the pool is process wide, it has to be
+  // enabled by the macro (ROOT::EnableImplicitMT).
+  // The streams are still filled in UserExec, the baskets of a flushed cluster are compressed and written in parallel,
+  // the content of the trees is the same as without threads (only the order of the baskets in the file changes)
+  if (fNumberOfWriterThreads > 0) {
+#ifdef R__USE_IMT
+    if (ROOT::IsImplicitMTEnabled()) {
+      AliInfo(Form("Compressing output baskets with %u threads", ROOT::GetImplicitMTPoolSize()));
+    } else {
+      AliWarning("Implicit multithreading is not enabled (ROOT::EnableImplicitMT), writing output on the main thread");
+      fNumberOfWriterThreads = 0;
+    }
+#else
+    AliWarning("ROOT was built without implicit multithreading, writing output on the main thread");
+    fNumberOfWriterThreads = 0;
+#endif
+  }
   //get the output file to make sure the trees will be associated to it
   OpenFile(1);
   fTreeSRedirector = new TTreeSRedirector();
@@ -218,6 +245,7 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
   fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
   fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  for (Int_t iStream=0; iStream<kNStreams; iStream++) ConfigureStreamTree(GetStreamTree(iStream));
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -393,22 +421,38 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
   //
   //
   //
+  // time spent per stream - RealTime() stops the watch
+  TStopwatch streamTimer;
   if(fProcessAll) { 
     ProcessAll(fESD,fMC,fESDfriend); // all track stages and MC
   }
   else {
     Process(fESD,fMC,fESDfriend);    // only global and TPC tracks
   }
+  fStreamTime[kStreamHighPt]+=streamTimer.RealTime();
   //
+  streamTimer.Start(kTRUE);
   ProcessV0(fESD,fMC,fESDfriend);
+  fStreamTime[kStreamV0s]+=streamTimer.RealTime();
+  streamTimer.Start(kTRUE);
   ProcessLaser(fESD,fMC,fESDfriend);
+  fStreamTime[kStreamLaser]+=streamTimer.RealTime();
+  streamTimer.Start(kTRUE);
   ProcessdEdx(fESD,fMC,fESDfriend);
-  if (fProcessCosmics) { ProcessCosmics(fESD,fESDfriend); }
+  fStreamTime[kStreamdEdx]+=streamTimer.RealTime();
+  if (fProcessCosmics) {
+    streamTimer.Start(kTRUE);
+    ProcessCosmics(fESD,fESDfriend);
+    fStreamTime[kStreamCosmicPairs]+=streamTimer.RealTime();
+  }
   if(fMC) {
+    streamTimer.Start(kTRUE);
     ProcessMCEff(fESD,fMC,fESDfriend);
+    fStreamTime[kStreamMCEff]+=streamTimer.RealTime();
     //ProcessMC();  //TODO - enable MC detailed view switch after holidays
   }
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  FlushStreams(kFALSE);
   printf("processed event %d\n", Int_t(Entry()));
 }
 
@@ -2772,10 +2816,96 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
         AliAnalysisManager::kProofAnalysis)
       deleteTrees=kFALSE;
   }
+  // flush the baskets still in memory before the trees are written
+  FlushStreams(kTRUE);
+  PrintStreamStatistics();
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
 }
 
+//_____________________________________________________________________________
+TTree * AliAnalysisTaskFilteredTree::GetStreamTree(Int_t stream) const
+{
+  switch (stream) {
+    case kStreamHighPt:      return fHighPtTree;
+    case kStreamV0s:         return fV0Tree;
+    case kStreamdEdx:        return fdEdxTree;
+    case kStreamLaser:       return fLaserTree;
+    case kStreamMCEff:       return fMCEffTree;
+    case kStreamCosmicPairs: return fCosmicPairsTree;
+    default:                 return NULL;
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::ConfigureStreamTree(TTree *tree)
+{
+  //
+  // Set the basket compression and memory limits of the output stream
+  //
+  if (!tree) return;
+#ifdef R__USE_IMT
+  // With implicit MT the baskets of all branches are compressed and written in parallel when a cluster is flushed.
+  // Without writer threads the tree keeps its default, which follows ROOT::EnableImplicitMT
+  if (fNumberOfWriterThreads > 0)
+    tree->SetImplicitMT(kTRUE);
+#endif
+  // with a buffer size the clusters are flushed by FlushStreams instead of TTree::Fill, so that the time spent
+  // in the compression and write can be measured per stream
+  if (fStreamBufferSize > 0) tree->SetAutoFlush(0);
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::FlushStreams(Bool_t force)
+{
+  //
+  // Flush the clusters of the output streams and measure the time of the flush (compression and write)
+  // Same policy as TTree::Fill with a negative auto flush value: the first cluster is flushed when the written
+  // baskets exceed fStreamBufferSize bytes, the basket sizes are then optimised and the following clusters
+  // have the same number of entries. The small baskets written by Fill before the first flush are not timed.
+  //
+  if (fStreamBufferSize<=0 && !force) return;
+  TStopwatch flushTimer;
+  for (Int_t iStream=0; iStream<kNStreams; iStream++) {
+    TTree *tree=GetStreamTree(iStream);
+    if (!tree) continue;
+    Long64_t pending=tree->GetEntries()-fStreamFlushedEntries[iStream];
+    if (pending<=0) continue;
+    Bool_t firstCluster=(fStreamClusterSize[iStream]==0);
+    if (!force) {
+      if (firstCluster && tree->GetZipBytes()<fStreamBufferSize) continue;
+      if (!firstCluster && pending<fStreamClusterSize[iStream]) continue;
+    }
+    flushTimer.Start(kTRUE);
+    if (firstCluster && !force) {
+      tree->OptimizeBaskets(tree->GetTotBytes(),1,"");
+      fStreamClusterSize[iStream]=pending;
+    }
+    tree->FlushBaskets();
+    fStreamWriteTime[iStream]+=flushTimer.RealTime();
+    fStreamFlushedEntries[iStream]=tree->GetEntries();
+  }
+}
+
+//_____________________________________________________________________________
+void AliAnalysisTaskFilteredTree::PrintStreamStatistics() const
+{
+  //
+  // Per stream counters: entries, uncompressed and compressed size, time spent in the producer,
+  // time spent in the flushes and write throughput
+  //
+  for (Int_t iStream=0; iStream<kNStreams; iStream++) {
+    TTree *tree=GetStreamTree(iStream);
+    if (!tree) continue;
+    Double_t totMB=tree->GetTotBytes()/1.e6;
+    Double_t zipMB=tree->GetZipBytes()/1.e6;
+    Double_t time=fStreamTime[iStream];
+    Double_t writeTime=fStreamWriteTime[iStream];
+    AliInfo(Form("Stream %-12s: %lld entries, %.1f MB (%.1f MB compressed), producer %.1f s, flush %.1f s, %.2f MB/s",
+                 tree->GetName(), tree->GetEntries(), totMB, zipMB, time, writeTime, (writeTime>0) ? totMB/writeTime : 0.));
+  }
+}
+
 //_____________________________________________________________________________
 void AliAnalysisTaskFilteredTree::Terminate(Option_t *) 
 {
@@ -3116,56 +3246,13 @@ Int_t   AliAnalysisTaskFilteredTree::GetNearestTrack(const AliExternalTrackParam
   //   paramType = 0 - global track
   //               1 - track at inner wall of TPC
   //
-  //          
-  if (trackMatch==NULL){
-    ::Error("AliAnalysisTaskFilteredTree::GetNearestTrack","invalid track pointer");
+  // Search done by AliESDtools::GetNearestTrack using the per event track index
+  //
+  if (fESDtool==NULL){
+    ::Error("AliAnalysisTaskFilteredTree::GetNearestTrack","AliESDtools not initialized");
     return -1;
   }
-  Int_t ntracks=event->GetNumberOfTracks();
-  const Double_t ktglCut=0.1;
-  const Double_t kqptCut=0.4;
-  const Double_t kAlphaCut=0.2;
-  //
-  Double_t chi2Min=100000;
-  Int_t indexMin=-1;
-  for (Int_t itrack=0; itrack<ntracks; itrack++){
-    if (itrack==indexSkip) continue;
-    AliESDtrack *ptrack=event->GetTrack(itrack);
-    if (ptrack==NULL) continue;
-    if (trackType==0 && (ptrack->IsOn(0x1)==kFALSE || ptrack->IsOn(0x10)==kTRUE))  continue;     // looks for track without TPC information
-    if (trackType==1 && (ptrack->IsOn(0x10)==kFALSE))   continue;                                // looks for tracks with   TPC information
-    if (trackType==2 && (ptrack->IsOn(0x1)==kFALSE || ptrack->IsOn(0x10)==kFALSE)) continue;      // looks for tracks with   TPC+ITS information
-    
-    if (ptrack->GetKinkIndex(0)<0) continue;              // skip kink daughters
-    const AliExternalTrackParam * track=0;                // 
-    if (paramType==0) track=ptrack;                       // Global track         
-    if (paramType==1) track=ptrack->GetInnerParam();      // TPC only track at inner wall of TPC
-    if (track==NULL) {
-      continue;
-    }
-    // first rough cuts
-    // fP3 cut
-    if (TMath::Abs((track->GetTgl()-trackMatch->GetTgl()))>ktglCut) continue; 
-    // fP4 cut 
-    if (TMath::Abs((track->GetSigned1Pt()-trackMatch->GetSigned1Pt()))>kqptCut) continue; 
-    // fAlpha cut
-    //Double_t alphaDist=TMath::Abs((track->GetAlpha()-trackMatch->GetAlpha()));
-    Double_t alphaDist=TMath::Abs(TMath::ATan2(track->Py(),track->Px())-TMath::ATan2(trackMatch->Py(),trackMatch->Py()));
-    if (alphaDist>TMath::Pi()) alphaDist-=TMath::TwoPi();
-    if (alphaDist>kAlphaCut) continue;
-    // calculate and extract track with smallest chi2 distance
-    AliExternalTrackParam param(*track);
-    if (param.Rotate(trackMatch->GetAlpha())==kFALSE) continue;
-    if (param.PropagateTo(trackMatch->GetX(),trackMatch->GetBz())==kFALSE) continue;
-    Double_t chi2=trackMatch->GetPredictedChi2(&param);
-    if (chi2<chi2Min){
-      indexMin=itrack;
-      chi2Min=chi2;
-      paramNearest=param;
-    }
-  }
-  return indexMin;
-
+  return fESDtool->GetNearestTrack(trackMatch, indexSkip, event, trackType, paramType, paramNearest);
 }
 
 
@@ -126,6 +126,13 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   
   void SetProcessAll(Bool_t proc) { fProcessAll = proc; }
+  /// output streams - baskets compressed by the ROOT implicit MT pool (enabled by the macro), memory of the not flushed baskets bounded per stream
+  enum EStream { kStreamHighPt=0, kStreamV0s, kStreamdEdx, kStreamLaser, kStreamMCEff, kStreamCosmicPairs, kNStreams };
+  void SetNumberOfWriterThreads(Int_t nThreads) { fNumberOfWriterThreads = nThreads; }
+  void SetStreamBufferSize(Long64_t nBytes) { fStreamBufferSize = nBytes; }
+  Double_t GetStreamTime(Int_t stream) const { return (stream>=0 && stream<kNStreams) ? fStreamTime[stream]:0; }
+  Double_t GetStreamWriteTime(Int_t stream) const { return (stream>=0 && stream<kNStreams) ? fStreamWriteTime[stream]:0; }
+  void PrintStreamStatistics() const;
   static Int_t GetMCTrueTrackMult(AliMCEvent *const mcEvent, AliFilteredTreeEventCuts *const evtCuts, AliFilteredTreeAcceptanceCuts *const accCuts);
 
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
@@ -163,6 +170,12 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   EAnalysisMode fAnalysisMode;   // analysis mode TPC only, TPC + ITS
 
   TTreeSRedirector* fTreeSRedirector;      //! temp tree to dump output
+  Int_t    fNumberOfWriterThreads;         // >0 compress the stream baskets in the ROOT implicit MT pool (0 = main thread only)
+  Long64_t fStreamBufferSize;              // maximal size of the not flushed baskets per stream in bytes (0 = ROOT default auto flush)
+  Double_t fStreamTime[kNStreams];         //! real time spent in the producer of each stream (filling included)
+  Double_t fStreamWriteTime[kNStreams];    //! real time spent in the flushes (compression and write) of each stream
+  Long64_t fStreamClusterSize[kNStreams];  //! entries per cluster of each stream, fixed at the first flush
+  Long64_t fStreamFlushedEntries[kNStreams]; //! entries of each stream already flushed
 
   TString fCentralityEstimator;     // use centrality can be "VOM" (default), "FMD", "TRK", "TKL", "CL0", "CL1", "V0MvsFMD", "TKLvsV0M", "ZEMvsZDC"
 
@@ -201,9 +214,13 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
 
+  void ConfigureStreamTree(TTree *tree);
+  void FlushStreams(Bool_t force);
+  TTree *GetStreamTree(Int_t stream) const;
+
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 3); // example of analysis
 };
 
 #endif
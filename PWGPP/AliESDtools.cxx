@@ -65,6 +65,7 @@
 #include "TF3.h"
 #include "TStatToolkit.h"
 #include <stdarg.h>
+#include <algorithm>
 #include "AliNDLocalRegression.h"
 #include "AliESDEvent.h"
 #include "AliLumiTools.h"
@@ -118,9 +119,14 @@ AliESDtools::AliESDtools():
   fCacheTrackChi2(nullptr),             // chi2 counter
   fCacheTrackMatchEff(nullptr),         // matchEff counter
   fLumiGraph(nullptr),                  // graph for the interaction rate info for a run
-  fStreamer(nullptr)
+  fStreamer(nullptr),
+  fUseTrackIndex(kTRUE),                // use the per event track index in the matching helpers
+  fCheckTrackIndex(kFALSE),             // cross-check of the track index with the brute force loop
+  fNTrackIndexMismatches(0),            // number of mismatches found by the cross-check
+  fTrackIndexCandidates()
 {
   fgInstance=this;
+  ResetTrackIndex();
   fTriggerAnalysis=new AliTriggerAnalysis;
 
 }
@@ -143,6 +149,7 @@ void AliESDtools::Init(TTree *tree, AliESDEvent *event) {
     tools.fEvent =event;
     fTaskMode=kTRUE;
   }
+  ResetTrackIndex();
   if (fHisTPCVertexA == nullptr) {
     tools.fHisITSVertex = new TH1F("hisITSZ", "hisITS", 300, -15, 15);
     tools.fHisTPCVertexA = new TH1F("hisTPCZA", "hisTPCZA", 1000, -250, 250);
@@ -252,6 +259,68 @@ void AliESDtools::TPCVertexFit(TH1F *hisVertex){
 
 
 
+/// Forget the track index of the previous event - called when a new event is loaded
+void AliESDtools::ResetTrackIndex(){
+  for (Int_t iType=0; iType<2; iType++){
+    fTrackIndex[iType].clear();
+    fTrackIndexEvent[iType]=nullptr;
+    fTrackIndexEventID[iType]=0;
+    fTrackIndexEventNumber[iType]=-1;
+    fTrackIndexNTracks[iType]=-1;
+  }
+}
+
+/// Track parameters used for matching
+/// \param track       - ESD track
+/// \param paramType   - 0 - global track, 1 - track at inner wall of TPC
+/// \return            - track parameter or nullptr if not available
+const AliExternalTrackParam * AliESDtools::GetMatchingParam(AliESDtrack *track, Int_t paramType){
+  if (paramType==0) return track;                       // Global track
+  if (paramType==1) return track->GetInnerParam();      // TPC only track at inner wall of TPC
+  return nullptr;
+}
+
+/// Select candidate tracks for the matching using the per event track index
+/// The index (tgl, track index) sorted in tgl is built lazily at the first query of the event and shared
+/// by all matching helpers. The tgl does not change with the propagation in the magnetic field.
+/// The event is identified by period/orbit/bunch crossing and event number in file, not by the AliESDEvent
+/// pointer which is reused by the input handler for all events.
+/// \param event       - ESD event
+/// \param paramType   - 0 - global track, 1 - track at inner wall of TPC
+/// \param tgl         - tgl of the track to match
+/// \param dTgl        - maximal tgl difference
+/// \param candidates  - output: indices of the tracks with |tgl-tglTrack|<=dTgl, in increasing order
+/// \return            - number of candidates
+Int_t AliESDtools::GetTrackIndexCandidates(AliESDEvent *event, Int_t paramType, Double_t tgl, Double_t dTgl, std::vector<Int_t> &candidates){
+  candidates.clear();
+  if (event== nullptr || paramType<0 || paramType>1) return 0;
+  const Double_t kTglMargin=1e-6;     // margin for the rounding of tgl-dTgl - final cut to be applied by the caller
+  Int_t nTracks=event->GetNumberOfTracks();
+  ULong64_t eventID=(ULong64_t(event->GetPeriodNumber())<<36)|(ULong64_t(event->GetOrbitNumber())<<12)|ULong64_t(event->GetBunchCrossNumber());
+  Int_t eventNumber=event->GetEventNumberInFile();
+  std::vector<std::pair<Double_t,Int_t> > &index=fTrackIndex[paramType];
+  if (fTrackIndexEvent[paramType]!=event || fTrackIndexEventID[paramType]!=eventID || fTrackIndexEventNumber[paramType]!=eventNumber || fTrackIndexNTracks[paramType]!=nTracks){
+    index.clear();
+    index.reserve(nTracks);
+    for (Int_t iTrack=0; iTrack<nTracks; iTrack++){
+      AliESDtrack *pTrack=event->GetTrack(iTrack);
+      if (pTrack== nullptr) continue;
+      const AliExternalTrackParam * track=GetMatchingParam(pTrack,paramType);
+      if (track== nullptr) continue;
+      index.push_back(std::make_pair(track->GetTgl(),iTrack));
+    }
+    std::sort(index.begin(),index.end());
+    fTrackIndexEvent[paramType]=event;
+    fTrackIndexEventID[paramType]=eventID;
+    fTrackIndexEventNumber[paramType]=eventNumber;
+    fTrackIndexNTracks[paramType]=nTracks;
+  }
+  std::vector<std::pair<Double_t,Int_t> >::const_iterator it=std::lower_bound(index.begin(),index.end(),std::make_pair(tgl-dTgl-kTglMargin,-1));
+  for (; it!=index.end() && it->first<=tgl+dTgl+kTglMargin; ++it) candidates.push_back(it->second);
+  std::sort(candidates.begin(),candidates.end());
+  return candidates.size();
+}
+
 ///
 /// \param trackMatch    -  input track parameter
 /// \param indexSkip     - index to skip  index of track itself
@@ -262,35 +331,61 @@ void AliESDtools::TPCVertexFit(TH1F *hisVertex){
 /// \param paramType
 /// \param paramNearest    - parameter for closest track according trackType
 /// \return               - index of the closets track (chi2 distance)
+/// Only tracks selected by the per event track index are tested (see SetUseTrackIndex).
+/// With SetCheckTrackIndex the result is compared with the loop over all tracks.
 Int_t   AliESDtools::GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest){
-  //
-  // Find track with closest chi2 distance  (assume all track ae propagated to the DCA)
+  if (trackMatch== nullptr){
+    ::Error("AliESDtools::GetNearestTrack","invalid track pointer");
+    return -1;
+  }
+  if (!fUseTrackIndex) return FindNearestTrack(trackMatch, indexSkip, event, trackType, paramType, paramNearest, nullptr);
+  const Double_t kTglCut=0.1;
+  GetTrackIndexCandidates(event, paramType, trackMatch->GetTgl(), kTglCut, fTrackIndexCandidates);
+  Int_t indexMin=FindNearestTrack(trackMatch, indexSkip, event, trackType, paramType, paramNearest, &fTrackIndexCandidates);
+  if (fCheckTrackIndex){
+    AliExternalTrackParam paramCheck;
+    Int_t indexCheck=FindNearestTrack(trackMatch, indexSkip, event, trackType, paramType, paramCheck, nullptr);
+    if (indexCheck!=indexMin){
+      fNTrackIndexMismatches++;
+      ::Error("AliESDtools::GetNearestTrack","track index mismatch: track %d type %d param %d - indexed %d, all tracks %d",indexSkip,trackType,paramType,indexMin,indexCheck);
+    }
+  }
+  return indexMin;
+}
 
-  //   paramType = 0 - global track
-  //               1 - track at inner wall of TPC
+/// Same as GetNearestTrack, looping over all tracks of the event
+Int_t   AliESDtools::GetNearestTrackBruteForce(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest){
   if (trackMatch== nullptr){
-    ::Error("AliAnalysisTaskFilteredTree::GetNearestTrack","invalid track pointer");
+    ::Error("AliESDtools::GetNearestTrackBruteForce","invalid track pointer");
     return -1;
   }
-  Int_t nTracks=event->GetNumberOfTracks();
+  return FindNearestTrack(trackMatch, indexSkip, event, trackType, paramType, paramNearest, nullptr);
+}
+
+/// Find track with closest chi2 distance  (assume all track ae propagated to the DCA)
+/// \param candidates    - indices of the tracks to test in increasing order, nullptr - all tracks
+Int_t   AliESDtools::FindNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest, const std::vector<Int_t> *candidates){
+  //
+  //   paramType = 0 - global track
+  //               1 - track at inner wall of TPC
+  Int_t nTracks=(candidates!= nullptr) ? candidates->size() : event->GetNumberOfTracks();
   const Double_t kTglCut=0.1;
   const Double_t kQPtCut=0.4;
   const Double_t kAlphaCut=0.2;
   //
   Double_t chi2Min=100000;
   Int_t indexMin=-1;
-  for (Int_t iTrack=0; iTrack<nTracks; iTrack++){
+  for (Int_t iCandidate=0; iCandidate<nTracks; iCandidate++){
+    Int_t iTrack=(candidates!= nullptr) ? (*candidates)[iCandidate] : iCandidate;
     if (iTrack==indexSkip) continue;
     AliESDtrack *pTrack=event->GetTrack(iTrack);
     if (pTrack== nullptr) continue;
     if (trackType==0 && (pTrack->IsOn(0x1) == 0 || pTrack->IsOn(0x10) != 0))  continue;     // looks for track without TPC information
     if (trackType==1 && (pTrack->IsOn(0x10)==0))   continue;                                // looks for tracks with   TPC information
-    if (trackType==2 && (pTrack->IsOn(0x1)==0 || pTrack->IsOn(0x10)!=0)) continue;      // looks for tracks with   TPC+ITS information
+    if (trackType==2 && (pTrack->IsOn(0x1)==0 || pTrack->IsOn(0x10)==0)) continue;      // looks for tracks with   TPC+ITS information
 
     if (pTrack->GetKinkIndex(0)<0) continue;              // skip kink daughters
-    const AliExternalTrackParam * track= nullptr;                //
-    if (paramType==0) track=pTrack;                       // Global track
-    if (paramType==1) track=pTrack->GetInnerParam();      // TPC only track at inner wall of TPC
+    const AliExternalTrackParam * track=GetMatchingParam(pTrack,paramType);
     if (track== nullptr) {
       continue;
     }
@@ -405,6 +500,7 @@ void AliESDtools::ProcessITSTPCmatchOut(AliESDEvent *const esdEvent, AliESDfrien
   AliESDtrack           esdTrackDummy;
   AliExternalTrackParam itsAtTPC;
   AliExternalTrackParam itsAtITSTPC;
+  std::vector<Int_t> candidates;
   for (Int_t iTrack0=0; iTrack0<nTracks; iTrack0++){
     AliESDtrack *track0 = esdEvent->GetTrack(iTrack0);
     if(!track0) continue;
@@ -427,7 +523,11 @@ void AliESDtools::ProcessITSTPCmatchOut(AliESDEvent *const esdEvent, AliESDfrien
     Int_t nCandidates1=0; // n candidates - rough + chi2 cut
     itsAtTPC=*(friendTrack0->GetITSOut());
     itsAtITSTPC=*(friendTrack0->GetITSOut());
-    for (Int_t iTrack1=0; iTrack1<nTracks; iTrack1++){
+    // candidates from the per event track index (TPC inner wall parameters) - tgl window of the fast theta cut
+    Int_t nTracks1=nTracks;
+    if (fUseTrackIndex) nTracks1=GetTrackIndexCandidates(esdEvent, 1, vecMomR0(iTrack0,5), dFastThetaCut, candidates);
+    for (Int_t iCandidate=0; iCandidate<nTracks1; iCandidate++){
+      Int_t iTrack1=(fUseTrackIndex) ? candidates[iCandidate] : iCandidate;
       AliESDtrack *track1 = esdEvent->GetTrack(iTrack1);
       if(!track1) continue;
       if (!track1->IsOn(AliVTrack::kTPCin)) continue;
@@ -776,6 +876,7 @@ Double_t AliESDtools::LoadESD(Int_t entry, Int_t verbose) {
   if (lastEntry==entry) return 1;
   lastEntry = entry;
   fgInstance->fEvent->Reset();
+  fgInstance->ResetTrackIndex();
   fgInstance->fESDtree->GetEntry(entry);
   if (verbose & 0x1) {
     Int_t nTracks = fgInstance->fEvent->GetNumberOfTracks();
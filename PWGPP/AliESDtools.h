@@ -12,8 +12,11 @@ class AliESDEvent;
 class AliESDfriend;
 class AliTriggerAnalysis;
 class AliMCEvent;
+class AliESDtrack;
 //class TVectorF;
 #include "TNamed.h"
+#include <vector>
+#include <utility>
 
 class AliESDtools : public TNamed {
   public:
@@ -32,6 +35,13 @@ class AliESDtools : public TNamed {
   Int_t  FillMCCounters();
   void TPCVertexFit(TH1F *hisVertex);
   Int_t  GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest);
+  Int_t  GetNearestTrackBruteForce(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest);
+  /// per event track index used by the matching helpers
+  void   SetUseTrackIndex(Bool_t useIndex){fUseTrackIndex=useIndex;}
+  void   SetCheckTrackIndex(Bool_t checkIndex){fCheckTrackIndex=checkIndex;}
+  void   ResetTrackIndex();
+  Int_t  GetTrackIndexCandidates(AliESDEvent *event, Int_t paramType, Double_t tgl, Double_t dTgl, std::vector<Int_t> &candidates);
+  Long64_t GetNTrackIndexMismatches() const {return fNTrackIndexMismatches;}
   void   ProcessITSTPCmatchOut(AliESDEvent *const esdEvent, AliESDfriend *const esdFriend, TTreeStream *pcstream);
   Double_t CachePileupVertexTPC(Int_t entry, Int_t doReset=0, Int_t verbose=0);
   //
@@ -94,10 +104,22 @@ class AliESDtools : public TNamed {
   //
   TTreeSRedirector * fStreamer;                  /// streamer
   static AliESDtools* fgInstance;                /// instance of the tool -needed in order to use static functions (for TTreeFormula)
+  //
+  Bool_t             fUseTrackIndex;             // switch - use the per event track index in the matching helpers
+  Bool_t             fCheckTrackIndex;           // switch - cross-check the indexed matching with the brute force loop
+  Long64_t           fNTrackIndexMismatches;     //! number of indexed matches different from the brute force result
   private:
+  static const AliExternalTrackParam * GetMatchingParam(AliESDtrack *track, Int_t paramType);
+  Int_t  FindNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType, AliExternalTrackParam & paramNearest, const std::vector<Int_t> *candidates);
+  std::vector<std::pair<Double_t,Int_t> > fTrackIndex[2];  //! (tgl, track index) sorted in tgl - for paramType 0 (global) and 1 (TPC inner wall)
+  const AliESDEvent *fTrackIndexEvent[2];        //! event the track index was built for
+  ULong64_t          fTrackIndexEventID[2];      //! period/orbit/bunch crossing of the event the track index was built for
+  Int_t              fTrackIndexEventNumber[2];  //! event number in file of the event the track index was built for
+  Int_t              fTrackIndexNTracks[2];      //! number of tracks of the event the track index was built for
+  std::vector<Int_t> fTrackIndexCandidates;      //! candidate buffer of GetNearestTrack
   AliESDtools(AliESDtools&);
   AliESDtools &operator=(const AliESDtools&);
-  ClassDef(AliESDtools, 1) 
+  ClassDef(AliESDtools, 2) 
 };
 
 #endif
@@ -0,0 +1,466 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/* AliAO2DArrowWriter
+ *
+ * Minimal writer of the Apache Arrow IPC file format (version V5), without dependency on the Arrow libraries.
+ * File layout: "ARROW1", schema message, record batches, dictionary batches, end-of-stream marker, footer.
+ * The flatbuffer metadata (Schema.fbs, Message.fbs, File.fbs of the Arrow format) is serialised by the small
+ * builder below. Fixed width columns map to Int / FloatingPoint, array branches to FixedSizeList.
+ */
+
+#include "AliAO2DArrowWriter.h"
+
+#include <TError.h>
+
+#include <cstring>
+
+namespace
+{
+
+const Int_t kAlignment = 64; // Alignment of the buffers in the file (recommended by the Arrow format)
+const Short_t kMetadataV5 = 4;
+const UChar_t kHeaderSchema = 1, kHeaderDictionaryBatch = 2, kHeaderRecordBatch = 3;
+const UChar_t kTypeInt = 2, kTypeFloatingPoint = 3, kTypeFixedSizeList = 16;
+
+Long64_t Padding(Long64_t size, Long64_t alignment) { return (alignment - size % alignment) % alignment; }
+
+} // namespace
+
+// Flatbuffer builder. As in the flatbuffers library the buffer is built from the end, children before parents,
+// and offsets are counted from the end of the buffer. The bytes are stored reversed and turned around in Finish()
+struct AliAO2DArrowWriter::FlatBuilder {
+  std::vector<char> fBuf;
+  Int_t fMinAlign = 1;
+  Int_t fTableStart = 0;
+  std::vector<std::pair<Int_t, Int_t>> fFields; // (slot, position) of the fields of the current table
+
+  Int_t Size() const { return fBuf.size(); }
+  void Align(Int_t n, Int_t extra = 0)
+  {
+    while ((fBuf.size() + extra) % n)
+      fBuf.push_back(0);
+    if (n > fMinAlign)
+      fMinAlign = n;
+  }
+  void PushRaw(const void* data, Int_t n)
+  {
+    const char* c = static_cast<const char*>(data);
+    for (Int_t i = n - 1; i >= 0; i--)
+      fBuf.push_back(c[i]);
+  }
+  template <typename T>
+  Int_t Push(T v)
+  {
+    Align(sizeof(T));
+    PushRaw(&v, sizeof(T));
+    return Size();
+  }
+  Int_t PushOffset(Int_t off)
+  {
+    Align(4);
+    return Push<UInt_t>(Size() + 4 - off);
+  }
+  Int_t CreateString(const char* s)
+  {
+    Int_t n = strlen(s);
+    Align(4, n + 1);
+    fBuf.push_back(0);
+    PushRaw(s, n);
+    return Push<UInt_t>(n);
+  }
+  Int_t CreateOffsetVector(const std::vector<Int_t>& offsets)
+  {
+    Align(4, 4 * offsets.size());
+    for (Int_t i = offsets.size() - 1; i >= 0; i--)
+      PushOffset(offsets[i]);
+    return Push<UInt_t>(offsets.size());
+  }
+  // Vector of structs made of 64 bit words (FieldNode, Buffer, Block)
+  Int_t CreateStructVector(const std::vector<Long64_t>& words, Int_t wordsPerStruct)
+  {
+    Int_t bytes = 8 * words.size();
+    Align(8, bytes);
+    for (Int_t i = words.size() - 1; i >= 0; i--)
+      PushRaw(&words[i], 8);
+    return Push<UInt_t>(words.size() / wordsPerStruct);
+  }
+  void StartTable()
+  {
+    fFields.clear();
+    fTableStart = Size();
+  }
+  template <typename T>
+  void AddScalar(Int_t slot, T v)
+  {
+    fFields.push_back(std::make_pair(slot, Push<T>(v)));
+  }
+  void AddOffset(Int_t slot, Int_t off)
+  {
+    fFields.push_back(std::make_pair(slot, PushOffset(off)));
+  }
+  Int_t EndTable()
+  {
+    Int_t table = Push<Int_t>(0);
+    Int_t nSlots = 0;
+    for (auto& f : fFields)
+      if (f.first + 1 > nSlots)
+        nSlots = f.first + 1;
+    std::vector<UShort_t> vtable(nSlots + 2, 0);
+    vtable[0] = 2 * (nSlots + 2);
+    vtable[1] = table - fTableStart;
+    for (auto& f : fFields)
+      vtable[2 + f.first] = table - f.second;
+    for (Int_t i = vtable.size() - 1; i >= 0; i--)
+      PushRaw(&vtable[i], 2);
+    // Patch the offset from the table to its vtable, which is placed just before it
+    Int_t soffset = Size() - table;
+    for (Int_t k = 0; k < 4; k++)
+      fBuf[table - 1 - k] = reinterpret_cast<const char*>(&soffset)[k];
+    return table;
+  }
+  void Finish(Int_t root, std::vector<char>& out)
+  {
+    Align(fMinAlign < 8 ? 8 : fMinAlign, 4);
+    PushOffset(root);
+    out.assign(fBuf.rbegin(), fBuf.rend());
+  }
+};
+
+AliAO2DArrowWriter::~AliAO2DArrowWriter()
+{
+  Close();
+}
+
+Bool_t AliAO2DArrowWriter::Open(const char* fileName, Int_t rowsPerBatch)
+{
+  Close();
+  fColumns.clear();
+  fBatchBlocks.clear();
+  fDictBlocks.clear();
+  fRows = 0;
+  fEntries = 0;
+  fSchemaWritten = kFALSE;
+  fRowsPerBatch = rowsPerBatch > 0 ? rowsPerBatch : 1000;
+  fFile.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!fFile.is_open())
+    return kFALSE;
+  fFile.write("ARROW1\0\0", 8);
+  return kTRUE;
+}
+
+Bool_t AliAO2DArrowWriter::AddColumn(const char* name, const void* address, Char_t type, Int_t length, Bool_t dictionary)
+{
+  if (!IsOpen() || fSchemaWritten || !address || length < 1)
+    return kFALSE;
+  Column col;
+  col.fName = name;
+  col.fAddress = static_cast<const char*>(address);
+  col.fType = type;
+  col.fLength = length;
+  switch (type) {
+  case 'B':
+  case 'b':
+    col.fWidth = 1;
+    break;
+  case 'S':
+  case 's':
+    col.fWidth = 2;
+    break;
+  case 'I':
+  case 'i':
+  case 'F':
+    col.fWidth = 4;
+    break;
+  case 'L':
+  case 'l':
+  case 'D':
+    col.fWidth = 8;
+    break;
+  default:
+    return kFALSE;
+  }
+  // Unsigned indices as wide as the values below 32 bits, int32 indices above (range checked in Fill)
+  if (dictionary && length == 1 && type != 'F' && type != 'D')
+    col.fIndexWidth = col.fWidth < 4 ? col.fWidth : 4;
+  col.fData.reserve(fRowsPerBatch * (col.fIndexWidth ? col.fIndexWidth : col.fWidth * length));
+  fColumns.push_back(col);
+  return kTRUE;
+}
+
+void AliAO2DArrowWriter::Fill()
+{
+  if (!IsOpen())
+    return;
+  if (!fSchemaWritten)
+    WriteSchema();
+  for (auto& col : fColumns) {
+    if (!col.fIndexWidth) {
+      col.fData.insert(col.fData.end(), col.fAddress, col.fAddress + col.fWidth * col.fLength);
+      continue;
+    }
+    ULong64_t value = 0;
+    memcpy(&value, col.fAddress, col.fWidth);
+    auto it = col.fDictIndex.find(value);
+    if (it == col.fDictIndex.end()) {
+      if (col.fIndexWidth >= 4 && col.fDictIndex.size() > (ULong64_t)kMaxInt)
+        ::Fatal("AliAO2DArrowWriter::Fill", "Dictionary of column %s exceeds the int32 index range", col.fName.Data());
+      it = col.fDictIndex.insert(std::make_pair(value, (ULong64_t)col.fDictIndex.size())).first;
+      col.fDictValues.insert(col.fDictValues.end(), col.fAddress, col.fAddress + col.fWidth);
+    }
+    const char* index = reinterpret_cast<const char*>(&it->second);
+    col.fData.insert(col.fData.end(), index, index + col.fIndexWidth);
+  }
+  fEntries++;
+  if (++fRows == fRowsPerBatch)
+    WriteRecordBatch();
+}
+
+void AliAO2DArrowWriter::Close()
+{
+  if (!IsOpen())
+    return;
+  if (!fSchemaWritten)
+    WriteSchema();
+  if (fRows > 0)
+    WriteRecordBatch();
+  WriteDictionaries();
+  const UInt_t eos[2] = { 0xFFFFFFFF, 0 };
+  fFile.write(reinterpret_cast<const char*>(eos), sizeof(eos));
+  WriteFooter();
+  fFile.close();
+  fColumns.clear();
+}
+
+Int_t AliAO2DArrowWriter::BuildSchema(FlatBuilder& b) const
+{
+  std::vector<Int_t> fields;
+  for (UInt_t i = 0; i < fColumns.size(); i++) {
+    const Column& col = fColumns[i];
+    // Value type
+    Int_t valueType;
+    UChar_t valueTypeId;
+    if (col.fType == 'F' || col.fType == 'D') {
+      b.StartTable();
+      b.AddScalar<Short_t>(0, col.fType == 'F' ? 1 : 2); // precision SINGLE / DOUBLE
+      valueType = b.EndTable();
+      valueTypeId = kTypeFloatingPoint;
+    } else {
+      b.StartTable();
+      b.AddScalar<Int_t>(0, 8 * col.fWidth);                // bitWidth
+      b.AddScalar<UChar_t>(1, col.fType >= 'A' && col.fType <= 'Z'); // is_signed
+      valueType = b.EndTable();
+      valueTypeId = kTypeInt;
+    }
+    Int_t type = valueType;
+    UChar_t typeId = valueTypeId;
+    std::vector<Int_t> children;
+    if (col.fLength > 1) {
+      Int_t itemName = b.CreateString("item");
+      Int_t itemChildren = b.CreateOffsetVector(std::vector<Int_t>());
+      b.StartTable();
+      b.AddOffset(0, itemName);
+      b.AddScalar<UChar_t>(1, 0);
+      b.AddScalar<UChar_t>(2, valueTypeId);
+      b.AddOffset(3, valueType);
+      b.AddOffset(5, itemChildren);
+      children.push_back(b.EndTable());
+      b.StartTable();
+      b.AddScalar<Int_t>(0, col.fLength); // listSize
+      type = b.EndTable();
+      typeId = kTypeFixedSizeList;
+    }
+    Int_t dictionary = 0;
+    if (col.fIndexWidth) {
+      b.StartTable();
+      b.AddScalar<Int_t>(0, 8 * col.fIndexWidth);
+      b.AddScalar<UChar_t>(1, col.fIndexWidth >= 4); // unsigned indices of the width of the values, int32 above
+      Int_t indexType = b.EndTable();
+      b.StartTable();
+      b.AddScalar<Long64_t>(0, i); // dictionary id
+      b.AddOffset(1, indexType);
+      b.AddScalar<UChar_t>(2, 0); // isOrdered
+      dictionary = b.EndTable();
+    }
+    Int_t name = b.CreateString(col.fName.Data());
+    Int_t childVector = b.CreateOffsetVector(children);
+    b.StartTable();
+    b.AddOffset(0, name);
+    b.AddScalar<UChar_t>(1, 0); // not nullable
+    b.AddScalar<UChar_t>(2, typeId);
+    b.AddOffset(3, type);
+    if (dictionary)
+      b.AddOffset(4, dictionary);
+    b.AddOffset(5, childVector);
+    fields.push_back(b.EndTable());
+  }
+  Int_t fieldVector = b.CreateOffsetVector(fields);
+  b.StartTable();
+  b.AddScalar<Short_t>(0, 0); // little endian
+  b.AddOffset(1, fieldVector);
+  return b.EndTable();
+}
+
+Long64_t AliAO2DArrowWriter::WriteMessage(UChar_t headerType, FlatBuilder& b, Int_t header, const std::vector<char>& body, Long64_t& metaLength)
+{
+  b.StartTable();
+  b.AddScalar<Long64_t>(3, body.size()); // bodyLength
+  b.AddOffset(2, header);
+  b.AddScalar<Short_t>(0, kMetadataV5);
+  b.AddScalar<UChar_t>(1, headerType);
+  std::vector<char> metadata;
+  b.Finish(b.EndTable(), metadata);
+
+  // Pad the metadata so that the body starts on a 64 byte boundary of the file
+  Long64_t offset = fFile.tellp();
+  Int_t length = metadata.size();
+  length += Padding(offset + 8 + length, kAlignment);
+  metadata.resize(length, 0);
+  const Int_t prefix[2] = { -1, length };
+  fFile.write(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+  fFile.write(metadata.data(), length);
+  if (!body.empty())
+    fFile.write(body.data(), body.size());
+  metaLength = 8 + length;
+  return offset;
+}
+
+void AliAO2DArrowWriter::WriteSchema()
+{
+  FlatBuilder b;
+  Int_t schema = BuildSchema(b);
+  Long64_t metaLength;
+  WriteMessage(kHeaderSchema, b, schema, std::vector<char>(), metaLength);
+  fSchemaWritten = kTRUE;
+}
+
+namespace
+{
+
+// Append a buffer to the body of a record batch and record its (offset, length)
+void AddBuffer(std::vector<char>& body, std::vector<Long64_t>& buffers, const std::vector<char>* data)
+{
+  Long64_t length = data ? data->size() : 0;
+  buffers.push_back(body.size());
+  buffers.push_back(length);
+  if (length) {
+    body.insert(body.end(), data->begin(), data->end());
+    body.resize(body.size() + Padding(length, kAlignment), 0);
+  }
+}
+
+} // namespace
+
+void AliAO2DArrowWriter::WriteRecordBatch()
+{
+  // All columns are non nullable: the validity buffers are empty
+  std::vector<char> body;
+  std::vector<Long64_t> nodes, buffers;
+  for (auto& col : fColumns) {
+    nodes.push_back(fRows);
+    nodes.push_back(0);
+    AddBuffer(body, buffers, nullptr);
+    if (col.fLength > 1) {
+      nodes.push_back(fRows * col.fLength);
+      nodes.push_back(0);
+      AddBuffer(body, buffers, nullptr);
+    }
+    AddBuffer(body, buffers, &col.fData);
+    col.fData.clear();
+  }
+
+  FlatBuilder b;
+  Int_t nodeVector = b.CreateStructVector(nodes, 2);
+  Int_t bufferVector = b.CreateStructVector(buffers, 2);
+  b.StartTable();
+  b.AddScalar<Long64_t>(0, fRows);
+  b.AddOffset(1, nodeVector);
+  b.AddOffset(2, bufferVector);
+  Int_t batch = b.EndTable();
+
+  Long64_t metaLength;
+  fBatchBlocks.push_back(WriteMessage(kHeaderRecordBatch, b, batch, body, metaLength));
+  fBatchBlocks.push_back(metaLength);
+  fBatchBlocks.push_back(body.size());
+  fRows = 0;
+}
+
+void AliAO2DArrowWriter::WriteDictionaries()
+{
+  for (UInt_t i = 0; i < fColumns.size(); i++) {
+    const Column& col = fColumns[i];
+    if (!col.fIndexWidth)
+      continue;
+    std::vector<char> body;
+    std::vector<Long64_t> nodes, buffers;
+    nodes.push_back(col.fDictIndex.size());
+    nodes.push_back(0);
+    AddBuffer(body, buffers, nullptr);
+    AddBuffer(body, buffers, &col.fDictValues);
+
+    FlatBuilder b;
+    Int_t nodeVector = b.CreateStructVector(nodes, 2);
+    Int_t bufferVector = b.CreateStructVector(buffers, 2);
+    b.StartTable();
+    b.AddScalar<Long64_t>(0, col.fDictIndex.size());
+    b.AddOffset(1, nodeVector);
+    b.AddOffset(2, bufferVector);
+    Int_t data = b.EndTable();
+    b.StartTable();
+    b.AddScalar<Long64_t>(0, i); // id
+    b.AddOffset(1, data);
+    b.AddScalar<UChar_t>(2, 0); // not a delta
+    Int_t dictionary = b.EndTable();
+
+    Long64_t metaLength;
+    fDictBlocks.push_back(WriteMessage(kHeaderDictionaryBatch, b, dictionary, body, metaLength));
+    fDictBlocks.push_back(metaLength);
+    fDictBlocks.push_back(body.size());
+  }
+}
+
+namespace
+{
+
+// Block structs of the footer: offset (int64), metaDataLength (int32 + 4 bytes padding), bodyLength (int64)
+std::vector<Long64_t> MakeBlocks(const std::vector<Long64_t>& blocks)
+{
+  std::vector<Long64_t> words(blocks);
+  for (UInt_t i = 1; i < words.size(); i += 3)
+    words[i] &= 0xFFFFFFFF;
+  return words;
+}
+
+} // namespace
+
+void AliAO2DArrowWriter::WriteFooter()
+{
+  FlatBuilder b;
+  Int_t schema = BuildSchema(b);
+  Int_t dictionaries = b.CreateStructVector(MakeBlocks(fDictBlocks), 3);
+  Int_t batches = b.CreateStructVector(MakeBlocks(fBatchBlocks), 3);
+  b.StartTable();
+  b.AddOffset(1, schema);
+  b.AddOffset(2, dictionaries);
+  b.AddOffset(3, batches);
+  b.AddScalar<Short_t>(0, kMetadataV5);
+  std::vector<char> footer;
+  b.Finish(b.EndTable(), footer);
+
+  Int_t length = footer.size();
+  fFile.write(footer.data(), length);
+  fFile.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  fFile.write("ARROW1", 6);
+}
@@ -0,0 +1,75 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. */
+/* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef AliAO2DArrowWriter_H
+#define AliAO2DArrowWriter_H
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+// Writer of one AO2D table as an Apache Arrow IPC file (Feather V2).
+// The columns are bound to the same memory as the branches of the AO2D tree,
+// Fill() copies the current values. Every fRowsPerBatch rows a record batch
+// is written. The buffers are uncompressed and 64 byte aligned, so the
+// file can be memory mapped and read without copies (pyarrow.memory_map,
+// arrow::io::MemoryMappedFile).
+// Dictionary encoded columns keep one dictionary for the whole file, which
+// is written after the last record batch and referenced from the footer.
+class AliAO2DArrowWriter
+{
+public:
+  AliAO2DArrowWriter() = default;
+  ~AliAO2DArrowWriter();
+
+  AliAO2DArrowWriter(const AliAO2DArrowWriter &) = delete;
+  AliAO2DArrowWriter &operator=(const AliAO2DArrowWriter &) = delete;
+
+  Bool_t Open(const char *fileName, Int_t rowsPerBatch = 1000);
+  // Add a column of ROOT leaf type (B, b, S, s, I, i, L, l, F, D) with length values per row.
+  // Only scalar integer columns can be dictionary encoded
+  Bool_t AddColumn(const char *name, const void *address, Char_t type, Int_t length = 1, Bool_t dictionary = kFALSE);
+  void Fill();
+  void Close();
+
+  Bool_t IsOpen() const { return fFile.is_open(); }
+  Long64_t GetEntries() const { return fEntries; }
+  Int_t GetNColumns() const { return fColumns.size(); }
+
+private:
+  struct Column {
+    TString fName;                   // Column name
+    const char *fAddress = nullptr;  // Address of the value(s) of the current row
+    Char_t fType = 0;                // ROOT leaf type code
+    Int_t fWidth = 0;                // Bytes per value
+    Int_t fLength = 1;               // Values per row (fixed size list if >1)
+    Int_t fIndexWidth = 0;           // Bytes per dictionary index (0 if not dictionary encoded)
+    std::vector<char> fData;         // Values (or dictionary indices) of the current batch
+    std::vector<char> fDictValues;   // Dictionary values
+    std::unordered_map<ULong64_t, ULong64_t> fDictIndex; // Value -> dictionary index
+  };
+
+  struct FlatBuilder; // Serialiser of the flatbuffer metadata
+
+  Int_t BuildSchema(FlatBuilder &b) const;
+  Long64_t WriteMessage(UChar_t headerType, FlatBuilder &b, Int_t header, const std::vector<char> &body, Long64_t &metaLength);
+  void WriteSchema();
+  void WriteRecordBatch();
+  void WriteDictionaries();
+  void WriteFooter();
+
+  std::ofstream fFile;             // Output file
+  std::vector<Column> fColumns;    // Columns of the table
+  Int_t fRowsPerBatch = 1000;      // Rows per record batch
+  Int_t fRows = 0;                 // Rows in the current batch
+  Long64_t fEntries = 0;           // Rows written
+  Bool_t fSchemaWritten = kFALSE;  // Schema message written
+  std::vector<Long64_t> fBatchBlocks; // (offset, metadata length, body length) of the record batches
+  std::vector<Long64_t> fDictBlocks;  // (offset, metadata length, body length) of the dictionary batches
+};
+
+#endif
@@ -20,6 +20,8 @@
 
 #include <TChain.h>
 #include <TTree.h>
+#include <TLeaf.h>
+#include <TROOT.h>
 #include <TMath.h>
 #include "AliAnalysisTask.h"
 #include "AliAnalysisManager.h"
@@ -27,6 +29,7 @@
 #include "AliESDInputHandler.h"
 #include "AliEMCALGeometry.h"
 #include "AliAnalysisTaskAO2Dconverter.h"
+#include "AliAO2DArrowWriter.h"
 #include "AliVHeader.h"
 #include "AliAnalysisManager.h"
 
@@ -118,9 +121,12 @@ AliAnalysisTaskAO2Dconverter::AliAnalysisTaskAO2Dconverter(const char* name)
 
 AliAnalysisTaskAO2Dconverter::~AliAnalysisTaskAO2Dconverter()
 {
-  for (Int_t i = 0; i < kTrees; i++)
+  for (Int_t i = 0; i < kTrees; i++) {
     if (fTree[i])
       delete fTree[i];
+    if (fArrowWriter[i])
+      delete fArrowWriter[i];
+  }
 }
 
 const TString AliAnalysisTaskAO2Dconverter::TreeName[kTrees] = { "O2collision", "DbgEventExtra", "O2track", "O2calo",  "O2calotrigger", "O2muon", "O2muoncluster", "O2zdc", "Run2v0", "O2fdd", "O2v0", "O2cascade", "O2tof", "O2mcparticle", "O2mccollision", "O2mctracklabel", "O2mccalolabel", "O2mccollisionlabel", "O2bc" };
@@ -132,6 +138,12 @@ const TClass* AliAnalysisTaskAO2Dconverter::Generator[kGenerators] = { AliGenEve
 TTree* AliAnalysisTaskAO2Dconverter::CreateTree(TreeIndex t)
 {
   fTree[t] = new TTree(TreeName[t], TreeTitle[t]);
+#ifdef R__USE_IMT
+  // With implicit MT the baskets of all branches are compressed and written in parallel when a cluster is flushed.
+  // Without writer threads the tree keeps its default, which follows ROOT::EnableImplicitMT
+  if (fNumberOfWriterThreads > 0)
+    fTree[t]->SetImplicitMT(kTRUE);
+#endif
   return fTree[t];
 }
 
@@ -146,7 +158,10 @@ void AliAnalysisTaskAO2Dconverter::FillTree(TreeIndex t)
 {
   if (!fTreeStatus[t])
     return;
-  fTree[t]->Fill();
+  if (fOutputFormat & kTTreeOutput)
+    fTree[t]->Fill();
+  if (fArrowWriter[t])
+    fArrowWriter[t]->Fill();
 }
 
 void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
@@ -169,6 +184,24 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
   fOffsetV0ID = 0;
   fOffsetLabel = 0;
 
+  // Compression of the output baskets in the ROOT implicit MT pool, which the steering macro has to enable
+  // (the pool is process wide and shared with the other tasks of the train).
+  // Fill stays on the main thread and each flush waits for its tasks, so at most one cluster per tree is in memory
+  // and the content of the output trees is the same as without threads (only the order of the baskets in the file changes)
+  if (fNumberOfWriterThreads > 0) {
+#ifdef R__USE_IMT
+    if (ROOT::IsImplicitMTEnabled()) {
+      AliInfo(Form("Compressing output baskets with %u threads", ROOT::GetImplicitMTPoolSize()));
+    } else {
+      AliWarning("Implicit multithreading is not enabled (ROOT::EnableImplicitMT), writing output on the main thread");
+      fNumberOfWriterThreads = 0;
+    }
+#else
+    AliWarning("ROOT was built without implicit multithreading, writing output on the main thread");
+    fNumberOfWriterThreads = 0;
+#endif
+  }
+
   // create output objects
   OpenFile(1); // Necessary for large outputs
 
@@ -484,6 +517,42 @@ void AliAnalysisTaskAO2Dconverter::UserCreateOutputObjects()
 
 
   Prune(); //Removing all unwanted branches (if any)
+
+  if (fOutputFormat & kArrowOutput)
+    OpenArrowWriters();
+}
+
+void AliAnalysisTaskAO2Dconverter::OpenArrowWriters()
+{
+  // One Arrow file per active tree, with the columns of the branches that survived the pruning.
+  // The columns read the same (truncated) variables as the branches in FillTree
+  TObjArray* dictionaryColumns = fArrowDictionaryColumns.Tokenize(" ");
+  for (Int_t i = 0; i < kTrees; i++) {
+    if (!fTree[i] || !fTreeStatus[i])
+      continue;
+    TString fileName = fArrowFilePrefix + TreeName[i] + ".arrow";
+    AliAO2DArrowWriter* writer = new AliAO2DArrowWriter();
+    if (!writer->Open(fileName, fNumberOfEventsPerCluster))
+      AliFatal(Form("Cannot open the Arrow file %s", fileName.Data()));
+    // Saved with the job outputs; Arrow files are not merged, each job keeps its own set
+    AliAnalysisManager::GetAnalysisManager()->RegisterExtraFile(fileName);
+    TObjArray* branches = fTree[i]->GetListOfBranches();
+    for (Int_t k = 0; k < branches->GetEntries(); k++) {
+      TBranch* branch = (TBranch*)branches->At(k);
+      if (!fTree[i]->GetBranchStatus(branch->GetName()))
+        continue;
+      TLeaf* leaf = (TLeaf*)branch->GetListOfLeaves()->At(0);
+      TString leaflist = branch->GetTitle();
+      Char_t type = leaflist[leaflist.Length() - 1];
+      if (type == 'C')
+        type = 'B'; // Single Char_t booked as a string leaf
+      Bool_t dictionary = dictionaryColumns->FindObject(branch->GetName()) != nullptr;
+      if (!writer->AddColumn(branch->GetName(), branch->GetAddress(), type, leaf->GetLenStatic(), dictionary))
+        AliFatal(Form("Cannot write branch %s of %s to Arrow", branch->GetName(), TreeName[i].Data()));
+    }
+    fArrowWriter[i] = writer;
+  }
+  delete dictionaryColumns;
 }
 
 void AliAnalysisTaskAO2Dconverter::Prune()
@@ -494,6 +563,8 @@ void AliAnalysisTaskAO2Dconverter::Prune()
   for (Int_t i = 0; i < arr->GetEntries(); i++) {
     Bool_t found = kFALSE;
     for (Int_t j = 0; j < kTrees; j++) {
+      if (!fTree[j])
+        continue;
       TObjArray* branches = fTree[j]->GetListOfBranches();
       for (Int_t k = 0; k < branches->GetEntries(); k++) {
         TString bname = branches->At(k)->GetName();
@@ -1360,6 +1431,18 @@ void AliAnalysisTaskAO2Dconverter::UserExec(Option_t *)
   fOffsetV0ID += nv0;
 }
 
+void AliAnalysisTaskAO2Dconverter::FinishTaskOutput()
+{
+  // Write the last record batches, the dictionaries and the footers of the Arrow files
+  for (Int_t i = 0; i < kTrees; i++) {
+    if (!fArrowWriter[i])
+      continue;
+    AliInfo(Form("Wrote %lld entries to %s%s.arrow", fArrowWriter[i]->GetEntries(), fArrowFilePrefix.Data(), TreeName[i].Data()));
+    delete fArrowWriter[i];
+    fArrowWriter[i] = nullptr;
+  }
+}
+
 void AliAnalysisTaskAO2Dconverter::Terminate(Option_t *)
 {
   // terminate
@@ -16,6 +16,7 @@
 #include <Rtypes.h>
 
 class AliESDEvent;
+class AliAO2DArrowWriter;
 
 class AliAnalysisTaskAO2Dconverter : public AliAnalysisTaskSE
 {
@@ -33,11 +34,21 @@ public:
   virtual void UserCreateOutputObjects();
   virtual void UserExec(Option_t *option);
   virtual void Terminate(Option_t *option);
+  virtual void FinishTaskOutput();
 
   void SetNumberOfEventsPerCluster(int n) { fNumberOfEventsPerCluster = n; }
+  void SetNumberOfWriterThreads(int n) { fNumberOfWriterThreads = n; } // Compress/write the tree baskets in the implicit MT pool enabled by the macro (0 = main thread only)
 
   virtual void SetTruncation(Bool_t trunc=kTRUE) {fTruncate = trunc;}
 
+  enum OutputFormat { // Output sinks, can be combined
+    kTTreeOutput = BIT(0), // TTrees in the analysis output file (default)
+    kArrowOutput = BIT(1)  // One Arrow IPC (Feather V2) file per tree, registered as extra job output (not merged)
+  };
+  void SetOutputFormat(UInt_t format) { fOutputFormat = format; }
+  void SetArrowFilePrefix(TString prefix) { fArrowFilePrefix = prefix; }                 // Arrow files are named <prefix><tree name>.arrow
+  void SetArrowDictionaryColumns(TString columns) { fArrowDictionaryColumns = columns; } // Space separated list of dictionary encoded columns
+
   static AliAnalysisTaskAO2Dconverter* AddTask(TString suffix = "");
   enum TreeIndex { // Index of the output trees
     kEvents = 0,
@@ -115,11 +126,19 @@ private:
   TTree* fTree[kTrees] = { nullptr }; //! Array with all the output trees
   void Prune();                       // Function to perform tree pruning
   void FillTree(TreeIndex t);         // Function to fill the trees (only the active ones)
+  void OpenArrowWriters();            // Function to create the Arrow writers of the active trees
+
+  // Output Arrow files
+  AliAO2DArrowWriter* fArrowWriter[kTrees] = { nullptr }; //! Arrow writers of the trees
 
   // Task configuration variables
   TString fPruneList = "";                // Names of the branches that will not be saved to output file
   Bool_t fTreeStatus[kTrees] = { kTRUE }; // Status of the trees i.e. kTRUE (enabled) or kFALSE (disabled)
   int fNumberOfEventsPerCluster = 1000;   // Maximum basket size of the trees
+  int fNumberOfWriterThreads = 0;         // Requested writer threads, >0 uses the ROOT implicit MT pool to compress the baskets
+  UInt_t fOutputFormat = kTTreeOutput;    // Output sinks (OutputFormat)
+  TString fArrowFilePrefix = "AO2D_";     // Prefix of the Arrow file names
+  TString fArrowDictionaryColumns = "fTrackType fFlags fCollisionTimeMask fCaloType fCellType fTriggerBits fLabelMask fGeneratorsID fStatusCode"; // Dictionary encoded Arrow columns
 
   TaskModes fTaskMode = kStandard; // Running mode of the task. Useful to set for e.g. MC mode
 
@@ -446,7 +465,7 @@ private:
   /// Set truncation
   Bool_t fTruncate = kFALSE;
   
-  ClassDef(AliAnalysisTaskAO2Dconverter, 9);
+  ClassDef(AliAnalysisTaskAO2Dconverter, 11);
 };
 
 #endif
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+# Compare the trees of AO2D.root with the Arrow files written by the converter with
+# SetOutputFormat(kTTreeOutput | kArrowOutput), e.g. convertAO2D(kFALSE, 0, kTRUE)
+#
+# usage: python3 compareAO2Darrow.py [AO2D.root] [arrow file prefix]
+
+import math
+import sys
+
+import ROOT
+import pyarrow as pa
+import pyarrow.ipc as ipc
+
+
+def same(a, b):
+    if isinstance(a, float) and math.isnan(a):
+        return isinstance(b, float) and math.isnan(b)
+    return a == b
+
+
+def compare(tree, table):
+    if tree.GetEntries() != table.num_rows:
+        return "%d entries in the tree, %d in the Arrow file" % (tree.GetEntries(), table.num_rows)
+    columns = {name: table.column(name).to_pylist() for name in table.column_names}
+    for name in columns:
+        if not tree.GetBranch(name):
+            return "column %s not in the tree" % name
+    for i in range(tree.GetEntries()):
+        tree.GetEntry(i)
+        for name, values in columns.items():
+            leaf = tree.GetLeaf(name)
+            if leaf.InheritsFrom("TLeafC"):
+                continue  # single characters booked as strings in the tree
+            if leaf.GetLenStatic() > 1:
+                treeValue = [leaf.GetValue(k) for k in range(leaf.GetLenStatic())]
+                if not all(same(float(a), float(b)) for a, b in zip(treeValue, values[i])):
+                    return "entry %d, column %s: %s != %s" % (i, name, treeValue, values[i])
+            elif not same(float(leaf.GetValue()), float(values[i])):
+                return "entry %d, column %s: %s != %s" % (i, name, leaf.GetValue(), values[i])
+    return None
+
+
+def main():
+    rootFile = sys.argv[1] if len(sys.argv) > 1 else "AO2D.root"
+    prefix = sys.argv[2] if len(sys.argv) > 2 else "AO2D_"
+    f = ROOT.TFile.Open(rootFile)
+    failed = False
+    for key in f.GetListOfKeys():
+        tree = f.Get(key.GetName())
+        if not isinstance(tree, ROOT.TTree):
+            continue
+        try:
+            table = ipc.open_file(pa.memory_map(prefix + tree.GetName() + ".arrow")).read_all()
+        except (IOError, OSError):
+            print("%-20s no Arrow file" % tree.GetName())
+            continue
+        error = compare(tree, table)
+        print("%-20s %8d entries %s" % (tree.GetName(), tree.GetEntries(), error if error else "OK"))
+        failed = failed or error is not None
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()